@@ -158,6 +158,8 @@ int ActivationDriver<T>::AddCmdLineArgs()
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
+    inflags.AddInputFlag(
+        "bandwidth", 'w', "0", "Measure Forward Bandwidth over iter runs (Default=0)", "int");
 
     return 0;
 }
@@ -262,6 +264,33 @@ int ActivationDriver<T>::RunForwardGPU()
         printf("GPU Kernel Time Forward Activation Elapsed: %f ms\n", time);
     }
 
+    if(inflags.GetValueInt("bandwidth") == 1)
+    {
+        // The first run above has built the kernel, so only the steady state is timed.
+        miopenEnableProfiling(GetHandle(), true);
+
+        int iters   = inflags.GetValueInt("iter");
+        float total = 0;
+        for(int i = 0; i < iters; i++)
+        {
+            miopenActivationForward(GetHandle(),
+                                    activDesc,
+                                    &alpha,
+                                    inputTensor,
+                                    in_dev->GetMem(),
+                                    &beta,
+                                    outputTensor,
+                                    out_dev->GetMem());
+            float time = 0;
+            miopenGetKernelTime(GetHandle(), &time);
+            total += time;
+        }
+
+        float ms    = total / iters;
+        double gbps = 2.0 * in.size() * sizeof(T) / (ms * 1e6);
+        printf("Forward Activation: %f ms, %.1f GB/s\n", ms, gbps);
+    }
+
     out_dev->FromGPU(GetStream(), out.data());
 
     return miopenStatusSuccess;
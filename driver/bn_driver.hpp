@@ -30,6 +30,7 @@
 #include "InputFlags.hpp"
 #include "driver.hpp"
 #include "miopen_BatchNormHost.hpp"
+#include "mloNeuronHost.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include <algorithm>
@@ -69,6 +70,7 @@ class BatchNormDriver : public Driver
         miopenCreateTensorDescriptor(&outputTensor);
         miopenCreateTensorDescriptor(&dxOutputTensor);
         miopenCreateTensorDescriptor(&dyInputTensor);
+        miopenCreateActivationDescriptor(&activDesc);
     }
 
     int AddCmdLineArgs();
@@ -94,6 +96,7 @@ class BatchNormDriver : public Driver
     void runGPUBwd(double epsilon, T alpha, T beta);
 
     void runCPUFwdInference(double epsilon, int batch_sz, int channels, int height, int width);
+    void runCPUFusedActivation();
     void
     runCPUFwdTrain(double epsilon, double eAF, int batch_sz, int channels, int height, int width);
 
@@ -107,6 +110,7 @@ class BatchNormDriver : public Driver
         miopenDestroyTensorDescriptor(biasScaleTensor);
         miopenDestroyTensorDescriptor(dxOutputTensor);
         miopenDestroyTensorDescriptor(dyInputTensor);
+        miopenDestroyActivationDescriptor(activDesc);
     }
 
     private:
@@ -115,6 +119,7 @@ class BatchNormDriver : public Driver
     bool bsaveMeanVar;
     bool keepRunningMeanVar;
     bool estimatedMeanVar;
+    int activMode;
 
     unsigned char forw;
     unsigned char back;
@@ -129,6 +134,9 @@ class BatchNormDriver : public Driver
     miopenTensorDescriptor_t dyInputTensor;
     miopenTensorDescriptor_t dxOutputTensor;
 
+    // Activation fused into inference
+    miopenActivationDescriptor_t activDesc;
+
     std::unique_ptr<GPUMem> dyin_dev; // this is the output of fwd
     std::unique_ptr<GPUMem> in_dev;
     std::unique_ptr<GPUMem> out_dev;
@@ -267,6 +275,12 @@ int BatchNormDriver<T>::AddCmdLineArgs()
         "int");
     inflags.AddInputFlag(
         "wall", 'w', "0", "Wall-clock Time Each Layer, Requires time == 1 (Default=0)", "int");
+    inflags.AddInputFlag("activ",
+                         'a',
+                         "-1",
+                         "Activation fused into inference, requires run == 1 (off: -1, "
+                         "miopenActivationMode_t otherwise) (Default=-1)",
+                         "int");
 
     return miopenStatusSuccess;
 }
@@ -340,6 +354,21 @@ int BatchNormDriver<T>::SetBNParametersFromCmdLineArgs()
         exit(EXIT_FAILURE);
     }
 
+    // fused activation
+    activMode = inflags.GetValueInt("activ");
+    if(activMode > miopenActivationPOWER || (activMode >= 0 && (forw != 2 || !keepRunningMeanVar)))
+    {
+        printf("Incorrect Batch Normalization fused activation mode\n");
+        exit(EXIT_FAILURE);
+    }
+    if(activMode >= 0)
+    {
+        // ReLU is plain max(0, x), tanh and the rest use unit scale and shift
+        double activBeta = (activMode == miopenActivationRELU) ? 0. : 1.;
+        miopenSetActivationDescriptor(
+            activDesc, static_cast<miopenActivationMode_t>(activMode), 1., activBeta, 1.);
+    }
+
     back = inflags.GetValueInt("back");
     if(back > 1)
     {
@@ -612,7 +641,25 @@ template <typename T>
 void BatchNormDriver<T>::runGPUFwdInference(double epsilon, T alpha, T beta)
 {
 
-    if(keepRunningMeanVar)
+    if(activMode >= 0)
+    { // use precalculated mean and variance, fused activation
+        miopenBatchNormalizationActivationForwardInference(GetHandle(),
+                                                           bn_mode,
+                                                           &alpha,
+                                                           &beta,
+                                                           inputTensor,
+                                                           in_dev->GetMem(),
+                                                           outputTensor,
+                                                           out_dev->GetMem(),
+                                                           biasScaleTensor,
+                                                           scale_dev->GetMem(),
+                                                           bias_dev->GetMem(),
+                                                           runningMean_dev->GetMem(),
+                                                           runningVariance_dev->GetMem(),
+                                                           epsilon,
+                                                           activDesc);
+    }
+    else if(keepRunningMeanVar)
     { // use precalculated mean and variance
         miopenBatchNormalizationForwardInference(GetHandle(),
                                                  bn_mode,
@@ -954,6 +1001,8 @@ int BatchNormDriver<T>::RunForwardCPU()
     else if(forw == 2)
     { // inference only
         runCPUFwdInference(epsilon, /* alpha, beta,*/ batch_sz, channels, height, width);
+        if(activMode >= 0)
+            runCPUFusedActivation();
     }
 
     return miopenStatusSuccess;
@@ -1059,6 +1108,34 @@ int BatchNormDriver<T>::RunBackwardGPU()
     return miopenStatusSuccess;
 }
 
+template <typename T>
+void BatchNormDriver<T>::runCPUFusedActivation()
+{
+    miopenActivationMode_t v_mode;
+    double v_Alpha;
+    double v_Beta;
+    double v_Power;
+    miopenGetActivationDescriptor(activDesc, &v_mode, &v_Alpha, &v_Beta, &v_Power);
+
+    // in place on the batch norm reference
+    int size     = out_host.size();
+    double* data = out_host.data();
+    switch(v_mode)
+    {
+    case miopenActivationPATHTRU: break;
+    case miopenActivationLOGISTIC: ActivationFunction_Sigmoid<double>(size, data, data); break;
+    case miopenActivationTANH:
+        ActivationFunction_TanH<double>(size, data, data, v_Alpha, v_Beta);
+        break;
+    case miopenActivationRELU: ActivationFunction_ReLU<double>(size, data, data, v_Beta); break;
+    case miopenActivationSOFTRELU: ActivationFunction_BNLL<double>(size, data, data); break;
+    case miopenActivationABS: ActivationFunction_Abs<double>(size, data, data); break;
+    case miopenActivationPOWER:
+        ActivationFunction_Power<double>(size, data, data, v_Power, v_Alpha, v_Beta);
+        break;
+    }
+}
+
 template <typename T>
 int BatchNormDriver<T>::VerifyForward()
 {
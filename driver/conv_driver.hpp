@@ -42,6 +42,7 @@
 #include "timer.hpp"
 #include "util_driver.hpp"
 #include <miopen/convolution.hpp>
+#include <../test/cpu_conv.hpp>
 #include <../test/verify.hpp>
 #include <algorithm>
 #include <cstdlib>
@@ -128,6 +129,7 @@ class ConvDriver : public Driver
                     std::vector<miopenConvAlgoPerf_t>& perf_results);
     int RunForwardGPU();
     int RunForwardCPU();
+    int RunForwardPlanLatency(miopenConvFwdAlgorithm_t algo);
 
     int FindBackwardData(int& ret_algo_count,
                          int request_algo_count,
@@ -285,6 +287,12 @@ int ConvDriver<T>::AddCmdLineArgs()
     inflags.AddInputFlag("dilation_h", 'l', "1", "Dilation of Filter Height (Default=1)", "int");
     inflags.AddInputFlag("dilation_w", 'j', "1", "Dilation of Filter Width (Default=1)", "int");
     inflags.AddInputFlag("in_bias", 'a', "", "Input bias filename (Default=)", "string");
+    inflags.AddInputFlag("plan",
+                         'L',
+                         "0",
+                         "Compare per-call host latency of Forward Convolution with and without a "
+                         "prepared plan (Default=0)",
+                         "int");
 
     return 0;
 }
@@ -633,6 +641,11 @@ int ConvDriver<T>::RunForwardGPU()
         printf("GPU Kernel Time Forward Conv. Elapsed: %f ms\n", time);
     }
 
+    if(inflags.GetValueInt("plan") == 1)
+    {
+        RunForwardPlanLatency(perf_results[0].fwd_algo);
+    }
+
     if(inflags.GetValueInt("bias") != 0)
     {
         if((inflags.GetValueStr("mode")) == "conv")
@@ -675,6 +688,70 @@ int ConvDriver<T>::RunForwardGPU()
     return miopenStatusSuccess;
 }
 
+template <typename T>
+int ConvDriver<T>::RunForwardPlanLatency(miopenConvFwdAlgorithm_t algo)
+{
+    float alpha = 1, beta = 0;
+    int iters   = inflags.GetValueInt("iter");
+
+    auto workspace      = (workspace_fwd_dev != nullptr) ? workspace_fwd_dev->GetMem() : nullptr;
+    auto workspace_size = (workspace_fwd_dev != nullptr) ? workspace_fwd_dev->GetSize() : 0;
+
+    miopenConvolutionPlan_t plan;
+    if(miopenCreateConvolutionForwardPlan(
+           GetHandle(), &plan, inputTensor, weightTensor, convDesc, outputTensor, algo) !=
+       miopenStatusSuccess)
+    {
+        printf("Could not create Forward Conv. plan for algorithm %d\n", algo);
+        return miopenStatusUnknownError;
+    }
+
+    // Only the host side is timed: the calls are enqueued back to back and the queue is drained
+    // by the read back below. Run with -t 0, profiling waits for every kernel to complete.
+    Timer t;
+    t.start();
+    for(int i = 0; i < iters; i++)
+    {
+        miopenConvolutionForward(GetHandle(),
+                                 &alpha,
+                                 inputTensor,
+                                 in_dev->GetMem(),
+                                 weightTensor,
+                                 wei_dev->GetMem(),
+                                 convDesc,
+                                 algo,
+                                 &beta,
+                                 outputTensor,
+                                 out_dev->GetMem(),
+                                 workspace,
+                                 workspace_size);
+    }
+    t.stop();
+    float desc_time = t.gettime_ms();
+    out_dev->FromGPU(GetStream(), out.data());
+
+    t.start();
+    for(int i = 0; i < iters; i++)
+    {
+        miopenExecuteConvolutionPlan(GetHandle(),
+                                     plan,
+                                     in_dev->GetMem(),
+                                     wei_dev->GetMem(),
+                                     out_dev->GetMem(),
+                                     workspace,
+                                     workspace_size);
+    }
+    t.stop();
+    float plan_time = t.gettime_ms();
+    out_dev->FromGPU(GetStream(), out.data());
+
+    miopenDestroyConvolutionPlan(plan);
+
+    printf("Host Latency Forward Conv. (descriptor): %f us/call\n", 1000 * desc_time / iters);
+    printf("Host Latency Forward Conv. (plan): %f us/call\n", 1000 * plan_time / iters);
+    return miopenStatusSuccess;
+}
+
 template <typename T>
 int ConvDriver<T>::RunForwardCPU()
 {
@@ -755,44 +832,26 @@ int ConvDriver<T>::RunForwardCPU()
                                     &wei_hstride,
                                     &wei_wstride);
 
-        for(int o = 0; o < out_n; o++)
-        { // mini-batch size
-            for(int w = 0; w < out_c; w++)
-            { // out_channels (num filters)
-                for(int i = 0; i < out_h; i++)
-                { // output_height (from getforwardoutputdim())
-                    int in_off_h = i * u;
-                    for(int j = 0; j < out_w; j++)
-                    { // output_width (from getforwardoutputdim())
-                        float acc    = 0;
-                        int in_off_w = j * v;
-                        for(int k = 0; k < in_c; k++)
-                        { // in_channels (RGB)
-                            for(int x = 0; x < wei_h; x++)
-                            {
-                                int in_x = in_off_h - pad_h + x * dilation_h;
-                                if(in_x >= 0 && in_x < in_h)
-                                {
-                                    for(int y = 0; y < wei_w; y++)
-                                    {
-                                        int in_y = in_off_w - pad_w + y * dilation_w;
-                                        if(in_y >= 0 && in_y < in_w)
-                                        {
-                                            acc += in[o * in_nstride + k * in_cstride +
-                                                      in_x * in_w + in_y] *
-                                                   wei[w * wei_nstride + k * wei_cstride +
-                                                       x * wei_hstride + y];
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        acc = inflags.GetValueInt("bias") != 0 ? acc + b[w] : acc;
-                        outhost[o * out_nstride + w * out_cstride + i * out_hstride + j] = acc;
-                    }
-                }
-            }
-        }
+        cpu_conv_problem problem{in_n,
+                                 in_c,
+                                 in_h,
+                                 in_w,
+                                 out_c,
+                                 wei_h,
+                                 wei_w,
+                                 out_h,
+                                 out_w,
+                                 pad_h,
+                                 pad_w,
+                                 u,
+                                 v,
+                                 dilation_h,
+                                 dilation_w};
+        cpu_convolution_forward(problem,
+                                in.data(),
+                                wei.data(),
+                                outhost.data(),
+                                inflags.GetValueInt("bias") != 0 ? b.data() : nullptr);
     }
     else if(mode == miopenTranspose)
     {
@@ -807,43 +866,24 @@ int ConvDriver<T>::RunForwardCPU()
                                     &wei_hstride,
                                     &wei_wstride);
 
-        for(int o = 0; o < in_n; o++)
-        { // mini-batch size
-            for(int k = 0; k < out_c; k++)
-            { // out_channels (RGB)
-                for(int w = 0; w < in_c; w++)
-                { // in_channels (num filters)
-                    for(int i = 0; i < in_h; i++)
-                    { // input_height
-                        int out_off_h = i * v;
-                        for(int j = 0; j < in_w; j++)
-                        { // input_width
-                            int out_off_w = j * u;
-                            for(int x = 0; x < wei_h; x++)
-                            {
-                                int out_x = out_off_h - pad_h + x * dilation_h;
-                                if(out_x >= 0 && out_x < out_h)
-                                {
-                                    for(int y = 0; y < wei_w; y++)
-                                    {
-                                        int out_y = out_off_w - pad_w + y * dilation_w;
-                                        if(out_y >= 0 && out_y < out_w)
-                                        {
-                                            outhost[o * out_nstride + k * out_cstride +
-                                                    out_x * out_hstride + out_y] +=
-                                                in[o * in_nstride + w * in_cstride +
-                                                   i * in_hstride + j] *
-                                                wei[w * wei_cstride + k * wei_nstride +
-                                                    x * wei_hstride + y];
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        // The transposed forward pass is the backward data pass of the
+        // convolution that maps outhost onto in.
+        cpu_conv_problem problem{in_n,
+                                 out_c,
+                                 out_h,
+                                 out_w,
+                                 in_c,
+                                 wei_h,
+                                 wei_w,
+                                 in_h,
+                                 in_w,
+                                 pad_h,
+                                 pad_w,
+                                 v,
+                                 u,
+                                 dilation_h,
+                                 dilation_w};
+        cpu_convolution_backward_data(problem, in.data(), wei.data(), outhost.data());
     }
 
     if(inflags.GetValueInt("dump_output"))
@@ -1151,39 +1191,22 @@ int ConvDriver<T>::RunBackwardWeightsCPU()
 #endif
 #endif
 
-        RunBackwardWeightsCPUVerify(dwei_host,
-                                    in,
-                                    dout,
-                                    in_n,
-                                    in_c,
-                                    in_h,
-                                    in_w,
-                                    in_nstride,
-                                    in_cstride,
-                                    in_hstride,
-                                    in_wstride,
-                                    wei_n,
-                                    wei_c,
-                                    wei_h,
-                                    wei_w,
-                                    wei_nstride,
-                                    wei_cstride,
-                                    wei_hstride,
-                                    wei_wstride,
-                                    out_n,
-                                    out_c,
-                                    out_h,
-                                    out_w,
-                                    out_nstride,
-                                    out_cstride,
-                                    out_hstride,
-                                    out_wstride,
-                                    u,
-                                    v,
-                                    pad_h,
-                                    pad_w,
-                                    dilation_h,
-                                    dilation_w);
+        cpu_conv_problem problem{in_n,
+                                 in_c,
+                                 in_h,
+                                 in_w,
+                                 out_c,
+                                 wei_h,
+                                 wei_w,
+                                 out_h,
+                                 out_w,
+                                 pad_h,
+                                 pad_w,
+                                 u,
+                                 v,
+                                 dilation_h,
+                                 dilation_w};
+        cpu_convolution_backward_weights(problem, in.data(), dout.data(), dwei_host.data());
     }
     else if(mode == miopenTranspose)
     {
@@ -1238,39 +1261,22 @@ int ConvDriver<T>::RunBackwardWeightsCPU()
 #endif
 #endif
 
-        RunBackwardWeightsCPUVerify(dwei_host,
-                                    dout,
-                                    in,
-                                    out_n,
-                                    out_c,
-                                    out_h,
-                                    out_w,
-                                    out_nstride,
-                                    out_cstride,
-                                    out_hstride,
-                                    out_wstride,
-                                    wei_c,
-                                    wei_n,
-                                    wei_h,
-                                    wei_w,
-                                    wei_cstride,
-                                    wei_nstride,
-                                    wei_hstride,
-                                    wei_wstride,
-                                    in_n,
-                                    in_c,
-                                    in_h,
-                                    in_w,
-                                    in_nstride,
-                                    in_cstride,
-                                    in_hstride,
-                                    in_wstride,
-                                    u,
-                                    v,
-                                    pad_h,
-                                    pad_w,
-                                    dilation_h,
-                                    dilation_w);
+        cpu_conv_problem problem{out_n,
+                                 out_c,
+                                 out_h,
+                                 out_w,
+                                 in_c,
+                                 wei_h,
+                                 wei_w,
+                                 in_h,
+                                 in_w,
+                                 pad_h,
+                                 pad_w,
+                                 u,
+                                 v,
+                                 dilation_h,
+                                 dilation_w};
+        cpu_convolution_backward_weights(problem, dout.data(), in.data(), dwei_host.data());
     }
 
     if(inflags.GetValueInt("dump_output"))
@@ -1362,43 +1368,22 @@ int ConvDriver<T>::RunBackwardDataCPU()
                                     &wei_hstride,
                                     &wei_wstride);
 
-        for(int o = 0; o < out_n; o++)
-        { // mini-batch size
-            for(int k = 0; k < in_c; k++)
-            { // in_channels (RGB)
-                for(int w = 0; w < out_c; w++)
-                { // out_channels (num filters)
-                    for(int i = 0; i < out_h; i++)
-                    { // output_height (from getforwardoutputdim())
-                        int in_off_h = i * u;
-                        for(int j = 0; j < out_w; j++)
-                        { // output_width (from getforwardoutputdim())
-                            int in_off_w = j * v;
-                            for(int x = 0; x < wei_h; x++)
-                            {
-                                int in_x = in_off_h - pad_h + x * dilation_h;
-                                if(in_x >= 0 && in_x < in_h)
-                                {
-                                    for(int y = 0; y < wei_w; y++)
-                                    {
-                                        int in_y = in_off_w - pad_w + y * dilation_w;
-                                        if(in_y >= 0 && in_y < in_w)
-                                        {
-                                            din_host[o * in_nstride + k * in_cstride +
-                                                     in_x * in_hstride + in_y] +=
-                                                dout[o * out_nstride + w * out_cstride +
-                                                     i * out_hstride + j] *
-                                                wei[w * wei_nstride + k * wei_cstride +
-                                                    x * wei_hstride + y];
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        cpu_conv_problem problem{in_n,
+                                 in_c,
+                                 in_h,
+                                 in_w,
+                                 out_c,
+                                 wei_h,
+                                 wei_w,
+                                 out_h,
+                                 out_w,
+                                 pad_h,
+                                 pad_w,
+                                 u,
+                                 v,
+                                 dilation_h,
+                                 dilation_w};
+        cpu_convolution_backward_data(problem, dout.data(), wei.data(), din_host.data());
     }
     else if(mode == miopenTranspose)
     {
@@ -1413,45 +1398,24 @@ int ConvDriver<T>::RunBackwardDataCPU()
                                     &wei_hstride,
                                     &wei_wstride);
 
-        for(int o = 0; o < in_n; o++)
-        { // mini-batch size
-            for(int w = 0; w < in_c; w++)
-            { // in_channels (num filters)
-                for(int i = 0; i < in_h; i++)
-                { // input_height (from getforwardoutputdim())
-                    int out_off_h = i * v;
-                    for(int j = 0; j < in_w; j++)
-                    { // input_width (from getforwardoutputdim())
-                        float acc     = 0;
-                        int out_off_w = j * u;
-                        for(int k = 0; k < out_c; k++)
-                        { // out_channels (RGB)
-                            for(int x = 0; x < wei_h; x++)
-                            {
-                                int out_x = out_off_h - pad_h + x * dilation_h;
-                                if(out_x >= 0 && out_x < out_h)
-                                {
-                                    for(int y = 0; y < wei_w; y++)
-                                    {
-                                        int out_y = out_off_w - pad_w + y * dilation_w;
-                                        if(out_y >= 0 && out_y < out_w)
-                                        {
-                                            acc += dout[o * out_nstride + k * out_cstride +
-                                                        out_x * out_w + out_y] *
-                                                   wei[w * wei_cstride + k * wei_nstride +
-                                                       x * wei_hstride + y];
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        //                      acc = inflags.GetValueInt("bias") != 0 ? acc + db[w]
-                        //                      : acc;  // db is zero in transpose case
-                        din_host[o * in_nstride + w * in_cstride + i * in_hstride + j] = acc;
-                    }
-                }
-            }
-        }
+        // The transposed backward data pass is the forward pass of the
+        // convolution that maps dout onto din.
+        cpu_conv_problem problem{in_n,
+                                 out_c,
+                                 out_h,
+                                 out_w,
+                                 in_c,
+                                 wei_h,
+                                 wei_w,
+                                 in_h,
+                                 in_w,
+                                 pad_h,
+                                 pad_w,
+                                 v,
+                                 u,
+                                 dilation_h,
+                                 dilation_w};
+        cpu_convolution_forward(problem, dout.data(), wei.data(), din_host.data());
     }
 
     if(inflags.GetValueInt("dump_output"))
@@ -125,7 +125,8 @@ void PadBufferSize(size_t& sz, int datatype_sz)
 [[gnu::noreturn]] void Usage()
 {
     printf("Usage: ./driver *base_arg* *other_args*\n");
-    printf("Supported Base Arguments: conv, pool, lrn, activ, softmax, bnorm, rnn, gemm\n");
+    printf("Supported Base Arguments: conv, pool, lrn, activ, softmax, bnorm, rnn, gemm, "
+           "overhead, transform\n");
     exit(0);
 }
 
@@ -140,7 +141,8 @@ std::string ParseBaseArg(int argc, char* argv[])
     std::string arg = argv[1];
 
     if(arg != "conv" && arg != "pool" && arg != "lrn" && arg != "activ" && arg != "softmax" &&
-       arg != "bnorm" && arg != "rnn" && arg != "gemm")
+       arg != "bnorm" && arg != "rnn" && arg != "gemm" && arg != "overhead" &&
+       arg != "transform")
 
     {
         printf("Invalid Base Input Argument\n");
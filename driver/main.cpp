@@ -29,9 +29,11 @@
 #include "driver.hpp"
 #include "gemm_driver.hpp"
 #include "lrn_driver.hpp"
+#include "overhead_driver.hpp"
 #include "pool_driver.hpp"
 #include "softmax_driver.hpp"
 #include "rnn_driver.hpp"
+#include "transform_driver.hpp"
 #include <cstdio>
 #include <iostream>
 
@@ -78,6 +80,14 @@ int main(int argc, char* argv[])
     {
         drv = new RNNDriver<float>();
     }
+    else if(base_arg == "overhead")
+    {
+        drv = new OverheadDriver<float>();
+    }
+    else if(base_arg == "transform")
+    {
+        drv = new TransformDriver<float>();
+    }
     else
     {
         printf("Incorrect BaseArg\n");
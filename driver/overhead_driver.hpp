@@ -0,0 +1,432 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_OVERHEAD_DRIVER_HPP
+#define GUARD_MIOPEN_OVERHEAD_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include "tensor_driver.hpp"
+#include "timer.hpp"
+#include <array>
+#include <cstdlib>
+#include <memory>
+#include <miopen/miopen.h>
+#include <vector>
+
+/// Measures the host time spent inside a single API call.
+///
+/// The problems are deliberately tiny so that the device work is negligible,
+/// profiling stays disabled so that no call waits for its kernels, and the
+/// queue is only drained after the timed loop. Every operation is run once
+/// before timing so that kernel compilation and perf DB lookups are excluded.
+/// With a runtime that does nothing on enqueue, the numbers are the pure cost
+/// of MIOpen itself (string building, map lookups, descriptor construction).
+/// test/stub/opencl.cpp is such a runtime, ctest runs this driver on top of it.
+template <typename T>
+class OverheadDriver : public Driver
+{
+    public:
+    OverheadDriver() : Driver()
+    {
+        miopenCreateTensorDescriptor(&inputTensor);
+        miopenCreateTensorDescriptor(&outputTensor);
+        miopenCreateTensorDescriptor(&weightTensor);
+        miopenCreateTensorDescriptor(&convOutputTensor);
+        miopenCreateTensorDescriptor(&poolOutputTensor);
+        miopenCreateTensorDescriptor(&rnnInputTensor);
+        miopenCreateTensorDescriptor(&rnnOutputTensor);
+        miopenCreateTensorDescriptor(&rnnHiddenTensor);
+        miopenCreateTensorDescriptor(&rnnWeightTensor);
+
+        miopenCreateActivationDescriptor(&activDesc);
+        miopenCreateConvolutionDescriptor(&convDesc);
+        miopenCreatePoolingDescriptor(&poolDesc);
+        miopenCreateRNNDescriptor(&rnnDesc);
+    }
+
+    int AddCmdLineArgs();
+    int ParseCmdLineArgs(int argc, char* argv[]);
+    InputFlags& GetInputFlags() { return inflags; }
+
+    int GetandSetData();
+    int AllocateBuffersAndCopy();
+
+    int RunForwardGPU();
+    int VerifyForward() { return miopenStatusSuccess; }
+
+    int RunBackwardGPU() { return miopenStatusSuccess; }
+    int VerifyBackward() { return miopenStatusSuccess; }
+
+    ~OverheadDriver()
+    {
+        miopenDestroyRNNDescriptor(rnnDesc);
+        miopenDestroyPoolingDescriptor(poolDesc);
+        miopenDestroyConvolutionDescriptor(convDesc);
+        miopenDestroyActivationDescriptor(activDesc);
+
+        miopenDestroyTensorDescriptor(rnnWeightTensor);
+        miopenDestroyTensorDescriptor(rnnHiddenTensor);
+        miopenDestroyTensorDescriptor(rnnOutputTensor);
+        miopenDestroyTensorDescriptor(rnnInputTensor);
+        miopenDestroyTensorDescriptor(poolOutputTensor);
+        miopenDestroyTensorDescriptor(convOutputTensor);
+        miopenDestroyTensorDescriptor(weightTensor);
+        miopenDestroyTensorDescriptor(outputTensor);
+        miopenDestroyTensorDescriptor(inputTensor);
+    }
+
+    private:
+    template <class F>
+    void MeasureOverhead(const char* name, F f);
+    void Drain();
+
+    InputFlags inflags;
+
+    miopenTensorDescriptor_t inputTensor;
+    miopenTensorDescriptor_t outputTensor;
+    miopenTensorDescriptor_t weightTensor;
+    miopenTensorDescriptor_t convOutputTensor;
+    miopenTensorDescriptor_t poolOutputTensor;
+    miopenTensorDescriptor_t rnnInputTensor;
+    miopenTensorDescriptor_t rnnOutputTensor;
+    miopenTensorDescriptor_t rnnHiddenTensor;
+    miopenTensorDescriptor_t rnnWeightTensor;
+
+    miopenActivationDescriptor_t activDesc;
+    miopenConvolutionDescriptor_t convDesc;
+    miopenPoolingDescriptor_t poolDesc;
+    miopenRNNDescriptor_t rnnDesc;
+
+    std::unique_ptr<GPUMem> in_dev;
+    std::unique_ptr<GPUMem> in2_dev;
+    std::unique_ptr<GPUMem> out_dev;
+    std::unique_ptr<GPUMem> wei_dev;
+    std::unique_ptr<GPUMem> conv_out_dev;
+    std::unique_ptr<GPUMem> pool_out_dev;
+    std::unique_ptr<GPUMem> workspace_dev;
+    std::unique_ptr<GPUMem> rnn_in_dev;
+    std::unique_ptr<GPUMem> rnn_out_dev;
+    std::unique_ptr<GPUMem> rnn_hx_dev;
+    std::unique_ptr<GPUMem> rnn_hy_dev;
+    std::unique_ptr<GPUMem> rnn_wei_dev;
+    std::unique_ptr<GPUMem> rnn_workspace_dev;
+};
+
+template <typename T>
+int OverheadDriver<T>::ParseCmdLineArgs(int argc, char* argv[])
+{
+    inflags.Parse(argc, argv);
+
+    if(inflags.GetValueInt("time") == 1)
+    {
+        printf("Profiling makes every call wait for its kernels, ignoring -t 1\n");
+    }
+    return 0;
+}
+
+template <typename T>
+int OverheadDriver<T>::AddCmdLineArgs()
+{
+    inflags.AddInputFlag("forw", 'F', "1", "Run only Forward (Default=1)", "int");
+    inflags.AddInputFlag("batchsize", 'n', "1", "Mini-batch size (Default=1)", "int");
+    inflags.AddInputFlag("in_channels", 'c', "4", "Number of Input Channels (Default=4)", "int");
+    inflags.AddInputFlag("in_h", 'H', "8", "Input Height (Default=8)", "int");
+    inflags.AddInputFlag("in_w", 'W', "8", "Input Width (Default=8)", "int");
+    inflags.AddInputFlag(
+        "out_channels", 'k', "4", "Number of Output Channels (Default=4)", "int");
+    inflags.AddInputFlag("iter", 'i', "1000", "Number of Iterations (Default=1000)", "int");
+    inflags.AddInputFlag(
+        "limit", 'L', "0", "Fail when a call takes more host ns (Default=0, no limit)", "int");
+    inflags.AddInputFlag("verify", 'V', "0", "Verify Each Layer (Default=0)", "int");
+    inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
+
+    return 0;
+}
+
+template <typename T>
+int OverheadDriver<T>::GetandSetData()
+{
+    int n = inflags.GetValueInt("batchsize");
+    int c = inflags.GetValueInt("in_channels");
+    int h = inflags.GetValueInt("in_h");
+    int w = inflags.GetValueInt("in_w");
+    int k = inflags.GetValueInt("out_channels");
+
+    std::vector<int> in_len{n, c, h, w};
+    SetTensor4d(inputTensor, in_len);
+    SetTensor4d(outputTensor, in_len);
+
+    miopenSetActivationDescriptor(activDesc, miopenActivationRELU, 1, 0, 1);
+
+    std::vector<int> wei_len{k, c, 3, 3};
+    SetTensor4d(weightTensor, wei_len);
+    miopenInitConvolutionDescriptor(convDesc, miopenConvolution, 1, 1, 1, 1, 1, 1);
+    std::vector<int> conv_out_len(4);
+    miopenGetConvolutionForwardOutputDim(convDesc,
+                                         inputTensor,
+                                         weightTensor,
+                                         &conv_out_len[0],
+                                         &conv_out_len[1],
+                                         &conv_out_len[2],
+                                         &conv_out_len[3]);
+    SetTensor4d(convOutputTensor, conv_out_len);
+
+    miopenSet2dPoolingDescriptor(poolDesc, miopenPoolingMax, 2, 2, 0, 0, 2, 2);
+    std::vector<int> pool_out_len(4);
+    miopenGetPoolingForwardOutputDim(poolDesc,
+                                     inputTensor,
+                                     &pool_out_len[0],
+                                     &pool_out_len[1],
+                                     &pool_out_len[2],
+                                     &pool_out_len[3]);
+    SetTensor4d(poolOutputTensor, pool_out_len);
+
+    // A single step of a single layer vanilla RNN with hidden size == input size.
+    std::array<int, 2> rnn_in_lens  = {{n, c}};
+    std::array<int, 3> rnn_hid_lens = {{1, n, c}};
+    miopenSetTensorDescriptor(rnnInputTensor, miopenFloat, 2, rnn_in_lens.data(), nullptr);
+    miopenSetTensorDescriptor(rnnOutputTensor, miopenFloat, 2, rnn_in_lens.data(), nullptr);
+    miopenSetTensorDescriptor(rnnHiddenTensor, miopenFloat, 3, rnn_hid_lens.data(), nullptr);
+    miopenSetRNNDescriptor(rnnDesc,
+                           c,
+                           1,
+                           miopenRNNlinear,
+                           miopenRNNunidirection,
+                           miopenRNNRELU,
+                           miopenRNNNoBias,
+                           miopenRNNdefault,
+                           miopenFloat);
+    miopenGetRNNParamsDescriptor(
+        GetHandle(), rnnDesc, rnnInputTensor, rnnWeightTensor, miopenFloat);
+
+    return miopenStatusSuccess;
+}
+
+template <typename T>
+int OverheadDriver<T>::AllocateBuffersAndCopy()
+{
+    size_t in_sz       = GetTensorSize(inputTensor);
+    size_t wei_sz      = GetTensorSize(weightTensor);
+    size_t conv_out_sz = GetTensorSize(convOutputTensor);
+    size_t pool_out_sz = GetTensorSize(poolOutputTensor);
+
+    size_t workspace_sz = 0;
+    miopenConvolutionForwardGetWorkSpaceSize(
+        GetHandle(), weightTensor, inputTensor, convDesc, convOutputTensor, &workspace_sz);
+
+    size_t rnn_in_sz        = 0;
+    size_t rnn_hy_sz        = 0;
+    size_t rnn_wei_sz       = 0;
+    size_t rnn_workspace_sz = 0;
+    miopenGetRNNInputTensorSize(GetHandle(), rnnDesc, 1, &rnnInputTensor, &rnn_in_sz);
+    miopenGetRNNHiddenTensorSize(GetHandle(), rnnDesc, 1, &rnnInputTensor, &rnn_hy_sz);
+    miopenGetRNNParamsSize(GetHandle(), rnnDesc, rnnInputTensor, &rnn_wei_sz, miopenFloat);
+    miopenGetRNNWorkspaceSize(GetHandle(), rnnDesc, 1, &rnnInputTensor, &rnn_workspace_sz);
+
+#if MIOPEN_BACKEND_OPENCL
+    cl_context ctx;
+
+    clGetCommandQueueInfo(q, CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, nullptr);
+#elif MIOPEN_BACKEND_HIP
+    uint32_t ctx = 0;
+#endif
+    in_dev        = std::unique_ptr<GPUMem>(new GPUMem(ctx, in_sz, sizeof(T)));
+    in2_dev       = std::unique_ptr<GPUMem>(new GPUMem(ctx, in_sz, sizeof(T)));
+    out_dev       = std::unique_ptr<GPUMem>(new GPUMem(ctx, in_sz, sizeof(T)));
+    wei_dev       = std::unique_ptr<GPUMem>(new GPUMem(ctx, wei_sz, sizeof(T)));
+    conv_out_dev  = std::unique_ptr<GPUMem>(new GPUMem(ctx, conv_out_sz, sizeof(T)));
+    pool_out_dev  = std::unique_ptr<GPUMem>(new GPUMem(ctx, pool_out_sz, sizeof(T)));
+    workspace_dev = std::unique_ptr<GPUMem>(new GPUMem(ctx, workspace_sz + 1, 1));
+
+    rnn_in_dev        = std::unique_ptr<GPUMem>(new GPUMem(ctx, rnn_in_sz + 1, 1));
+    rnn_out_dev       = std::unique_ptr<GPUMem>(new GPUMem(ctx, rnn_in_sz + 1, 1));
+    rnn_hx_dev        = std::unique_ptr<GPUMem>(new GPUMem(ctx, rnn_hy_sz + 1, 1));
+    rnn_hy_dev        = std::unique_ptr<GPUMem>(new GPUMem(ctx, rnn_hy_sz + 1, 1));
+    rnn_wei_dev       = std::unique_ptr<GPUMem>(new GPUMem(ctx, rnn_wei_sz + 1, 1));
+    rnn_workspace_dev = std::unique_ptr<GPUMem>(new GPUMem(ctx, rnn_workspace_sz + 1, 1));
+
+    // The contents do not matter, only the host side is measured.
+    std::vector<T> in(in_sz, static_cast<T>(1));
+    std::vector<T> wei(wei_sz, static_cast<T>(1));
+    in_dev->ToGPU(q, in.data());
+    in2_dev->ToGPU(q, in.data());
+    wei_dev->ToGPU(q, wei.data());
+
+    return miopenStatusSuccess;
+}
+
+template <typename T>
+void OverheadDriver<T>::Drain()
+{
+#if MIOPEN_BACKEND_OPENCL
+    clFinish(q);
+#elif MIOPEN_BACKEND_HIP
+    hipStreamSynchronize(q);
+#endif
+}
+
+template <typename T>
+template <class F>
+void OverheadDriver<T>::MeasureOverhead(const char* name, F f)
+{
+    int iters = inflags.GetValueInt("iter");
+
+    // Warm-up: builds the kernels and fills the caches.
+    if(f() != miopenStatusSuccess)
+    {
+        printf("Host Overhead %s: not supported, skipped\n", name);
+        return;
+    }
+    Drain();
+
+    Timer t;
+    t.start();
+    for(int i = 0; i < iters; i++)
+    {
+        f();
+    }
+    t.stop();
+    Drain();
+
+    double ns = t.gettime_ms() * 1e6 / iters;
+    printf("Host Overhead %s: %.0f ns/call\n", name, ns);
+
+    int limit = inflags.GetValueInt("limit");
+    if(limit > 0 && ns > limit)
+    {
+        printf("FAILED: %s is above the limit of %d ns/call\n", name, limit);
+    }
+}
+
+template <typename T>
+int OverheadDriver<T>::RunForwardGPU()
+{
+    float alpha = 1, beta = 0;
+
+    MeasureOverhead("miopenOpTensor", [&] {
+        return miopenOpTensor(GetHandle(),
+                              miopenTensorOpAdd,
+                              &alpha,
+                              inputTensor,
+                              in_dev->GetMem(),
+                              &alpha,
+                              inputTensor,
+                              in2_dev->GetMem(),
+                              &beta,
+                              outputTensor,
+                              out_dev->GetMem());
+    });
+
+    MeasureOverhead("miopenActivationForward", [&] {
+        return miopenActivationForward(GetHandle(),
+                                       activDesc,
+                                       &alpha,
+                                       inputTensor,
+                                       in_dev->GetMem(),
+                                       &beta,
+                                       outputTensor,
+                                       out_dev->GetMem());
+    });
+
+    int ret_algo_count = 0;
+    miopenConvAlgoPerf_t perf;
+    if(miopenFindConvolutionForwardAlgorithm(GetHandle(),
+                                             inputTensor,
+                                             in_dev->GetMem(),
+                                             weightTensor,
+                                             wei_dev->GetMem(),
+                                             convDesc,
+                                             convOutputTensor,
+                                             conv_out_dev->GetMem(),
+                                             1,
+                                             &ret_algo_count,
+                                             &perf,
+                                             workspace_dev->GetMem(),
+                                             workspace_dev->GetSize(),
+                                             false) == miopenStatusSuccess &&
+       ret_algo_count > 0)
+    {
+        MeasureOverhead("miopenConvolutionForward", [&] {
+            return miopenConvolutionForward(GetHandle(),
+                                            &alpha,
+                                            inputTensor,
+                                            in_dev->GetMem(),
+                                            weightTensor,
+                                            wei_dev->GetMem(),
+                                            convDesc,
+                                            perf.fwd_algo,
+                                            &beta,
+                                            convOutputTensor,
+                                            conv_out_dev->GetMem(),
+                                            workspace_dev->GetMem(),
+                                            workspace_dev->GetSize());
+        });
+    }
+    else
+    {
+        printf("Host Overhead miopenConvolutionForward: not supported, skipped\n");
+    }
+
+    MeasureOverhead("miopenPoolingForward", [&] {
+        return miopenPoolingForward(GetHandle(),
+                                    poolDesc,
+                                    &alpha,
+                                    inputTensor,
+                                    in_dev->GetMem(),
+                                    &beta,
+                                    poolOutputTensor,
+                                    pool_out_dev->GetMem(),
+                                    false,
+                                    nullptr,
+                                    0);
+    });
+
+    MeasureOverhead("miopenRNNForwardInference (1 step)", [&] {
+        return miopenRNNForwardInference(GetHandle(),
+                                         rnnDesc,
+                                         1,
+                                         &rnnInputTensor,
+                                         rnn_in_dev->GetMem(),
+                                         rnnHiddenTensor,
+                                         rnn_hx_dev->GetMem(),
+                                         rnnHiddenTensor,
+                                         nullptr,
+                                         rnnWeightTensor,
+                                         rnn_wei_dev->GetMem(),
+                                         &rnnOutputTensor,
+                                         rnn_out_dev->GetMem(),
+                                         rnnHiddenTensor,
+                                         rnn_hy_dev->GetMem(),
+                                         rnnHiddenTensor,
+                                         nullptr,
+                                         rnn_workspace_dev->GetMem(),
+                                         rnn_workspace_dev->GetSize());
+    });
+
+    return miopenStatusSuccess;
+}
+
+#endif // GUARD_MIOPEN_OVERHEAD_DRIVER_HPP
@@ -98,6 +98,9 @@ class PoolDriver : public Driver
     std::unique_ptr<GPUMem> mask_dev;
     std::vector<uint8_t> mask;
 
+    // NULL when the backward pass recomputes the argmax instead of reading it from the workspace
+    auto GetMaskMem() { return mask_dev ? mask_dev->GetMem() : nullptr; }
+
     std::vector<T> in;
     std::vector<T> out;
     std::vector<size_t> maskhost;
@@ -255,7 +258,7 @@ int PoolDriver<T>::AllocateBuffersAndCopy()
     size_t in_sz         = GetTensorSize(inputTensor);
     size_t out_sz        = GetTensorSize(outputTensor);
     size_t workSpaceSize = 0;
-    miopenPoolingGetWorkSpaceSize(outputTensor, &workSpaceSize);
+    miopenPoolingGetWorkSpaceSizeV2(poolDesc, outputTensor, &workSpaceSize);
 #if MIOPEN_BACKEND_OPENCL
     cl_context ctx;
 
@@ -265,8 +268,12 @@ int PoolDriver<T>::AllocateBuffersAndCopy()
 #endif
     in_dev  = std::unique_ptr<GPUMem>(new GPUMem(ctx, in_sz, sizeof(float)));
     out_dev = std::unique_ptr<GPUMem>(new GPUMem(ctx, out_sz, sizeof(float)));
-    mask_dev =
-        std::unique_ptr<GPUMem>(new GPUMem(ctx, workSpaceSize / sizeof(uint8_t), sizeof(uint8_t)));
+    // No workspace when the backward pass recomputes the argmax
+    if(workSpaceSize > 0)
+    {
+        mask_dev = std::unique_ptr<GPUMem>(
+            new GPUMem(ctx, workSpaceSize / sizeof(uint8_t), sizeof(uint8_t)));
+    }
     mask = std::vector<uint8_t>(workSpaceSize / sizeof(uint8_t), 0);
 
     din_dev  = std::unique_ptr<GPUMem>(new GPUMem(ctx, in_sz, sizeof(float)));
@@ -323,8 +330,8 @@ int PoolDriver<T>::RunForwardGPU()
                          outputTensor,
                          out_dev->GetMem(),
                          do_backward,
-                         mask_dev->GetMem(),
-                         0);
+                         GetMaskMem(),
+                         mask.size());
 
     Timer t;
     START_TIME;
@@ -340,8 +347,8 @@ int PoolDriver<T>::RunForwardGPU()
                              outputTensor,
                              out_dev->GetMem(),
                              do_backward,
-                             mask_dev->GetMem(),
-                             0);
+                             GetMaskMem(),
+                             mask.size());
     }
     if(inflags.GetValueInt("time") == 1)
     {
@@ -357,7 +364,8 @@ int PoolDriver<T>::RunForwardGPU()
     }
 
     out_dev->FromGPU(GetStream(), out.data());
-    mask_dev->FromGPU(GetStream(), mask.data());
+    if(mask_dev)
+        mask_dev->FromGPU(GetStream(), mask.data());
 
     return miopenStatusSuccess;
 }
@@ -380,7 +388,7 @@ int PoolDriver<T>::RunBackwardGPU()
                           &beta,
                           dInputTensor,
                           din_dev->GetMem(),
-                          mask_dev->GetMem());
+                          GetMaskMem());
 
     Timer t;
     START_TIME;
@@ -399,7 +407,7 @@ int PoolDriver<T>::RunBackwardGPU()
                               &beta,
                               dInputTensor,
                               din_dev->GetMem(),
-                              mask_dev->GetMem());
+                              GetMaskMem());
     }
     if(inflags.GetValueInt("time") == 1)
     {
@@ -488,7 +496,9 @@ int PoolDriver<T>::VerifyForward()
                                                           nOutStride,
                                                           in.data(),
                                                           out.data(),
-                                                          do_backward,
+                                                          // only 8 bit indices are compared
+                                                          do_backward && mask_dev &&
+                                                              mask.size() == out.size(),
                                                           maskhost.data(),
                                                           mask.data(),
                                                           1);
@@ -70,6 +70,9 @@ class SoftmaxDriver : public Driver
 
     int VerifyBackward();
     int VerifyForward();
+
+    // Splits the lengths around the softmax axis into outer x c x inner
+    void GetSoftmaxDims(int& outer, int& c, int& inner);
     ~SoftmaxDriver()
     {
         miopenDestroyTensorDescriptor(outputTensor);
@@ -138,6 +141,9 @@ int SoftmaxDriver<T>::AddCmdLineArgs()
     inflags.AddInputFlag("in_w", 'W', "32", "Input Width (Default=32)", "int");
     inflags.AddInputFlag("alpha", 'A', "1.0", "Softmax shift (Default=0.0)", "double");
     inflags.AddInputFlag("beta", 'B', "0.0", "Softmax scale (Default=0.0)", "double");
+    inflags.AddInputFlag(
+        "algorithm", 'a', "0", "Softmax algorithm, 0: accurate, 1: log (Default=0)", "int");
+    inflags.AddInputFlag("axis", 'x', "1", "Dimension to reduce over (Default=1)", "int");
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
@@ -215,23 +221,34 @@ template <typename T>
 int SoftmaxDriver<T>::RunForwardGPU()
 {
 
-    float alpha = 1, beta = 0;
+    float alpha    = 1, beta = 0;
+    auto algorithm = static_cast<miopenSoftmaxAlgorithm_t>(inflags.GetValueInt("algorithm"));
+    int axis       = inflags.GetValueInt("axis");
 
-    miopenSoftmaxForward(
-        GetHandle(), &alpha, inputTensor, in_dev->GetMem(), &beta, outputTensor, out_dev->GetMem());
+    miopenSoftmaxForwardEx(GetHandle(),
+                           &alpha,
+                           inputTensor,
+                           in_dev->GetMem(),
+                           &beta,
+                           outputTensor,
+                           out_dev->GetMem(),
+                           algorithm,
+                           axis);
 
     Timer t;
     START_TIME;
 
     for(int i = 0; i < inflags.GetValueInt("iter"); i++)
     {
-        miopenSoftmaxForward(GetHandle(),
-                             &alpha,
-                             inputTensor,
-                             in_dev->GetMem(),
-                             &beta,
-                             outputTensor,
-                             out_dev->GetMem());
+        miopenSoftmaxForwardEx(GetHandle(),
+                               &alpha,
+                               inputTensor,
+                               in_dev->GetMem(),
+                               &beta,
+                               outputTensor,
+                               out_dev->GetMem(),
+                               algorithm,
+                               axis);
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -251,40 +268,50 @@ int SoftmaxDriver<T>::RunForwardGPU()
     return miopenStatusSuccess;
 }
 
+template <typename T>
+void SoftmaxDriver<T>::GetSoftmaxDims(int& outer, int& c, int& inner)
+{
+    std::vector<int> lens = GetInputTensorLengthsFromCmdLine();
+    int axis              = inflags.GetValueInt("axis");
+
+    outer = std::accumulate(lens.begin(), lens.begin() + axis, 1, std::multiplies<int>());
+    c     = lens[axis];
+    inner = std::accumulate(lens.begin() + axis + 1, lens.end(), 1, std::multiplies<int>());
+}
+
 template <typename T>
 int SoftmaxDriver<T>::RunForwardCPU()
 {
-    int n, c, h, w;
-    miopenGet4dTensorDescriptorLengths(inputTensor, &n, &c, &h, &w);
+    int n, c, hw;
+    GetSoftmaxDims(n, c, hw);
+    bool log_softmax = inflags.GetValueInt("algorithm") == miopenSoftmaxLog;
 
     std::copy(in.begin(), in.end(), outhost.begin());
-    std::vector<float> channel_max(n * h * w, -FLT_MAX);
+    std::vector<float> channel_max(n * hw, -FLT_MAX);
 
     for(int i = 0; i < n; i++)
     {
-        for(int s = 0; s < h * w; s++)
+        for(int s = 0; s < hw; s++)
         {
             for(int j = 0; j < c; j++)
             {
-                channel_max[i * h * w + s] =
-                    std::max(outhost[(i * c + j) * h * w + s], channel_max[i * h * w + s]);
-            }
-
-            for(int j = 0; j < c; j++)
-            {
-                outhost[(i * c + j) * h * w + s] -= channel_max[i * h * w + s];
-                outhost[(i * c + j) * h * w + s] = exp(outhost[(i * c + j) * h * w + s]);
+                channel_max[i * hw + s] =
+                    std::max(outhost[(i * c + j) * hw + s], channel_max[i * hw + s]);
             }
 
-            channel_max[i * h * w + s] = 0.0;
+            double sum = 0.0;
             for(int j = 0; j < c; j++)
             {
-                channel_max[i * h * w + s] += outhost[(i * c + j) * h * w + s];
+                outhost[(i * c + j) * hw + s] -= channel_max[i * hw + s];
+                sum += exp(outhost[(i * c + j) * hw + s]);
             }
 
             for(int j = 0; j < c; j++)
             {
-                outhost[(i * c + j) * h * w + s] /= channel_max[i * h * w + s];
+                if(log_softmax)
+                    outhost[(i * c + j) * hw + s] -= log(sum);
+                else
+                    outhost[(i * c + j) * hw + s] = exp(outhost[(i * c + j) * hw + s]) / sum;
             }
         }
     }
@@ -295,32 +322,38 @@ int SoftmaxDriver<T>::RunForwardCPU()
 template <typename T>
 int SoftmaxDriver<T>::RunBackwardGPU()
 {
-    float alpha = 1., beta = 0.;
-
-    miopenSoftmaxBackward(GetHandle(),
-                          &alpha,
-                          outputTensor,
-                          out_dev->GetMem(),
-                          dOutputTensor,
-                          dout_dev->GetMem(),
-                          &beta,
-                          dInputTensor,
-                          din_dev->GetMem());
+    float alpha    = 1., beta = 0.;
+    auto algorithm = static_cast<miopenSoftmaxAlgorithm_t>(inflags.GetValueInt("algorithm"));
+    int axis       = inflags.GetValueInt("axis");
+
+    miopenSoftmaxBackwardEx(GetHandle(),
+                            &alpha,
+                            outputTensor,
+                            out_dev->GetMem(),
+                            dOutputTensor,
+                            dout_dev->GetMem(),
+                            &beta,
+                            dInputTensor,
+                            din_dev->GetMem(),
+                            algorithm,
+                            axis);
 
     Timer t;
     START_TIME;
 
     for(int i = 0; i < inflags.GetValueInt("iter"); i++)
     {
-        miopenSoftmaxBackward(GetHandle(),
-                              &alpha,
-                              outputTensor,
-                              out_dev->GetMem(),
-                              dOutputTensor,
-                              dout_dev->GetMem(),
-                              &beta,
-                              dInputTensor,
-                              din_dev->GetMem());
+        miopenSoftmaxBackwardEx(GetHandle(),
+                                &alpha,
+                                outputTensor,
+                                out_dev->GetMem(),
+                                dOutputTensor,
+                                dout_dev->GetMem(),
+                                &beta,
+                                dInputTensor,
+                                din_dev->GetMem(),
+                                algorithm,
+                                axis);
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -361,27 +394,39 @@ int SoftmaxDriver<T>::VerifyForward()
 template <typename T>
 int SoftmaxDriver<T>::RunBackwardCPU()
 {
-    int n, c, h, w;
-    miopenGet4dTensorDescriptorLengths(dOutputTensor, &n, &c, &h, &w);
+    int n, c, hw;
+    GetSoftmaxDims(n, c, hw);
+    bool log_softmax = inflags.GetValueInt("algorithm") == miopenSoftmaxLog;
 
     std::copy(dout.begin(), dout.end(), dinhost.begin());
-    std::vector<float> channel_dot(n * h * w, 0.0);
+    std::vector<float> channel_dot(n * hw, 0.0);
 
     for(int i = 0; i < n; i++)
     {
-        for(int s = 0; s < h * w; s++)
+        for(int s = 0; s < hw; s++)
         {
+            // sum(dy) for log-softmax, sum(y * dy) otherwise
             for(int j = 0; j < c; j++)
             {
-                channel_dot[i * h * w + s] +=
-                    out[(i * c + j) * h * w + s] * dinhost[(i * c + j) * h * w + s];
+                channel_dot[i * hw + s] += log_softmax
+                                               ? dinhost[(i * c + j) * hw + s]
+                                               : out[(i * c + j) * hw + s] *
+                                                     dinhost[(i * c + j) * hw + s];
             }
 
             for(int j = 0; j < c; j++)
             {
-                dinhost[(i * c + j) * h * w + s] -= channel_dot[i * h * w + s];
-                dinhost[(i * c + j) * h * w + s] =
-                    out[(i * c + j) * h * w + s] * dinhost[(i * c + j) * h * w + s];
+                if(log_softmax)
+                {
+                    dinhost[(i * c + j) * hw + s] -=
+                        exp(out[(i * c + j) * hw + s]) * channel_dot[i * hw + s];
+                }
+                else
+                {
+                    dinhost[(i * c + j) * hw + s] -= channel_dot[i * hw + s];
+                    dinhost[(i * c + j) * hw + s] =
+                        out[(i * c + j) * hw + s] * dinhost[(i * c + j) * hw + s];
+                }
             }
         }
     }
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRANSFORM_DRIVER_HPP
+#define GUARD_MIOPEN_TRANSFORM_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include "tensor_driver.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <miopen/miopen.h>
+#include <vector>
+
+/// Measures the device bandwidth of miopenTransformTensor.
+///
+/// The NCHW <-> NHWC permutations are compared with a copy between two NCHW
+/// tensors, which is the bandwidth a permutation can at best reach. Running again
+/// with MIOPEN_DEBUG_TRANSFORM_TILED=0 times the same permutations done element by
+/// element, without the local memory transpose.
+template <typename T>
+class TransformDriver : public Driver
+{
+    public:
+    TransformDriver() : Driver()
+    {
+        miopenCreateTensorDescriptor(&nchwTensor);
+        miopenCreateTensorDescriptor(&nhwcTensor);
+    }
+
+    int AddCmdLineArgs();
+    int ParseCmdLineArgs(int argc, char* argv[]);
+    InputFlags& GetInputFlags() { return inflags; }
+
+    int GetandSetData();
+    int AllocateBuffersAndCopy();
+
+    int RunForwardGPU();
+    int VerifyForward() { return miopenStatusSuccess; }
+
+    int RunBackwardGPU() { return miopenStatusSuccess; }
+    int VerifyBackward() { return miopenStatusSuccess; }
+
+    ~TransformDriver()
+    {
+        miopenDestroyTensorDescriptor(nhwcTensor);
+        miopenDestroyTensorDescriptor(nchwTensor);
+    }
+
+    private:
+    void MeasureBandwidth(const char* name,
+                          miopenTensorDescriptor_t xDesc,
+                          GPUMem& x,
+                          miopenTensorDescriptor_t yDesc,
+                          GPUMem& y,
+                          const std::vector<T>& expected);
+
+    InputFlags inflags;
+
+    miopenTensorDescriptor_t nchwTensor;
+    miopenTensorDescriptor_t nhwcTensor;
+
+    std::unique_ptr<GPUMem> in_dev;
+    std::unique_ptr<GPUMem> out_dev;
+
+    std::vector<T> in_nchw;
+    std::vector<T> in_nhwc;
+};
+
+template <typename T>
+int TransformDriver<T>::ParseCmdLineArgs(int argc, char* argv[])
+{
+    inflags.Parse(argc, argv);
+    return 0;
+}
+
+template <typename T>
+int TransformDriver<T>::AddCmdLineArgs()
+{
+    inflags.AddInputFlag("forw", 'F', "1", "Run only Forward (Default=1)", "int");
+    inflags.AddInputFlag("batchsize", 'n', "32", "Mini-batch size (Default=32)", "int");
+    inflags.AddInputFlag(
+        "in_channels", 'c', "64", "Number of Input Channels (Default=64)", "int");
+    inflags.AddInputFlag("in_h", 'H', "56", "Input Height (Default=56)", "int");
+    inflags.AddInputFlag("in_w", 'W', "56", "Input Width (Default=56)", "int");
+    inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
+    inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
+    inflags.AddInputFlag("time", 't', "1", "Time Each Layer (Default=1)", "int");
+
+    return 0;
+}
+
+template <typename T>
+int TransformDriver<T>::GetandSetData()
+{
+    int n = inflags.GetValueInt("batchsize");
+    int c = inflags.GetValueInt("in_channels");
+    int h = inflags.GetValueInt("in_h");
+    int w = inflags.GetValueInt("in_w");
+
+    std::vector<int> len{n, c, h, w};
+    std::vector<int> nhwc_strides{c * h * w, 1, w * c, c};
+    SetTensor4d(nchwTensor, len);
+    miopenSetTensorDescriptor(nhwcTensor, miopenFloat, 4, len.data(), nhwc_strides.data());
+
+    return miopenStatusSuccess;
+}
+
+template <typename T>
+int TransformDriver<T>::AllocateBuffersAndCopy()
+{
+    size_t sz = GetTensorSize(nchwTensor);
+
+#if MIOPEN_BACKEND_OPENCL
+    cl_context ctx;
+
+    clGetCommandQueueInfo(q, CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, nullptr);
+#elif MIOPEN_BACKEND_HIP
+    uint32_t ctx = 0;
+#endif
+    in_dev  = std::unique_ptr<GPUMem>(new GPUMem(ctx, sz, sizeof(T)));
+    out_dev = std::unique_ptr<GPUMem>(new GPUMem(ctx, sz, sizeof(T)));
+
+    std::vector<int> len = GetTensorLengths(nchwTensor);
+    int c                = len[1];
+    int hw               = len[2] * len[3];
+
+    in_nchw.resize(sz);
+    in_nhwc.resize(sz);
+    for(size_t i = 0; i < sz; i++)
+    {
+        in_nchw[i] = static_cast<T>(static_cast<double>(rand()) * (1.0 / RAND_MAX) - 0.5);
+        // element (n, c, hw) of the NCHW data moves to (n, hw, c)
+        size_t image = i / (c * hw);
+        size_t ch    = (i / hw) % c;
+        size_t pix   = i % hw;
+        in_nhwc[(image * hw + pix) * c + ch] = in_nchw[i];
+    }
+    in_dev->ToGPU(q, in_nchw.data());
+
+    return miopenStatusSuccess;
+}
+
+template <typename T>
+void TransformDriver<T>::MeasureBandwidth(const char* name,
+                                          miopenTensorDescriptor_t xDesc,
+                                          GPUMem& x,
+                                          miopenTensorDescriptor_t yDesc,
+                                          GPUMem& y,
+                                          const std::vector<T>& expected)
+{
+    float alpha = 1, beta = 0;
+    int iters   = inflags.GetValueInt("iter");
+
+    // Warm-up: builds the kernels.
+    if(miopenTransformTensor(GetHandle(), &alpha, xDesc, x.GetMem(), &beta, yDesc, y.GetMem()) !=
+       miopenStatusSuccess)
+    {
+        printf("Transform %s: failed\n", name);
+        return;
+    }
+
+    float total = 0;
+    for(int i = 0; i < iters; i++)
+    {
+        miopenTransformTensor(GetHandle(), &alpha, xDesc, x.GetMem(), &beta, yDesc, y.GetMem());
+        float time = 0;
+        miopenGetKernelTime(GetHandle(), &time);
+        total += time;
+    }
+
+    float ms    = total / iters;
+    double gbps = 2.0 * expected.size() * sizeof(T) / (ms * 1e6);
+    printf("Transform %s: %f ms, %.1f GB/s\n", name, ms, gbps);
+
+    if(inflags.GetValueInt("verify") == 1)
+    {
+        std::vector<T> result(expected.size());
+        y.FromGPU(GetStream(), result.data());
+        bool ok = std::equal(result.begin(), result.end(), expected.begin());
+        printf("Transform %s: %s\n", name, ok ? "Verifies OK" : "FAILED");
+    }
+}
+
+template <typename T>
+int TransformDriver<T>::RunForwardGPU()
+{
+    miopenEnableProfiling(GetHandle(), true);
+
+    MeasureBandwidth("NCHW->NCHW (copy)", nchwTensor, *in_dev, nchwTensor, *out_dev, in_nchw);
+    MeasureBandwidth("NCHW->NHWC", nchwTensor, *in_dev, nhwcTensor, *out_dev, in_nhwc);
+
+    // out_dev now holds the NHWC data
+    MeasureBandwidth("NHWC->NCHW", nhwcTensor, *out_dev, nchwTensor, *in_dev, in_nchw);
+
+    miopenEnableProfiling(GetHandle(), false);
+    return miopenStatusSuccess;
+}
+
+#endif // GUARD_MIOPEN_TRANSFORM_DRIVER_HPP
@@ -194,6 +194,77 @@ MIOPEN_EXPORT miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
                                                 miopenDeallocatorFunction deallocator,
                                                 void* allocatorContext);
 
+/*! @brief Statistics of the memory pool of a handle
+ *
+ * Sizes are in bytes, rounded up to the size classes of the pool.
+ */
+typedef struct
+{
+    size_t bytes_in_use;    /*!< Buffers handed out and not released yet */
+    size_t bytes_cached;    /*!< Released buffers kept for reuse */
+    size_t high_water_mark; /*!< Peak of bytes_in_use + bytes_cached */
+    size_t allocations;     /*!< Requests that called the allocator */
+    size_t reuses;          /*!< Requests served from cached buffers */
+} miopenMemoryPoolStats_t;
+
+/*! @brief Enable caching of the internal memory allocations of a handle
+ *
+ * While enabled, buffers MIOpen allocates internally are not freed on release but kept for
+ * reuse by later requests of the same size class, which removes allocator calls from hot paths
+ * such as the Find functions. The pool uses the allocator set by miopenSetAllocator. It can also
+ * be enabled for all handles with the MIOPEN_MEMORY_POOL environment variable. Disabling the
+ * pool frees its cached buffers once every buffer it handed out has been released.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param enable     Boolean to toggle the pool (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableMemoryPool(miopenHandle_t handle, bool enable);
+
+/*! @brief Get the statistics of the memory pool
+ *
+ * All statistics are zero while the pool is disabled.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param stats      Pointer to the statistics (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetMemoryPoolStats(miopenHandle_t handle,
+                                                      miopenMemoryPoolStats_t* stats);
+
+/*! @brief Free the buffers cached by the memory pool
+ *
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenTrimMemoryPool(miopenHandle_t handle);
+
+/*! @brief Let the handle provide the workspace of operations called without one
+ *
+ * With a non-zero limit the handle owns a workspace arena. Convolution forward, backward data
+ * and backward weights, their Find functions and RNN forward inference use it when called with
+ * a NULL workspace: the arena grows to the size the call requires and is reused by every later
+ * call on the handle. Calls requiring more than the limit run as if no workspace was given.
+ * Softmax forward also keeps the scratch buffer of its wide row kernels in the arena.
+ * Workspaces which carry state from one call to another, as for pooling, LRN and RNN training,
+ * must still be passed by the caller. The limit can also be set in MiB for all new handles with
+ * the MIOPEN_WORKSPACE_ARENA_MB environment variable. The arena is released when the limit is
+ * lowered below its size, so a limit of 0 disables and frees it.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param limit      Maximum size of the arena in bytes, 0 disables it (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetWorkspaceArenaLimit(miopenHandle_t handle, size_t limit);
+
+/*! @brief Get the current size of the workspace arena
+ *
+ * @param handle     MIOpen handle (input)
+ * @param size       Size of the arena in bytes (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetWorkspaceArenaSize(miopenHandle_t handle, size_t* size);
+
 /*! @brief Get time for last kernel launched
  *
  * This function is used only when profiling mode has been enabled.
@@ -215,6 +286,123 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Timing of a single kernel launch recorded by deferred profiling
+ *
+ * Timestamps are device clock values in nanoseconds, only differences between them are meaningful.
+ * The strings remain valid until the next call to miopenGetKernelProfiles or
+ * miopenResetKernelProfiles on the same handle.
+ */
+typedef struct
+{
+    const char* kernel_name;     /*!< Name of the kernel function */
+    const char* algorithm;       /*!< Algorithm the kernel was cached under */
+    const char* network_config;  /*!< Network configuration the kernel was cached under */
+    unsigned long long start_ns; /*!< Start of execution */
+    unsigned long long end_ns;   /*!< End of execution */
+} miopenKernelProfile_t;
+
+/*! @brief Enable deferred kernel profiling
+ *
+ * Unlike miopenEnableProfiling, deferred profiling does not wait for each kernel to finish. Every
+ * launch is recorded into a per-handle ring buffer (sized by the MIOPEN_PROFILING_RECORDS
+ * environment variable, 4096 by default) and the timings are only read back by
+ * miopenGetKernelProfiles. While miopenEnableProfiling is also on, it takes precedence.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param enable     Boolean to toggle deferred profiling (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableDeferredProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Get the timings recorded by deferred profiling
+ *
+ * Waits for the recorded launches to complete. When profiles is NULL only the number of records
+ * is returned in count. Otherwise count holds the capacity of profiles on input and the number of
+ * records written on output. Records are returned in launch order.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param profiles   Array to receive the records, or NULL (output)
+ * @param count      Capacity of profiles on input, number of records on output (input/output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetKernelProfiles(miopenHandle_t handle,
+                                                     miopenKernelProfile_t* profiles,
+                                                     size_t* count);
+
+/*! @brief Discard the records collected by deferred profiling
+ *
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenResetKernelProfiles(miopenHandle_t handle);
+
+/*! @brief Number of buckets in the host time histogram of miopenApiMetrics_t */
+#define MIOPEN_METRICS_HISTOGRAM_BUCKETS 24
+
+/*! @brief Statistics of a public entry point collected while metrics are enabled
+ *
+ * Bucket i of host_histogram counts the calls that took [2^i, 2^(i+1)) microseconds on the host.
+ * The first bucket also counts faster calls and the last one slower calls.
+ */
+typedef struct
+{
+    const char* name;   /*!< Name of the entry point */
+    size_t calls;       /*!< Number of calls */
+    size_t errors;      /*!< Number of calls that did not return miopenStatusSuccess */
+    double host_us;     /*!< Total host time in microseconds */
+    double max_host_us; /*!< Longest call in microseconds */
+    double device_us;   /*!< Total kernel time, only measured while miopenEnableProfiling is on */
+    size_t host_histogram[MIOPEN_METRICS_HISTOGRAM_BUCKETS]; /*!< Calls by host time */
+} miopenApiMetrics_t;
+
+/*! @brief Cache statistics collected while metrics are enabled
+ */
+typedef struct
+{
+    size_t kernel_cache_hits;   /*!< Kernels built from a program already loaded by the handle */
+    size_t kernel_cache_misses; /*!< Kernels that required loading a program */
+    size_t binary_cache_hits;   /*!< Programs loaded from the on-disk binary cache */
+    size_t binary_cache_misses; /*!< Programs that had to be compiled */
+    size_t perf_db_hits;        /*!< Solver configurations found in the performance database */
+    size_t perf_db_misses;      /*!< Solver configurations missing or invalid in the database */
+} miopenCacheMetrics_t;
+
+/*! @brief Enable or disable metrics collection
+ *
+ * Metrics are process-wide and are off by default unless the MIOPEN_METRICS environment variable
+ * is set. When MIOPEN_METRICS_DUMP_INTERVAL is set to a number of seconds, a summary is written to
+ * stderr at most that often and at exit.
+ *
+ * @param enable     Boolean to toggle metrics collection (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableMetrics(bool enable);
+
+/*! @brief Get a snapshot of the per entry point statistics
+ *
+ * When metrics is NULL only the number of entry points called so far is returned in count.
+ * Otherwise count holds the capacity of metrics on input and the number of entries written on
+ * output. Entries are sorted by name.
+ *
+ * @param metrics    Array to receive the statistics, or NULL (output)
+ * @param count      Capacity of metrics on input, number of entries on output (input/output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetApiMetrics(miopenApiMetrics_t* metrics, size_t* count);
+
+/*! @brief Get a snapshot of the cache statistics
+ *
+ * @param metrics    Pointer to receive the statistics (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetCacheMetrics(miopenCacheMetrics_t* metrics);
+
+/*! @brief Clear all collected metrics
+ *
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenResetMetrics(void);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -236,6 +424,26 @@ MIOPEN_DECLARE_OBJECT(miopenTensorDescriptor);
  */
 MIOPEN_DECLARE_OBJECT(miopenConvolutionDescriptor);
 
+/*! @ingroup convolutions
+ * @brief Creates the miopenConvolutionPlan_t type
+ *
+ * Convolution plan is an object that binds a convolution descriptor, the tensor descriptors and
+ * an algorithm to the kernels resolved for them, so that they can be executed repeatedly with
+ * minimal host overhead.
+ *
+ */
+MIOPEN_DECLARE_OBJECT(miopenConvolutionPlan);
+
+/*! @ingroup convolutions
+ * @brief Creates the miopenConvBiasActivPlan_t type
+ *
+ * Fused convolution plan is an object that describes a forward convolution followed by a
+ * per-channel bias add and an activation, executed with as few passes over the output as the
+ * selected algorithm allows.
+ *
+ */
+MIOPEN_DECLARE_OBJECT(miopenConvBiasActivPlan);
+
 /*! @ingroup pooling
  * @brief Creates the miopenPoolingDescriptor_t type
  *
@@ -270,9 +478,11 @@ MIOPEN_DECLARE_OBJECT(miopenRNNDescriptor);
 /*! @ingroup tensor
  * @enum miopenDataType_t
  * MIOpen floating point datatypes. Currently only 32-bit floats are fully supported in MIOpen.
+ * 16-bit floats can be used as the storage type of activations, pooling, softmax and the tensor
+ * operations, which still compute in 32-bit floats.
 */
 typedef enum {
-    miopenHalf  = 0, /*!< 16-bit floating point (Not supported) */
+    miopenHalf  = 0, /*!< 16-bit floating point (Partially supported) */
     miopenFloat = 1, /*!< 32-bit floating point (Fully supported) */
 } miopenDataType_t;
 
@@ -315,6 +525,16 @@ typedef enum {
     miopenPoolingAverage = 1, /*!< Average pooling */
 } miopenPoolingMode_t;
 
+/*! @ingroup pooling
+ * @enum miopenIndexType_t
+ * Type of the argmax indices max pooling saves in the workspace for the backward pass
+*/
+typedef enum {
+    miopenIndexUint8  = 0, /*!< 8-bit indices, windows of up to 254 elements (Default) */
+    miopenIndexUint16 = 1, /*!< 16-bit indices, windows of up to 65534 elements */
+    miopenIndexUint32 = 2, /*!< 32-bit indices */
+} miopenIndexType_t;
+
 /*! @ingroup LRN
  * @enum miopenLRNMode_t
  * Local Response Normalization layer mode
@@ -507,6 +727,29 @@ MIOPEN_EXPORT miopenStatus_t miopenScaleTensor(miopenHandle_t handle,
                                                void* y,
                                                const void* alpha);
 
+/*! @brief Copies a tensor into another one with a different layout or data type.
+ *
+ * Computes y = alpha * x + beta * y. Both tensors have the same lengths, up to 5 dimensions,
+ * and their strides may describe different layouts, for example NCHW and NHWC, or batch and
+ * sequence major RNN data. Float and half tensors may be mixed.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param alpha      Floating point scaling factor, allocated on the host (input)
+ * @param xDesc      Tensor descriptor for tensor x (input)
+ * @param x          Source tensor x (input)
+ * @param beta       Floating point scaling factor of y, allocated on the host (input)
+ * @param yDesc      Tensor descriptor for tensor y (input)
+ * @param y          Destination tensor y (input and output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTransformTensor(miopenHandle_t handle,
+                                                   const void* alpha,
+                                                   const miopenTensorDescriptor_t xDesc,
+                                                   const void* x,
+                                                   const void* beta,
+                                                   const miopenTensorDescriptor_t yDesc,
+                                                   void* y);
+
 /*! @brief Returns number of bytes associated with tensor descriptor
  *
  * @param tensorDesc Tensor descriptor (input)
@@ -744,6 +987,12 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
  * been executed previously to determine the required memory needed for the workspace and the
  * best convolutional algorithm, respectively.
  *
+ * Half precision tensors are supported by the direct and GEMM algorithms in
+ * miopenConvolution mode. They are read and written as half and accumulated in float.
+ *
+ * Packed NHWC input and output tensors, described with channels-last strides, are supported by
+ * the GEMM algorithm in miopenConvolution mode. The weights must stay packed NCHW.
+ *
  * @param handle         MIOpen handle (input)
  * @param alpha          Floating point scaling factor, allocated on the host (input)
  * @param xDesc          Tensor descriptor for data input tensor x (input)
@@ -1042,6 +1291,159 @@ MIOPEN_EXPORT miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle
                                                            const miopenTensorDescriptor_t dbDesc,
                                                            void* db);
 
+/*! @brief Prepares a forward convolution for repeated execution
+ *
+ * Resolves the kernels, workspace requirements and kernel arguments of the forward convolution
+ * described by the tensor and convolution descriptors for the selected algorithm. Kernels are
+ * compiled if they are not available yet. The returned plan can be executed with
+ * miopenExecuteConvolutionPlan() any number of times on the same handle.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param plan           Pointer to a convolution plan (output)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param algo           Algorithm selected (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateConvolutionForwardPlan(miopenHandle_t handle,
+                                   miopenConvolutionPlan_t* plan,
+                                   const miopenTensorDescriptor_t xDesc,
+                                   const miopenTensorDescriptor_t wDesc,
+                                   const miopenConvolutionDescriptor_t convDesc,
+                                   const miopenTensorDescriptor_t yDesc,
+                                   miopenConvFwdAlgorithm_t algo);
+
+/*! @brief Prepares a backward data convolution for repeated execution
+ *
+ * Backward data counterpart of miopenCreateConvolutionForwardPlan().
+ *
+ * @param handle         MIOpen handle (input)
+ * @param plan           Pointer to a convolution plan (output)
+ * @param dyDesc         Tensor descriptor for data input tensor dy (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dxDesc         Tensor descriptor for output data tensor dx (input)
+ * @param algo           Algorithm selected (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateConvolutionBackwardDataPlan(miopenHandle_t handle,
+                                        miopenConvolutionPlan_t* plan,
+                                        const miopenTensorDescriptor_t dyDesc,
+                                        const miopenTensorDescriptor_t wDesc,
+                                        const miopenConvolutionDescriptor_t convDesc,
+                                        const miopenTensorDescriptor_t dxDesc,
+                                        miopenConvBwdDataAlgorithm_t algo);
+
+/*! @brief Query the workspace size required to execute a convolution plan
+ *
+ * @param plan           Convolution plan (input)
+ * @param workSpaceSize  Size in bytes of the workspace required by the plan (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenConvolutionPlanGetWorkSpaceSize(miopenConvolutionPlan_t plan,
+                                                                   size_t* workSpaceSize);
+
+/*! @brief Execute a convolution plan
+ *
+ * Runs the convolution prepared by miopenCreateConvolutionForwardPlan() or
+ * miopenCreateConvolutionBackwardDataPlan() with alpha=1 and beta=0.
+ *
+ * @param handle         MIOpen handle the plan was created with (input)
+ * @param plan           Convolution plan (input)
+ * @param in             Data tensor x for forward plans, dy for backward data plans (input)
+ * @param w              Weights tensor w (input)
+ * @param out            Data tensor y for forward plans, dx for backward data plans (output)
+ * @param workSpace      Pointer to workspace required by the plan (input)
+ * @param workSpaceSize  Size in bytes of the workspace (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenExecuteConvolutionPlan(miopenHandle_t handle,
+                                                          miopenConvolutionPlan_t plan,
+                                                          const void* in,
+                                                          const void* w,
+                                                          void* out,
+                                                          void* workSpace,
+                                                          size_t workSpaceSize);
+
+/*! @brief Destroys a convolution plan
+ *
+ * @param plan           Convolution plan to destroy (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyConvolutionPlan(miopenConvolutionPlan_t plan);
+
+/*! @brief Prepares a fused forward convolution, bias and activation
+ *
+ * Computes y = activ(conv(x, w) + b) for the selected algorithm. For the direct algorithm the
+ * bias and logistic, tanh or ReLU activations are applied by the convolution kernel when the
+ * selected solver supports it. Otherwise the convolution is followed by a single kernel that adds
+ * the bias and applies the activation in place, instead of separate miopenConvolutionForwardBias()
+ * and miopenActivationForward() passes.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param plan           Pointer to a fused convolution plan (output)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param bDesc          Tensor descriptor for the bias tensor b, one element per output
+ *                       channel (input)
+ * @param activDesc      Activation descriptor (input)
+ * @param yDesc          Tensor descriptor for packed output data tensor y (input)
+ * @param algo           Algorithm selected (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateConvBiasActivForwardPlan(miopenHandle_t handle,
+                                     miopenConvBiasActivPlan_t* plan,
+                                     const miopenTensorDescriptor_t xDesc,
+                                     const miopenTensorDescriptor_t wDesc,
+                                     const miopenConvolutionDescriptor_t convDesc,
+                                     const miopenTensorDescriptor_t bDesc,
+                                     const miopenActivationDescriptor_t activDesc,
+                                     const miopenTensorDescriptor_t yDesc,
+                                     miopenConvFwdAlgorithm_t algo);
+
+/*! @brief Query the workspace size required to execute a fused convolution plan
+ *
+ * @param plan           Fused convolution plan (input)
+ * @param workSpaceSize  Size in bytes of the workspace required by the plan (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenConvBiasActivPlanGetWorkSpaceSize(
+    miopenConvBiasActivPlan_t plan, size_t* workSpaceSize);
+
+/*! @brief Execute a fused convolution plan
+ *
+ * @param handle         MIOpen handle the plan was created with (input)
+ * @param plan           Fused convolution plan (input)
+ * @param x              Data tensor x (input)
+ * @param w              Weights tensor w (input)
+ * @param b              Bias tensor b (input)
+ * @param y              Data tensor y (output)
+ * @param workSpace      Pointer to workspace required by the plan (input)
+ * @param workSpaceSize  Size in bytes of the workspace (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenExecuteConvBiasActivPlan(miopenHandle_t handle,
+                                                            miopenConvBiasActivPlan_t plan,
+                                                            const void* x,
+                                                            const void* w,
+                                                            const void* b,
+                                                            void* y,
+                                                            void* workSpace,
+                                                            size_t workSpaceSize);
+
+/*! @brief Destroys a fused convolution plan
+ *
+ * @param plan           Fused convolution plan to destroy (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyConvBiasActivPlan(miopenConvBiasActivPlan_t plan);
+
 /** @} */
 // CLOSEOUT CONVOLUTIONS DOXYGEN GROUP
 
@@ -1126,10 +1528,36 @@ miopenGetPoolingForwardOutputDim(const miopenPoolingDescriptor_t poolDesc,
                                  int* h,
                                  int* w);
 
+/*! @brief Sets the type of the indices max pooling saves for the backward pass
+ *
+ * Wider indices allow larger pooling windows, at the cost of a larger workspace. Windows with
+ * too many elements for the type save the next wider indices instead, which
+ * miopenPoolingGetWorkSpaceSizeV2() accounts for.
+ *
+ * @param poolDesc       Pointer to a pooling layer descriptor (input/output)
+ * @param index_type     Index type enum (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetPoolingIndexType(miopenPoolingDescriptor_t poolDesc,
+                                                       miopenIndexType_t index_type);
+
+/*! @brief Gets the type of the indices max pooling saves for the backward pass
+ *
+ * @param poolDesc       Pointer to a pooling layer descriptor (input)
+ * @param index_type     Index type enum (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetPoolingIndexType(miopenPoolingDescriptor_t poolDesc,
+                                                       miopenIndexType_t* index_type);
+
 /*! @brief Get the amount of GPU memory required for pooling
  *
  * Retrieves the amount of workspace in bytes require for pooling. This call is required to
  * determine the amount of GPU memory needed for the backwards pooling algorithms.
+ * The size assumes 8-bit indices, so it is only valid for descriptors that keep the default
+ * miopenIndexUint8 index type and windows of less than 255 elements. Use
+ * miopenPoolingGetWorkSpaceSizeV2() otherwise; miopenPoolingForward() rejects a workspace that is
+ * too small for the indices.
  *
  * @param yDesc          Descriptor for pooling layer (input)
  * @param workSpaceSize  Pointer to workSpaceSize (output)
@@ -1138,12 +1566,31 @@ miopenGetPoolingForwardOutputDim(const miopenPoolingDescriptor_t poolDesc,
 MIOPEN_EXPORT miopenStatus_t miopenPoolingGetWorkSpaceSize(const miopenTensorDescriptor_t yDesc,
                                                            size_t* workSpaceSize);
 
+/*! @brief Get the amount of GPU memory required for pooling with a given descriptor
+ *
+ * Retrieves the amount of workspace in bytes the indices of max pooling need, taking the index
+ * type of the descriptor and the window size into account. The size is 0 when the backward pass
+ * recomputes the argmax from x instead of reading it from the workspace, which happens for large
+ * outputs whose pooling windows do not overlap.
+ *
+ * @param poolDesc       Descriptor for pooling layer (input)
+ * @param yDesc          Descriptor for pooling output (input)
+ * @param workSpaceSize  Pointer to workSpaceSize (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenPoolingGetWorkSpaceSizeV2(const miopenPoolingDescriptor_t poolDesc,
+                                const miopenTensorDescriptor_t yDesc,
+                                size_t* workSpaceSize);
+
 /*! @brief Execute a forward pooling layer
  *
  * Runs forward pooling. miopenGetPoolingForwardOutputDim() should be called before
  * miopenPoolingForward().
  * If the parameter do_backward == 0, then set workSpace = nullptr and workSpaceSize = 0. However,
  * for back-propagation do_backwards must be set to 1 in miopenPoolingForward().
+ * Packed NHWC tensors, described with channels-last strides, are supported.
+ * The output is blended as y = alpha * pool(x) + beta * y; y is only read when beta is not 0.
  *
  * @param handle         MIOpen handle (input)
  * @param poolDesc       Descriptor for pooling layer (input)
@@ -1154,8 +1601,10 @@ MIOPEN_EXPORT miopenStatus_t miopenPoolingGetWorkSpaceSize(const miopenTensorDes
  * @param yDesc          Tensor descriptor for output data tensor y (input)
  * @param y              Data tensor y (output)
  * @param do_backward    Boolean to toggle save data in workspace for backwards pass (input)
- * @param workSpace      Pointer user allocated memory (input)
- * @param workSpaceSize  Size in bytes of the memory needed (input)
+ * @param workSpace      Pointer user allocated memory, may be NULL when no indices are to be
+ *                       saved (input)
+ * @param workSpaceSize  Size in bytes of workSpace, at least the size from
+ *                       miopenPoolingGetWorkSpaceSizeV2() when indices are saved (input)
  * @return               miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
@@ -1174,6 +1623,11 @@ MIOPEN_EXPORT miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
  *
  * Runs backward pooling. miopenPoolingGetWorkSpaceSize() must be called before
  * miopenPoolingBackward() to determine the amount of workSpace to be allocated.
+ * The output is blended as dx = alpha * grad + beta * dx; dx is only read when beta is not 0.
+ * Max pooling without a workspace, or with a workspace size of 0, recomputes the argmax of every
+ * window from x, so x must not be NULL then or miopenStatusBadParm is returned. Overlapping
+ * windows without a workspace run a forward pass into temporary memory first. The same workspace
+ * must be passed to the forward and the backward pass.
  *
  * @param handle         MIOpen handle (input)
  * @param poolDesc       Descriptor for pooling layer (input)
@@ -1183,11 +1637,12 @@ MIOPEN_EXPORT miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
  * @param dyDesc         Tensor descriptor for data input tensor dy (input)
  * @param dy             Data delta tensor dy (input)
  * @param xDesc          Tensor descriptor for output data tensor x (input)
- * @param x              Data tensor x (output)
+ * @param x              Data tensor x, may only be NULL when max pooling reads the argmax from
+ *                       the workspace (input)
  * @param beta           Floating point shift factor, allocated on the host (input)
  * @param dxDesc         Tensor descriptor for tensor dx (input)
  * @param dx             Weights delta tensor dx (output)
- * @param workSpace      Pointer to user allocated workspace (input)
+ * @param workSpace      Pointer to user allocated workspace, may be NULL (input)
  * @return               miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenPoolingBackward(miopenHandle_t handle,
@@ -1378,6 +1833,7 @@ MIOPEN_EXPORT miopenStatus_t miopenDeriveBNTensorDescriptor(miopenTensorDescript
  * and inverse variance will not be used.
  * Likewise, if either resultRunningMean, or resultRunningVariance are null pointers then the values
  * for the running mean and variance will not be saved.
+ * The output is blended as y = alpha * bn(x) + beta * y; y is only read when beta is not 0.
  * Running averages and variances are scaled using an exponential averaging factor: \f[
  * \mu_{old} = \mu_{new}*factor + \mu_{old}*(1-factor)
  * \f]
@@ -1431,6 +1887,7 @@ miopenBatchNormalizationForwardTraining(miopenHandle_t handle,
  * with their descriptor.
  * If either estimatedMean, or estimatedVariance are null pointers then the values for the mean and
  * variance will not be used.
+ * The output is blended as y = alpha * bn(x) + beta * y; y is only read when beta is not 0.
  *
  * @param handle                    MIOpen handle (input)
  * @param bn_mode                   Batch normalization mode (input)
@@ -1465,6 +1922,49 @@ miopenBatchNormalizationForwardInference(miopenHandle_t handle,
                                          void* estimatedVariance,
                                          double epsilon);
 
+/*! @brief Execute forward inference for batch normalization fused with an activation
+ *
+ * Computes the same result as miopenBatchNormalizationForwardInference() followed by
+ * miopenActivationForward() on its output, in a single pass over the data. Both the spatial and
+ * the per-activation modes are supported. Unlike miopenBatchNormalizationForwardInference(),
+ * estimatedMean and estimatedVariance are required.
+ * The output is blended as y = alpha * act(bn(x)) + beta * y; y is only read when beta is not 0.
+ *
+ * @param handle                    MIOpen handle (input)
+ * @param bn_mode                   Batch normalization mode (input)
+ * @param alpha                     Floating point scaling factor, allocated on the host (input)
+ * @param beta                      Floating point shift factor, allocated on the host (input)
+ * @param xDesc                     Tensor descriptor for data input tensor x (input)
+ * @param x                         Data tensor x (input)
+ * @param yDesc                     Tensor descriptor for output data tensor y (input)
+ * @param y                         Data tensor y (output)
+ * @param bnScaleBiasMeanVarDesc    Tensor descriptor for BN scaling, shifting, saved variance and
+ * mean (input)
+ * @param bnScale                   Batch norm scaling, gamma, tensor (input)
+ * @param bnBias                    Batch norm bias, beta, tensor (input)
+ * @param estimatedMean             Running average saved during forward training (input)
+ * @param estimatedVariance         Running variance saved during forward training (input)
+ * @param epsilon                   Value to stabilize inverse variance calculation (input)
+ * @param activDesc                 Activation applied to the normalized output (input)
+ * @return                          miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenBatchNormalizationActivationForwardInference(
+    miopenHandle_t handle,
+    miopenBatchNormMode_t bn_mode,
+    void* alpha,
+    void* beta,
+    const miopenTensorDescriptor_t xDesc,
+    const void* x,
+    const miopenTensorDescriptor_t yDesc,
+    void* y,
+    const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+    void* bnScale,
+    void* bnBias,
+    void* estimatedMean,
+    void* estimatedVariance,
+    double epsilon,
+    const miopenActivationDescriptor_t activDesc);
+
 /*! @brief Execute backwards propagation layer for batch normalization
  *
  * Batch normalization pass for backwards propagation training pass.
@@ -1571,6 +2071,9 @@ miopenGetActivationDescriptor(const miopenActivationDescriptor_t activDesc,
                               double* activPower);
 
 /*! @brief Execute an activation forward layer
+ *
+ * The output is blended as y = alpha * act(x) + beta * y; y is only read when beta is not 0, so a
+ * residual connection y = act(x) + y needs no separate tensor op.
  *
  * @param handle         MIOpen handle (input)
  * @param activDesc      Descriptor for activation layer (input)
@@ -1592,6 +2095,8 @@ MIOPEN_EXPORT miopenStatus_t miopenActivationForward(miopenHandle_t handle,
                                                      void* y);
 
 /*! @brief Execute a activation backwards layer
+ *
+ * The output is blended as dx = alpha * grad + beta * dx; dx is only read when beta is not 0.
  *
  * @param handle         MIOpen handle (input)
  * @param activDesc      Descriptor for activation layer (input)
@@ -1636,9 +2141,19 @@ miopenDestroyActivationDescriptor(miopenActivationDescriptor_t activDesc);
  *
  *  @{
  */
+
+/*! @enum miopenSoftmaxAlgorithm_t
+ * Softmax implementation selection
+ */
+typedef enum {
+    miopenSoftmaxAccurate = 0, /*!< Subtracts the max before exponentiation */
+    miopenSoftmaxLog      = 1, /*!< Log-softmax, x - max - log(sum(exp(x - max))) */
+} miopenSoftmaxAlgorithm_t;
+
 /*! @brief Execute a softmax forward layer
  *
  * MIOpen does not support Softmax modes. MIOpen implements the SOFTMAX_MODE_CHANNEL flavor.
+ * The output is blended as y = alpha * softmax(x) + beta * y; y is only read when beta is not 0.
  *
  * @param handle         MIOpen handle (input)
  * @param alpha          Floating point scaling factor, allocated on the host (input)
@@ -1657,9 +2172,36 @@ MIOPEN_EXPORT miopenStatus_t miopenSoftmaxForward(miopenHandle_t handle,
                                                   const miopenTensorDescriptor_t yDesc,
                                                   void* y);
 
+/*! @brief Execute a softmax forward layer over any axis
+ *
+ * Like miopenSoftmaxForward but reduces over the given axis of a packed tensor and can compute
+ * log-softmax. x and y may point to the same buffer.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param x              Data tensor x (input)
+ * @param beta           Floating point shift factor, allocated on the host (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param y              Data tensor y (output)
+ * @param algorithm      Softmax or log-softmax (input)
+ * @param axis           Dimension to reduce over, 1 for channels (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSoftmaxForwardEx(miopenHandle_t handle,
+                                                    const void* alpha,
+                                                    const miopenTensorDescriptor_t xDesc,
+                                                    const void* x,
+                                                    const void* beta,
+                                                    const miopenTensorDescriptor_t yDesc,
+                                                    void* y,
+                                                    miopenSoftmaxAlgorithm_t algorithm,
+                                                    int axis);
+
 /*! @brief Execute a softmax backwards layer
  *
  * MIOpen does not support Softmax modes. MIOpen implements the SOFTMAX_MODE_CHANNEL flavor.
+ * The output is blended as dx = alpha * grad + beta * dx; dx is only read when beta is not 0.
  *
  * @param handle         MIOpen handle (input)
  * @param alpha          Floating point scaling factor, allocated on the host (input)
@@ -1682,6 +2224,35 @@ MIOPEN_EXPORT miopenStatus_t miopenSoftmaxBackward(miopenHandle_t handle,
                                                    const miopenTensorDescriptor_t dxDesc,
                                                    void* dx);
 
+/*! @brief Execute a softmax backwards layer over any axis
+ *
+ * Backward of miopenSoftmaxForwardEx, algorithm and axis must match the forward call.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param yDesc          Tensor descriptor for input data tensor y (input)
+ * @param y              Data tensor y (input)
+ * @param dyDesc         Tensor descriptor for input data tensor dy (input)
+ * @param dy             Data delta tensor dy (input)
+ * @param beta           Floating point shift factor, allocated on the host (input)
+ * @param dxDesc         Tensor descriptor for data output tensor dx (input)
+ * @param dx             Output data delta tensor dx (output)
+ * @param algorithm      Softmax or log-softmax (input)
+ * @param axis           Dimension to reduce over, 1 for channels (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSoftmaxBackwardEx(miopenHandle_t handle,
+                                                     const void* alpha,
+                                                     const miopenTensorDescriptor_t yDesc,
+                                                     const void* y,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const void* dy,
+                                                     const void* beta,
+                                                     const miopenTensorDescriptor_t dxDesc,
+                                                     void* dx,
+                                                     miopenSoftmaxAlgorithm_t algorithm,
+                                                     int axis);
+
 /** @} */
 // CLOSEOUT SOFTMAX DOXYGEN GROUP
 
@@ -33,7 +33,9 @@ extern "C" miopenStatus_t miopenCreateActivationDescriptor(miopenActivationDescr
 {
 
     MIOPEN_LOG_FUNCTION(activDesc);
-    return miopen::try_([&] { miopen::deref(activDesc) = new miopen::ActivationDescriptor(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(activDesc) = new miopen::ActivationDescriptor(); });
 }
 
 extern "C" miopenStatus_t miopenSetActivationDescriptor(miopenActivationDescriptor_t activDesc,
@@ -44,7 +46,7 @@ extern "C" miopenStatus_t miopenSetActivationDescriptor(miopenActivationDescript
 {
 
     MIOPEN_LOG_FUNCTION(activDesc, mode, activAlpha, activBeta, activPower);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         std::initializer_list<double> parms = {activAlpha, activBeta, activPower};
         miopen::deref(activDesc)            = miopen::ActivationDescriptor(mode, parms.begin());
     });
@@ -58,7 +60,7 @@ extern "C" miopenStatus_t miopenGetActivationDescriptor(miopenActivationDescript
 {
 
     MIOPEN_LOG_FUNCTION(activDesc, mode, activAlpha, activBeta, activPower);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         *mode       = miopen::deref(activDesc).GetMode();
         *activAlpha = miopen::deref(activDesc).GetAlpha();
         *activBeta  = miopen::deref(activDesc).GetBeta();
@@ -77,7 +79,7 @@ extern "C" miopenStatus_t miopenActivationForward(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(activDesc, alpha, xDesc, x, beta, yDesc, y);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(activDesc).Forward(miopen::deref(handle),
                                          alpha,
                                          miopen::deref(xDesc),
@@ -103,7 +105,7 @@ extern "C" miopenStatus_t miopenActivationBackward(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(activDesc, alpha, yDesc, y, dyDesc, dy, xDesc, x, beta, dxDesc, dx)
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(activDesc).Backward(miopen::deref(handle),
                                           alpha,
                                           miopen::deref(yDesc),
@@ -122,5 +124,5 @@ extern "C" miopenStatus_t miopenDestroyActivationDescriptor(miopenActivationDesc
 {
 
     MIOPEN_LOG_FUNCTION(activDesc)
-    return miopen::try_([&] { miopen_destroy_object(activDesc); });
+    return miopen::try_(__func__, [&] { miopen_destroy_object(activDesc); });
 }
@@ -26,15 +26,26 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/batch_norm.hpp>
+#include <miopen/env.hpp>
+#include <miopen/float_equal.hpp>
+#include <miopen/logger.hpp>
 #include <cassert>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
 
 #define MIOPEN_BN_SYNCH 0
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_BN_SPECIALIZE)
+
 void DeriveBNTensorDescriptor(TensorDescriptor& derivedBnDesc,
                               const TensorDescriptor& xDesc,
                               miopenBatchNormMode_t bn_mode)
@@ -127,6 +138,8 @@ void bnFwdTrainSelectMulti(Handle& handle,
                            Data_t y,
                            ConstData_t bnScale,
                            ConstData_t bnBias,
+                           float alpha,
+                           float beta,
                            bool resultsave,
                            bool resultrunning,
                            double expAvgFactor,
@@ -168,7 +181,7 @@ void bnFwdTrainSelectMulti(Handle& handle,
 
         kernel_subname = kernel_name + "Norm";
         handle.GetKernel(algo_name, network_config, program_name, kernel_subname, vld, vgd, parms)(
-            x, y, bnScale, bnBias);
+            x, y, bnScale, bnBias, alpha, beta);
         profileSequence(handle, 2);
     }
     else if(resultsave)
@@ -197,7 +210,7 @@ void bnFwdTrainSelectMulti(Handle& handle,
 
         kernel_subname = kernel_name + "Norm";
         handle.GetKernel(algo_name, network_config, program_name, kernel_subname, vld, vgd, parms)(
-            x, y, bnScale, bnBias);
+            x, y, bnScale, bnBias, alpha, beta);
         profileSequence(handle, 2);
     }
     else if(resultrunning)
@@ -225,7 +238,7 @@ void bnFwdTrainSelectMulti(Handle& handle,
 
         kernel_subname = kernel_name + "Norm";
         handle.GetKernel(algo_name, network_config, program_name, kernel_subname, vld, vgd, parms)(
-            x, y, bnScale, bnBias);
+            x, y, bnScale, bnBias, alpha, beta);
         profileSequence(handle, 2);
     }
     else
@@ -253,7 +266,7 @@ void bnFwdTrainSelectMulti(Handle& handle,
 
         kernel_subname = kernel_name + "Norm";
         handle.GetKernel(algo_name, network_config, program_name, kernel_subname, vld, vgd, parms)(
-            x, y, bnScale, bnBias);
+            x, y, bnScale, bnBias, alpha, beta);
         profileSequence(handle, 2);
     }
 
@@ -276,6 +289,8 @@ void bnFwdTrainSelectSingle(Handle& handle,
                             Data_t y,
                             ConstData_t bnScale,
                             ConstData_t bnBias,
+                            float alpha,
+                            float beta,
                             bool resultsave,
                             bool resultrunning,
                             double expAvgFactor,
@@ -294,6 +309,8 @@ void bnFwdTrainSelectSingle(Handle& handle,
             y,
             bnScale,
             bnBias,
+            alpha,
+            beta,
             inhw,
             expAvgFactor,
             resultRunningMean,
@@ -305,7 +322,16 @@ void bnFwdTrainSelectSingle(Handle& handle,
     else if(resultsave)
     {
         handle.GetKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-            x, y, bnScale, bnBias, inhw, epsilon, resultSaveMean, resultSaveInvVariance);
+            x,
+            y,
+            bnScale,
+            bnBias,
+            alpha,
+            beta,
+            inhw,
+            epsilon,
+            resultSaveMean,
+            resultSaveInvVariance);
     }
     else if(resultrunning)
     {
@@ -314,6 +340,8 @@ void bnFwdTrainSelectSingle(Handle& handle,
             y,
             bnScale,
             bnBias,
+            alpha,
+            beta,
             inhw,
             expAvgFactor,
             resultRunningMean,
@@ -323,7 +351,7 @@ void bnFwdTrainSelectSingle(Handle& handle,
     else
     {
         handle.GetKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-            x, y, bnScale, bnBias, inhw, epsilon);
+            x, y, bnScale, bnBias, alpha, beta, inhw, epsilon);
     }
 }
 
@@ -475,4 +503,226 @@ void bnBwdTrainSelectMulti(Handle& handle,
               << std::endl;
 }
 
+namespace {
+
+using bn_shape = std::array<int, 4>;
+
+struct bn_specialized_shapes
+{
+    bool all = false;
+    std::vector<bn_shape> shapes;
+};
+
+bn_specialized_shapes bnParseSpecializedShapes(const char* value)
+{
+    bn_specialized_shapes result;
+    if(value == nullptr)
+        return result;
+    if(std::string(value) == "all")
+    {
+        result.all = true;
+        return result;
+    }
+
+    std::istringstream ss(value);
+    std::string item;
+    while(std::getline(ss, item, ','))
+    {
+        bn_shape shape;
+        if(std::sscanf(
+               item.c_str(), "%dx%dx%dx%d", &shape[0], &shape[1], &shape[2], &shape[3]) == 4)
+            result.shapes.push_back(shape);
+        else if(!item.empty())
+            MIOPEN_LOG_W("MIOPEN_BN_SPECIALIZE: ignoring " << item << ", expected NxCxHxW");
+    }
+    return result;
+}
+
+} // namespace
+
+bool bnUseGenericKernels(miopenBatchNormMode_t bn_mode, int n, int c, int h, int w)
+{
+    if(bn_mode != miopenBNSpatial)
+        return false;
+
+    static const auto specialized =
+        bnParseSpecializedShapes(GetStringEnv(MIOPEN_BN_SPECIALIZE{}));
+    if(specialized.all)
+        return false;
+
+    const bn_shape shape = {{n, c, h, w}};
+    if(!specialized.shapes.empty())
+        return std::find(specialized.shapes.begin(), specialized.shapes.end(), shape) ==
+               specialized.shapes.end();
+
+    // A shape seen before is likely part of a loop and worth its own programs, the first call of
+    // every other shape shares the generic ones instead of compiling.
+    static std::mutex mutex;
+    static std::set<bn_shape> seen;
+    std::lock_guard<std::mutex> lock(mutex);
+    return seen.insert(shape).second;
+}
+
+std::string bnBlendKernelParams(const void* beta)
+{
+    return float_equal(*(static_cast<const float*>(beta)), 0) ? "" : " -DMIO_BN_BLEND_Y=1";
+}
+
+void bnFwdTrainSpatialGeneric(Handle& handle,
+                              const void* alpha,
+                              const void* beta,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              Data_t y,
+                              ConstData_t bnScale,
+                              ConstData_t bnBias,
+                              double expAvgFactor,
+                              Data_t resultRunningMean,
+                              Data_t resultRunningVariance,
+                              double epsilon,
+                              Data_t resultSaveMean,
+                              Data_t resultSaveInvVariance)
+{
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    const unsigned int in_n       = n;
+    const unsigned int in_cstride = h * w;
+    const unsigned int in_nstride = c * in_cstride;
+    const auto inhw               = float(1.0 / (in_n * in_cstride));
+
+    const bool resultsave    = resultSaveMean != nullptr && resultSaveInvVariance != nullptr;
+    const bool resultrunning = resultRunningMean != nullptr && resultRunningVariance != nullptr;
+
+    // Only options that do not depend on the shape go into the program key.
+    std::string parms = "-DMIO_SAVE_MEAN_VARIANCE=" + std::to_string(resultsave ? 1 : 0);
+    parms += " -DMIO_RUNNING_RESULT=" + std::to_string(resultrunning ? 1 : 0);
+    parms += " -DMIO_BN_GRP0=" + std::to_string(MIO_BN_STATIC_WGSIZE);
+    parms += " -DMIO_BN_LDS_SIZE=" + std::to_string(MIO_BN_STATIC_WGSIZE);
+    parms += bnBlendKernelParams(beta);
+
+    const std::vector<size_t> vld = {MIO_BN_STATIC_WGSIZE, 1, 1};
+    const std::vector<size_t> vgd = {size_t{MIO_BN_STATIC_WGSIZE} * c, 1, 1};
+
+    handle.GetKernel("miopenBatchNormalizationForwardTraining",
+                     "",
+                     "MIOpenBatchNormSpatialGeneric.cl",
+                     "BatchNormFwdTrainSpatialGeneric",
+                     vld,
+                     vgd,
+                     parms)(x,
+                            y,
+                            bnScale,
+                            bnBias,
+                            *(static_cast<const float*>(alpha)),
+                            *(static_cast<const float*>(beta)),
+                            in_n,
+                            in_cstride,
+                            in_nstride,
+                            inhw,
+                            expAvgFactor,
+                            resultRunningMean,
+                            resultRunningVariance,
+                            epsilon,
+                            resultSaveMean,
+                            resultSaveInvVariance);
+}
+
+void bnFwdInferSpatialGeneric(Handle& handle,
+                              const void* alpha,
+                              const void* beta,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              Data_t y,
+                              ConstData_t bnScale,
+                              ConstData_t bnBias,
+                              ConstData_t estimatedMean,
+                              ConstData_t estimatedVariance,
+                              double epsilon)
+{
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    const unsigned int in_n       = n;
+    const unsigned int in_cstride = h * w;
+    const unsigned int in_nstride = c * in_cstride;
+
+    std::string parms = "-DMIO_BN_GRP0=" + std::to_string(MIO_BN_STATIC_WGSIZE);
+    parms += bnBlendKernelParams(beta);
+
+    const size_t segment = (in_cstride + MIO_BN_STATIC_WGSIZE - 1) / MIO_BN_STATIC_WGSIZE;
+
+    const std::vector<size_t> vld = {1, MIO_BN_STATIC_WGSIZE, 1};
+    const std::vector<size_t> vgd = {size_t(c), segment * MIO_BN_STATIC_WGSIZE, 1};
+
+    handle.GetKernel("miopenBatchNormalizationForwardInference",
+                     "",
+                     "MIOpenBatchNormSpatialGeneric.cl",
+                     "BatchNormFwdInferSpatialGeneric",
+                     vld,
+                     vgd,
+                     parms)(x,
+                            y,
+                            estimatedMean,
+                            estimatedVariance,
+                            bnScale,
+                            bnBias,
+                            *(static_cast<const float*>(alpha)),
+                            *(static_cast<const float*>(beta)),
+                            in_n,
+                            in_cstride,
+                            in_nstride,
+                            epsilon);
+}
+
+void bnBwdSpatialGeneric(Handle& handle,
+                         const TensorDescriptor& xDesc,
+                         ConstData_t x,
+                         ConstData_t dy,
+                         Data_t dx,
+                         ConstData_t bnScale,
+                         Data_t dScale,
+                         Data_t dBias,
+                         double epsilon,
+                         ConstData_t savedMean,
+                         ConstData_t savedInvVariance)
+{
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    const unsigned int in_n       = n;
+    const unsigned int in_cstride = h * w;
+    const unsigned int in_nstride = c * in_cstride;
+    const auto inhw               = float(1.0 / (in_n * in_cstride));
+
+    const bool useSaved = savedMean != nullptr && savedInvVariance != nullptr;
+
+    std::string parms = "-DMIO_BN_USESAVED=" + std::to_string(useSaved ? 1 : 0);
+    parms += " -DMIO_BN_GRP0=" + std::to_string(MIO_BN_STATIC_WGSIZE);
+    parms += " -DMIO_BN_LDS_SIZE=" + std::to_string(MIO_BN_STATIC_WGSIZE);
+
+    const std::vector<size_t> vld = {MIO_BN_STATIC_WGSIZE, 1, 1};
+    const std::vector<size_t> vgd = {size_t{MIO_BN_STATIC_WGSIZE} * c, 1, 1};
+
+    handle.GetKernel("miopenBatchNormalizationBackwardProp",
+                     "",
+                     "MIOpenBatchNormSpatialGeneric.cl",
+                     "BatchNormBwdSpatialGeneric",
+                     vld,
+                     vgd,
+                     parms)(x,
+                            dy,
+                            dx,
+                            bnScale,
+                            dScale,
+                            dBias,
+                            savedMean,
+                            savedInvVariance,
+                            epsilon,
+                            in_n,
+                            in_cstride,
+                            in_nstride,
+                            inhw);
+}
+
 } // namespace miopen
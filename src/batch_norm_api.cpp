@@ -37,7 +37,7 @@ extern "C" miopenStatus_t miopenDeriveBNTensorDescriptor(miopenTensorDescriptor_
 {
 
     MIOPEN_LOG_FUNCTION(derivedBnDesc, xDesc, bn_mode);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::DeriveBNTensorDescriptor(
             miopen::deref(derivedBnDesc), miopen::deref(xDesc), bn_mode);
     });
@@ -70,7 +70,7 @@ miopenBatchNormalizationForwardInference(miopenHandle_t handle,
                         estimatedMean,
                         estimatedVariance,
                         epsilon);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::BatchNormForwardInference(miopen::deref(handle),
                                           bn_mode,
                                           alpha,
@@ -88,6 +88,54 @@ miopenBatchNormalizationForwardInference(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t miopenBatchNormalizationActivationForwardInference(
+    miopenHandle_t handle,
+    miopenBatchNormMode_t bn_mode,
+    void* alpha,
+    void* beta,
+    const miopenTensorDescriptor_t xDesc,
+    const void* x,
+    const miopenTensorDescriptor_t yDesc,
+    void* y,
+    const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+    void* bnScale,
+    void* bnBias,
+    void* estimatedMean,
+    void* estimatedVariance,
+    double epsilon,
+    const miopenActivationDescriptor_t activDesc)
+{
+    MIOPEN_LOG_FUNCTION(bn_mode,
+                        xDesc,
+                        x,
+                        yDesc,
+                        y,
+                        bnScaleBiasMeanVarDesc,
+                        bnScale,
+                        bnBias,
+                        estimatedMean,
+                        estimatedVariance,
+                        epsilon,
+                        activDesc);
+    return miopen::try_(__func__, [&] {
+        miopen::BatchNormActivForwardInference(miopen::deref(handle),
+                                               bn_mode,
+                                               alpha,
+                                               beta,
+                                               miopen::deref(xDesc),
+                                               DataCast(x),
+                                               miopen::deref(yDesc),
+                                               DataCast(y),
+                                               miopen::deref(bnScaleBiasMeanVarDesc),
+                                               DataCast(bnScale),
+                                               DataCast(bnBias),
+                                               DataCast(estimatedMean),
+                                               DataCast(estimatedVariance),
+                                               epsilon,
+                                               miopen::deref(activDesc));
+    });
+}
+
 extern "C" miopenStatus_t
 miopenBatchNormalizationForwardTraining(miopenHandle_t handle,
                                         miopenBatchNormMode_t bn_mode,
@@ -143,7 +191,7 @@ miopenBatchNormalizationForwardTraining(miopenHandle_t handle,
         std::cerr << "\n";
     }
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::BatchNormForwardTraining(miopen::deref(handle),
                                          bn_mode,
                                          alpha,
@@ -204,7 +252,7 @@ miopenBatchNormalizationBackward(miopenHandle_t handle,
     {
         std::cerr << MIOPEN_DRIVER_CMD("bnorm") << "\n";
     }
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::BatchNormBackward(miopen::deref(handle),
                                   bn_mode,
                                   alphaDataDiff,
@@ -27,6 +27,7 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/md5.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/miopen.h>
@@ -87,14 +88,19 @@ std::string LoadBinary(const std::string& device,
                        bool is_kernel_str)
 {
     if(miopen::IsCacheDisabled())
+    {
+        IncrementMetric(MetricsCounter::BinaryCacheMiss);
         return {};
+    }
     auto f = GetCacheFile(device, name, args, is_kernel_str);
     if(boost::filesystem::exists(f))
     {
+        IncrementMetric(MetricsCounter::BinaryCacheHit);
         return f.string();
     }
     else
     {
+        IncrementMetric(MetricsCounter::BinaryCacheMiss);
         return {};
     }
 }
@@ -1,4 +1,5 @@
 #include <miopen/check_numerics.hpp>
+#include <miopen/datatype.hpp>
 #include <miopen/env.hpp>
 
 namespace miopen {
@@ -34,15 +35,22 @@ bool checkNumericsImpl(
 
     CheckNumericsResult abnormal_h;
 
-    auto abnormal_d =
-        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
+    // Served from the memory pool when it is enabled
+    auto abnormal_d = handle.Create(sizeof(CheckNumericsResult));
     handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
 
     std::string program_name      = "MIOpenCheckNumerics.cl";
     std::string kernel_name       = "MIOpenCheckNumerics";
     const std::vector<size_t> vld = {size_t{blockSize}, size_t{1}, size_t{1}};
     const std::vector<size_t> vgd = {numGlobalWorkItems, size_t{1}, size_t{1}};
-    handle.GetKernel("MIOpenCheckNumerics", "", program_name, kernel_name, vld, vgd, "")(
+    const auto type               = dDesc.GetType();
+    handle.GetKernel("MIOpenCheckNumerics",
+                     "t" + std::to_string(static_cast<int>(type)),
+                     program_name,
+                     kernel_name,
+                     vld,
+                     vgd,
+                     GetDataTypeKernelParams(type))(
         data, numElements, abnormal_d.get(), computeStats);
 
     handle.ReadTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
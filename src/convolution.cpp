@@ -178,10 +178,20 @@ size_t ConvolutionDescriptor::ForwardGetWorkSpaceSizeGEMM(Handle& handle,
     int out_h, out_w;
     std::tie(std::ignore, std::ignore, out_h, out_w) = miopen::tien<4>(yDesc.GetLengths());
 
-    int wei_c, wei_h, wei_w;
-    std::tie(std::ignore, wei_c, wei_h, wei_w) = miopen::tien<4>(wDesc.GetLengths());
+    int wei_n, wei_c, wei_h, wei_w;
+    std::tie(wei_n, wei_c, wei_h, wei_w) = miopen::tien<4>(wDesc.GetLengths());
 
-    size_t workspace_size = wei_c * wei_h * wei_w * out_h * out_w * sizeof(yDesc.GetType());
+    size_t workspace_size = wei_c * wei_h * wei_w * out_h * out_w * sizeof(float);
+
+    // The GEMM computes in float, so half problems keep float copies of the columns, the
+    // weights and one output image in the workspace, even for 1x1 filters.
+    const bool is_half = yDesc.GetType() == miopenHalf;
+    if(is_half)
+    {
+        workspace_size = (wei_c * wei_h * wei_w * out_h * out_w + wDesc.GetElementSize() +
+                          wei_n * out_h * out_w) *
+                         sizeof(float);
+    }
 
     // gfx803 devices have 4gb-6gb memory
     if(workspace_size > (1 << 30) && handle.GetDeviceName() == "gfx803")
@@ -189,7 +199,10 @@ size_t ConvolutionDescriptor::ForwardGetWorkSpaceSizeGEMM(Handle& handle,
         workspace_size = 0;
     }
 
-    return (wei_h == 1 && wei_w == 1 && v == 1 && u == 1) ? 0 : workspace_size;
+    // NHWC inputs are always unfolded by im2col, 1x1 filters included
+    const bool is_nhwc = yDesc.GetLayout() == "NHWC";
+    return (wei_h == 1 && wei_w == 1 && v == 1 && u == 1 && !is_half && !is_nhwc) ? 0
+                                                                                   : workspace_size;
 }
 
 // FIXME: This seems to duplicate
@@ -200,6 +213,10 @@ bool ConvolutionDescriptor::IsWinograd3x3Supported(Handle& handle,
                                                    const TensorDescriptor& wDesc,
                                                    const TensorDescriptor& xDesc) const
 {
+    if(xDesc.GetType() != miopenFloat || xDesc.GetLayout() != "NCHW")
+    {
+        return false;
+    }
     if(miopen::IsDisabled(MIOPEN_DEBUG_AMD_ROCM_PRECOMPILED_BINARIES{}))
     {
         // Support for MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING is not copypasted here.
@@ -462,7 +479,7 @@ size_t ConvolutionDescriptor::BackwardDataGetWorkSpaceSizeGEMM(Handle& handle,
     std::tie(std::ignore, std::ignore, out_h, out_w) = miopen::tien<4>(dyDesc.GetLengths());
     int wei_c, wei_h, wei_w;
     std::tie(std::ignore, wei_c, wei_h, wei_w) = miopen::tien<4>(wDesc.GetLengths());
-    size_t gemm_size = wei_c * wei_h * wei_w * out_h * out_w * sizeof(dyDesc.GetType());
+    size_t gemm_size = wei_c * wei_h * wei_w * out_h * out_w * sizeof(float);
 
     // gfx803 devices have limited memory
     // TODO: be graceful, need to ensure we can execute a config on the GPU
@@ -480,7 +497,7 @@ size_t ConvolutionDescriptor::BackwardWeightsGetWorkSpaceSizeGEMM(
     std::tie(std::ignore, std::ignore, out_h, out_w) = miopen::tien<4>(dyDesc.GetLengths());
     int wei_c, wei_h, wei_w;
     std::tie(std::ignore, wei_c, wei_h, wei_w) = miopen::tien<4>(dwDesc.GetLengths());
-    size_t gemm_size = wei_c * wei_h * wei_w * out_h * out_w * sizeof(dyDesc.GetType());
+    size_t gemm_size = wei_c * wei_h * wei_w * out_h * out_w * sizeof(float);
 
     // gfx803 devices have limited memory
     // TODO: be graceful, need to ensure we can execute a config on the GPU
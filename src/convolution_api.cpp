@@ -23,7 +23,9 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <miopen/conv_bias_activ_plan.hpp>
 #include <miopen/convolution.hpp>
+#include <miopen/convolution_plan.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor_ops.hpp>
@@ -34,7 +36,9 @@ inline std::ostream& operator<<(std::ostream& os, miopenConvAlgoPerf_t) { return
 extern "C" miopenStatus_t miopenCreateConvolutionDescriptor(miopenConvolutionDescriptor_t* convDesc)
 {
     MIOPEN_LOG_FUNCTION(convDesc);
-    return miopen::try_([&] { miopen::deref(convDesc) = new miopen::ConvolutionDescriptor(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(convDesc) = new miopen::ConvolutionDescriptor(); });
 }
 
 extern "C" miopenStatus_t miopenInitConvolutionDescriptor(miopenConvolutionDescriptor_t convDesc,
@@ -48,7 +52,7 @@ extern "C" miopenStatus_t miopenInitConvolutionDescriptor(miopenConvolutionDescr
 {
 
     MIOPEN_LOG_FUNCTION(convDesc, c_mode, pad_h, pad_w, u, v, dilation_h, dilation_w);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(convDesc) = miopen::ConvolutionDescriptor(
             c_mode, miopenPaddingDefault, pad_h, pad_w, u, v, dilation_h, dilation_w);
     });
@@ -65,7 +69,7 @@ extern "C" miopenStatus_t miopenGetConvolutionDescriptor(miopenConvolutionDescri
 {
 
     MIOPEN_LOG_FUNCTION(convDesc, c_mode, pad_h, pad_w, u, v, dilation_h, dilation_w);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(c_mode)     = miopen::deref(convDesc).mode;
         miopen::deref(pad_h)      = miopen::deref(convDesc).pad_h;
         miopen::deref(pad_w)      = miopen::deref(convDesc).pad_w;
@@ -87,7 +91,7 @@ miopenGetConvolutionForwardOutputDim(miopenConvolutionDescriptor_t convDesc,
 {
 
     MIOPEN_LOG_FUNCTION(convDesc, inputTensorDesc, filterDesc, n, c, h, w);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::tie_deref(n, c, h, w) = miopen::deref(convDesc).GetForwardOutputDim(
             miopen::deref(inputTensorDesc), miopen::deref(filterDesc));
     });
@@ -96,7 +100,7 @@ miopenGetConvolutionForwardOutputDim(miopenConvolutionDescriptor_t convDesc,
 extern "C" miopenStatus_t miopenDestroyConvolutionDescriptor(miopenConvolutionDescriptor_t convDesc)
 {
     MIOPEN_LOG_FUNCTION(convDesc);
-    return miopen::try_([&] { miopen_destroy_object(convDesc); });
+    return miopen::try_(__func__, [&] { miopen_destroy_object(convDesc); });
 }
 
 extern "C" miopenStatus_t
@@ -109,7 +113,7 @@ miopenConvolutionForwardGetWorkSpaceSize(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(wDesc, yDesc, convDesc, workSpaceSize);
-    miopen::try_([&] {
+    miopen::try_(__func__, [&] {
         miopen::deref(workSpaceSize) =
             miopen::deref(convDesc).ForwardGetWorkSpaceSize(miopen::deref(handle),
                                                             miopen::deref(wDesc),
@@ -150,7 +154,7 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                         workSpace,
                         workSpaceSize,
                         exhaustiveSearch);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(convDesc).FindConvFwdAlgorithm(miopen::deref(handle),
                                                      miopen::deref(xDesc),
                                                      DataCast(x),
@@ -206,7 +210,7 @@ extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                   << "\n";
     }
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(convDesc).ConvolutionForward(miopen::deref(handle),
                                                    alpha,
                                                    miopen::deref(xDesc),
@@ -232,7 +236,7 @@ extern "C" miopenStatus_t miopenConvolutionForwardBias(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(alpha, bDesc, b, beta, yDesc, y);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
 
         return OpTensor(miopen::deref(handle),
                         miopenTensorOpAdd,
@@ -278,7 +282,7 @@ miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                         workSpace,
                         workSpaceSize,
                         exhaustiveSearch);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(convDesc).FindConvBwdDataAlgorithm(miopen::deref(handle),
                                                          miopen::deref(dyDesc),
                                                          DataCast(dy),
@@ -335,7 +339,7 @@ miopenConvolutionBackwardData(miopenHandle_t handle,
                   << "\n";
     }
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(convDesc).ConvolutionBackwardData(miopen::deref(handle),
                                                         alpha,
                                                         miopen::deref(dyDesc),
@@ -361,7 +365,7 @@ miopenConvolutionBackwardDataGetWorkSpaceSize(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(dyDesc, wDesc, convDesc, dxDesc, workSpaceSize);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(workSpaceSize) =
             miopen::deref(convDesc).BackwardDataGetWorkSpaceSize(miopen::deref(handle),
                                                                  miopen::deref(wDesc),
@@ -380,7 +384,7 @@ miopenConvolutionBackwardWeightsGetWorkSpaceSize(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(dyDesc, xDesc, convDesc, dwDesc, workSpaceSize);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(workSpaceSize) =
             miopen::deref(convDesc).ConvolutionBackwardWeightsGetWorkSpaceSize(
                 miopen::deref(handle),
@@ -442,7 +446,7 @@ miopenFindConvolutionBackwardWeightsAlgorithm(miopenHandle_t handle,
                   << "\n";
     }
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(convDesc).FindConvBwdWeightsAlgorithm(miopen::deref(handle),
                                                             miopen::deref(dyDesc),
                                                             DataCast(dy),
@@ -477,7 +481,7 @@ miopenConvolutionBackwardWeights(miopenHandle_t handle,
 
     MIOPEN_LOG_FUNCTION(
         alpha, dyDesc, dy, xDesc, x, convDesc, algo, beta, dwDesc, dw, workSpace, workSpaceSize);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(convDesc).ConvolutionBackwardWeights(miopen::deref(handle),
                                                            alpha,
                                                            miopen::deref(dyDesc),
@@ -502,7 +506,7 @@ extern "C" miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle,
                                                         void* db)
 {
     MIOPEN_LOG_FUNCTION(alpha, dyDesc, dy, beta, dbDesc, db);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         ConvolutionBackwardBias(miopen::deref(handle),
                                 alpha,
                                 miopen::deref(dyDesc),
@@ -512,3 +516,137 @@ extern "C" miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle,
                                 DataCast(db));
     });
 }
+
+extern "C" miopenStatus_t
+miopenCreateConvolutionForwardPlan(miopenHandle_t handle,
+                                   miopenConvolutionPlan_t* plan,
+                                   const miopenTensorDescriptor_t xDesc,
+                                   const miopenTensorDescriptor_t wDesc,
+                                   const miopenConvolutionDescriptor_t convDesc,
+                                   const miopenTensorDescriptor_t yDesc,
+                                   miopenConvFwdAlgorithm_t algo)
+{
+    MIOPEN_LOG_FUNCTION(plan, xDesc, wDesc, convDesc, yDesc, algo);
+    return miopen::try_(__func__, [&] {
+        miopen::deref(plan) = new miopen::ConvolutionPlan(miopen::deref(handle),
+                                                          miopen::deref(convDesc),
+                                                          miopen::deref(xDesc),
+                                                          miopen::deref(wDesc),
+                                                          miopen::deref(yDesc),
+                                                          algo);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenCreateConvolutionBackwardDataPlan(miopenHandle_t handle,
+                                        miopenConvolutionPlan_t* plan,
+                                        const miopenTensorDescriptor_t dyDesc,
+                                        const miopenTensorDescriptor_t wDesc,
+                                        const miopenConvolutionDescriptor_t convDesc,
+                                        const miopenTensorDescriptor_t dxDesc,
+                                        miopenConvBwdDataAlgorithm_t algo)
+{
+    MIOPEN_LOG_FUNCTION(plan, dyDesc, wDesc, convDesc, dxDesc, algo);
+    return miopen::try_(__func__, [&] {
+        miopen::deref(plan) = new miopen::ConvolutionPlan(miopen::deref(handle),
+                                                          miopen::deref(convDesc),
+                                                          miopen::deref(dyDesc),
+                                                          miopen::deref(wDesc),
+                                                          miopen::deref(dxDesc),
+                                                          algo);
+    });
+}
+
+extern "C" miopenStatus_t miopenConvolutionPlanGetWorkSpaceSize(miopenConvolutionPlan_t plan,
+                                                                size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(plan, workSpaceSize);
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(workSpaceSize) = miopen::deref(plan).GetWorkSpaceSize(); });
+}
+
+extern "C" miopenStatus_t miopenExecuteConvolutionPlan(miopenHandle_t handle,
+                                                       miopenConvolutionPlan_t plan,
+                                                       const void* in,
+                                                       const void* w,
+                                                       void* out,
+                                                       void* workSpace,
+                                                       size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(plan, in, w, out, workSpace, workSpaceSize);
+    return miopen::try_(__func__, [&] {
+        miopen::deref(plan).Execute(miopen::deref(handle),
+                                    DataCast(in),
+                                    DataCast(w),
+                                    DataCast(out),
+                                    DataCast(workSpace),
+                                    workSpaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyConvolutionPlan(miopenConvolutionPlan_t plan)
+{
+    MIOPEN_LOG_FUNCTION(plan);
+    return miopen::try_(__func__, [&] { miopen_destroy_object(plan); });
+}
+
+extern "C" miopenStatus_t
+miopenCreateConvBiasActivForwardPlan(miopenHandle_t handle,
+                                     miopenConvBiasActivPlan_t* plan,
+                                     const miopenTensorDescriptor_t xDesc,
+                                     const miopenTensorDescriptor_t wDesc,
+                                     const miopenConvolutionDescriptor_t convDesc,
+                                     const miopenTensorDescriptor_t bDesc,
+                                     const miopenActivationDescriptor_t activDesc,
+                                     const miopenTensorDescriptor_t yDesc,
+                                     miopenConvFwdAlgorithm_t algo)
+{
+    MIOPEN_LOG_FUNCTION(plan, xDesc, wDesc, convDesc, bDesc, activDesc, yDesc, algo);
+    return miopen::try_(__func__, [&] {
+        miopen::deref(plan) = new miopen::ConvBiasActivPlan(miopen::deref(handle),
+                                                            miopen::deref(convDesc),
+                                                            miopen::deref(xDesc),
+                                                            miopen::deref(wDesc),
+                                                            miopen::deref(bDesc),
+                                                            miopen::deref(activDesc),
+                                                            miopen::deref(yDesc),
+                                                            algo);
+    });
+}
+
+extern "C" miopenStatus_t miopenConvBiasActivPlanGetWorkSpaceSize(miopenConvBiasActivPlan_t plan,
+                                                                  size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(plan, workSpaceSize);
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(workSpaceSize) = miopen::deref(plan).GetWorkSpaceSize(); });
+}
+
+extern "C" miopenStatus_t miopenExecuteConvBiasActivPlan(miopenHandle_t handle,
+                                                         miopenConvBiasActivPlan_t plan,
+                                                         const void* x,
+                                                         const void* w,
+                                                         const void* b,
+                                                         void* y,
+                                                         void* workSpace,
+                                                         size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(plan, x, w, b, y, workSpace, workSpaceSize);
+    return miopen::try_(__func__, [&] {
+        miopen::deref(plan).Execute(miopen::deref(handle),
+                                    DataCast(x),
+                                    DataCast(w),
+                                    DataCast(b),
+                                    DataCast(y),
+                                    DataCast(workSpace),
+                                    workSpaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyConvBiasActivPlan(miopenConvBiasActivPlan_t plan)
+{
+    MIOPEN_LOG_FUNCTION(plan);
+    return miopen::try_(__func__, [&] { miopen_destroy_object(plan); });
+}
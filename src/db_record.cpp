@@ -27,8 +27,11 @@
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <numeric>
+#include <tuple>
+#include <unordered_map>
 
 #include <miopen/errors.hpp>
 #include <miopen/db_record.hpp>
@@ -36,6 +39,61 @@
 
 namespace miopen {
 
+namespace {
+
+// Keys and "ID:VALUES" entries of a db file, parsed once for the nearest record lookups.
+// Flush drops the entry of the file it rewrites, other writers are noticed by the file size.
+struct NearestIndex
+{
+    std::streamoff size = -1;
+    std::vector<std::pair<std::string, std::vector<std::pair<std::string, std::string>>>> records;
+};
+
+std::mutex& NearestIndexMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::string, NearestIndex>& NearestIndices()
+{
+    static std::unordered_map<std::string, NearestIndex> indices;
+    return indices;
+}
+
+void ForgetNearestIndex(const std::string& db_filename)
+{
+    std::lock_guard<std::mutex> lock(NearestIndexMutex());
+    NearestIndices().erase(db_filename);
+}
+
+void ParseNearestIndex(std::istream& file, NearestIndex& index)
+{
+    index.records.clear();
+    std::string line;
+    while(std::getline(file, line))
+    {
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+            continue;
+
+        std::vector<std::pair<std::string, std::string>> entries;
+        std::istringstream ss(line.substr(key_size + 1));
+        std::string id_and_values;
+        while(std::getline(ss, id_and_values, ';'))
+        {
+            const auto id_size = id_and_values.find(':');
+            if(id_size == std::string::npos)
+                continue;
+            entries.emplace_back(id_and_values.substr(0, id_size),
+                                 id_and_values.substr(id_size + 1));
+        }
+        index.records.emplace_back(line.substr(0, key_size), std::move(entries));
+    }
+}
+
+} // namespace
+
 bool DbRecord::ParseContents(const std::string& contents)
 {
 #if MIOPEN_PERFDB_CONV_LEGACY_SUPPORT
@@ -308,6 +366,7 @@ static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
 bool DbRecord::Flush(const RecordPositions* const pos)
 {
     assert(pos);
+    ForgetNearestIndex(db_filename);
     if(pos->begin < 0 || pos->end < 0)
     {
         std::ofstream file(db_filename, std::ios::app);
@@ -494,4 +553,58 @@ void DbRecord::ReadFile(RecordPositions* const pos)
         break;
     }
 }
+
+std::vector<std::pair<std::string, std::string>>
+DbRecord::FindNearest(const std::string& id,
+                      const std::function<double(const std::string&)>& distance)
+{
+    std::vector<std::tuple<double, std::string, std::string>> candidates;
+    std::ifstream file(db_filename, std::ios::ate);
+
+    if(!file)
+    {
+        MIOPEN_LOG_W("File is unreadable.");
+        return {};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(NearestIndexMutex());
+        auto& index     = NearestIndices()[db_filename];
+        const auto size = static_cast<std::streamoff>(file.tellg());
+        if(index.size != size)
+        {
+            file.seekg(0);
+            ParseNearestIndex(file, index);
+            index.size = size;
+        }
+
+        for(auto&& record : index.records)
+        {
+            if(record.first == key)
+                continue;
+
+            const auto entry = std::find_if(record.second.begin(),
+                                            record.second.end(),
+                                            [&](auto&& e) { return e.first == id; });
+            if(entry == record.second.end())
+                continue;
+
+            const auto d = distance(record.first);
+            if(d < 0)
+                continue;
+
+            candidates.emplace_back(d, record.first, entry->second);
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](auto&& a, auto&& b) {
+        return std::get<0>(a) < std::get<0>(b);
+    });
+
+    std::vector<std::pair<std::string, std::string>> result;
+    result.reserve(candidates.size());
+    for(auto&& candidate : candidates)
+        result.emplace_back(std::move(std::get<1>(candidate)), std::move(std::get<2>(candidate)));
+    return result;
+}
 } // namespace miopen
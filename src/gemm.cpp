@@ -188,6 +188,13 @@ GemmGeometry CreateGemmGeometryConvFwd(const TensorDescriptor& xDesc,
     int ldb     = N;
     int ldc     = N;
 
+    // an NHWC output image is the transpose of the NCHW one
+    if(yDesc.GetLayout() == "NHWC")
+    {
+        tC  = true;
+        ldc = M;
+    }
+
     MIOpenGEMM::Geometry tgg{};
     GemmGeometry gg;
     if(!isDataColMajor)
@@ -54,7 +54,7 @@ miopenStatus_t miopenGemm(miopenHandle_t handle,
         isDataColMajor = true;
     }
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::GemmGeometry gg =
             miopen::CreateMIOpenGemmGeometry(M,
                                              N,
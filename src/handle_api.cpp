@@ -23,31 +23,35 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <cstdio>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/metrics.hpp>
 
 extern "C" miopenStatus_t miopenCreate(miopenHandle_t* handle)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(); });
+    return miopen::try_(__func__, [&] { miopen::deref(handle) = new miopen::Handle(); });
 }
 
 extern "C" miopenStatus_t miopenCreateWithStream(miopenHandle_t* handle,
                                                  miopenAcceleratorQueue_t stream)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(stream); });
+    return miopen::try_(__func__, [&] { miopen::deref(handle) = new miopen::Handle(stream); });
 }
 
 extern "C" miopenStatus_t miopenSetStream(miopenHandle_t handle, miopenAcceleratorQueue_t streamID)
 {
-    return miopen::try_([&] { miopen::deref(handle).SetStream(streamID); });
+    return miopen::try_(__func__, [&] { miopen::deref(handle).SetStream(streamID); });
 }
 
 extern "C" miopenStatus_t miopenGetStream(miopenHandle_t handle, miopenAcceleratorQueue_t* streamID)
 {
-    return miopen::try_([&] { miopen::deref(streamID) = miopen::deref(handle).GetStream(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(streamID) = miopen::deref(handle).GetStream(); });
 }
 
 extern "C" miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
@@ -56,19 +60,146 @@ extern "C" miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
                                              void* allocatorContext)
 {
     return miopen::try_(
+        __func__,
         [&] { miopen::deref(handle).SetAllocator(allocator, deallocator, allocatorContext); });
 }
 
+extern "C" miopenStatus_t miopenEnableMemoryPool(miopenHandle_t handle, bool enable)
+{
+    return miopen::try_(__func__, [&] { miopen::deref(handle).EnableMemoryPool(enable); });
+}
+
+extern "C" miopenStatus_t miopenGetMemoryPoolStats(miopenHandle_t handle,
+                                                   miopenMemoryPoolStats_t* stats)
+{
+    return miopen::try_(__func__, [&] {
+        const auto result   = miopen::deref(handle).GetMemoryPoolStats();
+        auto& out           = miopen::deref(stats);
+        out.bytes_in_use    = result.bytes_in_use;
+        out.bytes_cached    = result.bytes_cached;
+        out.high_water_mark = result.high_water_mark;
+        out.allocations     = result.allocations;
+        out.reuses          = result.reuses;
+    });
+}
+
+extern "C" miopenStatus_t miopenTrimMemoryPool(miopenHandle_t handle)
+{
+    return miopen::try_(__func__, [&] { miopen::deref(handle).TrimMemoryPool(); });
+}
+
+extern "C" miopenStatus_t miopenSetWorkspaceArenaLimit(miopenHandle_t handle, size_t limit)
+{
+    return miopen::try_(__func__, [&] { miopen::deref(handle).SetWorkspaceArenaLimit(limit); });
+}
+
+extern "C" miopenStatus_t miopenGetWorkspaceArenaSize(miopenHandle_t handle, size_t* size)
+{
+    return miopen::try_(__func__, [&] {
+        miopen::deref(size) = miopen::deref(handle).GetWorkspaceArenaSize();
+    });
+}
+
 extern "C" miopenStatus_t miopenDestroy(miopenHandle_t handle)
 {
-    return miopen::try_([&] { miopen_destroy_object(handle); });
+    return miopen::try_(__func__, [&] { miopen_destroy_object(handle); });
 }
 
 extern "C" miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* time)
 {
-    return miopen::try_([&] { miopen::deref(time) = miopen::deref(handle).GetKernelTime(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(time) = miopen::deref(handle).GetKernelTime(); });
 }
 extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable)
 {
-    return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
+    return miopen::try_(__func__, [&] { miopen::deref(handle).EnableProfiling(enable); });
+}
+
+extern "C" miopenStatus_t miopenEnableDeferredProfiling(miopenHandle_t handle, bool enable)
+{
+    return miopen::try_(__func__, [&] { miopen::deref(handle).EnableDeferredProfiling(enable); });
+}
+
+extern "C" miopenStatus_t
+miopenGetKernelProfiles(miopenHandle_t handle, miopenKernelProfile_t* profiles, size_t* count)
+{
+    return miopen::try_(__func__, [&] {
+        const auto& records = miopen::deref(handle).GetKernelProfiles();
+        if(profiles == nullptr)
+        {
+            miopen::deref(count) = records.size();
+            return;
+        }
+        const auto n = std::min(miopen::deref(count), records.size());
+        for(std::size_t i = 0; i < n; i++)
+        {
+            profiles[i].kernel_name    = records[i].kernel_name.c_str();
+            profiles[i].algorithm      = records[i].algorithm.c_str();
+            profiles[i].network_config = records[i].network_config.c_str();
+            profiles[i].start_ns       = records[i].start_ns;
+            profiles[i].end_ns         = records[i].end_ns;
+        }
+        *count = n;
+    });
+}
+
+extern "C" miopenStatus_t miopenResetKernelProfiles(miopenHandle_t handle)
+{
+    return miopen::try_(__func__, [&] { miopen::deref(handle).ResetKernelProfiles(); });
+}
+
+extern "C" miopenStatus_t miopenEnableMetrics(bool enable)
+{
+    return miopen::try_(__func__, [&] { miopen::EnableMetrics(enable); });
+}
+
+extern "C" miopenStatus_t miopenGetApiMetrics(miopenApiMetrics_t* metrics, size_t* count)
+{
+    return miopen::try_(__func__, [&] {
+        const auto apis = miopen::GetApiMetrics();
+        if(metrics == nullptr)
+        {
+            miopen::deref(count) = apis.size();
+            return;
+        }
+        const auto n = std::min(miopen::deref(count), apis.size());
+        for(std::size_t i = 0; i < n; i++)
+        {
+            metrics[i].name        = apis[i].name;
+            metrics[i].calls       = apis[i].calls;
+            metrics[i].errors      = apis[i].errors;
+            metrics[i].host_us     = apis[i].host_us;
+            metrics[i].max_host_us = apis[i].max_host_us;
+            metrics[i].device_us   = apis[i].device_us;
+            std::copy(apis[i].host_histogram.begin(),
+                      apis[i].host_histogram.end(),
+                      metrics[i].host_histogram);
+        }
+        *count = n;
+    });
+}
+
+extern "C" miopenStatus_t miopenGetCacheMetrics(miopenCacheMetrics_t* metrics)
+{
+    return miopen::try_(__func__, [&] {
+        using miopen::MetricsCounter;
+        const auto counters = miopen::GetCacheMetrics();
+        const auto get      = [&](MetricsCounter c) {
+            return counters[static_cast<std::size_t>(c)];
+        };
+
+        auto&& m              = miopen::deref(metrics);
+        m.kernel_cache_hits   = get(MetricsCounter::KernelCacheHit);
+        m.kernel_cache_misses = get(MetricsCounter::KernelCacheMiss);
+        m.binary_cache_hits   = get(MetricsCounter::BinaryCacheHit);
+        m.binary_cache_misses = get(MetricsCounter::BinaryCacheMiss);
+        m.perf_db_hits        = get(MetricsCounter::PerfDbHit);
+        m.perf_db_misses      = get(MetricsCounter::PerfDbMiss);
+    });
+}
+
+extern "C" miopenStatus_t miopenResetMetrics()
+{
+    return miopen::try_(__func__, [&] { miopen::ResetMetrics(); });
 }
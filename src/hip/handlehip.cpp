@@ -25,10 +25,13 @@
  *******************************************************************************/
 #include <algorithm>
 #include <miopen/device_name.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/kernel_cache.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/binary_cache.hpp>
+#include <miopen/trace.hpp>
 #include <boost/filesystem.hpp>
 
 #ifndef _WIN32
@@ -41,6 +44,9 @@
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEMORY_POOL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_WORKSPACE_ARENA_MB)
+
 // Get current context
 // We leak resources for now as there is no hipCtxRetain API
 hipCtx_t get_ctx()
@@ -119,7 +125,8 @@ int set_default_device()
 struct HandleImpl
 {
     // typedef MIOPEN_MANAGE_PTR(hipStream_t, hipStreamDestroy) StreamPtr;
-    using StreamPtr = std::shared_ptr<typename std::remove_pointer<hipStream_t>::type>;
+    using StreamPtr      = std::shared_ptr<typename std::remove_pointer<hipStream_t>::type>;
+    using SharedEventPtr = std::shared_ptr<typename std::remove_pointer<hipEvent_t>::type>;
 
     HandleImpl() : ctx(get_ctx()) {}
 
@@ -137,6 +144,7 @@ struct HandleImpl
     void elapsed_time(hipEvent_t start, hipEvent_t stop)
     {
         hipEventElapsedTime(&this->profiling_result, start, stop);
+        RecordDeviceTime(this->profiling_result);
     }
 
     std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler()
@@ -145,6 +153,67 @@ struct HandleImpl
             &HandleImpl::elapsed_time, this, std::placeholders::_1, std::placeholders::_2);
     }
 
+    // HIP events only measure intervals, so timestamps are taken relative to
+    // an event recorded when deferred profiling was enabled.
+    std::function<void(hipEvent_t, hipEvent_t)>
+    deferred_profiling_handler(KernelProfiler& target,
+                               const HIPOCKernel& k,
+                               const std::string& algorithm,
+                               const std::string& network_config)
+    {
+        KernelProfile profile;
+        profile.kernel_name    = k.name;
+        profile.algorithm      = algorithm;
+        profile.network_config = network_config;
+        auto origin            = this->profiling_origin;
+        return [=, &target](hipEvent_t start, hipEvent_t stop) {
+            SharedEventPtr start_ev{start, &hipEventDestroy};
+            SharedEventPtr stop_ev{stop, &hipEventDestroy};
+            auto launched = profile;
+            if(IsTracingEnabled())
+                launched.enqueue_ns = TraceNow();
+            target.Record(launched, [=](KernelProfile& p) {
+                float start_ms = 0;
+                float stop_ms  = 0;
+                hipEventSynchronize(stop_ev.get());
+                hipEventElapsedTime(&start_ms, origin.get(), start_ev.get());
+                hipEventElapsedTime(&stop_ms, origin.get(), stop_ev.get());
+                p.start_ns = static_cast<std::uint64_t>(start_ms * 1e6);
+                p.end_ns   = static_cast<std::uint64_t>(stop_ms * 1e6);
+            });
+        };
+    }
+
+    KernelInvoke invoke(HIPOCKernel& k,
+                        hipStream_t s,
+                        const std::string& algorithm,
+                        const std::string& network_config)
+    {
+        if(this->enable_profiling)
+            return k.Invoke(s, this->elapsed_time_handler());
+        else if(this->deferred_profiling)
+            return k.Invoke(
+                s, this->deferred_profiling_handler(profiler, k, algorithm, network_config), false);
+        else if(IsTracingEnabled())
+        {
+            if(this->profiling_origin == nullptr)
+                this->record_profiling_origin(s);
+            return k.Invoke(
+                s,
+                this->deferred_profiling_handler(trace_profiler, k, algorithm, network_config),
+                false);
+        }
+        else
+            return k.Invoke(s);
+    }
+
+    void record_profiling_origin(hipStream_t s)
+    {
+        auto origin = make_hip_event();
+        hipEventRecord(origin.get(), s);
+        this->profiling_origin = SharedEventPtr{origin.release(), &hipEventDestroy};
+    }
+
     void set_ctx()
     {
         miopen::set_ctx(this->ctx);
@@ -152,12 +221,17 @@ struct HandleImpl
         // TODO: Check device matches
     }
 
-    bool enable_profiling  = false;
-    StreamPtr stream       = nullptr;
-    float profiling_result = 0.0;
-    int device             = -1;
+    bool enable_profiling   = false;
+    bool deferred_profiling = false;
+    StreamPtr stream        = nullptr;
+    float profiling_result  = 0.0;
+    int device              = -1;
     Allocator allocator{};
+    WorkspaceArena workspace;
     KernelCache cache;
+    KernelProfiler profiler;
+    KernelProfiler trace_profiler;
+    SharedEventPtr profiling_origin;
     hipCtx_t ctx;
 };
 
@@ -172,6 +246,8 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
         this->impl->stream = HandleImpl::reference_stream(stream);
 
     this->SetAllocator(nullptr, nullptr, nullptr);
+    this->EnableMemoryPool(miopen::IsEnabled(MIOPEN_MEMORY_POOL{}));
+    this->SetWorkspaceArenaLimit(std::size_t(miopen::Value(MIOPEN_WORKSPACE_ARENA_MB{})) << 20);
 }
 
 Handle::Handle() : impl(new HandleImpl())
@@ -186,9 +262,19 @@ Handle::Handle() : impl(new HandleImpl())
     this->impl->stream = HandleImpl::reference_stream(nullptr);
 #endif
     this->SetAllocator(nullptr, nullptr, nullptr);
+    this->EnableMemoryPool(miopen::IsEnabled(MIOPEN_MEMORY_POOL{}));
+    this->SetWorkspaceArenaLimit(std::size_t(miopen::Value(MIOPEN_WORKSPACE_ARENA_MB{})) << 20);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    if(impl != nullptr && IsTracingEnabled())
+    {
+        this->impl->set_ctx();
+        TraceKernels(this->GetStream(), this->impl->trace_profiler.Collect());
+        FlushTrace();
+    }
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -205,6 +291,38 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
     this->impl->allocator.context = allocatorContext;
+    // Cached buffers belong to the previous allocator
+    const bool pooled          = this->impl->allocator.pool != nullptr;
+    this->impl->allocator.pool = nullptr;
+    this->impl->allocator.EnablePool(pooled);
+}
+
+void Handle::EnableMemoryPool(bool enable) const { this->impl->allocator.EnablePool(enable); }
+
+MemoryPoolStats Handle::GetMemoryPoolStats() const
+{
+    const auto& pool = this->impl->allocator.pool;
+    return pool == nullptr ? MemoryPoolStats{} : pool->GetStats();
+}
+
+void Handle::TrimMemoryPool() const
+{
+    if(this->impl->allocator.pool != nullptr)
+        this->impl->allocator.pool->Trim();
+}
+
+void Handle::SetWorkspaceArenaLimit(std::size_t limit) const
+{
+    this->impl->workspace.SetLimit(limit);
+}
+
+std::size_t Handle::GetWorkspaceArenaLimit() const { return this->impl->workspace.limit; }
+
+std::size_t Handle::GetWorkspaceArenaSize() const { return this->impl->workspace.size; }
+
+Data_t Handle::GetWorkspaceArena(std::size_t sz)
+{
+    return this->impl->workspace.Get(this->impl->allocator, sz);
 }
 
 void Handle::EnableProfiling(bool enable) { this->impl->enable_profiling = enable; }
@@ -252,28 +370,30 @@ KernelInvoke Handle::GetKernel(const std::string& algorithm,
     this->impl->set_ctx();
     auto k = this->impl->cache.GetKernel(
         *this, algorithm, network_config, program_name, kernel_name, vld, vgd, params);
-    if(this->impl->enable_profiling)
-        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
-    else
-        return k.Invoke(this->GetStream());
+    return this->impl->invoke(k, this->GetStream(), algorithm, network_config);
 }
 
 KernelInvoke Handle::GetKernel(const std::string& algorithm, const std::string& network_config)
 {
     this->impl->set_ctx();
     auto k = this->impl->cache.GetKernel(algorithm, network_config);
-    if(this->impl->enable_profiling)
-        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
-    else
-        return k.Invoke(this->GetStream());
+    return this->impl->invoke(k, this->GetStream(), algorithm, network_config);
+}
+
+bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
+{
+    return this->impl->cache.HasKernel(algorithm, network_config);
 }
 
 Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
 {
     this->impl->set_ctx();
     params += " -mcpu=" + this->GetDeviceName();
+    TraceSpan span{"program", "Handle::LoadProgram"};
+    span.Arg("program", program_name).Arg("params", params);
     auto cache_file =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
+    span.Arg("binary_cache", cache_file.empty() ? "miss" : "hit");
     if(cache_file.empty())
     {
         auto p = HIPOCProgram{program_name, params, is_kernel_str};
@@ -315,11 +435,37 @@ void Handle::Finish() const
     if(status != hipSuccess)
         MIOPEN_THROW_HIP_STATUS(status, "Failed hip sychronization");
 #endif
+    // The stream is idle, so draining the traced launches costs nothing here.
+    if(IsTracingEnabled())
+    {
+        TraceKernels(this->GetStream(), this->impl->trace_profiler.Collect());
+        this->impl->trace_profiler.Reset();
+    }
 }
 void Handle::Flush() const {}
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
+void Handle::EnableDeferredProfiling(bool enable)
+{
+    if(enable && !this->impl->deferred_profiling)
+    {
+        this->impl->set_ctx();
+        this->impl->record_profiling_origin(this->GetStream());
+    }
+    this->impl->deferred_profiling = enable;
+}
+
+bool Handle::IsDeferredProfilingEnabled() const { return this->impl->deferred_profiling; }
+
+const std::vector<KernelProfile>& Handle::GetKernelProfiles()
+{
+    this->impl->set_ctx();
+    return this->impl->profiler.Collect();
+}
+
+void Handle::ResetKernelProfiles() { this->impl->profiler.Reset(); }
+
 void Handle::ResetKernelTime() { this->impl->profiling_result = 0.0; }
 void Handle::AccumKernelTime(float curr_time) { this->impl->profiling_result += curr_time; }
 
@@ -27,6 +27,7 @@
 #include <chrono>
 #include <miopen/errors.hpp>
 #include <miopen/hipoc_kernel.hpp>
+#include <miopen/trace.hpp>
 #include <thread>
 #include <hip/hip_hcc.h>
 
@@ -55,6 +56,9 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
     }
 
     // std::cerr << "Launch kernel: " << name << std::endl;
+    TraceSpan span{"enqueue"};
+    if(span.IsActive())
+        span.SetName(name);
 
     auto status = hipHccModuleLaunchKernel(fun,
                                            gdims[0],
@@ -72,7 +76,11 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
     if(status != hipSuccess)
         MIOPEN_THROW_HIP_STATUS(status, "Failed to launch kernel");
 
-    if(callback)
+    if(callback && !blocking_callback)
+    {
+        callback(start.release(), stop.release());
+    }
+    else if(callback)
     {
 #if 0
         auto start_time = std::chrono::system_clock::now();
@@ -93,8 +101,9 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 }
 
 HIPOCKernelInvoke HIPOCKernel::Invoke(hipStream_t stream,
-                                      std::function<void(hipEvent_t, hipEvent_t)> callback)
+                                      std::function<void(hipEvent_t, hipEvent_t)> callback,
+                                      bool blocking_callback)
 {
-    return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, callback};
+    return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, callback, blocking_callback};
 }
 } // namespace miopen
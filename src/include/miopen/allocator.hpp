@@ -6,7 +6,9 @@
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/manage_ptr.hpp>
+#include <miopen/memory_pool.hpp>
 #include <miopen/miopen.h>
+#include <memory>
 
 namespace miopen {
 
@@ -14,12 +16,23 @@ struct AllocatorDeleter
 {
     miopenDeallocatorFunction deallocator;
     void* context;
+    // Buffers from a pool go back to it, which keeps the pool alive
+    std::shared_ptr<MemoryPool> pool = nullptr;
+    std::size_t size                 = 0;
 
     template <class T>
     void operator()(T* x) const
     {
         assert(deallocator != nullptr);
-        if(x != nullptr)
+        if(x == nullptr)
+        {
+            return;
+        }
+        if(pool != nullptr)
+        {
+            pool->Release(x, size);
+        }
+        else
         {
             deallocator(context, x);
         }
@@ -30,14 +43,30 @@ struct Allocator
     miopenAllocatorFunction allocator;
     miopenDeallocatorFunction deallocator;
     void* context;
+    std::shared_ptr<MemoryPool> pool = nullptr;
 
     using ManageDataPtr =
         std::unique_ptr<typename std::remove_pointer<Data_t>::type, AllocatorDeleter>;
 
+    /// Enabling keeps an existing pool, disabling drops it and its cached
+    /// buffers are freed once the buffers still in use have been released.
+    void EnablePool(bool enable)
+    {
+        if(!enable)
+            pool = nullptr;
+        else if(pool == nullptr)
+            pool = std::make_shared<MemoryPool>(allocator, deallocator, context);
+    }
+
     ManageDataPtr operator()(std::size_t n) const
     {
         assert(allocator != nullptr);
         assert(deallocator != nullptr);
+        if(pool != nullptr && n != 0)
+        {
+            return ManageDataPtr{DataCast(pool->Acquire(n)),
+                                 AllocatorDeleter{deallocator, context, pool, n}};
+        }
         auto result = allocator(context, n);
         if(result == nullptr && n != 0)
         {
@@ -48,6 +77,41 @@ struct Allocator
     }
 };
 
+/// A workspace owned by the handle which only grows, up to a limit, so that
+/// callers can leave the scratch memory of an operation to the library.
+struct WorkspaceArena
+{
+    std::size_t limit               = 0;
+    std::size_t size                = 0;
+    Allocator::ManageDataPtr buffer = nullptr;
+
+    void SetLimit(std::size_t plimit)
+    {
+        limit = plimit;
+        if(size > limit)
+        {
+            buffer = nullptr;
+            size   = 0;
+        }
+    }
+
+    /// Returns nullptr when sz is over the limit.
+    Data_t Get(const Allocator& allocator, std::size_t sz)
+    {
+        if(sz == 0 || sz > limit)
+            return nullptr;
+        if(sz > size)
+        {
+            // Free the old buffer first so both never have to fit at once
+            buffer = nullptr;
+            size   = 0;
+            buffer = allocator(sz);
+            size   = sz;
+        }
+        return buffer.get();
+    }
+};
+
 } // namespace miopen
 
 #endif
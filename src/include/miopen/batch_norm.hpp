@@ -28,6 +28,7 @@
 
 #include <chrono>
 #include <cmath>
+#include <miopen/activ.hpp>
 #include <miopen/common.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/miopen.h>
@@ -45,6 +46,11 @@ void DeriveBNTensorDescriptor(TensorDescriptor& derivedBnDesc,
                               const TensorDescriptor& xDesc,
                               miopenBatchNormMode_t bn_mode);
 
+// The forward kernels blend the normalized output into y as alpha * y_hat + beta * y, with alpha
+// and beta passed as kernel arguments. Only whether y is read goes into the program key:
+// MIO_BN_BLEND_Y is defined for a non-zero beta, otherwise the result is empty.
+std::string bnBlendKernelParams(const void* beta);
+
 void bnBwdTrainSelectSingle(Handle& handle,
                             std::string& program_name,
                             std::string& algo_name,
@@ -97,6 +103,8 @@ void bnFwdTrainSelectSingle(Handle& handle,
                             Data_t y,
                             ConstData_t bnScale,
                             ConstData_t bnBias,
+                            float alpha,
+                            float beta,
                             bool resultsave,
                             bool resultrunning,
                             double expAvgFactor,
@@ -119,6 +127,8 @@ void bnFwdTrainSelectMulti(Handle& handle,
                            Data_t y,
                            ConstData_t bnScale,
                            ConstData_t bnBias,
+                           float alpha,
+                           float beta,
                            bool resultsave,
                            bool resultrunning,
                            double expAvgFactor,
@@ -129,6 +139,51 @@ void bnFwdTrainSelectMulti(Handle& handle,
                            Data_t resultSaveInvVariance,
                            float inhw);
 
+// Spatial kernels that take the tensor shape as arguments, so a single program per option set
+// serves every batch size and resolution. By default a shape runs the generic kernels on its first
+// call and the shape specialized ones from its second call on. MIOPEN_BN_SPECIALIZE overrides this
+// with a list of shapes to specialize (comma separated NxCxHxW), or "all".
+bool bnUseGenericKernels(miopenBatchNormMode_t bn_mode, int n, int c, int h, int w);
+
+void bnFwdTrainSpatialGeneric(Handle& handle,
+                              const void* alpha,
+                              const void* beta,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              Data_t y,
+                              ConstData_t bnScale,
+                              ConstData_t bnBias,
+                              double expAvgFactor,
+                              Data_t resultRunningMean,
+                              Data_t resultRunningVariance,
+                              double epsilon,
+                              Data_t resultSaveMean,
+                              Data_t resultSaveInvVariance);
+
+void bnFwdInferSpatialGeneric(Handle& handle,
+                              const void* alpha,
+                              const void* beta,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              Data_t y,
+                              ConstData_t bnScale,
+                              ConstData_t bnBias,
+                              ConstData_t estimatedMean,
+                              ConstData_t estimatedVariance,
+                              double epsilon);
+
+void bnBwdSpatialGeneric(Handle& handle,
+                         const TensorDescriptor& xDesc,
+                         ConstData_t x,
+                         ConstData_t dy,
+                         Data_t dx,
+                         ConstData_t bnScale,
+                         Data_t dScale,
+                         Data_t dBias,
+                         double epsilon,
+                         ConstData_t savedMean,
+                         ConstData_t savedInvVariance);
+
 void profileSequence(Handle& handle, unsigned char select);
 
 void BatchNormForwardInference(Handle& handle,
@@ -146,6 +201,24 @@ void BatchNormForwardInference(Handle& handle,
                                ConstData_t estimatedVariance,
                                double epsilon);
 
+/// Forward inference followed by the activation described by activDesc, in a
+/// single pass over x. Requires the estimated mean and variance.
+void BatchNormActivForwardInference(Handle& handle,
+                                    miopenBatchNormMode_t bn_mode,
+                                    const void* alpha,
+                                    const void* beta,
+                                    const TensorDescriptor& xDesc,
+                                    ConstData_t x,
+                                    const TensorDescriptor& yDesc,
+                                    Data_t y,
+                                    const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                    ConstData_t bnScale,
+                                    ConstData_t bnBias,
+                                    ConstData_t estimatedMean,
+                                    ConstData_t estimatedVariance,
+                                    double epsilon,
+                                    const ActivationDescriptor& activDesc);
+
 void BatchNormForwardTraining(Handle& handle,
                               miopenBatchNormMode_t bn_mode,
                               const void* alpha, /* these don't seem to be used in conv */
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONV_BIAS_ACTIV_PLAN_HPP_
+#define GUARD_MIOPEN_CONV_BIAS_ACTIV_PLAN_HPP_
+
+#include <miopen/activ.hpp>
+#include <miopen/common.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/convolution_plan.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+/// A forward convolution followed by a per-channel bias add and an activation.
+///
+/// When the direct solver picks MIOpenConvDirUni.cl and the activation is
+/// logistic, tanh or ReLU, the bias and the activation are compiled into the
+/// epilogue of the convolution kernel and the output is written once.
+/// Otherwise the convolution runs through a ConvolutionPlan and is followed by
+/// a single bias+activation pass over the output (MIOpenBiasActiv.cl).
+struct ConvBiasActivPlan : miopenConvBiasActivPlan
+{
+    ConvBiasActivPlan(Handle& handle,
+                      const ConvolutionDescriptor& conv,
+                      const TensorDescriptor& xDesc,
+                      const TensorDescriptor& wDesc,
+                      const TensorDescriptor& bDesc,
+                      const ActivationDescriptor& activ,
+                      const TensorDescriptor& yDesc,
+                      miopenConvFwdAlgorithm_t algo);
+
+    void Execute(Handle& handle,
+                 ConstData_t x,
+                 ConstData_t w,
+                 ConstData_t b,
+                 Data_t y,
+                 Data_t workSpace,
+                 size_t workSpaceSize);
+
+    std::size_t GetWorkSpaceSize() const
+    {
+        return conv_plan == nullptr ? 0 : conv_plan->GetWorkSpaceSize();
+    }
+    /// True if bias and activation are applied by the convolution kernel itself.
+    bool IsEpilogueFused() const { return conv_plan == nullptr; }
+
+    friend std::ostream& operator<<(std::ostream& stream, const ConvBiasActivPlan& p);
+
+    private:
+    bool ResolveEpilogue(Handle& handle);
+    void ResolveBiasActiv(Handle& handle);
+
+    ConvolutionDescriptor conv;
+    TensorDescriptor xDesc;
+    TensorDescriptor wDesc;
+    TensorDescriptor yDesc;
+    ActivationDescriptor activ;
+    int algo;
+
+    std::unique_ptr<ConvolutionPlan> conv_plan;
+    std::string network_config;
+};
+
+} // namespace miopen
+MIOPEN_DEFINE_OBJECT(miopenConvBiasActivPlan, miopen::ConvBiasActivPlan);
+
+#endif // GUARD_MIOPEN_CONV_BIAS_ACTIV_PLAN_HPP_
@@ -145,6 +145,15 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                               size_t workSpaceSize,
                               bool timed = false) const;
 
+    float ExecuteFwdGemmHalf(Handle& handle,
+                             const TensorDescriptor& xDesc,
+                             ConstData_t x,
+                             const TensorDescriptor& wDesc,
+                             ConstData_t w,
+                             const TensorDescriptor& yDesc,
+                             Data_t y,
+                             Data_t workSpace) const;
+
     int FindBwdFFTKernel(Handle& handle,
                          const TensorDescriptor& dyDesc,
                          const TensorDescriptor& wDesc,
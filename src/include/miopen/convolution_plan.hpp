@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONVOLUTION_PLAN_HPP_
+#define GUARD_MIOPEN_CONVOLUTION_PLAN_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+
+#include <iosfwd>
+#include <vector>
+
+namespace miopen {
+
+/// A convolution bound to a fixed problem and algorithm.
+///
+/// All the work ConvolutionForward()/ConvolutionBackwardData() repeat on every
+/// call (building the mlo_construct_* object, serializing the network config,
+/// looking the kernels up by name and querying the compiled-in Winograd
+/// parameters) is done once at construction. Execute() then only sets the
+/// kernel arguments and enqueues. Algorithms that are not resolved here
+/// (GEMM, FFT and transpose convolutions) are forwarded to the descriptor.
+///
+/// The resolved kernels are bound to the stream and profiling state of the
+/// handle; they are re-resolved if either changes between calls.
+struct ConvolutionPlan : miopenConvolutionPlan
+{
+    ConvolutionPlan(Handle& handle,
+                    const ConvolutionDescriptor& conv,
+                    const TensorDescriptor& xDesc,
+                    const TensorDescriptor& wDesc,
+                    const TensorDescriptor& yDesc,
+                    miopenConvFwdAlgorithm_t algo);
+
+    ConvolutionPlan(Handle& handle,
+                    const ConvolutionDescriptor& conv,
+                    const TensorDescriptor& dyDesc,
+                    const TensorDescriptor& wDesc,
+                    const TensorDescriptor& dxDesc,
+                    miopenConvBwdDataAlgorithm_t algo);
+
+    /// \param in  x for forward plans, dy for backward data plans.
+    /// \param out y for forward plans, dx for backward data plans.
+    void Execute(Handle& handle,
+                 ConstData_t in,
+                 ConstData_t w,
+                 Data_t out,
+                 Data_t workSpace,
+                 size_t workSpaceSize);
+
+    std::size_t GetWorkSpaceSize() const { return workspace_size; }
+    bool IsForward() const { return direction == 1; }
+    bool IsResolved() const { return resolvable; }
+
+    friend std::ostream& operator<<(std::ostream& stream, const ConvolutionPlan& p);
+
+    private:
+    void Resolve(Handle& handle);
+    void ExecuteUnresolved(Handle& handle,
+                           ConstData_t in,
+                           ConstData_t w,
+                           Data_t out,
+                           Data_t workSpace,
+                           size_t workSpaceSize) const;
+
+    ConvolutionDescriptor conv;
+    TensorDescriptor inDesc;
+    TensorDescriptor wDesc;
+    TensorDescriptor outDesc;
+    int direction;
+    int algo;
+    std::size_t workspace_size = 0;
+
+    std::vector<KernelInvoke> kernels;
+    miopenAcceleratorQueue_t bound_stream = nullptr;
+    bool bound_profiling                  = false;
+    bool bound_deferred_profiling         = false;
+    bool resolvable                       = false;
+    bool is_winograd                      = false;
+    WinogradKernelParams winograd_params;
+};
+
+} // namespace miopen
+MIOPEN_DEFINE_OBJECT(miopenConvolutionPlan, miopen::ConvolutionPlan);
+
+#endif // GUARD_MIOPEN_CONVOLUTION_PLAN_HPP_
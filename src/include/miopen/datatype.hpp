@@ -26,6 +26,8 @@
 #ifndef GUARD_MIOPEN_DATATYPE_HPP
 #define GUARD_MIOPEN_DATATYPE_HPP
 
+#include <cstddef>
+#include <miopen/miopen.h>
 #include <string>
 
 namespace miopen {
@@ -45,6 +47,29 @@ std::string inline GetDataType(miopenDataType_t type)
     return type_str;
 }
 
+std::size_t inline GetTypeSize(miopenDataType_t type)
+{
+    std::size_t type_size = 0;
+    switch(type)
+    {
+    case miopenHalf: type_size  = 2; break;
+    case miopenFloat: type_size = 4; break;
+    }
+    return type_size;
+}
+
+/// Type name used by the mlo problem descriptions and their network configs.
+std::string inline GetMloDataType(miopenDataType_t type)
+{
+    return type == miopenHalf ? "FP16" : "FP32";
+}
+
+/// Selects the storage type of the kernels, which still compute in float.
+std::string inline GetDataTypeKernelParams(miopenDataType_t type)
+{
+    return type == miopenHalf ? " -DMIOPEN_USE_FP16=1" : " -DMIOPEN_USE_FP32=1";
+}
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_DATATYPE_HPP
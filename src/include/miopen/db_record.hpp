@@ -28,11 +28,15 @@
 
 #include <miopen/config.h>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 
 #include <sstream>
 #include <string>
 #include <atomic>
+#include <functional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <iostream>
 
 namespace miopen {
@@ -138,6 +142,8 @@ class DbRecord
 #endif
     bool Flush(const RecordPositions* pos);
     void ReadFile(RecordPositions* pos);
+    std::vector<std::pair<std::string, std::string>>
+    FindNearest(const std::string& id, const std::function<double(const std::string&)>& distance);
 
 #if MIOPEN_PERFDB_CONV_LEGACY_SUPPORT
     DbRecord(const std::string& db_filename_,
@@ -182,6 +188,8 @@ class DbRecord
     template <class T>
     bool Store(const std::string& id, const T& values)
     {
+        TraceSpan span{"perfdb", "DbRecord::Store"};
+        span.Arg("key", key).Arg("id", id);
         RecordPositions pos;
         // If there is a record with the same key, we need to load its content
         // (otherwise existing content will be lost) and find out its positions.
@@ -215,6 +223,8 @@ class DbRecord
     template <class T>
     bool Load(const std::string& id, T& values)
     {
+        TraceSpan span{"perfdb", "DbRecord::Load"};
+        span.Arg("key", key).Arg("id", id);
         std::string s;
         ReadFile(nullptr);
 #if MIOPEN_PERFDB_CONV_LEGACY_SUPPORT
@@ -244,6 +254,40 @@ class DbRecord
         }
         return ok;
     }
+
+    /// Loads VALUES associated with ID under the KEY nearest to the current one.
+    ///
+    /// distance(KEY) measures how far a KEY is from the current one and returns
+    /// a negative value for KEYs that shall not be considered. Records are tried
+    /// in the order of increasing distance until accept(values) returns true.
+    /// The KEY of the record used is written to found_key.
+    /// Records in legacy format are ignored.
+    template <class T, class Distance, class Accept>
+    bool LoadNearest(
+        const std::string& id, T& values, Distance distance, Accept accept, std::string& found_key)
+    {
+        TraceSpan span{"perfdb", "DbRecord::LoadNearest"};
+        span.Arg("key", key).Arg("id", id);
+        for(auto&& candidate : FindNearest(id, distance))
+        {
+            T candidate_values{};
+            if(!candidate_values.Deserialize(candidate.second))
+            {
+                MIOPEN_LOG(LoggingLevel::Error, "deserialize failed: " << candidate.second);
+                continue;
+            }
+            if(!accept(candidate_values))
+            {
+                MIOPEN_LOG_I("Nearest record rejected: " << candidate.first << '=' << id << ':'
+                                                         << candidate.second);
+                continue;
+            }
+            values    = candidate_values;
+            found_key = candidate.first;
+            return true;
+        }
+        return false;
+    }
 };
 } // namespace miopen
 
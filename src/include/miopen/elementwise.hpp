@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_ELEMENTWISE_HPP_
+#define GUARD_MIOPEN_ELEMENTWISE_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+enum class ElementwiseOp
+{
+    Input,
+    Constant,
+    // Unary
+    Neg,
+    Abs,
+    Exp,
+    Log,
+    Sqrt,
+    Tanh,
+    Sigmoid,
+    Relu,
+    // Binary
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Min,
+    Max,
+};
+
+struct ElementwiseInput
+{
+    const TensorDescriptor& desc;
+    ConstData_t data;
+    size_t offset;
+};
+
+/// A small DAG of unary and binary operations over up to MaxInputs tensors
+/// which is compiled into a single kernel and evaluated in one pass. Nodes are
+/// appended in topological order and the last node is the result. Inputs
+/// broadcast like OpTensor: each of their dims is either 1 or equal to the
+/// output dim. One kernel is built per signature, i.e. per DAG, broadcast
+/// pattern and data type; lengths and constant values are kernel arguments.
+struct ElementwiseExpression
+{
+    static constexpr int MaxInputs    = 4;
+    static constexpr int MaxConstants = 4;
+    static constexpr int MaxDims      = 5;
+
+    using Node = int;
+
+    Node Input(int index);
+    Node Constant(float value);
+    Node Unary(ElementwiseOp op, Node a);
+    Node Binary(ElementwiseOp op, Node a, Node b);
+
+    int GetInputCount() const;
+
+    void Run(Handle& handle,
+             const std::vector<ElementwiseInput>& inputs,
+             const TensorDescriptor& yDesc,
+             Data_t y,
+             size_t yOffset = 0) const;
+
+    // Identifies the generated kernel: data type, input broadcasts and the node
+    // list. Run uses it as the kernel cache network config.
+    std::string Signature(const std::vector<ElementwiseInput>& inputs,
+                          const TensorDescriptor& yDesc) const;
+
+    private:
+    struct NodeInfo
+    {
+        ElementwiseOp op;
+        int a;
+        int b;
+    };
+
+    Node Append(ElementwiseOp op, int a, int b);
+    std::string GenerateSource(const std::vector<unsigned int>& bitmaps, int dims) const;
+
+    std::vector<NodeInfo> nodes;
+    std::vector<float> constants;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_ELEMENTWISE_HPP_
@@ -28,6 +28,7 @@
 
 #include <exception>
 #include <iostream>
+#include <miopen/metrics.hpp>
 #include <miopen/miopen.h>
 #include <miopen/object.hpp>
 #include <miopen/returns.hpp>
@@ -88,6 +89,17 @@ miopenStatus_t try_(F f)
     return miopenStatusSuccess;
 }
 
+// Public entry points pass their name so that they are counted and timed
+// while metrics are enabled.
+template <class F>
+miopenStatus_t try_(const char* api, F f)
+{
+    if(!IsMetricsEnabled())
+        return try_(f);
+    ApiCallMetrics metrics{api};
+    return metrics.Finish(try_(f));
+}
+
 template <class T>
 auto deref(T& x, miopenStatus_t err = miopenStatusBadParm)
     -> decltype((x == nullptr), get_object(*x))
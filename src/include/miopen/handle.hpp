@@ -31,6 +31,7 @@
 #include <memory>
 #include <miopen/common.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/kernel_profiler.hpp>
 #include <miopen/miopen.h>
 #include <miopen/object.hpp>
 #include <miopen/allocator.hpp>
@@ -55,6 +56,33 @@ struct Handle : miopenHandle
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
 
+    // Opt-in caching of released buffers, see MemoryPool
+    void EnableMemoryPool(bool enable = true) const;
+    MemoryPoolStats GetMemoryPoolStats() const;
+    void TrimMemoryPool() const;
+
+    // Handle owned workspace, see miopenSetWorkspaceArenaLimit
+    void SetWorkspaceArenaLimit(std::size_t limit) const;
+    std::size_t GetWorkspaceArenaLimit() const;
+    std::size_t GetWorkspaceArenaSize() const;
+    Data_t GetWorkspaceArena(std::size_t sz);
+
+    /// Substitutes the arena when the caller passed no workspace. The
+    /// required size is only computed when the arena is used.
+    template <class F>
+    void UseWorkspaceArena(Data_t& workSpace, std::size_t& workSpaceSize, F get_required)
+    {
+        if(workSpace != nullptr || this->GetWorkspaceArenaLimit() == 0)
+            return;
+        const std::size_t required = get_required();
+        auto arena                 = this->GetWorkspaceArena(required);
+        if(arena != nullptr)
+        {
+            workSpace     = arena;
+            workSpaceSize = required;
+        }
+    }
+
     void EnableProfiling(bool enable = true);
 
     void ResetKernelTime();
@@ -63,6 +91,13 @@ struct Handle : miopenHandle
     float GetKernelTime() const;
     bool IsProfilingEnabled() const;
 
+    // Deferred profiling records every launch without synchronizing. The
+    // synchronous mode above takes precedence while both are enabled.
+    void EnableDeferredProfiling(bool enable = true);
+    bool IsDeferredProfilingEnabled() const;
+    const std::vector<KernelProfile>& GetKernelProfiles();
+    void ResetKernelProfiles();
+
     KernelInvoke GetKernel(const std::string& algorithm,
                            const std::string& network_config,
                            const std::string& program_name,
@@ -73,6 +108,10 @@ struct Handle : miopenHandle
 
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config);
 
+    // True when a kernel was already built under this algorithm and network config,
+    // so the two-argument GetKernel can be used without regenerating its source.
+    bool HasKernel(const std::string& algorithm, const std::string& network_config) const;
+
     Program LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str);
 
     void Finish() const;
@@ -126,6 +126,9 @@ struct HIPOCKernelInvoke
     std::array<size_t, 3> gdims = {};
     std::string name;
     std::function<void(hipEvent_t, hipEvent_t)> callback;
+    // When false the callback runs right after the launch and takes ownership
+    // of both events.
+    bool blocking_callback = true;
 
     // Workaround for aggregate types in c++11
     HIPOCKernelInvoke() {}
@@ -134,8 +137,15 @@ struct HIPOCKernelInvoke
                       std::array<size_t, 3> pldims,
                       std::array<size_t, 3> pgdims,
                       std::string pname,
-                      std::function<void(hipEvent_t, hipEvent_t)> pcallback)
-        : stream(pstream), fun(pfun), ldims(pldims), gdims(pgdims), name(pname), callback(pcallback)
+                      std::function<void(hipEvent_t, hipEvent_t)> pcallback,
+                      bool pblocking_callback = true)
+        : stream(pstream),
+          fun(pfun),
+          ldims(pldims),
+          gdims(pgdims),
+          name(pname),
+          callback(pcallback),
+          blocking_callback(pblocking_callback)
     {
     }
 
@@ -181,7 +191,8 @@ struct HIPOCKernel
     }
 
     HIPOCKernelInvoke Invoke(hipStream_t stream,
-                             std::function<void(hipEvent_t, hipEvent_t)> callback = nullptr);
+                             std::function<void(hipEvent_t, hipEvent_t)> callback = nullptr,
+                             bool blocking_callback                               = true);
 };
 
 } // namespace miopen
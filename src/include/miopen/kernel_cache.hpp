@@ -83,6 +83,8 @@ class KernelCache
 
     Kernel GetKernel(const std::string& algorithm, const std::string& network_config);
 
+    bool HasKernel(const std::string& algorithm, const std::string& network_config) const;
+
     KernelCache();
 
     private:
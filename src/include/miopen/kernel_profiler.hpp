@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_PROFILER_HPP
+#define GUARD_MIOPEN_KERNEL_PROFILER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct KernelProfile
+{
+    std::string kernel_name;
+    std::string algorithm;
+    std::string network_config;
+    std::uint64_t start_ns   = 0;
+    std::uint64_t end_ns     = 0;
+    std::uint64_t enqueue_ns = 0; // Trace clock at launch, only set while tracing.
+
+    float GetTime() const { return (end_ns - start_ns) * 1e-6f; }
+};
+
+/**
+ * @brief Records kernel launches without waiting for them to complete.
+ *
+ * Each record carries a resolver that owns the backend events and fills in
+ * the timestamps. Resolvers only run when the records are collected, so the
+ * queue is never drained at launch time. Once the capacity is reached the
+ * oldest records are dropped.
+ */
+class KernelProfiler
+{
+    public:
+    using Resolver = std::function<void(KernelProfile&)>;
+
+    KernelProfiler(std::size_t pcapacity = 0);
+
+    void Record(KernelProfile profile, Resolver resolve);
+
+    /// Waits for the pending launches and returns every record in launch order.
+    const std::vector<KernelProfile>& Collect();
+
+    void Reset();
+
+    std::size_t GetCapacity() const { return capacity; }
+    std::size_t GetDropped() const { return dropped; }
+
+    private:
+    struct Entry
+    {
+        KernelProfile profile;
+        Resolver resolve;
+    };
+
+    std::size_t capacity;
+    std::size_t dropped = 0;
+    std::deque<Entry> entries;
+    std::vector<KernelProfile> collected;
+};
+
+} // namespace miopen
+
+#endif
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MEMORY_POOL_HPP
+#define GUARD_MIOPEN_MEMORY_POOL_HPP
+
+#include <miopen/miopen.h>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace miopen {
+
+struct MemoryPoolStats
+{
+    std::size_t bytes_in_use    = 0;
+    std::size_t bytes_cached    = 0;
+    std::size_t high_water_mark = 0;
+    std::size_t allocations     = 0;
+    std::size_t reuses          = 0;
+};
+
+/**
+ * @brief Caches released device buffers for reuse.
+ *
+ * Requests are rounded up to a size class and served from the buffers
+ * released in that class before falling back to the allocator. Reuse needs no
+ * synchronization as all work of a handle is ordered on its queue. Cached
+ * buffers are only freed by Trim, when an allocation fails or when the pool is
+ * destroyed, which happens once the handle drops it and every buffer handed
+ * out has been released.
+ */
+class MemoryPool
+{
+    public:
+    MemoryPool(miopenAllocatorFunction pallocator,
+               miopenDeallocatorFunction pdeallocator,
+               void* pcontext);
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+    ~MemoryPool();
+
+    /// Returns a buffer of at least GetSizeClass(n) bytes.
+    void* Acquire(std::size_t n);
+    /// Gives back a buffer returned by Acquire(n).
+    void Release(void* buffer, std::size_t n);
+    /// Frees every cached buffer.
+    void Trim();
+
+    MemoryPoolStats GetStats() const;
+
+    /// Four classes per power of two bounds the padding to a quarter.
+    static std::size_t GetSizeClass(std::size_t n);
+
+    private:
+    void TrimLocked();
+
+    miopenAllocatorFunction allocator;
+    miopenDeallocatorFunction deallocator;
+    void* context;
+
+    mutable std::mutex mutex;
+    std::map<std::size_t, std::vector<void*>> cached;
+    MemoryPoolStats stats;
+};
+
+} // namespace miopen
+
+#endif
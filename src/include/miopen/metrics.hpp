@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_METRICS_HPP
+#define GUARD_MIOPEN_METRICS_HPP
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <miopen/miopen.h>
+#include <vector>
+
+namespace miopen {
+
+/// Library-wide metrics for production monitoring.
+///
+/// Collection is off unless MIOPEN_METRICS is set or miopenEnableMetrics is
+/// called; while off every hook costs a single atomic load. When
+/// MIOPEN_METRICS_DUMP_INTERVAL is set to a number of seconds, a summary is
+/// written to stderr at most that often (checked when an API call returns)
+/// and once more at exit.
+
+enum class MetricsCounter
+{
+    KernelCacheHit,
+    KernelCacheMiss,
+    BinaryCacheHit,
+    BinaryCacheMiss,
+    PerfDbHit,
+    PerfDbMiss,
+    Count
+};
+
+struct ApiMetrics
+{
+    static constexpr std::size_t HistogramBuckets = MIOPEN_METRICS_HISTOGRAM_BUCKETS;
+
+    const char* name   = nullptr;
+    std::size_t calls  = 0;
+    std::size_t errors = 0;
+    double host_us     = 0;
+    double max_host_us = 0;
+    double device_us   = 0;
+    std::array<std::size_t, HistogramBuckets> host_histogram{};
+
+    /// Bucket i counts calls in [2^i, 2^(i+1)) us, the first and last
+    /// buckets also take everything below and above.
+    static std::size_t GetBucket(double us);
+};
+
+using CacheMetrics = std::array<std::size_t, static_cast<std::size_t>(MetricsCounter::Count)>;
+
+bool IsMetricsEnabled();
+void EnableMetrics(bool enable = true);
+
+void IncrementMetric(MetricsCounter counter);
+
+/// Adds kernel time to the API call in progress on this thread. Only the
+/// synchronous profiling mode reports device time, as anything else would
+/// have to wait for the kernels.
+void RecordDeviceTime(float ms);
+
+/// Entry points sorted by name.
+std::vector<ApiMetrics> GetApiMetrics();
+CacheMetrics GetCacheMetrics();
+void ResetMetrics();
+void DumpMetrics(std::ostream& os);
+
+/// Measures one public API call, see try_.
+class ApiCallMetrics
+{
+    public:
+    ApiCallMetrics(const char* pname);
+    ApiCallMetrics(const ApiCallMetrics&) = delete;
+    ApiCallMetrics& operator=(const ApiCallMetrics&) = delete;
+    ~ApiCallMetrics();
+
+    miopenStatus_t Finish(miopenStatus_t status);
+    void AddDeviceTime(float ms) { device_ms += ms; }
+
+    private:
+    const char* name;
+    double start_us;
+    double device_ms = 0;
+    ApiCallMetrics* previous;
+};
+
+} // namespace miopen
+
+#endif
@@ -218,6 +218,17 @@ struct ProblemDescription
                      : direction.IsBackwardData() ? "B" : "W"); // clang-format on
     }
 
+    /// Reads the fields written by Serialize() back.
+    /// Returns false and leaves the object unchanged if the key is ill-formed.
+    bool ParseKey(const std::string& key);
+
+    /// How far the other problem is from this one, for reusing tuning results between
+    /// similar problems. Sizes are compared by ratio, so that being off by a few pixels
+    /// matters less for large images. Negative if the problems differ in a field that
+    /// changes the nature of the convolution (filter, stride, dilation, layout, type,
+    /// direction or bias).
+    double Distance(const ProblemDescription& other) const;
+
 #if MIOPEN_PERFDB_CONV_LEGACY_SUPPORT
     void LegacySerialize(std::ostream& stream) const
     {
@@ -279,6 +290,8 @@ struct ConvolutionContext : ProblemDescription
     int in_batch_stride    = 0;
     int out_channel_stride = 0;
     int out_batch_stride   = 0;
+    int in_pix_stride      = 1;
+    int out_pix_stride     = 1;
     int n_timer_iter       = 0;
     rocm_meta_version rmv  = rocm_meta_version::Default;
     std::string general_compile_options;
@@ -549,16 +562,16 @@ struct mlo_construct_direct2D
                                 int height,
                                 int width,
                                 int batch_stride,
-                                int channel_stride,
-                                int stride,
-                                int w_stride)
+                                int /*channel_stride*/,
+                                int /*stride*/,
+                                int /*w_stride*/)
     {
         _search_params.kernel_size0 = width;
         _search_params.kernel_size1 = height;
-        int data_len                = (data_type == "FP32" ? 4 : 8);
+        int data_len                = (data_type == "FP16" ? 2 : data_type == "FP32" ? 4 : 8);
         size_t size                 = (layout == "NCHW")
                           ? batch * depth * height * width * data_len
-                          : batch * batch_stride * channel_stride * stride * w_stride * data_len;
+                          : batch * batch_stride * data_len;
         _search_params.weights_sz = size;
     }
 
@@ -577,10 +590,10 @@ struct mlo_construct_direct2D
                                int w_stride)
     {
         _search_params.batch_sz = batch;
-        int data_len            = (data_type == "FP32" ? 4 : 8);
+        int data_len            = (data_type == "FP16" ? 2 : data_type == "FP32" ? 4 : 8);
         size_t size             = (layout == "NCHW")
                           ? batch * depth * height * width * data_len
-                          : batch * batch_stride * channel_stride * stride * w_stride * data_len;
+                          : batch * batch_stride * data_len;
         if(_search_params.direction.IsForward())
         {
 
@@ -590,6 +603,7 @@ struct mlo_construct_direct2D
             _search_params.out_batch_stride   = batch_stride;
             _search_params.out_channel_stride = channel_stride;
             _search_params.out_stride         = stride;
+            _search_params.out_pix_stride     = w_stride;
             _search_params.top_sz             = size;
             _search_params.out_layout         = layout;
             _search_params.out_data_type      = data_type;
@@ -602,6 +616,7 @@ struct mlo_construct_direct2D
             _search_params.in_batch_stride   = batch_stride;
             _search_params.in_channel_stride = channel_stride;
             _search_params.in_stride         = stride;
+            _search_params.in_pix_stride     = w_stride;
             _search_params.bot_sz            = size;
             _search_params.in_layout         = layout;
             _search_params.in_data_type      = data_type;
@@ -626,10 +641,10 @@ struct mlo_construct_direct2D
                               int w_stride)
     {
         _search_params.batch_sz = batch;
-        int data_len            = (data_type == "FP32" ? 4 : 8);
+        int data_len            = (data_type == "FP16" ? 2 : data_type == "FP32" ? 4 : 8);
         size_t size             = (layout == "NCHW")
                           ? batch * depth * height * width * data_len
-                          : batch * batch_stride * channel_stride * stride * w_stride * data_len;
+                          : batch * batch_stride * data_len;
         if(_search_params.direction.IsForward())
         {
 
@@ -639,6 +654,7 @@ struct mlo_construct_direct2D
             _search_params.in_batch_stride   = batch_stride;
             _search_params.in_channel_stride = channel_stride;
             _search_params.in_stride         = stride;
+            _search_params.in_pix_stride     = w_stride;
             _search_params.bot_sz            = size;
             _search_params.in_layout         = layout;
             _search_params.in_data_type      = data_type;
@@ -653,6 +669,7 @@ struct mlo_construct_direct2D
             _search_params.out_batch_stride   = batch_stride;
             _search_params.out_channel_stride = channel_stride;
             _search_params.out_stride         = stride;
+            _search_params.out_pix_stride     = w_stride;
             _search_params.top_sz             = size;
             _search_params.out_layout         = layout;
             _search_params.out_data_type      = data_type;
@@ -676,10 +693,10 @@ struct mlo_construct_direct2D
                      int w_stride)
     {
         _search_params.batch_sz = batch;
-        int data_len            = (data_type == "FP32" ? 4 : 8);
+        int data_len            = (data_type == "FP16" ? 2 : data_type == "FP32" ? 4 : 8);
         size_t size             = (layout == "NCHW")
                           ? batch * depth * height * width * data_len
-                          : batch * batch_stride * channel_stride * stride * w_stride * data_len;
+                          : batch * batch_stride * data_len;
 
         _search_params.out_width          = width;
         _search_params.out_height         = height;
@@ -687,6 +704,7 @@ struct mlo_construct_direct2D
         _search_params.out_batch_stride   = batch_stride;
         _search_params.out_channel_stride = channel_stride;
         _search_params.out_stride         = stride;
+        _search_params.out_pix_stride     = w_stride;
         _search_params.top_sz             = size;
         _search_params.out_layout         = layout;
         _search_params.out_data_type      = data_type;
@@ -709,10 +727,10 @@ struct mlo_construct_direct2D
                      int w_stride)
     {
         _search_params.batch_sz = batch;
-        int data_len            = (data_type == "FP32" ? 4 : 8);
+        int data_len            = (data_type == "FP16" ? 2 : data_type == "FP32" ? 4 : 8);
         size_t size             = (layout == "NCHW")
                           ? batch * depth * height * width * data_len
-                          : batch * batch_stride * channel_stride * stride * w_stride * data_len;
+                          : batch * batch_stride * data_len;
 
         _search_params.in_width          = width;
         _search_params.in_height         = height;
@@ -720,6 +738,7 @@ struct mlo_construct_direct2D
         _search_params.in_batch_stride   = batch_stride;
         _search_params.in_channel_stride = channel_stride;
         _search_params.in_stride         = stride;
+        _search_params.in_pix_stride     = w_stride;
         _search_params.bot_sz            = size;
         _search_params.in_layout         = layout;
         _search_params.in_data_type      = data_type;
@@ -742,10 +761,10 @@ struct mlo_construct_direct2D
                        int w_stride)
     {
         _search_params.batch_sz = batch;
-        int data_len            = (data_type == "FP32" ? 4 : 8);
+        int data_len            = (data_type == "FP16" ? 2 : data_type == "FP32" ? 4 : 8);
         size_t size             = (layout == "NCHW")
                           ? batch * depth * height * width * data_len
-                          : batch * batch_stride * channel_stride * stride * w_stride * data_len;
+                          : batch * batch_stride * data_len;
 
         _out_df_width            = width;
         _out_df_height           = height;
@@ -753,6 +772,7 @@ struct mlo_construct_direct2D
         _out_df_batch_stride     = batch_stride;
         _out_df_channel_stride   = channel_stride;
         _out_df_stride           = stride;
+        _out_df_pix_stride       = w_stride;
         _top_df_sz               = size;
         _out_df_layout           = layout;
         _out_df_data_type        = data_type;
@@ -774,10 +794,10 @@ struct mlo_construct_direct2D
                        int w_stride)
     {
         _search_params.batch_sz = batch;
-        int data_len            = (data_type == "FP32" ? 4 : 8);
+        int data_len            = (data_type == "FP16" ? 2 : data_type == "FP32" ? 4 : 8);
         size_t size             = (layout == "NCHW")
                           ? batch * depth * height * width * data_len
-                          : batch * batch_stride * channel_stride * stride * w_stride * data_len;
+                          : batch * batch_stride * data_len;
 
         _in_df_width            = width;
         _in_df_height           = height;
@@ -785,6 +805,7 @@ struct mlo_construct_direct2D
         _in_df_batch_stride     = batch_stride;
         _in_df_channel_stride   = channel_stride;
         _in_df_stride           = stride;
+        _in_df_pix_stride       = w_stride;
         _bot_df_sz              = size;
         _in_df_layout           = layout;
         _in_df_data_type        = data_type;
@@ -868,6 +889,7 @@ struct mlo_construct_direct2D
     int _in_df_batch_stride   = 0;
     int _in_df_channel_stride = 0;
     int _in_df_stride         = 0;
+    int _in_df_pix_stride     = 1;
     std::string _in_df_layout;
     std::string _in_df_data_type;
 
@@ -876,6 +898,7 @@ struct mlo_construct_direct2D
     int _out_df_batch_stride   = 0;
     int _out_df_channel_stride = 0;
     int _out_df_stride         = 0;
+    int _out_df_pix_stride     = 1;
     std::string _out_df_layout;
     std::string _out_df_data_type;
 
@@ -1013,12 +1036,18 @@ struct mlo_construct_pooling2D : mlo_construct_direct2D
     }
 
     inline int getPoolingMethod() const { return (_pooling_method); }
+
+    // max pooling backward recomputes the argmax from the forward input instead of reading the
+    // indices the forward pass saved
+    inline void setIndexFree(bool index_free) { _index_free = index_free; }
     int mloConstruct();
 
     protected:
     int _pooling_method;
     int _NAN_option;
+    bool _index_free = false;
     int mloConstructFwd();
+    int mloConstructFwdGlobal();
     int mloConstructBwd();
 };
 
@@ -90,6 +90,9 @@ struct OCLKernelInvoke
     std::array<size_t, 3> global_work_dim    = {};
     std::array<size_t, 3> local_work_dim     = {};
     std::function<void(cl_event&)> callback;
+    // When false the callback receives the event right after the launch and
+    // must retain it if it needs it later.
+    bool blocking_callback = true;
 
     template <class... Ts>
     void operator()(const Ts&... xs) const
@@ -137,7 +140,8 @@ class OCLKernel
     }
 
     OCLKernelInvoke Invoke(cl_command_queue q,
-                           std::function<void(cl_event&)> callback = nullptr) const;
+                           std::function<void(cl_event&)> callback = nullptr,
+                           bool blocking_callback                  = true) const;
 
     cl_kernel GetKernel() { return kernel.get(); }
 
@@ -58,6 +58,18 @@ struct PoolingDescriptor : miopenPoolingDescriptor
     miopenPoolingMode_t GetMode();
     int GetSize() const;
 
+    void SetIndexType(miopenIndexType_t index_type);
+    miopenIndexType_t GetIndexType() const;
+    // Type of the indices saved in the workspace, the requested one widened as far as needed to
+    // number every element of the window
+    miopenIndexType_t GetWorkSpaceIndexType() const;
+    std::size_t GetIndexSize() const;
+
+    bool HasOverlappingWindows() const;
+    // Whether max pooling backward recomputes the argmax from x instead of saving it in the
+    // workspace
+    bool IsIndexFreeBackward(const TensorDescriptor& yDesc) const;
+
     std::tuple<std::size_t, std::size_t, std::size_t, std::size_t>
     GetForwardOutputDim(const TensorDescriptor& tensorDesc) const;
     TensorDescriptor GetForwardOutputTensor(const TensorDescriptor& tensorDesc) const;
@@ -94,8 +106,9 @@ struct PoolingDescriptor : miopenPoolingDescriptor
     std::vector<int> strides;
     std::vector<int> pads;
 
-    miopenPoolingMode_t mode  = miopenPoolingMax;
-    miopenPaddingMode_t pmode = miopenPaddingDefault;
+    miopenPoolingMode_t mode     = miopenPoolingMax;
+    miopenPaddingMode_t pmode    = miopenPaddingDefault;
+    miopenIndexType_t index_type = miopenIndexUint8;
 };
 } // namespace miopen
 MIOPEN_DEFINE_OBJECT(miopenPoolingDescriptor, miopen::PoolingDescriptor);
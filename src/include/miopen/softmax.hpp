@@ -35,9 +35,35 @@
 
 namespace miopen {
 
+/// Reads x and writes y, which may be the same buffer, in one pass. The result
+/// is blended as y = alpha * softmax(x) + beta * y.
+miopenStatus_t SoftmaxForward(Handle& handle,
+                              const void* alpha,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              const void* beta,
+                              const TensorDescriptor& yDesc,
+                              Data_t y,
+                              miopenSoftmaxAlgorithm_t algorithm = miopenSoftmaxAccurate,
+                              int axis                           = 1);
+
+/// In place softmax over the channels of y
 miopenStatus_t SoftmaxForward(
     Handle& handle, const void* alpha, const void* beta, const TensorDescriptor& yDesc, Data_t y);
 
+miopenStatus_t SoftmaxBackward(Handle& handle,
+                               const void* alpha,
+                               const TensorDescriptor& yDesc,
+                               ConstData_t y,
+                               const TensorDescriptor& dyDesc,
+                               ConstData_t dy,
+                               const void* beta,
+                               const TensorDescriptor& dxDesc,
+                               Data_t dx,
+                               miopenSoftmaxAlgorithm_t algorithm = miopenSoftmaxAccurate,
+                               int axis                           = 1);
+
+/// In place backward softmax over the channels, dx holds dy on entry
 miopenStatus_t SoftmaxBackward(Handle& handle,
                                const void* alpha,
                                const TensorDescriptor& yDesc,
@@ -29,17 +29,20 @@
 
 #include <miopen/config.h>
 
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <ostream>
+#include <sstream>
 
 #include <miopen/find_controls.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
 #include <miopen/make_unique.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/env.hpp>
 #include <miopen/type_name.hpp>
 #include <miopen/miopen.h>
@@ -47,6 +50,8 @@
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_DYNAMIC_BATCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PERFDB_NEAREST)
 
 namespace solver {
 
@@ -122,11 +127,101 @@ const std::string& SolverDbId(Solver solver)
     return result;
 }
 
+/// Largest batch size served by the programs of batch-agnostic solvers.
+/// Zero (the default) disables dynamic batching.
+inline int GetDynamicBatchBound() { return miopen::Value(MIOPEN_CONV_DYNAMIC_BATCH{}); }
+
+/// True if the solver shall build kernels that do not depend on the batch size of the
+/// problem, so that a single program serves every batch size up to GetDynamicBatchBound().
+template <class Solver, class Context>
+bool IsDynamicBatch(Solver s, const Context& context)
+{
+    const auto bound = GetDynamicBatchBound();
+    return bound > 0 && context.batch_sz <= bound && s.IsBatchAgnostic(context);
+}
+
+/// Loads the config stored for the solver under the problem nearest to the context.
+/// distance(ProblemDescription) shall return a negative value for problems to skip.
+template <class Solver, class Context, class PerformanceConfig, class Distance>
+bool LoadNearestConfig(Solver s,
+                       const Context& context,
+                       DbRecord& dbRecord,
+                       PerformanceConfig& config,
+                       Distance distance,
+                       std::string& found_key)
+{
+    const auto key_distance = [&](const std::string& key) -> double {
+        ProblemDescription other;
+        if(!other.ParseKey(key))
+            return -1;
+        return distance(other);
+    };
+    const auto accept = [&](const PerformanceConfig& c) {
+        return s.IsValidPerformanceConfig(context, c);
+    };
+    return dbRecord.LoadNearest(SolverDbId(s), config, key_distance, accept, found_key);
+}
+
+/// Loads the config tuned for the same problem with the nearest batch size.
+template <class Solver, class Context, class PerformanceConfig>
+bool LoadNearestBatch(Solver s,
+                      const Context& context,
+                      DbRecord& dbRecord,
+                      PerformanceConfig& config)
+{
+    std::ostringstream ss;
+    context.Serialize(ss);
+    const auto key = ss.str();
+
+    const auto distance = [&](ProblemDescription other) -> double {
+        const auto batch_sz = other.batch_sz;
+        other.batch_sz      = context.batch_sz;
+        std::ostringstream other_ss;
+        other.Serialize(other_ss);
+        if(other_ss.str() != key)
+            return -1;
+        return std::abs(batch_sz - context.batch_sz);
+    };
+
+    std::string found_key;
+    if(!LoadNearestConfig(s, context, dbRecord, config, distance, found_key))
+        return false;
+    MIOPEN_LOG_I("Perf Db: nearest batch record loaded: " << SolverDbId(s) << ", key: "
+                                                          << found_key);
+    return true;
+}
+
+/// With MIOPEN_PERFDB_NEAREST enabled, problems missing from the perf db use the config
+/// tuned for the nearest problem (see ProblemDescription::Distance) instead of the
+/// heuristic default.
+inline bool IsPerfDbNearestEnabled() { return miopen::IsEnabled(MIOPEN_PERFDB_NEAREST{}); }
+
+template <class Solver, class Context, class PerformanceConfig>
+bool LoadNearestProblem(Solver s,
+                        const Context& context,
+                        DbRecord& dbRecord,
+                        PerformanceConfig& config)
+{
+    const auto distance = [&](const ProblemDescription& other) { return context.Distance(other); };
+
+    std::string found_key;
+    if(!LoadNearestConfig(s, context, dbRecord, config, distance, found_key))
+        return false;
+    MIOPEN_LOG_W("Perf Db: no record for " << SolverDbId(s) << ", using the nearest one: "
+                                           << found_key
+                                           << ": "
+                                           << config);
+    return true;
+}
+
 template <class Solver, class Context>
 auto FindSolutionImpl(rank<1>, Solver s, const Context& context, DbRecord& dbRecord)
     -> decltype(s.GetSolution(context, s.Search(context)))
 {
     const FindEnforce enforce = GetFindEnforce();
+    // TODO: Make it a customization point
+    const bool search = context.do_search || enforce == FindEnforce::Search ||
+                        enforce == FindEnforce::SearchDbUpdate;
     MIOPEN_LOG_I(SolverDbId(s));
     if(enforce == FindEnforce::Clean)
     {
@@ -149,15 +244,24 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, DbRecord& dbRec
                 MIOPEN_LOG_I("Perf Db: record loaded: " << SolverDbId(s));
                 if(s.IsValidPerformanceConfig(context, config))
                 {
+                    IncrementMetric(MetricsCounter::PerfDbHit);
                     return s.GetSolution(context, config);
                 }
                 MIOPEN_LOG_E("Invalid config loaded from Perf Db: " << SolverDbId(s) << ": "
                                                                     << config);
             }
+            IncrementMetric(MetricsCounter::PerfDbMiss);
+            // Records of other batch sizes or problems only stand in when no search is
+            // requested, otherwise the current problem would never be tuned and stored.
+            if(!search && IsDynamicBatch(s, context) &&
+               LoadNearestBatch(s, context, dbRecord, config))
+                return s.GetSolution(context, config);
+            if(!search && IsPerfDbNearestEnabled() &&
+               LoadNearestProblem(s, context, dbRecord, config))
+                return s.GetSolution(context, config);
         }
 
-        if(context.do_search || enforce == FindEnforce::Search ||
-           enforce == FindEnforce::SearchDbUpdate) // TODO: Make it a customization point
+        if(search)
         {
             MIOPEN_LOG_I("Starting search: " << SolverDbId(s) << ", enforce: " << enforce);
             try
@@ -216,6 +320,7 @@ auto SearchForSolution(const Context& search_params, miopen::DbRecord dbRecord)
     // clang-format off
     MIOPEN_STATIC_FOR_EACH(solver, Solvers{}, {
         if(!solution.Succeeded() && solver.IsApplicable(search_params) &&
+           (search_params.in_data_type != "FP16" || solver.IsFp16Capable(search_params)) &&
            (no_perf_filtering || solver.IsFast(search_params)))
         {
             solution = FindSolution(solver, search_params, dbRecord);
@@ -274,6 +379,17 @@ struct SolverBase
     /// Warning: Non-trivial implementations introduce implicit dependencies between solutions.
     bool IsFast(const Context&) const { return true; }
 
+    /// Returns true if the solution can be built for a bound of the batch size instead
+    /// of the exact one, with only the launch grid depending on the actual batch size.
+    /// Such solvers are asked to do so when dynamic batching is enabled,
+    /// see IsDynamicBatch().
+    bool IsBatchAgnostic(const Context&) const { return false; }
+
+    /// Returns true if the kernels of the solution read and write half precision
+    /// buffers (with MIOPEN_USE_FP16) while accumulating in single precision.
+    /// Solvers which do not are skipped for FP16 problems.
+    bool IsFp16Capable(const Context&) const { return false; }
+
     /// Takes problem config, optimization parameters and other info
     /// and computes information required to build and run the kernel(s).
     /// ConvSolution GetSolution(const ConvolutionContext& params) const;
@@ -340,6 +456,8 @@ struct ConvOclDirectFwdLegacyExhaustiveSearch : SolverBase<ConvolutionContext>
 
 struct ConvOclDirectFwd : ConvOclDirectFwdLegacyExhaustiveSearch
 {
+    bool IsBatchAgnostic(const ConvolutionContext&) const { return true; }
+    bool IsFp16Capable(const ConvolutionContext&) const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const LegacyPerformanceConfig& searched_params) const;
 };
@@ -75,6 +75,9 @@ struct TensorDescriptor : miopenTensorDescriptor
 
     std::size_t GetNumBytes() const;
 
+    // "NHWC" for a packed channels-last 4-D tensor, "NCHW" otherwise
+    std::string GetLayout() const;
+
     std::size_t GetIndex(std::initializer_list<int> l) const;
 
     template <class... Ts>
@@ -62,5 +62,17 @@ void CopyTensor(Handle& handle,
                 int srcOffset  = 0,
                 int destOffset = 0);
 
+// y = alpha * x + beta * y between tensors of the same lengths, whose strides and data
+// types may differ. This permutes the data when the strides describe different layouts.
+void TransformTensor(Handle& handle,
+                     const void* alpha,
+                     const TensorDescriptor& xDesc,
+                     ConstData_t x,
+                     const void* beta,
+                     const TensorDescriptor& yDesc,
+                     Data_t y,
+                     size_t xOffset = 0,
+                     size_t yOffset = 0);
+
 } // namespace miopen
 #endif // GUARD_MIOPEN_TENSOR_OPPS_HPP_
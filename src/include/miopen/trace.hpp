@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP
+#define GUARD_MIOPEN_TRACE_HPP
+
+#include <cstdint>
+#include <miopen/kernel_profiler.hpp>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Timeline tracing of library activity.
+///
+/// When MIOPEN_TRACE is set, spans for program loads, perf db accesses, Find
+/// candidates and kernel launches are collected process-wide and written as a
+/// Chrome trace-event JSON file (chrome://tracing, Perfetto). MIOPEN_TRACE names
+/// the output file; "1"/"enable"/... selects "miopen_trace.json". The file is
+/// rewritten whenever a handle is destroyed and once more at exit.
+///
+/// Everything here is a no-op when tracing is disabled.
+bool IsTracingEnabled();
+
+/// Nanoseconds on the trace clock.
+std::uint64_t TraceNow();
+
+/// Arguments attached to a trace event, kept as a JSON object body.
+class TraceArgs
+{
+    public:
+    TraceArgs& Add(const char* name, const std::string& value);
+    TraceArgs& Add(const char* name, double value);
+
+    const std::string& Get() const { return json; }
+
+    private:
+    std::string json;
+};
+
+/// Records a complete event on the calling host thread. The category must be a
+/// string literal.
+void TraceEvent(const char* category,
+                const std::string& name,
+                std::uint64_t start_ns,
+                std::uint64_t end_ns,
+                const TraceArgs& args = {});
+
+/// Records completed kernels on the device track of their queue. Device
+/// timestamps are shifted onto the trace clock so that no kernel starts before
+/// it was enqueued; the alignment is therefore approximate.
+void TraceKernels(const void* queue, const std::vector<KernelProfile>& profiles);
+
+/// Writes every event recorded so far to the trace file.
+void FlushTrace();
+
+/// Scoped span on the calling thread.
+class TraceSpan
+{
+    public:
+    TraceSpan(const char* pcategory, std::string pname = {});
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    ~TraceSpan();
+
+    bool IsActive() const { return active; }
+
+    /// The setters only do work while tracing, so arguments that are
+    /// expensive to compute should still be guarded by IsActive().
+    void SetName(std::string pname);
+    TraceSpan& Arg(const char* arg_name, const std::string& value);
+    TraceSpan& Arg(const char* arg_name, double value);
+
+    private:
+    bool active;
+    const char* category;
+    std::string name;
+    TraceArgs args;
+    std::uint64_t start = 0;
+};
+
+/// Back-to-back spans, each one covering the time since the previous mark.
+class TraceSequence
+{
+    public:
+    TraceSequence(const char* pcategory);
+
+    void Mark(const std::string& name, const TraceArgs& args = {});
+
+    private:
+    bool active;
+    const char* category;
+    std::uint64_t last = 0;
+};
+
+} // namespace miopen
+
+#endif
@@ -52,7 +52,9 @@ float Im2ColGPU(Handle& handle,
                 int stride_w,
                 int dilation_h,
                 int dilation_w,
-                Data_t col);
+                Data_t col,
+                miopenDataType_t type     = miopenFloat,
+                const std::string& layout = "NCHW");
 
 float Col2ImGPU(Handle& handle,
                 ConstData_t col,
@@ -72,5 +74,15 @@ float Col2ImGPU(Handle& handle,
                 Data_t im,
                 size_t im_offset);
 
+/// Converts n elements between half and float buffers, at least one side must be float.
+float CastGPU(Handle& handle,
+              int n,
+              ConstData_t src,
+              size_t src_offset,
+              miopenDataType_t src_type,
+              Data_t dst,
+              size_t dst_offset,
+              miopenDataType_t dst_type);
+
 } // namespace miopen
 #endif // _MIOPEN_UTIL_HPP_
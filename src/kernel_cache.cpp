@@ -42,6 +42,8 @@
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/metrics.hpp>
+#include <miopen/stringutils.hpp>
 
 #include <iostream>
 #include <iterator>
@@ -108,15 +110,22 @@ Kernel KernelCache::GetKernel(const std::string& algorithm, const std::string& n
     auto kernel_iterator = kernel_map.find(key);
     if(kernel_iterator != kernel_map.end())
     {
+        IncrementMetric(MetricsCounter::KernelCacheHit);
         return kernel_iterator->second;
     }
     else
     {
+        IncrementMetric(MetricsCounter::KernelCacheMiss);
         MIOPEN_THROW("looking for default kernel (does not exist): " + algorithm + ", " +
                      network_config);
     }
 }
 
+bool KernelCache::HasKernel(const std::string& algorithm, const std::string& network_config) const
+{
+    return kernel_map.count(std::make_pair(algorithm, network_config)) > 0;
+}
+
 Kernel KernelCache::GetKernel(Handle& h,
                               const std::string& algorithm,
                               const std::string& network_config,
@@ -150,11 +159,15 @@ Kernel KernelCache::GetKernel(Handle& h,
     auto program_it = program_map.find(std::make_pair(program_name, params));
     if(program_it != program_map.end())
     {
+        IncrementMetric(MetricsCounter::KernelCacheHit);
         program = program_it->second;
     }
     else
     {
-        bool is_kernel_str = algorithm.find("GEMM") != std::string::npos;
+        IncrementMetric(MetricsCounter::KernelCacheMiss);
+        // GEMM and generated kernels pass their source as the program name
+        bool is_kernel_str = algorithm.find("GEMM") != std::string::npos ||
+                             StartsWith(algorithm, "miopenGenerated");
 #ifndef NDEBUG
         if(is_kernel_str == false)
             std::cout << "Kernel filename: " << program_name << "\n";
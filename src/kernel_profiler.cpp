@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/env.hpp>
+#include <miopen/kernel_profiler.hpp>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PROFILING_RECORDS)
+
+static std::size_t DefaultCapacity()
+{
+    const auto n = miopen::Value(MIOPEN_PROFILING_RECORDS{});
+    return n > 0 ? n : 4096;
+}
+
+KernelProfiler::KernelProfiler(std::size_t pcapacity)
+    : capacity(pcapacity == 0 ? DefaultCapacity() : pcapacity)
+{
+}
+
+void KernelProfiler::Record(KernelProfile profile, Resolver resolve)
+{
+    if(entries.size() == capacity)
+    {
+        entries.pop_front();
+        dropped++;
+    }
+    entries.push_back({std::move(profile), std::move(resolve)});
+}
+
+const std::vector<KernelProfile>& KernelProfiler::Collect()
+{
+    collected.clear();
+    collected.reserve(entries.size());
+    for(auto&& e : entries)
+    {
+        if(e.resolve)
+        {
+            e.resolve(e.profile);
+            // Drop the resolver so the events it holds are released.
+            e.resolve = nullptr;
+        }
+        collected.push_back(e.profile);
+    }
+    return collected;
+}
+
+void KernelProfiler::Reset()
+{
+    entries.clear();
+    collected.clear();
+    dropped = 0;
+}
+
+} // namespace miopen
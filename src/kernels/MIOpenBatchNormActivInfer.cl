@@ -0,0 +1,227 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Batch norm inference fused with the activation of MIOpenNeuron.cl, so the
+// normalized tensor is written once instead of being re-read by a separate
+// activation pass. The normalization follows MIOpenBatchNormFwdInferSpatial.cl
+// and MIOpenBatchNormFwdInferPerAct.cl; MIO_BN_ACTIV takes the value of the
+// corresponding miopenActivationMode_t.
+
+#define _FLOAT float
+#define _FLOAT2 float2
+#define _FLOAT4 float4
+#define _FLOAT8 float8
+
+#ifndef MIO_BN_N
+#define MIO_BN_N 1
+#endif
+
+#ifndef MIO_BN_HW
+#define MIO_BN_HW 1
+#endif
+
+#ifndef MIO_BN_CHW
+#define MIO_BN_CHW 1
+#endif
+
+#ifndef MIO_BN_GRP0
+#define MIO_BN_GRP0 1
+#endif
+
+#ifndef MIO_BN_GRP1
+#define MIO_BN_GRP1 1
+#endif
+
+#ifndef MIO_BN_GRP2
+#define MIO_BN_GRP2 1
+#endif
+
+#ifndef MIO_BN_ACTIV
+#define MIO_BN_ACTIV 0
+#endif
+
+#define UNUSED __attribute__((__unused__))
+
+// Disable specific warnings
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconditional-uninitialized"
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsometimes-uninitialized"
+#endif
+
+static inline _FLOAT
+bnActivation(_FLOAT x, UNUSED _FLOAT alpha, UNUSED _FLOAT beta, UNUSED _FLOAT power)
+{
+#if MIO_BN_ACTIV == 0
+    return x;
+#elif MIO_BN_ACTIV == 1
+    // 1/(1 + exp(-x))
+    return 1.f / (1.f + exp(-x));
+#elif MIO_BN_ACTIV == 2
+    return alpha * tanh(beta * x);
+#elif MIO_BN_ACTIV == 3
+    return (x > 0) ? x : x * beta;
+#elif MIO_BN_ACTIV == 4
+    //	log(1 + exp(x))
+    return (x > 0) ? x + log(1.f + exp(-x)) : log(1.f + exp(x));
+#elif MIO_BN_ACTIV == 5
+    return fabs(x);
+#elif MIO_BN_ACTIV == 6
+    // (alpha + beta * x ) ^power
+    _FLOAT arg = alpha + beta * x;
+    return (arg == 0) ? 0 : pow(arg, power);
+#else
+#error "Unsupported MIO_BN_ACTIV"
+#endif
+}
+
+// y = alpha * value + beta * y, y is only read when the host sets MIO_BN_BLEND_Y for a non-zero
+// beta, see bnBlendKernelParams
+#ifndef MIO_BN_BLEND_Y
+#define MIO_BN_BLEND_Y 0
+#endif
+
+#if(MIO_BN_BLEND_Y == 1)
+#define MIO_BN_BLEND(dst, value) (alpha * (value) + beta * (dst))
+#else
+#define MIO_BN_BLEND(dst, value) (alpha * (value))
+#endif
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+BatchNormActivInferSpatialEst(const __global _FLOAT* __restrict in, /* x input */
+                              __global _FLOAT* __restrict out,      /* y output */
+                              const __global _FLOAT* __restrict estimatedMean,
+                              const __global _FLOAT* __restrict estimatedVariance,
+                              const __global _FLOAT* __restrict scale,
+                              const __global _FLOAT* __restrict bias,
+                              float alpha,
+                              UNUSED float beta,
+                              double epsilon,
+                              _FLOAT activ_alpha,
+                              _FLOAT activ_beta,
+                              _FLOAT activ_power)
+{
+    int xgid = get_global_id(0);
+    int ygid = get_global_id(1);
+    local _FLOAT lmean;
+    local _FLOAT lvar;
+    local _FLOAT lscale;
+    local _FLOAT lbias;
+
+    unsigned int cidx = xgid * MIO_BN_HW;
+    unsigned int index;
+
+    _FLOAT mean, variance, invVariance;
+    _FLOAT inhat;
+    _FLOAT pscale, pbias;
+
+    if(get_local_id(1) == 0)
+    {
+        lmean  = estimatedMean[xgid];
+        lvar   = estimatedVariance[xgid];
+        lscale = scale[xgid]; // dims 1xCx1x1
+        lbias  = bias[xgid];
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    // move across the sections of the image mini_batch stack
+    if(ygid < MIO_BN_HW)
+    {
+        mean        = lmean;
+        variance    = lvar;
+        pscale      = lscale;
+        pbias       = lbias;
+        invVariance = rsqrt(fabs(variance + epsilon));
+
+#pragma unroll
+        for(int n = 0; n < MIO_BN_N; n++)
+        {
+            index      = n * MIO_BN_CHW + cidx + ygid;
+            inhat      = (in[index] - mean) * invVariance;
+            out[index] = MIO_BN_BLEND(
+                out[index],
+                bnActivation(mad(pscale, inhat, pbias), activ_alpha, activ_beta, activ_power));
+        }
+    }
+} // end spatial norm
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+BatchNormActivInferPerActEst(const __global _FLOAT* in,       /* x input */
+                             __global _FLOAT* __restrict out, /* y output */
+                             const __global _FLOAT* __restrict estimatedMean,
+                             const __global _FLOAT* __restrict estimatedVariance,
+                             const __global _FLOAT* __restrict scale, /* gamma 1xCxHxW */
+                             const __global _FLOAT* __restrict bias,  /* beta 1xCxHxW */
+                             float alpha,
+                             UNUSED float beta,
+                             double epsilon,
+                             _FLOAT activ_alpha,
+                             _FLOAT activ_beta,
+                             _FLOAT activ_power)
+{
+    _FLOAT mean, variance;
+    _FLOAT invVariance, inhat;
+    _FLOAT pvt_scale, pvt_bias;
+    unsigned int adjIndex, inImgIndex, index;
+
+    int xgid    = get_global_id(0);
+    int ygid    = get_global_id(1);
+    int yglb_sz = get_global_size(1);
+
+    int Cidx = MIO_BN_HW * xgid;
+
+    // move across the sections of an image in the mini_batch stack
+    for(int img_offset = 0; img_offset < MIO_BN_HW; img_offset += yglb_sz)
+    {
+        inImgIndex = img_offset + ygid;
+        if(inImgIndex < MIO_BN_HW)
+        {
+            adjIndex    = Cidx + inImgIndex; // gamma and beta tensor index
+            mean        = estimatedMean[adjIndex];
+            variance    = estimatedVariance[adjIndex];
+            invVariance = rsqrt(fabs(variance + epsilon));
+            pvt_scale   = scale[adjIndex];
+            pvt_bias    = bias[adjIndex];
+#pragma unroll
+            for(int n = 0; n < MIO_BN_N; n++)
+            {
+                index = MIO_BN_CHW * n + adjIndex;
+                inhat = (in[index] - mean) * invVariance;
+                out[index] = MIO_BN_BLEND(out[index],
+                                          bnActivation(mad(pvt_scale, inhat, pvt_bias),
+                                                       activ_alpha,
+                                                       activ_beta,
+                                                       activ_power));
+            }
+        }
+    }
+}
+
+// Restore warnings
+#ifdef __clang__
+#pragma clang diagnostic pop
+#pragma clang diagnostic pop
+#endif
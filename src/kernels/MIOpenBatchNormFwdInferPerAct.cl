@@ -52,6 +52,20 @@
 #define MIO_BN_GRP2 1
 #endif
 
+#define UNUSED __attribute__((__unused__))
+
+// y = alpha * value + beta * y, y is only read when the host sets MIO_BN_BLEND_Y for a non-zero
+// beta, see bnBlendKernelParams
+#ifndef MIO_BN_BLEND_Y
+#define MIO_BN_BLEND_Y 0
+#endif
+
+#if(MIO_BN_BLEND_Y == 1)
+#define MIO_BN_BLEND(dst, value) (alpha * (value) + beta * (dst))
+#else
+#define MIO_BN_BLEND(dst, value) (alpha * (value))
+#endif
+
 // Disable specific warnings
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -68,6 +82,8 @@ BatchNormFwdInferPerActivationEst(
     __global _FLOAT* __restrict estimatedVariance, /*input and output*/
     const __global _FLOAT* __restrict scale,       /* gamma 1xCxHxW */
     const __global _FLOAT* __restrict bias,        /* beta 1xCxHxW */
+    float alpha,
+    UNUSED float beta,
     double epsilon)
 {
 
@@ -102,7 +118,8 @@ BatchNormFwdInferPerActivationEst(
                 index      = MIO_BN_CHW * n + adjIndex;
                 elemStd    = in[index] - mean; // (x_i - mean)
                 inhat      = elemStd * invVariance;
-                out[index] = mad(pvt_scale, inhat, pvt_bias); //	y_i = gamma*x_hat + beta
+                //	y_i = gamma*x_hat + beta
+                out[index] = MIO_BN_BLEND(out[index], mad(pvt_scale, inhat, pvt_bias));
             }                                                 // end for
         }                                                     // end if
     } // end for(img_offset) //image mini_batch is processed
@@ -58,6 +58,18 @@
 
 #define UNUSED __attribute__((__unused__))
 
+// y = alpha * value + beta * y, y is only read when the host sets MIO_BN_BLEND_Y for a non-zero
+// beta, see bnBlendKernelParams
+#ifndef MIO_BN_BLEND_Y
+#define MIO_BN_BLEND_Y 0
+#endif
+
+#if(MIO_BN_BLEND_Y == 1)
+#define MIO_BN_BLEND(dst, value) (alpha * (value) + beta * (dst))
+#else
+#define MIO_BN_BLEND(dst, value) (alpha * (value))
+#endif
+
 // Disable specific warnings
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -73,6 +85,8 @@ BatchNormFwdInferSpatialEst(const __global _FLOAT* __restrict in, /* x input */
                             const __global _FLOAT* __restrict estimatedVariance,
                             const __global _FLOAT* __restrict scale,
                             const __global _FLOAT* __restrict bias,
+                            float alpha,
+                            UNUSED float beta,
                             double epsilon)
 {
 
@@ -112,7 +126,8 @@ BatchNormFwdInferSpatialEst(const __global _FLOAT* __restrict in, /* x input */
         {
             index      = n * MIO_BN_CHW + cidx + ygid;
             inhat      = (in[index] - mean) * invVariance;
-            out[index] = mad(pscale, inhat, pbias); // y_i = gamma*x_hat + beta
+            // y_i = gamma*x_hat + beta
+            out[index] = MIO_BN_BLEND(out[index], mad(pscale, inhat, pbias));
         }                                           // end for(img_offset)
     }
 } // end spatial norm
@@ -77,6 +77,20 @@
 #pragma clang diagnostic ignored "-Wsometimes-uninitialized"
 #endif
 
+#define UNUSED __attribute__((__unused__))
+
+// y = alpha * value + beta * y, y is only read when the host sets MIO_BN_BLEND_Y for a non-zero
+// beta, see bnBlendKernelParams
+#ifndef MIO_BN_BLEND_Y
+#define MIO_BN_BLEND_Y 0
+#endif
+
+#if(MIO_BN_BLEND_Y == 1)
+#define MIO_BN_BLEND(dst, value) (alpha * (value) + beta * (dst))
+#else
+#define MIO_BN_BLEND(dst, value) (alpha * (value))
+#endif
+
 //==================== PER ACTIVATION =======================
 
 __kernel void BatchNormFwdTrainPerActivation(
@@ -86,6 +100,8 @@ __kernel void BatchNormFwdTrainPerActivation(
     __global _FLOAT* __restrict out,         /* y output */
     const __global _FLOAT* __restrict scale, /* gamma 1xCxHxW */
     const __global _FLOAT* __restrict bias,  /* beta 1xCxHxW */
+    float alpha,                             /* y = alpha * y_hat */
+    UNUSED float beta,                       /*     + beta * y */
     double expAvgFactor,                     /* input momentum */
 #if(MIO_RUNNING_RESULT == 1)
     __global _FLOAT* __restrict resultRunningMean,     /*input and output, same descriptor as bias*/
@@ -203,7 +219,7 @@ Note from cuDNN: expAvgFactor
                 inhat   = elemStd * invVariance;
                 // #5 Gamma and Beta adjust
                 //	y_i = gamma*x_hat + beta
-                out[index] = mad(pvt_scale, inhat, pvt_bias);
+                out[index] = MIO_BN_BLEND(out[index], mad(pvt_scale, inhat, pvt_bias));
             } // end for(n)
         }     // end if(inImgIndex)
     }         // end for(img_offset) //image mini_batch is processed
@@ -229,6 +229,18 @@ dppLDSReduce16(_FLOAT* value, __local _FLOAT* data, unsigned int localID, _FLOAT
 }
 #endif
 
+// y = alpha * value + beta * y, y is only read when the host sets MIO_BN_BLEND_Y for a non-zero
+// beta, see bnBlendKernelParams
+#ifndef MIO_BN_BLEND_Y
+#define MIO_BN_BLEND_Y 0
+#endif
+
+#if(MIO_BN_BLEND_Y == 1)
+#define MIO_BN_BLEND(dst, value) (alpha * (value) + beta * (dst))
+#else
+#define MIO_BN_BLEND(dst, value) (alpha * (value))
+#endif
+
 #if(MIO_BN_VARIANT == 255)
 
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
@@ -236,6 +248,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                          __global _FLOAT* __restrict out,
                          __constant _FLOAT* __restrict scale,
                          __constant _FLOAT* __restrict bias,
+                         float alpha,
+                         UNUSED float beta,
                          float INHW,
 #if(MIO_RUNNING_RESULT == 1)
                          double expAvgFactor,
@@ -375,7 +389,7 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
 
             index = nid * MIO_BN_CHW + chwid;
             if(index < MIO_BN_NCHW)
-                out[index] = mad(pvscale, inhat, pvbias);
+                out[index] = MIO_BN_BLEND(out[index], mad(pvscale, inhat, pvbias));
         } // end for
     }
 #if(MIO_SAVE_MEAN_VARIANCE == 1 || MIO_RUNNING_RESULT == 1)
@@ -412,6 +426,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                          __global _FLOAT* __restrict out,
                          __constant _FLOAT* __restrict scale,
                          __constant _FLOAT* __restrict bias,
+                         float alpha,
+                         UNUSED float beta,
                          float INHW,
 #if(MIO_RUNNING_RESULT == 1)
                          double expAvgFactor,
@@ -551,7 +567,7 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         {
             index      = ylid * MIO_BN_CHW + cidx + hw;
             inhat      = minibatch[hw] * invVariance;
-            out[index] = mad(pvscale, inhat, pvbias);
+            out[index] = MIO_BN_BLEND(out[index], mad(pvscale, inhat, pvbias));
         } // end for
     }     // end if
 
@@ -587,6 +603,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                          __global _FLOAT* __restrict out,
                          __constant _FLOAT* __restrict scale,
                          __constant _FLOAT* __restrict bias,
+                         float alpha,
+                         UNUSED float beta,
                          float INHW,
 #if(MIO_RUNNING_RESULT == 1)
                          double expAvgFactor,
@@ -727,7 +745,7 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         { // apply normalization
             index      = n * MIO_BN_CHW + idx;
             inhat      = minibatch[n] * invVariance;
-            out[index] = mad(pvscale, inhat, pvbias);
+            out[index] = MIO_BN_BLEND(out[index], mad(pvscale, inhat, pvbias));
         } // end for
     }     // end if
 
@@ -764,6 +782,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                          __global _FLOAT* __restrict out,
                          __constant _FLOAT* __restrict scale,
                          __constant _FLOAT* __restrict bias,
+                         float alpha,
+                         UNUSED float beta,
                          float INHW,
 #if(MIO_RUNNING_RESULT == 1)
                          double expAvgFactor,
@@ -915,7 +935,7 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
 #else
             inhat = (*(in + index) - mean) * invVariance;
 #endif
-            out[index] = mad(pvscale, inhat, pvbias);
+            out[index] = MIO_BN_BLEND(out[index], mad(pvscale, inhat, pvbias));
         } // end for
     }     // end if
 
@@ -951,7 +971,9 @@ __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __k
 BatchNormFwdTrainSpatialNorm(const __global _FLOAT* __restrict in,
                              __global _FLOAT* __restrict out,
                              const __global _FLOAT* __restrict scale,
-                             const __global _FLOAT* __restrict bias)
+                             const __global _FLOAT* __restrict bias,
+                             float alpha,
+                             UNUSED float beta)
 {
 
     // SPATIAL
@@ -994,7 +1016,7 @@ BatchNormFwdTrainSpatialNorm(const __global _FLOAT* __restrict in,
             index = n * MIO_BN_CHW + cidx + ygid;
             inhat = (*(in + index) - mean) * invVariance;
             // #5 Gamma and Beta adjust :: y_i = gamma*x_hat + beta
-            out[index] = mad(pvt_scale, inhat, pvt_bias);
+            out[index] = MIO_BN_BLEND(out[index], mad(pvt_scale, inhat, pvt_bias));
         } // end for(n)
     }     // end if(inImgIndex)
 } // end spatial norm
@@ -1382,6 +1404,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                          __global _FLOAT* __restrict out,
                          __constant _FLOAT* __restrict scale,
                          __constant _FLOAT* __restrict bias,
+                         float alpha,
+                         UNUSED float beta,
                          float INHW,
 #if(MIO_RUNNING_RESULT == 1)
                          double expAvgFactor,
@@ -1525,7 +1549,7 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                 inhat = (batchvalues[n][hw] - mean) * invVariance;
                 index = nid + cid + lidhw;
                 // if(index < MIO_BN_NCHW)
-                out[index] = mad(pvscale, inhat, pvbias);
+                out[index] = MIO_BN_BLEND(out[index], mad(pvscale, inhat, pvbias));
             }
         }
     } // end for
@@ -1567,6 +1591,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                          __global _FLOAT* __restrict out,
                          __constant _FLOAT* __restrict scale,
                          __constant _FLOAT* __restrict bias,
+                         float alpha,
+                         UNUSED float beta,
                          float INHW,
 #if(MIO_RUNNING_RESULT == 1)
                          double expAvgFactor,
@@ -1707,7 +1733,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         nidx       = iDiv(k, MIO_BN_HW);
         hwidx      = iMod(k, nidx, MIO_BN_HW);
         index      = nidx * MIO_BN_CHW + chwid + hwidx;
-        out[index] = mad(pvscale, (*(in + index) - mean) * invVariance, pvbias);
+        out[index] =
+            MIO_BN_BLEND(out[index], mad(pvscale, (*(in + index) - mean) * invVariance, pvbias));
     } // end for
 #if(MIO_BN_REM)
     nidx  = iDiv(MIO_BN_LESS + lid, MIO_BN_HW);
@@ -1715,7 +1742,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
     index = nidx * MIO_BN_CHW + chwid + hwidx;
     if(index < MIO_BN_NCHW)
     {
-        *(out + index) = mad(pvscale, (*(in + index) - mean) * invVariance, pvbias);
+        *(out + index) = MIO_BN_BLEND(*(out + index),
+                                      mad(pvscale, (*(in + index) - mean) * invVariance, pvbias));
     }
 #endif
 
@@ -1752,6 +1780,8 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
                          __global _FLOAT* __restrict out,
                          __constant _FLOAT* __restrict scale,
                          __constant _FLOAT* __restrict bias,
+                         float alpha,
+                         UNUSED float beta,
                          float INHW,
 #if(MIO_RUNNING_RESULT == 1)
                          double expAvgFactor,
@@ -1875,7 +1905,7 @@ BatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         {
             index      = n * MIO_BN_CHW + chwid + hw;
             _FLOAT tmp = (((index < MIO_BN_NCHW) ? *(in + index) : 0.) - mean) * invVariance;
-            out[index] = mad(pvscale, tmp, pvbias);
+            out[index] = MIO_BN_BLEND(out[index], mad(pvscale, tmp, pvbias));
         }
     } // end for
 
@@ -0,0 +1,280 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Spatial batch norm kernels that take the tensor shape as arguments instead of
+// compile time constants, so one program serves every batch size and resolution.
+// Each work group of the training kernels handles one channel.
+
+#define _FLOAT float
+#define _FLOAT2 float2
+#define _FLOAT4 float4
+#define _FLOAT8 float8
+
+#ifndef MIO_SAVE_MEAN_VARIANCE
+#define MIO_SAVE_MEAN_VARIANCE 0
+#endif
+
+#ifndef MIO_RUNNING_RESULT
+#define MIO_RUNNING_RESULT 0
+#endif
+
+#ifndef MIO_BN_USESAVED
+#define MIO_BN_USESAVED 1
+#endif
+
+#ifndef MIO_BN_GRP0
+#define MIO_BN_GRP0 256
+#endif
+
+#ifndef MIO_BN_LDS_SIZE
+#define MIO_BN_LDS_SIZE MIO_BN_GRP0
+#endif
+
+#define UNUSED __attribute__((__unused__))
+
+static inline void
+lclTreeReduce(_FLOAT* value, __local _FLOAT* data, unsigned int lid, _FLOAT scale)
+{
+    data[lid] = *value;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(unsigned int stride = (MIO_BN_LDS_SIZE >> 1); stride > 0; stride >>= 1)
+    {
+        if(lid < stride)
+            data[lid] += data[lid + stride];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    *value = data[0] * scale;
+    // data is reused by the next reduction
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+// y = alpha * value + beta * y, y is only read when the host sets MIO_BN_BLEND_Y for a non-zero
+// beta, see bnBlendKernelParams
+#ifndef MIO_BN_BLEND_Y
+#define MIO_BN_BLEND_Y 0
+#endif
+
+#if(MIO_BN_BLEND_Y == 1)
+#define MIO_BN_BLEND(dst, value) (alpha * (value) + beta * (dst))
+#else
+#define MIO_BN_BLEND(dst, value) (alpha * (value))
+#endif
+
+// Offset of the k-th element of channel cidx, walking the channel in NHW order.
+static inline unsigned int
+chanIndex(unsigned int k, unsigned int cidx, unsigned int cstride, unsigned int nstride)
+{
+    unsigned int nid = k / cstride;
+    return nid * nstride + cidx * cstride + (k - nid * cstride);
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+BatchNormFwdTrainSpatialGeneric(const __global _FLOAT* __restrict in,
+                                __global _FLOAT* __restrict out,
+                                const __global _FLOAT* __restrict scale,
+                                const __global _FLOAT* __restrict bias,
+                                float alpha,
+                                UNUSED float beta,
+                                unsigned int N,
+                                unsigned int cstride,
+                                unsigned int nstride,
+                                float INHW,
+                                UNUSED double expAvgFactor,
+                                UNUSED __global _FLOAT* __restrict resultRunningMean,
+                                UNUSED __global _FLOAT* __restrict resultRunningVariance,
+                                double epsilon,
+                                UNUSED __global _FLOAT* __restrict resultSaveMean,
+                                UNUSED __global _FLOAT* __restrict resultSaveInvVariance)
+{
+    __local _FLOAT lcl_data[MIO_BN_LDS_SIZE];
+
+    unsigned int lid   = get_local_id(0);
+    unsigned int grpid = get_group_id(0);
+    unsigned int nhw   = N * cstride;
+
+    _FLOAT mean        = 0.;
+    _FLOAT variance    = 0.;
+    _FLOAT invVariance = 0.;
+    _FLOAT xhat        = 0.;
+
+    for(unsigned int k = lid; k < nhw; k += MIO_BN_GRP0)
+    {
+        mean += in[chanIndex(k, grpid, cstride, nstride)];
+    }
+    lclTreeReduce(&mean, lcl_data, lid, INHW);
+
+    for(unsigned int k = lid; k < nhw; k += MIO_BN_GRP0)
+    {
+        xhat     = in[chanIndex(k, grpid, cstride, nstride)] - mean;
+        variance = mad(xhat, xhat, variance);
+    }
+    lclTreeReduce(&variance, lcl_data, lid, INHW);
+    invVariance = rsqrt(variance + epsilon);
+
+    _FLOAT pvscale = scale[grpid];
+    _FLOAT pvbias  = bias[grpid];
+
+    for(unsigned int k = lid; k < nhw; k += MIO_BN_GRP0)
+    {
+        unsigned int index = chanIndex(k, grpid, cstride, nstride);
+        xhat               = (in[index] - mean) * invVariance;
+        out[index]         = MIO_BN_BLEND(out[index], mad(pvscale, xhat, pvbias));
+    }
+
+#if(MIO_SAVE_MEAN_VARIANCE == 1 || MIO_RUNNING_RESULT == 1)
+    if(lid == 0)
+    {
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+        resultSaveMean[grpid]        = mean;
+        resultSaveInvVariance[grpid] = invVariance;
+#endif
+
+#if(MIO_RUNNING_RESULT == 1)
+        _FLOAT pvt_runMean = resultRunningMean[grpid];
+        _FLOAT pvt_newRunMean =
+            mad((_FLOAT)-expAvgFactor, pvt_runMean, pvt_runMean); // tmp = oldRunMean*(1-factor)
+        resultRunningMean[grpid] =
+            mad(mean, (_FLOAT)expAvgFactor, pvt_newRunMean); // newMean*factor + tmp
+        const _FLOAT adjust =
+            (nhw == 1) ? variance : variance * ((_FLOAT)nhw / (_FLOAT)(nhw - 1.0));
+        resultRunningVariance[grpid] =
+            (1 - (_FLOAT)expAvgFactor) * resultRunningVariance[grpid] +
+            (_FLOAT)expAvgFactor * adjust;
+#endif
+    }
+#endif
+}
+
+__attribute__((reqd_work_group_size(1, MIO_BN_GRP0, 1))) __kernel void
+BatchNormFwdInferSpatialGeneric(const __global _FLOAT* __restrict in,
+                                __global _FLOAT* __restrict out,
+                                const __global _FLOAT* __restrict estimatedMean,
+                                const __global _FLOAT* __restrict estimatedVariance,
+                                const __global _FLOAT* __restrict scale,
+                                const __global _FLOAT* __restrict bias,
+                                float alpha,
+                                UNUSED float beta,
+                                unsigned int N,
+                                unsigned int cstride,
+                                unsigned int nstride,
+                                double epsilon)
+{
+    unsigned int xgid = get_global_id(0);
+    unsigned int ygid = get_global_id(1);
+
+    if(ygid < cstride)
+    {
+        _FLOAT mean        = estimatedMean[xgid];
+        _FLOAT invVariance = rsqrt(fabs(estimatedVariance[xgid] + epsilon));
+        _FLOAT pscale      = scale[xgid];
+        _FLOAT pbias       = bias[xgid];
+
+        unsigned int index = xgid * cstride + ygid;
+        for(unsigned int n = 0; n < N; n++, index += nstride)
+        {
+            _FLOAT inhat = (in[index] - mean) * invVariance;
+            // y_i = gamma*x_hat + beta
+            out[index] = MIO_BN_BLEND(out[index], mad(pscale, inhat, pbias));
+        }
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+BatchNormBwdSpatialGeneric(const __global _FLOAT* __restrict x_in,
+                           const __global _FLOAT* __restrict dy_in,
+                           __global _FLOAT* __restrict dx_out,
+                           const __global _FLOAT* __restrict bnScale,
+                           __global _FLOAT* __restrict delta_scale,
+                           __global _FLOAT* __restrict delta_bias,
+                           UNUSED const __global _FLOAT* __restrict savedMean,
+                           UNUSED const __global _FLOAT* __restrict savedInvVariance,
+                           UNUSED double epsilon,
+                           unsigned int N,
+                           unsigned int cstride,
+                           unsigned int nstride,
+                           float INHW)
+{
+    __local _FLOAT lcl_data[MIO_BN_LDS_SIZE];
+
+    unsigned int lid   = get_local_id(0);
+    unsigned int grpid = get_group_id(0);
+    unsigned int nhw   = N * cstride;
+    unsigned int index;
+
+    _FLOAT mean        = 0.;
+    _FLOAT invVariance = 0.;
+    _FLOAT xhat        = 0.;
+    _FLOAT dyvalue     = 0.;
+
+#if(MIO_BN_USESAVED == 1)
+    mean        = savedMean[grpid];
+    invVariance = savedInvVariance[grpid];
+#else
+    _FLOAT variance = 0.;
+    for(unsigned int k = lid; k < nhw; k += MIO_BN_GRP0)
+    {
+        mean += x_in[chanIndex(k, grpid, cstride, nstride)];
+    }
+    lclTreeReduce(&mean, lcl_data, lid, INHW);
+
+    for(unsigned int k = lid; k < nhw; k += MIO_BN_GRP0)
+    {
+        xhat     = x_in[chanIndex(k, grpid, cstride, nstride)] - mean;
+        variance = mad(xhat, xhat, variance);
+    }
+    lclTreeReduce(&variance, lcl_data, lid, INHW);
+    invVariance = rsqrt(variance + epsilon);
+#endif
+
+    _FLOAT dbias  = 0.;
+    _FLOAT dscale = 0.;
+    for(unsigned int k = lid; k < nhw; k += MIO_BN_GRP0)
+    {
+        index   = chanIndex(k, grpid, cstride, nstride);
+        xhat    = (x_in[index] - mean) * invVariance;
+        dyvalue = dy_in[index];
+        dbias += dyvalue;
+        dscale = mad(xhat, dyvalue, dscale);
+    }
+    lclTreeReduce(&dbias, lcl_data, lid, 1.);
+    lclTreeReduce(&dscale, lcl_data, lid, 1.);
+
+    if(lid == 0)
+    {
+        delta_bias[grpid]  = dbias;
+        delta_scale[grpid] = dscale;
+    }
+
+    _FLOAT pscale = bnScale[grpid];
+    for(unsigned int k = lid; k < nhw; k += MIO_BN_GRP0)
+    {
+        index   = chanIndex(k, grpid, cstride, nstride);
+        xhat    = (x_in[index] - mean) * invVariance;
+        dyvalue = mad((_FLOAT)nhw, dy_in[index], -dbias);
+        // dx = scale * invVar / NHW * (NHW * dy - sum(dy) - xhat * sum(dy * xhat))
+        dx_out[index] = pscale * invVariance * INHW * mad(-xhat, dscale, dyvalue);
+    }
+}
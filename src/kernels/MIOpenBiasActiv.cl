@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Bias add followed by an activation, in place on the output of a convolution.
+// Used by the fused conv+bias+activation path when the convolution kernel has
+// no epilogue of its own. MIO_ACTIV_MODE takes the value of the corresponding
+// miopenActivationMode_t; the shape is passed at run time so one program
+// serves every tensor size.
+
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// Buffers are stored as _FLOAT_STORE, the activation is computed in _FLOAT
+#define _FLOAT float
+
+#ifndef MIO_ACTIV_MODE
+#define MIO_ACTIV_MODE 0
+#endif
+
+#ifndef MIO_BIAS
+#define MIO_BIAS 1
+#endif
+
+#define UNUSED __attribute__((__unused__))
+
+static inline _FLOAT
+Activation(_FLOAT x, UNUSED _FLOAT alpha, UNUSED _FLOAT beta, UNUSED _FLOAT power)
+{
+#if MIO_ACTIV_MODE == 0
+    return x;
+#elif MIO_ACTIV_MODE == 1
+    // 1/(1 + exp(-x))
+    return 1.f / (1.f + exp(-x));
+#elif MIO_ACTIV_MODE == 2
+    return alpha * tanh(beta * x);
+#elif MIO_ACTIV_MODE == 3
+    return (x > 0) ? x : x * beta;
+#elif MIO_ACTIV_MODE == 4
+    //	log(1 + exp(x))
+    return (x > 0) ? x + log(1.f + exp(-x)) : log(1.f + exp(x));
+#elif MIO_ACTIV_MODE == 5
+    return fabs(x);
+#elif MIO_ACTIV_MODE == 6
+    // (alpha + beta * x ) ^power
+    _FLOAT arg = alpha + beta * x;
+    return (arg == 0) ? 0 : pow(arg, power);
+#else
+#error "Unsupported MIO_ACTIV_MODE"
+#endif
+}
+
+__kernel void MIOpenBiasActivFwd(__global _FLOAT_STORE* __restrict data,
+                                 UNUSED const __global _FLOAT_STORE* __restrict bias,
+                                 const unsigned int channels,
+                                 const unsigned int cstride,
+                                 const unsigned int total,
+                                 const _FLOAT alpha,
+                                 const _FLOAT beta,
+                                 const _FLOAT power)
+{
+    for(unsigned int gid = get_global_id(0); gid < total; gid += get_global_size(0))
+    {
+        _FLOAT val = (_FLOAT)data[gid];
+#if MIO_BIAS
+        val += (_FLOAT)bias[(gid / cstride) % channels];
+#endif
+        data[gid] = (_FLOAT_STORE)Activation(val, alpha, beta, power);
+    }
+}
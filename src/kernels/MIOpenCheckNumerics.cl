@@ -1,3 +1,11 @@
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// Values are read as _FLOAT_STORE and checked and accumulated in DTYPE
 #define DTYPE float
 #define ACCUMTYPE float
 
@@ -78,7 +86,7 @@ void cl_atomic_max_float(volatile __global float* addr, float val)
     }
 
 // Checks a block of data for abnormal numeric values :
-__kernel void MIOpenCheckNumerics(const __global DTYPE* data,
+__kernel void MIOpenCheckNumerics(const __global _FLOAT_STORE* data,
                                   int size,
                                   __global struct CheckNumericsResult* abnormal,
                                   int computeStats)
@@ -96,7 +104,7 @@ __kernel void MIOpenCheckNumerics(const __global DTYPE* data,
     DTYPE maxV       = FLT_MIN;
     while(offset < size)
     {
-        DTYPE value = data[offset];
+        DTYPE value = (DTYPE)data[offset];
         sum += value;
         abssum += fabs(value);
         minV = min(minV, value);
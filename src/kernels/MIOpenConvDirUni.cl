@@ -24,6 +24,14 @@
  *
  *******************************************************************************/
 
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// Buffers are stored as _FLOAT_STORE, the convolution is accumulated in _FLOAT
 #define _FLOAT float
 #define _FLOAT2 float2
 #define _FLOAT4 float4
@@ -42,6 +50,10 @@
 #define MLO_FILTER_STRIDE1 1
 #endif
 
+#ifndef MLO_CONV_ACTIV
+#define MLO_CONV_ACTIV 0
+#endif
+
 #define MLO_FILTER_SZ (MLO_FILTER_SIZE1 * MLO_FILTER_SIZE0)
 
 #define MLO_GRP_SZ0 (MLO_GRP_TILE0 * MLO_GRP_TILE1)
@@ -181,7 +193,7 @@ static inline void readDataElem(uint linPos,
                                 int lcl_stride,
                                 int lcl_y,
                                 int lcl_x,
-                                const __global _FLOAT* gbl_data,
+                                const __global _FLOAT_STORE* gbl_data,
                                 int gbl_base,
                                 uint gbl_height,
                                 uint gbl_width,
@@ -232,7 +244,7 @@ static inline void readData(uint lcl_id,
                             int lcl_stride,
                             int lcl_y,
                             int lcl_x,
-                            const __global _FLOAT* gbl_data,
+                            const __global _FLOAT_STORE* gbl_data,
                             int gbl_base,
                             uint gbl_height,
                             uint gbl_width,
@@ -275,7 +287,7 @@ static inline void loadData(uint lcl_id,
                             int lcl_stride,
                             int lcl_bot_y,
                             int lcl_bot_x,
-                            const __global _FLOAT* gbl_data,
+                            const __global _FLOAT_STORE* gbl_data,
                             int gbl_off,
                             int gbl_size,
                             uint gbl_height,
@@ -448,14 +460,38 @@ static inline void Conv(uint o_map_base,
       // MLO_IN_LCL_PERSTACK_SZ)
 }
 
+// Activation applied in the epilogue of the fused conv+bias+activation path.
+// MLO_CONV_ACTIV takes the value of the corresponding miopenActivationMode_t.
+#if MLO_CONV_ACTIV
+static inline _FLOAT ConvActivation(_FLOAT x, UNUSED _FLOAT alpha, UNUSED _FLOAT beta)
+{
+#if MLO_CONV_ACTIV == 1
+    // 1/(1 + exp(-x))
+    return 1.f / (1.f + exp(-x));
+#elif MLO_CONV_ACTIV == 2
+    return alpha * tanh(beta * x);
+#elif MLO_CONV_ACTIV == 3
+    return (x > 0) ? x : x * beta;
+#else
+#error "Unsupported MLO_CONV_ACTIV"
+#endif
+}
+#endif
+
 __attribute__((reqd_work_group_size(MLO_GRP_SZ0, MLO_GRP_SZ1, MLO_GRP_SZ2))) __kernel void
-MIOpenConvUni(const __global _FLOAT* __restrict in,
-              const __global _FLOAT* __restrict weights,
+MIOpenConvUni(const __global _FLOAT_STORE* __restrict in,
+              const __global _FLOAT_STORE* __restrict weights,
 #if MLO_CONV_BIAS
-              const __global _FLOAT* __restrict bias,
+              const __global _FLOAT_STORE* __restrict bias,
+#endif
+              __global _FLOAT_STORE* __restrict out,
+              UNUSED _FLOAT padding_val
+#if MLO_CONV_ACTIV
+              ,
+              _FLOAT activ_alpha,
+              _FLOAT activ_beta
 #endif
-              __global _FLOAT* __restrict out,
-              UNUSED _FLOAT padding_val)
+              )
 {
     __local _FLOAT lcl_indata[MLO_IN_LCL_SZ];
     __local _FLOAT lcl_wei[MLO_WEIGHTS_SZ];
@@ -815,11 +851,17 @@ MIOpenConvUni(const __global _FLOAT* __restrict in,
                             if(x_out_grp + x_out_lcl + i < MLO_OUT_WIDTH &&
                                out_off2 + i < MLO_OUT_BATCH_STRIDE * MLO_BATCH_SZ)
 #endif
-                        out[out_off2 + i] = pvt_accum[o * MLO_OUT_TILE_SZ + j * MLO_OUT_TILE0 + i]
+                    {
+                        _FLOAT val = pvt_accum[o * MLO_OUT_TILE_SZ + j * MLO_OUT_TILE0 + i]
 #if MLO_CONV_BIAS
-                                            + bias[o_map + o]
+                                     + bias[o_map + o]
 #endif
                             ;
+#if MLO_CONV_ACTIV
+                        val = ConvActivation(val, activ_alpha, activ_beta);
+#endif
+                        out[out_off2 + i] = val;
+                    }
                     }
                 }
             }
@@ -24,6 +24,14 @@
  *
  *******************************************************************************/
 
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// Buffers are stored as _FLOAT_STORE, the activation is computed in _FLOAT
 #define _FLOAT float
 #define _FLOAT2 float2
 #define _FLOAT4 float4
@@ -47,6 +55,14 @@
 //#define MLO_NEURON_LINEAR		MLO_NEURON_SQR	+ 1			//	a + b * x
 #define MLO_NEURON_TOTAL MLO_NEURON_POWER + 1
 
+// Blends the result into the destination as alpha * value + beta * dst. The destination is only
+// read for non-zero beta so it may be uninitialized
+__attribute__((always_inline)) void
+neuron_store(__global _FLOAT_STORE* dst, _FLOAT value, _FLOAT alpha, _FLOAT beta)
+{
+    *dst = (beta == 0.f) ? alpha * value : alpha * value + beta * (*dst);
+}
+
 __attribute__((always_inline)) void ActivationFunction_PassThru(_FLOAT* res, const _FLOAT* data)
 {
     for(int i = 0; i < 4; i++)
@@ -171,7 +187,7 @@ void ActivationFunction(
     ActivationFunction_TanH(n, res, data, alpha, beta);
 
 #elif MLO_NRN_OP_ID == MLO_NEURON_RELU
-    ActivationFunction_ReLU(n, res, data, alpha);
+    ActivationFunction_ReLU(n, res, data, beta);
 
 //#elif	MLO_NRN_OP_ID==MLO_NEURON_BRELU
 //	ActivationFunction_BReLU(n, res, data, alpha);
@@ -285,13 +301,15 @@ __attribute__((always_inline)) void ActivationFunction_BNLL_Diff(int n,
 
 __attribute__((reqd_work_group_size(MLO_NRN_GROUP_SZ0, MLO_NRN_GROUP_SZ1, MLO_NRN_GROUP_SZ2)))
 __kernel void
-MIOpenNeuronFwd(const __global _FLOAT* bot,
-                __global _FLOAT* top,
+MIOpenNeuronFwd(const __global _FLOAT_STORE* bot,
+                __global _FLOAT_STORE* top,
                 _FLOAT power,
                 _FLOAT scale,
                 _FLOAT shift,
                 const long xOffset,
-                const long yOffset)
+                const long yOffset,
+                _FLOAT alpha,
+                _FLOAT beta)
 {
     int x = get_global_id(0); // channel x
 
@@ -369,7 +387,9 @@ MIOpenNeuronFwd(const __global _FLOAT* bot,
             }
         }
     }
-    ActivationFunction(MLO_READ_UNIT, response, (const _FLOAT*)data, power, scale, shift);
+    // alpha * tanh(beta * x) and (alpha + beta * x)^power with the descriptor's alpha as shift
+    // and its beta as scale, the same as the backward pass and the fused activations
+    ActivationFunction(MLO_READ_UNIT, response, (const _FLOAT*)data, power, shift, scale);
 
 #if MLO_N_PIXS_OFF > 0
     if(x == MLO_MAP_SZ_ALIGNED - 1)
@@ -389,13 +409,16 @@ MIOpenNeuronFwd(const __global _FLOAT* bot,
                 w_loc = ((loc % (MLO_C_OUT * MLO_H_OUT * MLO_W_OUT)) % (MLO_H_OUT * MLO_W_OUT)) %
                         MLO_W_OUT;
 
-                top[yOffset + n_loc * MLO_N_OUT_STRIDE + c_loc * MLO_C_OUT_STRIDE +
-                    h_loc * MLO_H_OUT_STRIDE + w_loc * MLO_W_OUT_STRIDE] = response[i];
+                neuron_store(&top[yOffset + n_loc * MLO_N_OUT_STRIDE + c_loc * MLO_C_OUT_STRIDE +
+                                  h_loc * MLO_H_OUT_STRIDE + w_loc * MLO_W_OUT_STRIDE],
+                             response[i],
+                             alpha,
+                             beta);
             }
             else
 #endif
             {
-                top[yOffset + x * MLO_READ_UNIT + i] = response[i];
+                neuron_store(&top[yOffset + x * MLO_READ_UNIT + i], response[i], alpha, beta);
             }
         }
     }
@@ -416,13 +439,16 @@ MIOpenNeuronFwd(const __global _FLOAT* bot,
                 w_loc = ((loc % (MLO_C_OUT * MLO_H_OUT * MLO_W_OUT)) % (MLO_H_OUT * MLO_W_OUT)) %
                         MLO_W_OUT;
 
-                top[yOffset + n_loc * MLO_N_OUT_STRIDE + c_loc * MLO_C_OUT_STRIDE +
-                    h_loc * MLO_H_OUT_STRIDE + w_loc * MLO_W_OUT_STRIDE] = response[i];
+                neuron_store(&top[yOffset + n_loc * MLO_N_OUT_STRIDE + c_loc * MLO_C_OUT_STRIDE +
+                                  h_loc * MLO_H_OUT_STRIDE + w_loc * MLO_W_OUT_STRIDE],
+                             response[i],
+                             alpha,
+                             beta);
             }
             else
 #endif
             {
-                top[yOffset + x * MLO_READ_UNIT + i] = response[i];
+                neuron_store(&top[yOffset + x * MLO_READ_UNIT + i], response[i], alpha, beta);
             }
         }
     }
@@ -430,10 +456,10 @@ MIOpenNeuronFwd(const __global _FLOAT* bot,
 
 __attribute__((reqd_work_group_size(MLO_NRN_GROUP_SZ0, MLO_NRN_GROUP_SZ1, MLO_NRN_GROUP_SZ2)))
 __kernel void
-MIOpenNeuronBwd(__global _FLOAT* bot_diff,
-                __global const _FLOAT* top_diff,
-                __global const _FLOAT* bot_data,
-                __global const _FLOAT* top_data,
+MIOpenNeuronBwd(__global _FLOAT_STORE* bot_diff,
+                __global const _FLOAT_STORE* top_diff,
+                __global const _FLOAT_STORE* bot_data,
+                __global const _FLOAT_STORE* top_data,
                 _FLOAT diff_scale,
                 _FLOAT power,
                 _FLOAT scale,
@@ -441,7 +467,9 @@ MIOpenNeuronBwd(__global _FLOAT* bot_diff,
                 const long dxOffset,
                 const long dyOffset,
                 const long xOffset,
-                const long yOffset)
+                const long yOffset,
+                _FLOAT alpha,
+                _FLOAT beta)
 {
 
     (void)diff_scale;
@@ -673,14 +701,19 @@ MIOpenNeuronBwd(__global _FLOAT* bot_diff,
                     ((loc % (MLO_C_DIN * MLO_H_DIN * MLO_W_DIN)) % (MLO_H_DIN * MLO_W_DIN)) %
                     MLO_W_DIN;
 
-                bot_diff[dxOffset + n_loc_bot_diff * MLO_N_DIN_STRIDE +
-                         c_loc_bot_diff * MLO_C_DIN_STRIDE + h_loc_bot_diff * MLO_H_DIN_STRIDE +
-                         w_loc_bot_diff * MLO_W_DIN_STRIDE] = bot_diff_dat[i];
+                neuron_store(&bot_diff[dxOffset + n_loc_bot_diff * MLO_N_DIN_STRIDE +
+                                       c_loc_bot_diff * MLO_C_DIN_STRIDE +
+                                       h_loc_bot_diff * MLO_H_DIN_STRIDE +
+                                       w_loc_bot_diff * MLO_W_DIN_STRIDE],
+                             bot_diff_dat[i],
+                             alpha,
+                             beta);
             }
             else
 #endif
             {
-                bot_diff[dxOffset + x * MLO_READ_UNIT + i] = bot_diff_dat[i];
+                neuron_store(
+                    &bot_diff[dxOffset + x * MLO_READ_UNIT + i], bot_diff_dat[i], alpha, beta);
             }
         }
     }
@@ -705,14 +738,19 @@ MIOpenNeuronBwd(__global _FLOAT* bot_diff,
                     ((loc % (MLO_C_DIN * MLO_H_DIN * MLO_W_DIN)) % (MLO_H_DIN * MLO_W_DIN)) %
                     MLO_W_DIN;
 
-                bot_diff[dxOffset + n_loc_bot_diff * MLO_N_DIN_STRIDE +
-                         c_loc_bot_diff * MLO_C_DIN_STRIDE + h_loc_bot_diff * MLO_H_DIN_STRIDE +
-                         w_loc_bot_diff * MLO_W_DIN_STRIDE] = bot_diff_dat[i];
+                neuron_store(&bot_diff[dxOffset + n_loc_bot_diff * MLO_N_DIN_STRIDE +
+                                       c_loc_bot_diff * MLO_C_DIN_STRIDE +
+                                       h_loc_bot_diff * MLO_H_DIN_STRIDE +
+                                       w_loc_bot_diff * MLO_W_DIN_STRIDE],
+                             bot_diff_dat[i],
+                             alpha,
+                             beta);
             }
             else
 #endif
             {
-                bot_diff[dxOffset + x * MLO_READ_UNIT + i] = bot_diff_dat[i];
+                neuron_store(
+                    &bot_diff[dxOffset + x * MLO_READ_UNIT + i], bot_diff_dat[i], alpha, beta);
             }
         }
     }
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#define LOAD_FLOAT4(i, p) vload_half4(i, p)
+#define STORE_FLOAT4(v, i, p) vstore_half4(v, i, p)
+#define LOAD_FLOAT(i, p) vload_half(i, p)
+#define STORE_FLOAT(v, i, p) vstore_half(v, i, p)
+#else
+#define _FLOAT_STORE float
+#define LOAD_FLOAT4(i, p) vload4(i, p)
+#define STORE_FLOAT4(v, i, p) vstore4(v, i, p)
+#define LOAD_FLOAT(i, p) ((p)[i])
+#define STORE_FLOAT(v, i, p) ((p)[i] = (v))
+#endif
+
+#define MLO_NEURON_PASTHRU 0
+#define MLO_NEURON_LOGISTIC 1
+#define MLO_NEURON_TANH 2
+#define MLO_NEURON_RELU 3
+#define MLO_NEURON_SOFTRELU 4
+#define MLO_NEURON_ABS 5
+#define MLO_NEURON_POWER 6
+
+#define MLO_NRN_PACKED_GROUP_SZ 256
+
+// Same functions and parameter order as ActivationFunction in MIOpenNeuron.cl, with the mode
+// passed at run time so that one program serves every activation
+inline float4 ActivationFunction4(int mode, float4 x, float power, float alpha, float beta)
+{
+    switch(mode)
+    {
+    case MLO_NEURON_LOGISTIC: return 1.f / (1.f + exp(-x));
+    case MLO_NEURON_TANH: return alpha * tanh(beta * x);
+    case MLO_NEURON_RELU: return select(x * beta, x, x > 0.f);
+    case MLO_NEURON_SOFTRELU: return select(log(1.f + exp(x)), x + log(1.f + exp(-x)), x > 0.f);
+    case MLO_NEURON_ABS: return fabs(x);
+    case MLO_NEURON_POWER:
+    {
+        float4 arg     = alpha + x * beta;
+        float4 run_arg = select(arg, (float4)1.f, arg == 0.f);
+        return select(pow(run_arg, (float4)power), (float4)0.f, arg == 0.f);
+    }
+    default: return x;
+    }
+}
+
+// Forward activation of a packed tensor. Each work item moves four elements per iteration and
+// strides over the whole tensor, so the launch size does not depend on the tensor size.
+__attribute__((reqd_work_group_size(MLO_NRN_PACKED_GROUP_SZ, 1, 1))) __kernel void
+MIOpenNeuronFwdPacked(const __global _FLOAT_STORE* x,
+                      __global _FLOAT_STORE* y,
+                      int mode,
+                      float power,
+                      float scale,
+                      float shift,
+                      const long xOffset,
+                      const long yOffset,
+                      const long n,
+                      float alpha,
+                      float beta)
+{
+    const __global _FLOAT_STORE* src = x + xOffset;
+    __global _FLOAT_STORE* dst       = y + yOffset;
+
+    const long gid = get_global_id(0);
+    const long gsz = get_global_size(0);
+    const long n4  = n / 4;
+
+    for(long i = gid; i < n4; i += gsz)
+    {
+        float4 res = alpha * ActivationFunction4(mode, LOAD_FLOAT4(i, src), power, shift, scale);
+        // The destination is only read for non-zero beta so it may be uninitialized
+        if(beta != 0.f)
+            res += beta * LOAD_FLOAT4(i, dst);
+        STORE_FLOAT4(res, i, dst);
+    }
+
+    for(long i = n4 * 4 + gid; i < n; i += gsz)
+    {
+        float4 data = (float4)LOAD_FLOAT(i, src);
+        float res   = alpha * ActivationFunction4(mode, data, power, shift, scale).x;
+        if(beta != 0.f)
+            res += beta * LOAD_FLOAT(i, dst);
+        STORE_FLOAT(res, i, dst);
+    }
+}
@@ -24,12 +24,26 @@
  *
  *******************************************************************************/
 
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// Buffers are stored as _FLOAT_STORE, the pooling is computed in _FLOAT
 #define _FLOAT float
 #define _FLOAT2 float2
 #define _FLOAT4 float4
 #define _FLOAT8 float8
-#define _INT_MASK_GLOBAL uchar
-#define _INT_MASK_LOCAL uchar
+
+// argmax indices saved for the backward pass, the largest value marks a window without a maximum
+#ifndef MLO_POOLING_INDEX_TYPE
+#define MLO_POOLING_INDEX_TYPE uchar
+#define MLO_POOLING_INDEX_MAX UCHAR_MAX
+#endif
+#define _INT_MASK_GLOBAL MLO_POOLING_INDEX_TYPE
+#define _INT_MASK_LOCAL MLO_POOLING_INDEX_TYPE
 
 #ifndef FLT_MAX
 #define FLT_MAX 3.402823466e+38F /* max value */
@@ -57,6 +71,21 @@
 
 **********************************************************************************/
 
+// distance between horizontally adjacent pixels, the channel count for NHWC tensors
+#ifndef MLO_POOLING_BOT_PIX_STRIDE
+#define MLO_POOLING_BOT_PIX_STRIDE 1
+#endif
+#ifndef MLO_POOLING_TOP_PIX_STRIDE
+#define MLO_POOLING_TOP_PIX_STRIDE 1
+#endif
+
+// Blends the result into the destination as alpha * value + beta * dst. The destination is only
+// read for non-zero beta so it may be uninitialized
+inline void pooling_store(__global _FLOAT_STORE* dst, _FLOAT value, _FLOAT alpha, _FLOAT beta)
+{
+    *dst = (beta == 0.f) ? alpha * value : alpha * value + beta * (*dst);
+}
+
 #define MLO_BOT_DATA_SZ0 \
     (MLO_POOLING_N_HORIZ_OUT_PIX * MLO_POOLING_STRIDE0 + MLO_POOLING_KERNEL_SZ0 - 1)
 #define MLO_BOT_DATA_SZ1 \
@@ -65,12 +94,14 @@
 __attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0,
                                     MLO_POOLING_GROUP_SZ1,
                                     MLO_POOLING_GROUP_SZ2))) __kernel void
-mloPoolingG(const __global _FLOAT* bot,
-            __global _FLOAT* top,
+mloPoolingG(const __global _FLOAT_STORE* bot,
+            __global _FLOAT_STORE* top,
 #if !defined(MLO_POOLING_DO_BACKWARD) || MLO_POOLING_OP_ID != MLO_POOLING_OP_MAX
             UNUSED
 #endif
-                __global _INT_MASK_GLOBAL* mask)
+                __global _INT_MASK_GLOBAL* mask,
+            _FLOAT alpha,
+            _FLOAT beta)
 {
 
     uint x       = get_group_id(0) * MLO_POOLING_GROUP_SZ0 * MLO_POOLING_N_HORIZ_OUT_PIX;
@@ -109,7 +140,8 @@ mloPoolingG(const __global _FLOAT* bot,
         for(uint i = 0; i < MLO_BOT_DATA_SZ0; ++i)
         {
             int run_x        = (int)bot_x + i - MLO_POOLING_PAD0;
-            uint bot_gbl_off = bot_off + (uint)run_y * MLO_POOLING_BOT_STRIDE + (uint)run_x;
+            uint bot_gbl_off = bot_off + (uint)run_y * MLO_POOLING_BOT_STRIDE +
+                               (uint)run_x * MLO_POOLING_BOT_PIX_STRIDE;
             bool vis         = ((run_y >= 0 && run_y < MLO_POOLING_BOT_HEIGHT) &&
                         (run_x >= 0 && run_x < MLO_POOLING_BOT_WIDTH))
                            ? true
@@ -143,7 +175,7 @@ mloPoolingG(const __global _FLOAT* bot,
             uint pool_size = (hend - hstart) * (wend - wstart);
 #endif
 #if defined(MLO_POOLING_DO_BACKWARD) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
-            mask_private[k][l] = 0xFF;
+            mask_private[k][l] = MLO_POOLING_INDEX_MAX;
 #endif
 
             for(uint j = 0; j < MLO_POOLING_KERNEL_SZ1; j++)
@@ -185,16 +217,18 @@ mloPoolingG(const __global _FLOAT* bot,
     uint top_y   = (y + lcl_id1 * MLO_POOLING_N_VERT_OUT_PIX);
     uint top_x   = (x + lcl_id0 * MLO_POOLING_N_HORIZ_OUT_PIX);
     uint top_off = b * MLO_POOLING_TOP_BATCH_STRIDE + o * MLO_POOLING_TOP_CHANNEL_STRIDE +
-                   top_y * MLO_POOLING_TOP_STRIDE + top_x;
+                   top_y * MLO_POOLING_TOP_STRIDE + top_x * MLO_POOLING_TOP_PIX_STRIDE;
     for(uint k = 0; k < MLO_POOLING_N_VERT_OUT_PIX; k++)
     {
         for(uint l = 0; l < MLO_POOLING_N_HORIZ_OUT_PIX; l++)
         {
             if(top_y + k < MLO_POOLING_TOP_HEIGHT && top_x + l < MLO_POOLING_TOP_WIDTH)
             {
-                top[top_off + k * MLO_POOLING_TOP_STRIDE + l] = res[k][l];
+                uint top_idx =
+                    top_off + k * MLO_POOLING_TOP_STRIDE + l * MLO_POOLING_TOP_PIX_STRIDE;
+                pooling_store(&top[top_idx], res[k][l], alpha, beta);
 #if defined(MLO_POOLING_DO_BACKWARD) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
-                mask[top_off + k * MLO_POOLING_TOP_STRIDE + l] = mask_private[k][l];
+                mask[top_idx] = mask_private[k][l];
 #endif
             }
         }
@@ -24,12 +24,26 @@
  *
  *******************************************************************************/
 
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// Buffers are stored as _FLOAT_STORE, the pooling is computed in _FLOAT
 #define _FLOAT float
 #define _FLOAT2 float2
 #define _FLOAT4 float4
 #define _FLOAT8 float8
-#define _INT_MASK_GLOBAL uchar
-#define _INT_MASK_LOCAL uchar
+
+// argmax indices saved for the backward pass, the largest value marks a window without a maximum
+#ifndef MLO_POOLING_INDEX_TYPE
+#define MLO_POOLING_INDEX_TYPE uchar
+#define MLO_POOLING_INDEX_MAX UCHAR_MAX
+#endif
+#define _INT_MASK_GLOBAL MLO_POOLING_INDEX_TYPE
+#define _INT_MASK_LOCAL MLO_POOLING_INDEX_TYPE
 
 #ifndef FLT_MAX
 #define FLT_MAX 3.402823466e+38F /* max value */
@@ -41,6 +55,24 @@
 
 #define MLO_POOLBWD_GROUP_SZ2 1
 
+// distance between horizontally adjacent pixels, the channel count for NHWC tensors
+#ifndef MLO_POOLBWD_BOT_PIX_STRIDE
+#define MLO_POOLBWD_BOT_PIX_STRIDE 1
+#endif
+#ifndef MLO_POOLBWD_BOTDF_PIX_STRIDE
+#define MLO_POOLBWD_BOTDF_PIX_STRIDE 1
+#endif
+#ifndef MLO_POOLBWD_TOPDF_PIX_STRIDE
+#define MLO_POOLBWD_TOPDF_PIX_STRIDE 1
+#endif
+
+// Blends the result into the destination as alpha * value + beta * dst. The destination is only
+// read for non-zero beta so it may be uninitialized
+inline void pooling_store(__global _FLOAT_STORE* dst, _FLOAT value, _FLOAT alpha, _FLOAT beta)
+{
+    *dst = (beta == 0.f) ? alpha * value : alpha * value + beta * (*dst);
+}
+
 #define MLO_POOLBWD_LCL_DATA_WIDTH                                                   \
     ((MLO_POOLBWD_GROUP_SZ0 * MLO_POOLBWD_N_HORIZ_OUT_PIX + MLO_POOLING_KERNEL_SZ0 + \
       MLO_POOLING_STRIDE0 - 2) /                                                     \
@@ -53,7 +85,10 @@
 __attribute__((reqd_work_group_size(MLO_POOLBWD_GROUP_SZ0,
                                     MLO_POOLBWD_GROUP_SZ1,
                                     MLO_POOLBWD_GROUP_SZ2))) __kernel void
-mloPoolingAveBwd(const __global _FLOAT* top_diff, __global _FLOAT* bot_diff)
+mloPoolingAveBwd(const __global _FLOAT_STORE* top_diff,
+                 __global _FLOAT_STORE* bot_diff,
+                 _FLOAT alpha,
+                 _FLOAT beta)
 {
     __local _FLOAT lcl_top_diff[MLO_POOLBWD_LCL_DATA_WIDTH * MLO_POOLBWD_LCL_DATA_HEIGHT];
 
@@ -100,7 +135,9 @@ mloPoolingAveBwd(const __global _FLOAT* top_diff, __global _FLOAT* bot_diff)
 
             bool invisibleX = (top_x_act >= MLO_POOLBWD_TOP_WIDTH);
 
-            int top_diff_off = (invisibleX || invisibleY) ? 0 : top_off + top_y_off + top_x_act;
+            int top_diff_off = (invisibleX || invisibleY)
+                                   ? 0
+                                   : top_off + top_y_off + top_x_act * MLO_POOLBWD_TOPDF_PIX_STRIDE;
 
             _FLOAT top_val = top_diff[top_diff_off];
 
@@ -170,14 +207,18 @@ mloPoolingAveBwd(const __global _FLOAT* top_diff, __global _FLOAT* bot_diff)
     }
 
     int bot_off = b * MLO_POOLBWD_BOTDF_BATCH_STRIDE + o * MLO_POOLBWD_BOTDF_CHANNEL_STRIDE +
-                  bot_y * MLO_POOLBWD_BOTDF_STRIDE + bot_x;
+                  bot_y * MLO_POOLBWD_BOTDF_STRIDE + bot_x * MLO_POOLBWD_BOTDF_PIX_STRIDE;
     for(int k = 0; k < MLO_POOLBWD_N_VERT_OUT_PIX; k++)
     {
         for(int l = 0; l < MLO_POOLBWD_N_HORIZ_OUT_PIX; l++)
         {
             if(bot_y + k < MLO_POOLBWD_BOT_HEIGHT && bot_x + l < MLO_POOLBWD_BOT_WIDTH)
             {
-                bot_diff[bot_off + k * MLO_POOLBWD_BOTDF_STRIDE + l] = res[k][l];
+                pooling_store(&bot_diff[bot_off + k * MLO_POOLBWD_BOTDF_STRIDE +
+                                        l * MLO_POOLBWD_BOTDF_PIX_STRIDE],
+                              res[k][l],
+                              alpha,
+                              beta);
 #if 0
 					if (lcl_id0==0&&lcl_id1==0&&o==0&&b==0)
 					{
@@ -192,9 +233,11 @@ mloPoolingAveBwd(const __global _FLOAT* top_diff, __global _FLOAT* bot_diff)
 __attribute__((reqd_work_group_size(MLO_POOLBWD_GROUP_SZ0,
                                     MLO_POOLBWD_GROUP_SZ1,
                                     MLO_POOLBWD_GROUP_SZ2))) __kernel void
-mloPoolingMaxBwd(const __global _FLOAT* top_df,
-                 __global _FLOAT* bot_df,
-                 __global _INT_MASK_GLOBAL* mask)
+mloPoolingMaxBwd(const __global _FLOAT_STORE* top_df,
+                 __global _FLOAT_STORE* bot_df,
+                 __global _INT_MASK_GLOBAL* mask,
+                 _FLOAT alpha,
+                 _FLOAT beta)
 {
     __local _FLOAT lcl_top_df[MLO_POOLBWD_LCL_DATA_WIDTH * MLO_POOLBWD_LCL_DATA_HEIGHT];
     __local _INT_MASK_LOCAL lcl_mask[MLO_POOLBWD_LCL_DATA_WIDTH * MLO_POOLBWD_LCL_DATA_HEIGHT];
@@ -236,12 +279,14 @@ mloPoolingMaxBwd(const __global _FLOAT* top_df,
             int top_x_act = top_x + ti;
 
             bool visible = visibleY && (top_x_act < MLO_POOLBWD_TOP_WIDTH);
-            int idx      = visible ? (top_df_off + top_df_y_off + top_x_act) : 0;
+            int idx      = visible ? (top_df_off + top_df_y_off +
+                                 top_x_act * MLO_POOLBWD_TOPDF_PIX_STRIDE)
+                              : 0;
 
             _FLOAT top_df_val        = top_df[idx];
             _INT_MASK_LOCAL mask_val = mask[idx];
             // top_df_val *= visible;
-            mask_val = visible ? mask_val : 0xFF;
+            mask_val = visible ? mask_val : MLO_POOLING_INDEX_MAX;
 
             int lcl_idx = lcl_off_v + ti;
 
@@ -313,15 +358,100 @@ mloPoolingMaxBwd(const __global _FLOAT* top_df,
     }
 
     int bot_df_off = b * MLO_POOLBWD_BOTDF_BATCH_STRIDE + o * MLO_POOLBWD_BOTDF_CHANNEL_STRIDE +
-                     bt_y * MLO_POOLBWD_BOTDF_STRIDE + bt_x;
+                     bt_y * MLO_POOLBWD_BOTDF_STRIDE + bt_x * MLO_POOLBWD_BOTDF_PIX_STRIDE;
     for(int k = 0; k < MLO_POOLBWD_N_VERT_OUT_PIX; k++)
     {
         for(int l = 0; l < MLO_POOLBWD_N_HORIZ_OUT_PIX; l++)
         {
             if((bt_y + k) < MLO_POOLBWD_BOT_HEIGHT && (bt_x + l) < MLO_POOLBWD_BOT_WIDTH)
             {
-                bot_df[bot_df_off + k * MLO_POOLBWD_BOTDF_STRIDE + l] = res[k][l];
+                pooling_store(&bot_df[bot_df_off + k * MLO_POOLBWD_BOTDF_STRIDE +
+                                      l * MLO_POOLBWD_BOTDF_PIX_STRIDE],
+                              res[k][l],
+                              alpha,
+                              beta);
+            }
+        }
+    }
+}
+
+// Max pooling backward without the saved indices, for windows that do not overlap. Each work item
+// finds the argmax of one window from the forward input, scanning it in the same order and with
+// the same tie breaking as mloPoolingG, and writes the part of dx from its window up to the next
+// one. The first and last rows and columns also take the pixels outside of every window.
+__attribute__((reqd_work_group_size(MLO_POOLBWD_GROUP_SZ0,
+                                    MLO_POOLBWD_GROUP_SZ1,
+                                    MLO_POOLBWD_GROUP_SZ2))) __kernel void
+mloPoolingMaxBwdIndexFree(const __global _FLOAT_STORE* top_df,
+                          __global _FLOAT_STORE* bot_df,
+                          const __global _FLOAT_STORE* bot,
+                          _FLOAT alpha,
+                          _FLOAT beta)
+{
+    int t_x = get_global_id(0);
+    int t_y = get_global_id(1);
+    int ob  = get_global_id(2); // outputs * batch_sz
+    int b   = ob / MLO_POOLING_N_OUTPUTS;
+    int o   = ob - b * MLO_POOLING_N_OUTPUTS;
+
+    if(t_x >= MLO_POOLBWD_TOP_WIDTH || t_y >= MLO_POOLBWD_TOP_HEIGHT)
+    {
+        return;
+    }
+
+    int bot_off    = b * MLO_POOLBWD_BOT_BATCH_STRIDE + o * MLO_POOLBWD_BOT_CHANNEL_STRIDE;
+    int bot_df_off = b * MLO_POOLBWD_BOTDF_BATCH_STRIDE + o * MLO_POOLBWD_BOTDF_CHANNEL_STRIDE;
+    int top_df_off = b * MLO_POOLBWD_TOPDF_BATCH_STRIDE + o * MLO_POOLBWD_TOPDF_CHANNEL_STRIDE +
+                     t_y * MLO_POOLBWD_TOPDF_STRIDE + t_x * MLO_POOLBWD_TOPDF_PIX_STRIDE;
+
+    int hstart = t_y * MLO_POOLING_STRIDE1 - MLO_POOLING_PAD1;
+    int wstart = t_x * MLO_POOLING_STRIDE0 - MLO_POOLING_PAD0;
+
+    _FLOAT max_val = -FLT_MAX;
+    int max_idx    = -1;
+    for(int j = 0; j < MLO_POOLING_KERNEL_SZ1; ++j)
+    {
+        int run_y = hstart + j;
+        for(int i = 0; i < MLO_POOLING_KERNEL_SZ0; ++i)
+        {
+            int run_x    = wstart + i;
+            bool visible = run_y >= 0 && run_y < MLO_POOLBWD_BOT_HEIGHT && run_x >= 0 &&
+                           run_x < MLO_POOLBWD_BOT_WIDTH;
+            _FLOAT bot_val = visible ? (_FLOAT)bot[bot_off + run_y * MLO_POOLBWD_BOT_STRIDE +
+                                                   run_x * MLO_POOLBWD_BOT_PIX_STRIDE]
+                                     : -FLT_MAX;
+            if(bot_val > max_val)
+            {
+                max_val = bot_val;
+                max_idx = i + MLO_POOLING_KERNEL_SZ0 * j;
             }
         }
     }
+
+    _FLOAT top_val = top_df[top_df_off];
+
+    int y_begin = (t_y == 0) ? 0 : max(0, hstart);
+    int x_begin = (t_x == 0) ? 0 : max(0, wstart);
+    int y_end   = (t_y == MLO_POOLBWD_TOP_HEIGHT - 1)
+                    ? MLO_POOLBWD_BOT_HEIGHT
+                    : min(MLO_POOLBWD_BOT_HEIGHT, hstart + MLO_POOLING_STRIDE1);
+    int x_end = (t_x == MLO_POOLBWD_TOP_WIDTH - 1)
+                    ? MLO_POOLBWD_BOT_WIDTH
+                    : min(MLO_POOLBWD_BOT_WIDTH, wstart + MLO_POOLING_STRIDE0);
+
+    for(int run_y = y_begin; run_y < y_end; ++run_y)
+    {
+        int j = run_y - hstart;
+        for(int run_x = x_begin; run_x < x_end; ++run_x)
+        {
+            int i       = run_x - wstart;
+            bool is_max = j < MLO_POOLING_KERNEL_SZ1 && i < MLO_POOLING_KERNEL_SZ0 &&
+                          max_idx == i + MLO_POOLING_KERNEL_SZ0 * j;
+            pooling_store(&bot_df[bot_df_off + run_y * MLO_POOLBWD_BOTDF_STRIDE +
+                                  run_x * MLO_POOLBWD_BOTDF_PIX_STRIDE],
+                          is_max ? top_val : 0.f,
+                          alpha,
+                          beta);
+        }
+    }
 }
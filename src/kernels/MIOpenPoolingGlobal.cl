@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// Buffers are stored as _FLOAT_STORE, the pooling is computed in _FLOAT
+#define _FLOAT float
+
+// argmax indices saved for the backward pass, the largest value marks a window without a maximum
+#ifndef MLO_POOLING_INDEX_TYPE
+#define MLO_POOLING_INDEX_TYPE uchar
+#define MLO_POOLING_INDEX_MAX UCHAR_MAX
+#endif
+#define _INT_MASK_GLOBAL MLO_POOLING_INDEX_TYPE
+
+#ifndef FLT_MAX
+#define FLT_MAX 3.402823466e+38F /* max value */
+#endif
+
+#define UNUSED __attribute__((__unused__))
+
+#define MLO_POOLING_OP_AVE 0
+#define MLO_POOLING_OP_MAX 1
+
+#ifndef MLO_POOLING_OP_ID
+#define MLO_POOLING_OP_ID 0
+#endif
+
+// distance between horizontally adjacent pixels, the channel count for NHWC tensors
+#ifndef MLO_POOLING_BOT_PIX_STRIDE
+#define MLO_POOLING_BOT_PIX_STRIDE 1
+#endif
+
+#define MLO_POOLING_GLOBAL_GROUP_SZ 256
+// MLO_POOLING_GLOBAL_LANES work items reduce one plane; a power of two that divides the group
+#define MLO_POOLING_GLOBAL_PLANES (MLO_POOLING_GLOBAL_GROUP_SZ / MLO_POOLING_GLOBAL_LANES)
+#define MLO_POOLING_GLOBAL_PLANE_SZ (MLO_POOLING_BOT_HEIGHT * MLO_POOLING_BOT_WIDTH)
+
+// Blends the result into the destination as alpha * value + beta * dst. The destination is only
+// read for non-zero beta so it may be uninitialized
+inline void pooling_store(__global _FLOAT_STORE* dst, _FLOAT value, _FLOAT alpha, _FLOAT beta)
+{
+    *dst = (beta == 0.f) ? alpha * value : alpha * value + beta * (*dst);
+}
+
+// Pooling whose window is the whole input plane, so every output is the reduction of one (n, c)
+// plane. Each plane is read by MLO_POOLING_GLOBAL_LANES work items and reduced as a tree in local
+// memory. The max keeps the lowest index among equal values, which is the element mloPoolingG
+// finds first.
+__attribute__((reqd_work_group_size(MLO_POOLING_GLOBAL_GROUP_SZ, 1, 1))) __kernel void
+mloPoolingGlobalFwd(const __global _FLOAT_STORE* bot,
+                    __global _FLOAT_STORE* top,
+                    UNUSED __global _INT_MASK_GLOBAL* mask,
+                    _FLOAT alpha,
+                    _FLOAT beta)
+{
+    __local _FLOAT lcl_val[MLO_POOLING_GLOBAL_GROUP_SZ];
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+    __local uint lcl_idx[MLO_POOLING_GLOBAL_GROUP_SZ];
+#endif
+
+    uint lcl_id  = get_local_id(0);
+    uint lane    = lcl_id & (MLO_POOLING_GLOBAL_LANES - 1);
+    uint plane   = get_group_id(0) * MLO_POOLING_GLOBAL_PLANES + lcl_id / MLO_POOLING_GLOBAL_LANES;
+    bool visible = plane < MLO_POOLING_BATCH_SZ * MLO_POOLING_N_OUTPUTS;
+    uint b       = plane / MLO_POOLING_N_OUTPUTS;
+    uint o       = plane - b * MLO_POOLING_N_OUTPUTS;
+    uint bot_off = b * MLO_POOLING_BOT_BATCH_STRIDE + o * MLO_POOLING_BOT_CHANNEL_STRIDE;
+
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+    _FLOAT res   = -FLT_MAX;
+    uint res_idx = MLO_POOLING_INDEX_MAX;
+#else
+    _FLOAT res = 0;
+#endif
+
+    for(uint i = lane; visible && i < MLO_POOLING_GLOBAL_PLANE_SZ; i += MLO_POOLING_GLOBAL_LANES)
+    {
+        uint h = i / MLO_POOLING_BOT_WIDTH;
+        uint w = i - h * MLO_POOLING_BOT_WIDTH;
+        _FLOAT bot_val = bot[bot_off + h * MLO_POOLING_BOT_STRIDE + w * MLO_POOLING_BOT_PIX_STRIDE];
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+        if(bot_val > res)
+        {
+            res     = bot_val;
+            res_idx = i;
+        }
+#else
+        res += bot_val;
+#endif
+    }
+
+    lcl_val[lcl_id] = res;
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+    lcl_idx[lcl_id] = res_idx;
+#endif
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(uint s = MLO_POOLING_GLOBAL_LANES / 2; s > 0; s >>= 1)
+    {
+        if(lane < s)
+        {
+            _FLOAT other = lcl_val[lcl_id + s];
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+            uint other_idx = lcl_idx[lcl_id + s];
+            if(other > res || (other == res && other_idx < res_idx))
+            {
+                res     = other;
+                res_idx = other_idx;
+            }
+            lcl_idx[lcl_id] = res_idx;
+#else
+            res += other;
+#endif
+            lcl_val[lcl_id] = res;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(visible && lane == 0)
+    {
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE
+        res *= (_FLOAT)1.f / (_FLOAT)MLO_POOLING_GLOBAL_PLANE_SZ;
+#endif
+        uint top_idx = b * MLO_POOLING_TOP_BATCH_STRIDE + o * MLO_POOLING_TOP_CHANNEL_STRIDE;
+        pooling_store(&top[top_idx], res, alpha, beta);
+#if defined(MLO_POOLING_DO_BACKWARD) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+        mask[top_idx] = (_INT_MASK_GLOBAL)res_idx;
+#endif
+    }
+}
@@ -35,9 +35,65 @@
  * J. L. Greathouse, M. Daga, Efficient sparse matrix-vector multiplication
  * on GPUs using the CSR storage format, in: Proc. Int'l Conf. High Performance
  * Computing, Networking, Storage and Analysis (SC'14)
+ *
+ * USE_SOFTMAX_LOG computes log-softmax instead, i.e. x - max - log(sum).
+ * All kernels read from one buffer and write to another, which may be the same
+ * buffer, and blend the result into the destination as alpha * r + beta * dst.
 */
 
-kernel void SoftmaxForward(global float* y, const int c, const int grid_size, const int spatial_dim)
+#ifndef USE_SOFTMAX_LOG
+#define USE_SOFTMAX_LOG 0
+#endif
+
+// Tensors are stored as _FLOAT_STORE, all reductions are done in float
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// The destination is only read for non-zero beta so it may be uninitialized
+inline void softmax_store(global _FLOAT_STORE* dst, float value, float alpha, float beta)
+{
+    *dst = (beta == 0.f) ? alpha * value : alpha * value + beta * (*dst);
+}
+
+inline float softmax_out(float x, float channel_max, float channel_sum)
+{
+#if USE_SOFTMAX_LOG
+    return x - channel_max - log(channel_sum);
+#else
+    return exp(x - channel_max) / channel_sum;
+#endif
+}
+
+// Backward reduces sum(y * dy) for softmax and sum(dy) for log-softmax
+inline float softmax_dot(float y, float dy)
+{
+#if USE_SOFTMAX_LOG
+    return dy;
+#else
+    return y * dy;
+#endif
+}
+
+inline float softmax_grad(float y, float dy, float channel_dot)
+{
+#if USE_SOFTMAX_LOG
+    return dy - exp(y) * channel_dot;
+#else
+    return y * (dy - channel_dot);
+#endif
+}
+
+kernel void SoftmaxForward(const global _FLOAT_STORE* x,
+                           global _FLOAT_STORE* y,
+                           const int c,
+                           const int grid_size,
+                           const int spatial_dim,
+                           const float alpha,
+                           const float beta)
 {
 #if NUM_BATCH == 1 // CSR-Vector like appraoch
 
@@ -70,7 +126,7 @@ kernel void SoftmaxForward(global float* y, const int c, const int grid_size, co
         // and compute max
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            t_helper = max(y[mad24(n, c, i) * spatial_dim + s], t_helper);
+            t_helper = max(x[mad24(n, c, i) * spatial_dim + s], t_helper);
         }
 
         // Now we have to compute the max from 256 values (one per each thread)
@@ -93,7 +149,7 @@ kernel void SoftmaxForward(global float* y, const int c, const int grid_size, co
         // Subtract channel_max from each value
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            float value = y[mad24(n, c, i) * spatial_dim + s];
+            float value = x[mad24(n, c, i) * spatial_dim + s];
 
             // Compute exponent of each value
             // Then sum all the values touched by this thread
@@ -119,14 +175,15 @@ kernel void SoftmaxForward(global float* y, const int c, const int grid_size, co
         // Normalize each value in the channel by the channel_sum
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            float value = y[mad24(n, c, i) * spatial_dim + s];
+            float value = x[mad24(n, c, i) * spatial_dim + s];
 
             // Subtracting max again because we do not write the output of
             // value-max to DRAM above. Doing a subtraction again is much
             // faster than writing uncoalesced to DRAM
-            value = exp(value - channel_max);
-
-            y[mad24(n, c, i) * spatial_dim + s] = value / channel_sum;
+            softmax_store(&y[mad24(n, c, i) * spatial_dim + s],
+                          softmax_out(value, channel_max, channel_sum),
+                          alpha,
+                          beta);
         }
     }
 
@@ -171,7 +228,7 @@ kernel void SoftmaxForward(global float* y, const int c, const int grid_size, co
     for(int i = batch_lid; i < c; i += BATCH_SIZE)
     {
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
-            value[i / BATCH_SIZE] = y[mad24(batch_n, c, i) * spatial_dim + batch_s];
+            value[i / BATCH_SIZE] = x[mad24(batch_n, c, i) * spatial_dim + batch_s];
         t_helper                  = max(value[i / BATCH_SIZE], t_helper);
     }
 
@@ -220,17 +277,24 @@ kernel void SoftmaxForward(global float* y, const int c, const int grid_size, co
     // Normalize each value in the channel by the channel_sum
     for(int i = batch_lid; i < c; i += BATCH_SIZE)
     {
-        value[i / BATCH_SIZE] = exp(value[i / BATCH_SIZE] - channel_max);
-
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
-            y[mad24(batch_n, c, i) * spatial_dim + batch_s] = value[i / BATCH_SIZE] / channel_sum;
+            softmax_store(&y[mad24(batch_n, c, i) * spatial_dim + batch_s],
+                          softmax_out(value[i / BATCH_SIZE], channel_max, channel_sum),
+                          alpha,
+                          beta);
     }
 
 #endif // CSR-Vector vs CSR-Stream
 }
 
-kernel void SoftmaxBackward(
-    global float* y, global float* dx, const int c, const int grid_size, const int spatial_dim)
+kernel void SoftmaxBackward(const global _FLOAT_STORE* y,
+                            const global _FLOAT_STORE* dy,
+                            global _FLOAT_STORE* dx,
+                            const int c,
+                            const int grid_size,
+                            const int spatial_dim,
+                            const float alpha,
+                            const float beta)
 {
 
 #if NUM_BATCH == 1 // CSR-Vector like appraoch
@@ -253,8 +317,8 @@ kernel void SoftmaxBackward(
         // and compute dot-product
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            channel_dot +=
-                (y[mad24(n, c, i) * spatial_dim + s] * dx[mad24(n, c, i) * spatial_dim + s]);
+            channel_dot += softmax_dot(y[mad24(n, c, i) * spatial_dim + s],
+                                       dy[mad24(n, c, i) * spatial_dim + s]);
         }
 
         // Now we have to compute the sum from 256 values (one per each thread)
@@ -276,9 +340,12 @@ kernel void SoftmaxBackward(
         // Subtract and element-wise multiplication
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            float value = dx[mad24(n, c, i) * spatial_dim + s] - channel_dot;
-
-            dx[mad24(n, c, i) * spatial_dim + s] = y[mad24(n, c, i) * spatial_dim + s] * value;
+            softmax_store(&dx[mad24(n, c, i) * spatial_dim + s],
+                          softmax_grad(y[mad24(n, c, i) * spatial_dim + s],
+                                       dy[mad24(n, c, i) * spatial_dim + s],
+                                       channel_dot),
+                          alpha,
+                          beta);
         }
     }
 
@@ -310,9 +377,9 @@ kernel void SoftmaxBackward(
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
         {
             y_value[i / BATCH_SIZE]  = y[mad24(batch_n, c, i) * spatial_dim + batch_s];
-            dx_value[i / BATCH_SIZE] = dx[mad24(batch_n, c, i) * spatial_dim + batch_s];
+            dx_value[i / BATCH_SIZE] = dy[mad24(batch_n, c, i) * spatial_dim + batch_s];
         }
-        channel_dot += y_value[i / BATCH_SIZE] * dx_value[i / BATCH_SIZE];
+        channel_dot += softmax_dot(y_value[i / BATCH_SIZE], dx_value[i / BATCH_SIZE]);
     }
 
     // Now we have to compute the sum from 256 values (one per each thread)
@@ -334,12 +401,124 @@ kernel void SoftmaxBackward(
     // Subtract and element-wise multiplication
     for(int i = batch_lid; i < c; i += BATCH_SIZE)
     {
-        dx_value[i / BATCH_SIZE] -= channel_dot;
-
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
-            dx[mad24(batch_n, c, i) * spatial_dim + batch_s] =
-                y_value[i / BATCH_SIZE] * dx_value[i / BATCH_SIZE];
+            softmax_store(&dx[mad24(batch_n, c, i) * spatial_dim + batch_s],
+                          softmax_grad(
+                              y_value[i / BATCH_SIZE], dx_value[i / BATCH_SIZE], channel_dot),
+                          alpha,
+                          beta);
     }
 
 #endif // CSR-Vector vs CSR-Stream
 }
+
+/* Wide rows: when there are only a few very wide rows (e.g. a softmax over a
+ * large vocabulary) a single workgroup per row leaves most of the GPU idle.
+ * Each row is instead split into NUM_PARTS chunks, one workgroup per chunk.
+ * The first kernel writes the max and the sum of exp(x - max) of each chunk
+ * to the workspace. The second one merges the partial results of its row,
+ * which only takes 2 * NUM_PARTS loads, and writes the output of its chunk.
+ */
+
+kernel void SoftmaxForwardWideStats(const global _FLOAT_STORE* x,
+                                    global float* partial,
+                                    const int c,
+                                    const int spatial_dim)
+{
+    local float l_helper[256];
+
+    int lid   = get_local_id(0);
+    int row   = get_group_id(0) / NUM_PARTS;
+    int part  = get_group_id(0) % NUM_PARTS;
+    int chunk = (c + NUM_PARTS - 1) / NUM_PARTS;
+    int c_st  = part * chunk;
+    int c_end = min(c, c_st + chunk);
+    int n     = row / spatial_dim;
+    int s     = row % spatial_dim;
+
+    float t_helper = -FLT_MAX;
+    for(int i = c_st + lid; i < c_end; i += get_local_size(0))
+    {
+        t_helper = max(x[mad24(n, c, i) * spatial_dim + s], t_helper);
+    }
+
+    l_helper[lid] = t_helper;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(int i = (get_local_size(0) >> 1); i > 0; i >>= 1)
+    {
+        if(lid < i)
+        {
+            l_helper[lid] = max(l_helper[lid], l_helper[lid + i]);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    float chunk_max = l_helper[0];
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    t_helper = 0.;
+    for(int i = c_st + lid; i < c_end; i += get_local_size(0))
+    {
+        t_helper += exp(x[mad24(n, c, i) * spatial_dim + s] - chunk_max);
+    }
+
+    l_helper[lid] = t_helper;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(int i = (get_local_size(0) >> 1); i > 0; i >>= 1)
+    {
+        if(lid < i)
+        {
+            l_helper[lid] += l_helper[lid + i];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(lid == 0)
+    {
+        partial[2 * get_group_id(0)]     = chunk_max;
+        partial[2 * get_group_id(0) + 1] = l_helper[0];
+    }
+}
+
+kernel void SoftmaxForwardWide(const global _FLOAT_STORE* x,
+                               global _FLOAT_STORE* y,
+                               const global float* partial,
+                               const int c,
+                               const int spatial_dim,
+                               const float alpha,
+                               const float beta)
+{
+    int lid   = get_local_id(0);
+    int row   = get_group_id(0) / NUM_PARTS;
+    int part  = get_group_id(0) % NUM_PARTS;
+    int chunk = (c + NUM_PARTS - 1) / NUM_PARTS;
+    int c_st  = part * chunk;
+    int c_end = min(c, c_st + chunk);
+    int n     = row / spatial_dim;
+    int s     = row % spatial_dim;
+
+    const global float* row_partial = partial + 2 * row * NUM_PARTS;
+
+    float channel_max = -FLT_MAX;
+    for(int p = 0; p < NUM_PARTS; p++)
+    {
+        channel_max = max(channel_max, row_partial[2 * p]);
+    }
+
+    // Rescale the chunk sums to the max of the whole row
+    float channel_sum = 0.;
+    for(int p = 0; p < NUM_PARTS; p++)
+    {
+        channel_sum += row_partial[2 * p + 1] * exp(row_partial[2 * p] - channel_max);
+    }
+
+    for(int i = c_st + lid; i < c_end; i += get_local_size(0))
+    {
+        softmax_store(&y[mad24(n, c, i) * spatial_dim + s],
+                      softmax_out(x[mad24(n, c, i) * spatial_dim + s], channel_max, channel_sum),
+                      alpha,
+                      beta);
+    }
+}
@@ -41,15 +41,20 @@
 #define MIOPEN_TENSOR_DIMS 4
 #endif
 
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#endif
+
 #define UNUSED __attribute__((__unused__))
 
-MIOPEN_TYPE miopenAdd(MIOPEN_TYPE a, MIOPEN_TYPE b) { return a + b; }
+// MIOPEN_TYPE is only used for storage, the arithmetic is done in float
+float miopenAdd(float a, float b) { return a + b; }
 
-MIOPEN_TYPE miopenMul(MIOPEN_TYPE a, MIOPEN_TYPE b) { return a * b; }
+float miopenMul(float a, float b) { return a * b; }
 
-MIOPEN_TYPE miopenMax(MIOPEN_TYPE a, MIOPEN_TYPE b) { return ((a > b) ? a : b); }
+float miopenMax(float a, float b) { return ((a > b) ? a : b); }
 
-MIOPEN_TYPE miopenMin(MIOPEN_TYPE a, MIOPEN_TYPE b) { return ((a < b) ? a : b); }
+float miopenMin(float a, float b) { return ((a < b) ? a : b); }
 
 __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
                               global MIOPEN_TYPE* b,
@@ -86,9 +91,9 @@ __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
     {
 
 #if INCR_WG == 1
-        int o_n             = gid / b_c;
-        int o_c             = gid % b_c;
-        MIOPEN_TYPE operand = b_off[o_c] * alpha1;
+        int o_n       = gid / b_c;
+        int o_c       = gid % b_c;
+        float operand = b_off[o_c] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -100,8 +105,8 @@ __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
 // each workgroup computes N*H*W for each C (bias-term)
 // number of workgroups = c_c (b_c)
 #elif INCR_WG == 0
-        MIOPEN_TYPE operand = b_off[gid] * alpha1;
-        int work_off        = work_per_wg / c_n;
+        float operand = b_off[gid] * alpha1;
+        int work_off  = work_per_wg / c_n;
 
         while(lid < work_per_wg)
         {
@@ -161,8 +166,8 @@ __kernel void OpTensorFwdBiasGeneric(global MIOPEN_TYPE* a,
         int o_c = gid % b_c;
         int o_n = gid / b_c;
 
-        int bindex          = o_c * b_cstride;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex    = o_c * b_cstride;
+        float operand = b_off[bindex] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -178,7 +183,7 @@ __kernel void OpTensorFwdBiasGeneric(global MIOPEN_TYPE* a,
 // each workgroup computes N*H*W for each C (bias-term)
 // number of workgroups = c_c (b_c)
 #elif INCR_WG == 0
-        MIOPEN_TYPE operand = b_off[gid * b_cstride] * alpha1;
+        float operand = b_off[gid * b_cstride] * alpha1;
         // int work_off        = work_per_wg / c_n;
 
         while(lid < work_per_wg)
@@ -249,7 +254,7 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
     for(; tid < num_wg; tid += MAX_NUM_WG)
     {
 
-        MIOPEN_TYPE operand = b_off[tid] * alpha1;
+        float operand = b_off[tid] * alpha1;
 
         int o_w = tid % c_w;
         int o_h = (tid / c_w) % c_h;
@@ -266,8 +271,8 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
     for(; gid < num_wg; gid += MAX_NUM_WG)
     {
 
-        int lid             = get_local_id(0);
-        MIOPEN_TYPE operand = b_off[gid] * alpha1;
+        int lid       = get_local_id(0);
+        float operand = b_off[gid] * alpha1;
 
         int o_h = gid % c_h;
         int o_c = (gid / c_h) % c_c;
@@ -287,8 +292,8 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
     for(; gid < num_wg; gid += MAX_NUM_WG)
     {
 
-        int lid             = get_local_id(0);
-        MIOPEN_TYPE operand = b_off[gid] * alpha1;
+        int lid       = get_local_id(0);
+        float operand = b_off[gid] * alpha1;
 
         int o_c = gid % c_c;
         int o_n = gid / c_c;
@@ -307,8 +312,8 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
     // MAX_NUM_WG: the maximum number of workgroups actually launched
     for(; gid < num_wg; gid += MAX_NUM_WG)
     {
-        int lid             = get_local_id(0);
-        MIOPEN_TYPE operand = b_off[gid] * alpha1;
+        int lid       = get_local_id(0);
+        float operand = b_off[gid] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -373,7 +378,7 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
     global MIOPEN_TYPE* c_off = c + Coffset;
 #if FIRST_NOT_ONE == 3 // bitmap = 1,1,1,1
     int tid = get_global_id(0);
-    // MIOPEN_TYPE operand = b[tid];
+    // float operand = b[tid];
 
     // num_wg: the number of workgroups should be launched
     // MAX_NUM_WG: the maximum number of workgroups actually launched
@@ -404,8 +409,8 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
         int o_c = (gid / c_h) % c_c;
         int o_n = gid / (c_c * c_h);
 
-        int bindex          = o_n * b_nstride + o_c * b_cstride + o_h * b_hstride;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex    = o_n * b_nstride + o_c * b_cstride + o_h * b_hstride;
+        float operand = b_off[bindex] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -428,8 +433,8 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
         int o_c = gid % c_c;
         int o_n = gid / c_c;
 
-        int bindex          = o_n * b_nstride + o_c * b_cstride;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex    = o_n * b_nstride + o_c * b_cstride;
+        float operand = b_off[bindex] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -450,8 +455,8 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
     // MAX_NUM_WG: the maximum number of workgroups actually launched
     for(; gid < num_wg; gid += MAX_NUM_WG)
     {
-        int lid             = get_local_id(0);
-        MIOPEN_TYPE operand = b_off[gid * b_nstride] * alpha1;
+        int lid       = get_local_id(0);
+        float operand = b_off[gid * b_nstride] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -505,7 +510,7 @@ __kernel void Op4dTensorGeneric(global MIOPEN_TYPE* a,
     global MIOPEN_TYPE* b_off = b + Boffset;
     global MIOPEN_TYPE* c_off = c + Coffset;
 
-    // MIOPEN_TYPE operand = b[gid + Boffset];
+    // float operand = b[gid + Boffset];
     // num_wg: the number of workgroups should be launched
     // MAX_NUM_WG: the maximum number of workgroups actually launched
     for(; gid < num_wg; gid += MAX_NUM_WG)
@@ -523,7 +528,7 @@ __kernel void Op4dTensorGeneric(global MIOPEN_TYPE* a,
 
         int bindex = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off * b_hstride +
                      o_w_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        float operand = b_off[bindex] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -604,7 +609,7 @@ __kernel void Op5dTensorGeneric(global MIOPEN_TYPE* a,
         int bindex = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_d_gid_off * b_dstride +
                      o_h_gid_off * b_hstride + o_w_gid_off;
 
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        float operand = b_off[bindex] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -663,7 +668,7 @@ __kernel void Op3dTensorGeneric(global MIOPEN_TYPE* a,
     {
 
         int lid = get_local_id(0);
-        // MIOPEN_TYPE operand = b[gid + Boffset];
+        // float operand = b[gid + Boffset];
         int o_c_div = bitmap & (1 << 0) ? 1 : c_h;
         int o_n_div = o_c_div * (bitmap & (1 << 1) ? 1 : c_c);
 
@@ -671,8 +676,8 @@ __kernel void Op3dTensorGeneric(global MIOPEN_TYPE* a,
         int o_c_gid_off = (gid / b_h) % b_c;
         int o_n_gid_off = (gid / b_h) / b_c;
 
-        int bindex          = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex    = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off;
+        float operand = b_off[bindex] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -727,8 +732,8 @@ __kernel void Op2dTensorGeneric(global MIOPEN_TYPE* a,
         int o_c_gid_off = gid % b_c;
         int o_n_gid_off = gid / b_c;
 
-        int bindex          = o_n_gid_off * b_nstride + o_c_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex    = o_n_gid_off * b_nstride + o_c_gid_off;
+        float operand = b_off[bindex] * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -769,10 +774,10 @@ __kernel void Op1dTensorGeneric(global MIOPEN_TYPE* a,
     // MAX_NUM_WG: the maximum number of workgroups actually launched
     for(; gid < num_wg; gid += MAX_NUM_WG)
     {
-        int lid             = get_local_id(0);
-        int o_n_gid_off     = gid % b_n;
-        int bindex          = o_n_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int lid         = get_local_id(0);
+        int o_n_gid_off = gid % b_n;
+        int bindex      = o_n_gid_off;
+        float operand   = b_off[bindex] * alpha1;
         while(lid < work_per_wg)
         {
             int o_n    = (bitmap & (1 << 0)) ? o_n_gid_off : lid % c_n;
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#endif
+
+#ifndef MIOPEN_SRC_TYPE
+#define MIOPEN_SRC_TYPE float
+#endif
+
+#ifndef MIOPEN_DST_TYPE
+#define MIOPEN_DST_TYPE float
+#endif
+
+#ifndef MIOPEN_TRANSFORM_USE_BETA
+#define MIOPEN_TRANSFORM_USE_BETA 0
+#endif
+
+#define TRANSFORM_TILE 32
+#define TRANSFORM_TILE_ROWS 8
+
+inline void StoreTransformed(global MIOPEN_DST_TYPE* y, long idx, float val, float beta)
+{
+#if MIOPEN_TRANSFORM_USE_BETA
+    val += beta * (float)y[idx];
+#else
+    (void)beta;
+#endif
+    y[idx] = (MIOPEN_DST_TYPE)val;
+}
+
+// Transposes the dimension that is contiguous in x (a) with the one that is
+// contiguous in y (b) through a local memory tile, so that both the reads and the
+// writes of a work group are coalesced. Each work group moves one 32x32 tile of one
+// slice, the slice being selected by the up to three remaining dimensions.
+__attribute__((reqd_work_group_size(TRANSFORM_TILE, TRANSFORM_TILE_ROWS, 1))) __kernel void
+TransformTensorTiled(const global MIOPEN_SRC_TYPE* x,
+                     long x_offset,
+                     global MIOPEN_DST_TYPE* y,
+                     long y_offset,
+                     float alpha,
+                     float beta,
+                     int len_a,
+                     int len_b,
+                     int x_stride_b,
+                     int y_stride_a,
+                     int len1,
+                     int len2,
+                     int x_stride0,
+                     int x_stride1,
+                     int x_stride2,
+                     int y_stride0,
+                     int y_stride1,
+                     int y_stride2)
+{
+    local float tile[TRANSFORM_TILE][TRANSFORM_TILE + 1];
+
+    int lx    = get_local_id(0);
+    int ly    = get_local_id(1);
+    int a0    = get_group_id(0) * TRANSFORM_TILE;
+    int b0    = get_group_id(1) * TRANSFORM_TILE;
+    int slice = get_group_id(2);
+
+    int i2 = slice % len2;
+    int i1 = (slice / len2) % len1;
+    int i0 = slice / (len2 * len1);
+    x += x_offset + (long)i0 * x_stride0 + (long)i1 * x_stride1 + (long)i2 * x_stride2;
+    y += y_offset + (long)i0 * y_stride0 + (long)i1 * y_stride1 + (long)i2 * y_stride2;
+
+    int a = a0 + lx;
+    for(int r = ly; r < TRANSFORM_TILE; r += TRANSFORM_TILE_ROWS)
+    {
+        int b = b0 + r;
+        if(a < len_a && b < len_b)
+            tile[r][lx] = (float)x[a + (long)b * x_stride_b];
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    int b = b0 + lx;
+    for(int r = ly; r < TRANSFORM_TILE; r += TRANSFORM_TILE_ROWS)
+    {
+        a = a0 + r;
+        if(a < len_a && b < len_b)
+            StoreTransformed(y, b + (long)a * y_stride_a, alpha * tile[lx][r], beta);
+    }
+}
+
+// One element per work item, the dimensions ordered so that consecutive work items
+// write consecutive elements of y.
+__kernel void TransformTensor(const global MIOPEN_SRC_TYPE* x,
+                              long x_offset,
+                              global MIOPEN_DST_TYPE* y,
+                              long y_offset,
+                              float alpha,
+                              float beta,
+                              long n,
+                              int len1,
+                              int len2,
+                              int len3,
+                              int len4,
+                              int x_stride0,
+                              int x_stride1,
+                              int x_stride2,
+                              int x_stride3,
+                              int x_stride4,
+                              int y_stride0,
+                              int y_stride1,
+                              int y_stride2,
+                              int y_stride3,
+                              int y_stride4)
+{
+    for(long gid = get_global_id(0); gid < n; gid += get_global_size(0))
+    {
+        long idx = gid;
+        int i4   = idx % len4;
+        idx /= len4;
+        int i3 = idx % len3;
+        idx /= len3;
+        int i2 = idx % len2;
+        idx /= len2;
+        int i1 = idx % len1;
+        int i0 = idx / len1;
+
+        long x_idx = x_offset + (long)i0 * x_stride0 + (long)i1 * x_stride1 +
+                     (long)i2 * x_stride2 + (long)i3 * x_stride3 + (long)i4 * x_stride4;
+        long y_idx = y_offset + (long)i0 * y_stride0 + (long)i1 * y_stride1 +
+                     (long)i2 * y_stride2 + (long)i3 * y_stride3 + (long)i4 * y_stride4;
+        StoreTransformed(y, y_idx, alpha * (float)x[x_idx], beta);
+    }
+}
@@ -63,8 +63,16 @@
  * }
  */
 
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
+// The image is read as _FLOAT_STORE, the column buffer is always float
 kernel void Im2Col(const int data_size_off,
-                   global float* im,
+                   global _FLOAT_STORE* im,
                    size_t im_offset,
                    const int h,
                    const int w,
@@ -88,9 +96,9 @@ kernel void Im2Col(const int data_size_off,
 #define IM_OFF_GUARD(idx) im_off[idx]
 #endif
 
-    global float* im_off = im + im_offset;
-    int lid              = get_local_id(0);
-    int gid              = get_group_id(0);
+    global _FLOAT_STORE* im_off = im + im_offset;
+    int lid                     = get_local_id(0);
+    int gid                     = get_group_id(0);
 
 #if NUM_IM_BLKS == 1 && STRIDE_GT_1 == 0
 
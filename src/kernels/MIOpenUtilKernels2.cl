@@ -23,6 +23,13 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT_STORE half
+#else
+#define _FLOAT_STORE float
+#endif
+
 __kernel void Col2Im(global float* col,
                      const int col_h,
                      const int col_w,
@@ -75,3 +82,61 @@ __kernel void Col2Im(global float* col,
     }
     im_off[gid] = tmp;
 }
+
+__kernel void CastToFloat(const global _FLOAT_STORE* src,
+                          size_t src_offset,
+                          global float* dst,
+                          size_t dst_offset,
+                          const int n)
+{
+    for(int gid = (int)get_global_id(0); gid < n; gid += (int)get_global_size(0))
+        dst[dst_offset + gid] = (float)src[src_offset + gid];
+}
+
+__kernel void CastFromFloat(const global float* src,
+                            size_t src_offset,
+                            global _FLOAT_STORE* dst,
+                            size_t dst_offset,
+                            const int n)
+{
+    for(int gid = (int)get_global_id(0); gid < n; gid += (int)get_global_size(0))
+        dst[dst_offset + gid] = (_FLOAT_STORE)src[src_offset + gid];
+}
+
+// Unfolds one channels-last image into the same column matrix Im2Col builds for NCHW,
+// with rows (channel, filter y, filter x) and one column per output pixel.
+__kernel void Im2ColNHWC(const global _FLOAT_STORE* im,
+                         size_t im_offset,
+                         const int c,
+                         const int h,
+                         const int w,
+                         const int wei_h,
+                         const int wei_w,
+                         const int out_h,
+                         const int out_w,
+                         const int pad_h,
+                         const int pad_w,
+                         const int stride_h,
+                         const int stride_w,
+                         const int dilation_h,
+                         const int dilation_w,
+                         global float* col)
+{
+    const int col_w = out_h * out_w;
+    const int n     = c * wei_h * wei_w * col_w;
+    for(int gid = (int)get_global_id(0); gid < n; gid += (int)get_global_size(0))
+    {
+        int col_row = gid / col_w;
+        int col_pix = gid % col_w;
+
+        int im_ch = col_row / (wei_h * wei_w);
+        int wei_y = (col_row / wei_w) % wei_h;
+        int wei_x = col_row % wei_w;
+
+        int im_y = (col_pix / out_w) * stride_h - pad_h + wei_y * dilation_h;
+        int im_x = (col_pix % out_w) * stride_w - pad_w + wei_x * dilation_w;
+
+        bool inside = im_y >= 0 && im_y < h && im_x >= 0 && im_x < w;
+        col[gid]    = inside ? (float)im[im_offset + (im_y * w + im_x) * c + im_ch] : 0.0f;
+    }
+}
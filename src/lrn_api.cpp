@@ -32,7 +32,7 @@
 extern "C" miopenStatus_t miopenCreateLRNDescriptor(miopenLRNDescriptor_t* lrnDesc)
 {
 
-    return miopen::try_([&] { miopen::deref(lrnDesc) = new miopen::LRNDescriptor(); });
+    return miopen::try_(__func__, [&] { miopen::deref(lrnDesc) = new miopen::LRNDescriptor(); });
 }
 
 extern "C" miopenStatus_t miopenSetLRNDescriptor(miopenLRNDescriptor_t lrnDesc,
@@ -43,7 +43,7 @@ extern "C" miopenStatus_t miopenSetLRNDescriptor(miopenLRNDescriptor_t lrnDesc,
                                                  double lrnK)
 {
     MIOPEN_LOG_FUNCTION(lrnDesc, mode, lrnN, lrnAlpha, lrnBeta, lrnK);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         std::initializer_list<double> parms = {lrnAlpha, lrnBeta, lrnK};
         miopen::deref(lrnDesc)              = miopen::LRNDescriptor(mode, lrnN, parms.begin());
     });
@@ -58,7 +58,7 @@ extern "C" miopenStatus_t miopenGetLRNDescriptor(const miopenLRNDescriptor_t lrn
 {
 
     MIOPEN_LOG_FUNCTION(lrnDesc, mode, lrnN, lrnAlpha, lrnBeta, lrnK);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         *mode     = miopen::deref(lrnDesc).GetMode();
         *lrnN     = miopen::deref(lrnDesc).GetN();
         *lrnAlpha = miopen::deref(lrnDesc).GetAlpha();
@@ -72,7 +72,7 @@ extern "C" miopenStatus_t miopenLRNGetWorkSpaceSize(const miopenTensorDescriptor
 {
 
     // TODO: Supporting size 4 bytes only
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(workSpaceSize) = miopen::deref(yDesc).GetLengths()[0] *
                                        miopen::deref(yDesc).GetStrides()[0] * sizeof(float);
     });
@@ -91,7 +91,7 @@ extern "C" miopenStatus_t miopenLRNForward(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(lrnDesc, alpha, xDesc, x, beta, yDesc, y, do_backward, workSpace);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(lrnDesc).Forward(miopen::deref(handle),
                                        alpha,
                                        miopen::deref(xDesc),
@@ -121,7 +121,7 @@ extern "C" miopenStatus_t miopenLRNBackward(miopenHandle_t handle,
 
     MIOPEN_LOG_FUNCTION(
         lrnDesc, alpha, yDesc, y, dyDesc, dy, xDesc, x, beta, dxDesc, dx, workSpace);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(lrnDesc).Backward(miopen::deref(handle),
                                         alpha,
                                         miopen::deref(yDesc),
@@ -140,5 +140,5 @@ extern "C" miopenStatus_t miopenLRNBackward(miopenHandle_t handle,
 extern "C" miopenStatus_t miopenDestroyLRNDescriptor(miopenLRNDescriptor_t lrnDesc)
 {
     MIOPEN_LOG_FUNCTION(lrnDesc);
-    return miopen::try_([&] { miopen_destroy_object(lrnDesc); });
+    return miopen::try_(__func__, [&] { miopen_destroy_object(lrnDesc); });
 }
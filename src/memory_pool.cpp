@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/errors.hpp>
+#include <miopen/memory_pool.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace miopen {
+
+MemoryPool::MemoryPool(miopenAllocatorFunction pallocator,
+                       miopenDeallocatorFunction pdeallocator,
+                       void* pcontext)
+    : allocator(pallocator), deallocator(pdeallocator), context(pcontext)
+{
+    assert(allocator != nullptr);
+    assert(deallocator != nullptr);
+}
+
+MemoryPool::~MemoryPool() { TrimLocked(); }
+
+std::size_t MemoryPool::GetSizeClass(std::size_t n)
+{
+    const std::size_t min_size = 256;
+    if(n <= min_size)
+        return min_size;
+
+    std::size_t octave = min_size;
+    while(octave * 2 < n)
+        octave *= 2;
+    const std::size_t step = octave / 4;
+    return (n + step - 1) / step * step;
+}
+
+void* MemoryPool::Acquire(std::size_t n)
+{
+    const auto size = GetSizeClass(n);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    void* result = nullptr;
+    auto it      = cached.find(size);
+    if(it != cached.end() && !it->second.empty())
+    {
+        result = it->second.back();
+        it->second.pop_back();
+        stats.bytes_cached -= size;
+        stats.reuses++;
+    }
+    else
+    {
+        // On failure give the cached buffers back and try once more
+        try
+        {
+            result = allocator(context, size);
+        }
+        catch(const Exception&)
+        {
+            if(stats.bytes_cached == 0)
+                throw;
+        }
+        if(result == nullptr && stats.bytes_cached > 0)
+        {
+            TrimLocked();
+            result = allocator(context, size);
+        }
+        if(result == nullptr)
+        {
+            MIOPEN_THROW("Custom allocator failed to allocate memory for buffer size " +
+                         std::to_string(size) + ": ");
+        }
+        stats.allocations++;
+    }
+    stats.bytes_in_use += size;
+    stats.high_water_mark =
+        std::max(stats.high_water_mark, stats.bytes_in_use + stats.bytes_cached);
+    return result;
+}
+
+void MemoryPool::Release(void* buffer, std::size_t n)
+{
+    const auto size = GetSizeClass(n);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    cached[size].push_back(buffer);
+    stats.bytes_in_use -= size;
+    stats.bytes_cached += size;
+}
+
+void MemoryPool::Trim()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    TrimLocked();
+}
+
+void MemoryPool::TrimLocked()
+{
+    for(auto&& p : cached)
+    {
+        for(auto buffer : p.second)
+            deallocator(context, buffer);
+    }
+    cached.clear();
+    stats.bytes_cached = 0;
+}
+
+MemoryPoolStats MemoryPool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+} // namespace miopen
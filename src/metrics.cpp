@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/metrics.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_METRICS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_METRICS_DUMP_INTERVAL)
+
+namespace {
+
+double NowUs()
+{
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+const char* CounterName(std::size_t i)
+{
+    static const char* const names[] = {"kernel_cache_hits",
+                                        "kernel_cache_misses",
+                                        "binary_cache_hits",
+                                        "binary_cache_misses",
+                                        "perf_db_hits",
+                                        "perf_db_misses"};
+    static_assert(sizeof(names) / sizeof(names[0]) ==
+                      static_cast<std::size_t>(MetricsCounter::Count),
+                  "Missing counter name");
+    return names[i];
+}
+
+/// Never destroyed, so API calls made during static destruction can still
+/// record into it.
+struct Registry
+{
+    std::atomic<bool> enabled;
+    std::array<std::atomic<std::size_t>, static_cast<std::size_t>(MetricsCounter::Count)> counters;
+    std::mutex mutex;
+    std::unordered_map<const char*, ApiMetrics> apis;
+    double dump_interval_us;
+    double last_dump_us;
+
+    Registry()
+        : enabled(IsEnabled(MIOPEN_METRICS{})),
+          dump_interval_us(Value(MIOPEN_METRICS_DUMP_INTERVAL{}) * 1e6),
+          last_dump_us(NowUs())
+    {
+        for(auto&& c : counters)
+            c = 0;
+        if(dump_interval_us > 0)
+            std::atexit([] {
+                if(IsMetricsEnabled())
+                    DumpMetrics(std::cerr);
+            });
+    }
+
+    static Registry& Get()
+    {
+        static auto* registry = new Registry();
+        return *registry;
+    }
+};
+
+thread_local ApiCallMetrics* current_call = nullptr;
+
+} // namespace
+
+std::size_t ApiMetrics::GetBucket(double us)
+{
+    if(us < 2)
+        return 0;
+    return std::min<std::size_t>(static_cast<std::size_t>(std::log2(us)), HistogramBuckets - 1);
+}
+
+bool IsMetricsEnabled() { return Registry::Get().enabled.load(std::memory_order_relaxed); }
+
+void EnableMetrics(bool enable) { Registry::Get().enabled = enable; }
+
+void IncrementMetric(MetricsCounter counter)
+{
+    auto& r = Registry::Get();
+    if(r.enabled.load(std::memory_order_relaxed))
+        r.counters[static_cast<std::size_t>(counter)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecordDeviceTime(float ms)
+{
+    if(current_call != nullptr)
+        current_call->AddDeviceTime(ms);
+}
+
+std::vector<ApiMetrics> GetApiMetrics()
+{
+    auto& r = Registry::Get();
+    std::vector<ApiMetrics> result;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        result.reserve(r.apis.size());
+        for(auto&& p : r.apis)
+            result.push_back(p.second);
+    }
+    std::sort(result.begin(), result.end(), [](const ApiMetrics& x, const ApiMetrics& y) {
+        return std::strcmp(x.name, y.name) < 0;
+    });
+    return result;
+}
+
+CacheMetrics GetCacheMetrics()
+{
+    auto& r = Registry::Get();
+    CacheMetrics result{};
+    for(std::size_t i = 0; i < result.size(); i++)
+        result[i] = r.counters[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+void ResetMetrics()
+{
+    auto& r = Registry::Get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.apis.clear();
+    for(auto&& c : r.counters)
+        c = 0;
+}
+
+void DumpMetrics(std::ostream& os)
+{
+    const auto apis     = GetApiMetrics();
+    const auto counters = GetCacheMetrics();
+    os << PlatformName() << ": Metrics {" << std::endl;
+    for(auto&& m : apis)
+    {
+        os << "    " << m.name << ": calls = " << m.calls << ", errors = " << m.errors
+           << ", host_us = " << m.host_us << ", max_host_us = " << m.max_host_us
+           << ", device_us = " << m.device_us << std::endl;
+    }
+    for(std::size_t i = 0; i < counters.size(); i++)
+        os << "    " << CounterName(i) << " = " << counters[i] << std::endl;
+    os << "}" << std::endl;
+}
+
+ApiCallMetrics::ApiCallMetrics(const char* pname)
+    : name(pname), start_us(NowUs()), previous(current_call)
+{
+    current_call = this;
+}
+
+ApiCallMetrics::~ApiCallMetrics() { current_call = previous; }
+
+miopenStatus_t ApiCallMetrics::Finish(miopenStatus_t status)
+{
+    const auto now     = NowUs();
+    const auto host_us = now - start_us;
+    auto& r            = Registry::Get();
+    bool dump          = false;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto& m = r.apis[name];
+        m.name  = name;
+        m.calls++;
+        if(status != miopenStatusSuccess)
+            m.errors++;
+        m.host_us += host_us;
+        m.max_host_us = std::max(m.max_host_us, host_us);
+        m.device_us += device_ms * 1e3;
+        m.host_histogram[ApiMetrics::GetBucket(host_us)]++;
+
+        if(r.dump_interval_us > 0 && now - r.last_dump_us >= r.dump_interval_us)
+        {
+            r.last_dump_us = now;
+            dump           = true;
+        }
+    }
+    if(dump)
+        DumpMetrics(std::cerr);
+    return status;
+}
+
+} // namespace miopen
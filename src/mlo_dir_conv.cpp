@@ -36,6 +36,7 @@
 #include <unordered_map>
 
 #include <miopen/solver.hpp>
+#include <miopen/datatype.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/gcn_asm_utils.hpp>
@@ -74,6 +75,75 @@ void mlo_construct_direct2D::setupRocm()
     }
 }
 
+bool miopen::ProblemDescription::ParseKey(const std::string& key)
+{
+    std::vector<std::string> fields;
+    std::istringstream ss(key);
+    std::string field;
+    while(std::getline(ss, field, '-'))
+        fields.push_back(field);
+    if(fields.size() != 15)
+        return false;
+
+    const auto one = [&](std::size_t i, int& v) {
+        char tail;
+        return std::sscanf(fields[i].c_str(), "%d%c", &v, &tail) == 1;
+    };
+    const auto two = [&](std::size_t i, int& v1, int& v0) {
+        char tail;
+        return std::sscanf(fields[i].c_str(), "%dx%d%c", &v1, &v0, &tail) == 2;
+    };
+
+    ProblemDescription p;
+    // clang-format off
+    if(!(one(0, p.n_inputs) && one(1, p.in_height) && one(2, p.in_width) &&
+         two(3, p.kernel_size1, p.kernel_size0) &&
+         one(4, p.n_outputs) && one(5, p.out_height) && one(6, p.out_width) &&
+         one(7, p.batch_sz) &&
+         two(8, p.pad1, p.pad0) &&
+         two(9, p.kernel_stride1, p.kernel_stride0) &&
+         two(10, p.kernel_dilation1, p.kernel_dilation0) &&
+         one(11, p.bias))) // clang-format on
+        return false;
+
+    if(fields[14] == "F")
+        p.direction.Set(1);
+    else if(fields[14] == "B")
+        p.direction.Set(0);
+    else if(fields[14] == "W")
+        p.direction.SetBackwardWrW();
+    else
+        return false;
+
+    p.in_layout    = fields[12];
+    p.in_data_type = fields[13];
+    *this          = p;
+    return true;
+}
+
+double miopen::ProblemDescription::Distance(const ProblemDescription& other) const
+{
+    // Only kernel_dilation1 takes part in the key, see Serialize().
+    if(kernel_size0 != other.kernel_size0 || kernel_size1 != other.kernel_size1 ||
+       kernel_stride0 != other.kernel_stride0 || kernel_stride1 != other.kernel_stride1 ||
+       kernel_dilation1 != other.kernel_dilation1 || bias != other.bias ||
+       in_layout != other.in_layout || in_data_type != other.in_data_type ||
+       direction.IsForward() != other.direction.IsForward() ||
+       direction.IsBackwardData() != other.direction.IsBackwardData())
+        return -1;
+
+    const auto ratio = [](int a, int b) {
+        return std::fabs(std::log2(a + 1.0) - std::log2(b + 1.0));
+    };
+
+    // Batch size affects tuning less than the image and channel sizes do.
+    return ratio(n_inputs, other.n_inputs) + ratio(n_outputs, other.n_outputs) +
+           ratio(in_height, other.in_height) + ratio(in_width, other.in_width) +
+           ratio(out_height, other.out_height) + ratio(out_width, other.out_width) +
+           0.25 * ratio(batch_sz, other.batch_sz) + std::abs(pad0 - other.pad0) +
+           std::abs(pad1 - other.pad1);
+}
+
 miopen::DbRecord mlo_construct_direct2D::GetDbRecord() const
 {
 #if MIOPEN_PERFDB_CONV_LEGACY_SUPPORT
@@ -377,10 +447,12 @@ mlo_construct_direct2D::setWeightDescFromMLDesc(const miopen::TensorDescriptor&
     std::tie(nWeiStride, cWeiStride, hWeiStride, wWeiStride) =
         miopen::tien<4>(weight_tensor.GetStrides());
 
+    const auto layout    = weight_tensor.GetLayout();
+    const auto data_type = miopen::GetMloDataType(weight_tensor.GetType());
     setWeightsDescr(
-        "NCHW", "FP32", nWei, cWei, hWei, wWei, nWeiStride, cWeiStride, hWeiStride, wWeiStride);
+        layout, data_type, nWei, cWei, hWei, wWei, nWeiStride, cWeiStride, hWeiStride, wWeiStride);
 
-    size_t weights_sz = nWei * cWei * hWei * wWei * sizeof(float);
+    size_t weights_sz = nWei * cWei * hWei * wWei * miopen::GetTypeSize(weight_tensor.GetType());
     return weights_sz;
 }
 
@@ -401,10 +473,12 @@ mlo_construct_direct2D::setOutputDescFromMLDesc(const miopen::TensorDescriptor&
     std::tie(nOutStride, cOutStride, hOutStride, wOutStride) =
         miopen::tien<4>(output_tensor.GetStrides());
 
+    const auto layout    = output_tensor.GetLayout();
+    const auto data_type = miopen::GetMloDataType(output_tensor.GetType());
     setOutputDescr(
-        "NCHW", "FP32", nOut, cOut, hOut, wOut, nOutStride, cOutStride, hOutStride, wOutStride);
+        layout, data_type, nOut, cOut, hOut, wOut, nOutStride, cOutStride, hOutStride, wOutStride);
 
-    size_t output_sz = nOut * cOut * hOut * wOut * sizeof(float);
+    size_t output_sz = nOut * cOut * hOut * wOut * miopen::GetTypeSize(output_tensor.GetType());
     return output_sz;
 }
 
@@ -424,9 +498,12 @@ size_t mlo_construct_direct2D::setInputDescFromMLDesc(const miopen::TensorDescri
     std::tie(nInStride, cInStride, hInStride, wInStride) =
         miopen::tien<4>(input_tensor.GetStrides());
 
-    setInputDescr("NCHW", "FP32", nIn, cIn, hIn, wIn, nInStride, cInStride, hInStride, wInStride);
+    const auto layout    = input_tensor.GetLayout();
+    const auto data_type = miopen::GetMloDataType(input_tensor.GetType());
+    setInputDescr(
+        layout, data_type, nIn, cIn, hIn, wIn, nInStride, cInStride, hInStride, wInStride);
 
-    size_t input_sz = nIn * cIn * hIn * wIn * sizeof(float);
+    size_t input_sz = nIn * cIn * hIn * wIn * miopen::GetTypeSize(input_tensor.GetType());
 
     return input_sz;
 }
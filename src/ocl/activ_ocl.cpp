@@ -24,12 +24,27 @@
  *
  *******************************************************************************/
 #include <miopen/activ.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/mlo_internal.hpp>
-#include <miopen/float_equal.hpp>
+
+#include <algorithm>
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ACTIVATION_PACKED)
+
+// x and y hold their elements in the same order without gaps, so the activation can be applied
+// to them as flat arrays
+static bool IsPackedActivation(const TensorDescriptor& xDesc, const TensorDescriptor& yDesc)
+{
+    return xDesc.GetElementSize() == xDesc.GetElementSpace() &&
+           yDesc.GetElementSize() == yDesc.GetElementSpace() &&
+           xDesc.GetLengths() == yDesc.GetLengths() && xDesc.GetStrides() == yDesc.GetStrides() &&
+           !miopen::IsDisabled(MIOPEN_DEBUG_ACTIVATION_PACKED{});
+}
+
 miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                                              const void* alpha,
                                              const TensorDescriptor& xDesc,
@@ -41,13 +56,52 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                                              size_t yOffset)
 {
 
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    if(alpha == nullptr || beta == nullptr)
     {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+        MIOPEN_THROW(miopenStatusBadParm, "alpha and beta must not be null");
+    }
+    if(xDesc.GetType() != yDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Input and output tensor types do not match.");
     }
     miopenStatus_t status = miopenStatusSuccess;
 
+    const float miopen_alpha = *(static_cast<const float*>(alpha));
+    const float miopen_beta  = *(static_cast<const float*>(beta));
+
+    if(IsPackedActivation(xDesc, yDesc))
+    {
+        // A single program for every shape and mode. Enough work groups are launched to fill the
+        // device and each work item strides over the rest of the tensor.
+        const std::size_t n          = xDesc.GetElementSize();
+        const std::size_t local_size = 256;
+        const std::size_t max_groups = handle.GetMaxComputeUnits() * 8;
+        const std::size_t groups     = std::max<std::size_t>(
+            1, std::min((n / 4 + local_size - 1) / local_size, max_groups));
+
+        const std::vector<size_t> vld = {local_size, 1, 1};
+        const std::vector<size_t> vgd = {groups * local_size, 1, 1};
+
+        handle.GetKernel("miopenActivationForwardPacked",
+                         "",
+                         "MIOpenNeuronPacked.cl",
+                         "MIOpenNeuronFwdPacked",
+                         vld,
+                         vgd,
+                         GetDataTypeKernelParams(xDesc.GetType()))(x,
+                                                                   y,
+                                                                   static_cast<int>(mode),
+                                                                   static_cast<float>(GetPower()),
+                                                                   static_cast<float>(GetBeta()),
+                                                                   static_cast<float>(GetAlpha()),
+                                                                   long(xOffset),
+                                                                   long(yOffset),
+                                                                   long(n),
+                                                                   miopen_alpha,
+                                                                   miopen_beta);
+        return status;
+    }
+
     mlo_construct_neuron construct_params(1); // forward
 
     construct_params.setStream(&handle);
@@ -96,8 +150,16 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
         MIOPEN_THROW("activation does not support tensor size larger than 4 or smaller than 1");
     }
 
-    construct_params.setTopDescr(
-        "NCHW", "FP32", nOut, cOut, hOut, wOut, nOutStride, cOutStride, hOutStride, wOutStride);
+    construct_params.setTopDescr("NCHW",
+                                 GetMloDataType(yDesc.GetType()),
+                                 nOut,
+                                 cOut,
+                                 hOut,
+                                 wOut,
+                                 nOutStride,
+                                 cOutStride,
+                                 hOutStride,
+                                 wOutStride);
     int nIn       = 1;
     int cIn       = 1;
     int hIn       = 1;
@@ -143,8 +205,16 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
             "Activation does not support tensor dimension larger than 4 or smaller than 1");
     }
 
-    construct_params.setBotDescr(
-        "NCHW", "FP32", nIn, cIn, hIn, wIn, nInStride, cInStride, hInStride, wInStride);
+    construct_params.setBotDescr("NCHW",
+                                 GetMloDataType(xDesc.GetType()),
+                                 nIn,
+                                 cIn,
+                                 hIn,
+                                 wIn,
+                                 nInStride,
+                                 cInStride,
+                                 hInStride,
+                                 wInStride);
 
     double activ_alpha = GetAlpha();
     double activ_beta  = GetBeta();
@@ -191,6 +261,7 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
         std::to_string(1) + " -DMLO_IN_BLOCK_SZ=" + std::to_string(cIn * hIn * wIn) +
         " -DMLO_OUT_BLOCK_SZ=" + std::to_string(cOut * hOut * wOut) + " -DMLO_DIN_BLOCK_SZ=" +
         std::to_string(1) + " -DMLO_DOUT_BLOCK_SZ=" + std::to_string(1);
+    compiler_options += GetDataTypeKernelParams(xDesc.GetType());
 
     handle.GetKernel("miopenActivationForward",
                      network_config,
@@ -198,8 +269,15 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                      kernel_name,
                      vld,
                      vgd,
-                     compiler_options)(
-        x, y, f_activ_power, f_activ_beta, f_activ_alpha, long(xOffset), long(yOffset));
+                     compiler_options)(x,
+                                       y,
+                                       f_activ_power,
+                                       f_activ_beta,
+                                       f_activ_alpha,
+                                       long(xOffset),
+                                       long(yOffset),
+                                       miopen_alpha,
+                                       miopen_beta);
 
     return (status);
 }
@@ -221,10 +299,13 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                                               size_t dxOffset)
 {
 
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    if(alpha == nullptr || beta == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "alpha and beta must not be null");
+    }
+    if(dyDesc.GetType() != dxDesc.GetType())
     {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+        MIOPEN_THROW(miopenStatusBadParm, "Input and output tensor types do not match.");
     }
     miopenStatus_t status = miopenStatusSuccess;
 
@@ -276,7 +357,7 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
     }
 
     construct_params.setTopDfDescr("NCHW",
-                                   "FP32",
+                                   GetMloDataType(dyDesc.GetType()),
                                    ndOut,
                                    cdOut,
                                    hdOut,
@@ -331,8 +412,16 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
             "Activation does not support tensor dimensions larger than 4 or smaller than 1");
     }
 
-    construct_params.setTopDescr(
-        "NCHW", "FP32", nOut, cOut, hOut, wOut, nOutStride, cOutStride, hOutStride, wOutStride);
+    construct_params.setTopDescr("NCHW",
+                                 GetMloDataType(yDesc.GetType()),
+                                 nOut,
+                                 cOut,
+                                 hOut,
+                                 wOut,
+                                 nOutStride,
+                                 cOutStride,
+                                 hOutStride,
+                                 wOutStride);
 
     int ndIn       = 1;
     int cdIn       = 1;
@@ -379,8 +468,16 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
             "Activation does not support tensor dimensions larger than 4 or smaller than 1");
     }
 
-    construct_params.setBotDfDescr(
-        "NCHW", "FP32", ndIn, cdIn, hdIn, wdIn, ndInStride, cdInStride, hdInStride, wdInStride);
+    construct_params.setBotDfDescr("NCHW",
+                                   GetMloDataType(dxDesc.GetType()),
+                                   ndIn,
+                                   cdIn,
+                                   hdIn,
+                                   wdIn,
+                                   ndInStride,
+                                   cdInStride,
+                                   hdInStride,
+                                   wdInStride);
 
     int nIn       = 1;
     int cIn       = 1;
@@ -427,8 +524,16 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
             "Activation does not support tensor dimensions larger than 4 or smaller than 1");
     }
 
-    construct_params.setBotDescr(
-        "NCHW", "FP32", nIn, cIn, hIn, wIn, nInStride, cInStride, hInStride, wInStride);
+    construct_params.setBotDescr("NCHW",
+                                 GetMloDataType(xDesc.GetType()),
+                                 nIn,
+                                 cIn,
+                                 hIn,
+                                 wIn,
+                                 nInStride,
+                                 cInStride,
+                                 hInStride,
+                                 wInStride);
 
     int activ_mode     = GetMode();
     double activ_alpha = GetAlpha();
@@ -478,6 +583,10 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
         std::to_string(cOut * hOut * wOut) + " -DMLO_DIN_BLOCK_SZ=" +
         std::to_string(cdIn * hdIn * wdIn) + " -DMLO_DOUT_BLOCK_SZ=" +
         std::to_string(cdOut * hdOut * wdOut);
+    compiler_options += GetDataTypeKernelParams(dyDesc.GetType());
+
+    const float miopen_alpha = *(static_cast<const float*>(alpha));
+    const float miopen_beta  = *(static_cast<const float*>(beta));
 
     handle.GetKernel("miopenActivationBackward",
                      network_config,
@@ -496,7 +605,9 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                                        long(dxOffset),
                                        long(dyOffset),
                                        long(xOffset),
-                                       long(yOffset));
+                                       long(yOffset),
+                                       miopen_alpha,
+                                       miopen_beta);
 
     return (status);
 }
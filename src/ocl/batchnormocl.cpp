@@ -50,6 +50,10 @@ void BatchNormForwardTraining(Handle& handle,
                               Data_t resultSaveMean,
                               Data_t resultSaveInvVariance)
 {
+    if(xDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
 
     if(x == nullptr || y == nullptr || bnScale == nullptr || bnBias == nullptr)
     {
@@ -67,16 +71,20 @@ void BatchNormForwardTraining(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    if(alpha == nullptr || beta == nullptr)
     {
-        std::cerr << "Only alpha=1 and beta=0 is supported" << std::endl;
         MIOPEN_THROW(miopenStatusBadParm);
     }
+    const float miopen_alpha = *(static_cast<const float*>(alpha));
+    const float miopen_beta  = *(static_cast<const float*>(beta));
+    const bool blend_y       = !float_equal(miopen_beta, 0);
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, xDesc, x);
-        // miopen::checkNumericsInput(handle, yDesc, y); // if beta!=0?
+        if(blend_y)
+        {
+            miopen::checkNumericsInput(handle, yDesc, y);
+        }
         miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, bnScale);
         miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, bnBias);
     }
@@ -135,10 +143,31 @@ void BatchNormForwardTraining(Handle& handle,
     parms += " -DMIO_BN_NHW=" + std::to_string(in_nhw);
     parms += " -DMIO_BN_CHW=" + std::to_string(in_nstride);
     parms += " -DMIO_BN_NCHW=" + std::to_string(in_nchw);
+    parms += bnBlendKernelParams(beta);
 
     auto inhw = float(1.0 / in_nhw);
 
-    if(bn_mode == miopenBNSpatial)
+    // The multi-kernel spatial variant stashes the statistics in y, which would clobber the
+    // destination being blended into.
+    if(bnUseGenericKernels(bn_mode, n, c, h, w) ||
+       (blend_y && bn_mode == miopenBNSpatial && in_cstride > 1024 && in_nhw >= 33554432))
+    {
+        bnFwdTrainSpatialGeneric(handle,
+                                 alpha,
+                                 beta,
+                                 xDesc,
+                                 x,
+                                 y,
+                                 bnScale,
+                                 bnBias,
+                                 expAvgFactor,
+                                 resultRunningMean,
+                                 resultRunningVariance,
+                                 epsilon,
+                                 resultSaveMean,
+                                 resultSaveInvVariance);
+    }
+    else if(bn_mode == miopenBNSpatial)
     {
 
         program_name += "Spatial.cl";
@@ -189,6 +218,8 @@ void BatchNormForwardTraining(Handle& handle,
                                    y,
                                    bnScale,
                                    bnBias,
+                                   miopen_alpha,
+                                   miopen_beta,
                                    resultsave,
                                    resultrunning,
                                    expAvgFactor,
@@ -248,6 +279,8 @@ void BatchNormForwardTraining(Handle& handle,
                                    y,
                                    bnScale,
                                    bnBias,
+                                   miopen_alpha,
+                                   miopen_beta,
                                    resultsave,
                                    resultrunning,
                                    expAvgFactor,
@@ -302,6 +335,8 @@ void BatchNormForwardTraining(Handle& handle,
                                   y,
                                   bnScale,
                                   bnBias,
+                                  miopen_alpha,
+                                  miopen_beta,
                                   resultsave,
                                   resultrunning,
                                   expAvgFactor,
@@ -367,6 +402,8 @@ void BatchNormForwardTraining(Handle& handle,
                                    y,
                                    bnScale,
                                    bnBias,
+                                   miopen_alpha,
+                                   miopen_beta,
                                    resultsave,
                                    resultrunning,
                                    expAvgFactor,
@@ -415,6 +452,8 @@ void BatchNormForwardTraining(Handle& handle,
                 y,
                 bnScale,
                 bnBias,
+                miopen_alpha,
+                miopen_beta,
                 expAvgFactor,
                 resultRunningMean,
                 resultRunningVariance,
@@ -431,6 +470,8 @@ void BatchNormForwardTraining(Handle& handle,
                 y,
                 bnScale,
                 bnBias,
+                miopen_alpha,
+                miopen_beta,
                 expAvgFactor,
                 epsilon,
                 resultSaveMean,
@@ -445,6 +486,8 @@ void BatchNormForwardTraining(Handle& handle,
                 y,
                 bnScale,
                 bnBias,
+                miopen_alpha,
+                miopen_beta,
                 expAvgFactor,
                 resultRunningMean,
                 resultRunningVariance,
@@ -453,7 +496,16 @@ void BatchNormForwardTraining(Handle& handle,
         else
         {
             handle.GetKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                x, in_nstride, in_cstride, y, bnScale, bnBias, expAvgFactor, epsilon);
+                x,
+                in_nstride,
+                in_cstride,
+                y,
+                bnScale,
+                bnBias,
+                miopen_alpha,
+                miopen_beta,
+                expAvgFactor,
+                epsilon);
         }
     } // end per-activation
 
@@ -484,6 +536,10 @@ void BatchNormForwardInference(Handle& handle,
                                ConstData_t estimatedVariance,
                                double epsilon)
 {
+    if(xDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, xDesc, x);
@@ -514,10 +570,8 @@ void BatchNormForwardInference(Handle& handle,
         {
             MIOPEN_THROW(miopenStatusBadParm);
         }
-        if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-           !float_equal(*(static_cast<const float*>(beta)), 0))
+        if(alpha == nullptr || beta == nullptr)
         {
-            std::cerr << "Only alpha=1 and beta=0 is supported" << std::endl;
             MIOPEN_THROW(miopenStatusBadParm);
         }
 
@@ -530,12 +584,33 @@ void BatchNormForwardInference(Handle& handle,
         int n, c, h, w;
         std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
 
+        if(bnUseGenericKernels(bn_mode, n, c, h, w))
+        {
+            bnFwdInferSpatialGeneric(handle,
+                                     alpha,
+                                     beta,
+                                     xDesc,
+                                     x,
+                                     y,
+                                     bnScale,
+                                     bnBias,
+                                     estimatedMean,
+                                     estimatedVariance,
+                                     epsilon);
+            if(miopen::CheckNumericsEnabled())
+            {
+                miopen::checkNumericsOutput(handle, yDesc, y);
+            }
+            return;
+        }
+
         unsigned int in_nstride = c * h * w;
         unsigned int in_cstride = h * w;
 
         parms += "-DMIO_BN_N=" + std::to_string(n);
         parms += " -DMIO_BN_HW=" + std::to_string(in_cstride);
         parms += " -DMIO_BN_CHW=" + std::to_string(in_nstride);
+        parms += bnBlendKernelParams(beta);
 
         size_t xlocalsize = 0;
         size_t ylocalsize = 0;
@@ -585,7 +660,15 @@ void BatchNormForwardInference(Handle& handle,
         std::cout << parms << std::endl;
 #endif
         handle.GetKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-            x, y, estimatedMean, estimatedVariance, bnScale, bnBias, epsilon);
+            x,
+            y,
+            estimatedMean,
+            estimatedVariance,
+            bnScale,
+            bnBias,
+            *(static_cast<const float*>(alpha)),
+            *(static_cast<const float*>(beta)),
+            epsilon);
     }
     else
     {
@@ -616,6 +699,115 @@ void BatchNormForwardInference(Handle& handle,
         miopen::checkNumericsOutput(handle, yDesc, y);
     }
 }
+
+void BatchNormActivForwardInference(Handle& handle,
+                                    miopenBatchNormMode_t bn_mode,
+                                    const void* alpha,
+                                    const void* beta,
+                                    const TensorDescriptor& xDesc,
+                                    ConstData_t x,
+                                    const TensorDescriptor& yDesc,
+                                    Data_t y,
+                                    const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                    ConstData_t bnScale,
+                                    ConstData_t bnBias,
+                                    ConstData_t estimatedMean,
+                                    ConstData_t estimatedVariance,
+                                    double epsilon,
+                                    const ActivationDescriptor& activDesc)
+{
+    if(xDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
+    if(x == nullptr || y == nullptr || bnScale == nullptr || bnBias == nullptr ||
+       estimatedMean == nullptr || estimatedVariance == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetSize() != yDesc.GetSize() || xDesc.GetSize() != bnScaleBiasMeanVarDesc.GetSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetType() != yDesc.GetType() || xDesc.GetType() != bnScaleBiasMeanVarDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetSize() < 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(alpha == nullptr || beta == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, bnScale);
+        miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, bnBias);
+        miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, estimatedMean);
+        miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, estimatedVariance);
+    }
+
+    std::string algo_name    = "miopenBatchNormalizationActivationForwardInference";
+    std::string program_name = "MIOpenBatchNormActivInfer.cl";
+    std::string kernel_name  = "BatchNormActivInfer";
+    std::string network_config{};
+    std::string parms{}; // compiler parameters
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    unsigned int in_nstride = c * h * w;
+    unsigned int in_cstride = h * w;
+
+    // Same launch geometry as the unfused inference kernels
+    size_t ylocalsize = (in_cstride > 1024) ? 1024 : ((64 >= in_cstride) ? 64 : 256);
+    auto segment      = std::ceil(double(in_cstride) / double(ylocalsize));
+    size_t ygridsize  = segment * ylocalsize;
+
+    std::vector<size_t> vld = {1, ylocalsize, 1};
+    std::vector<size_t> vgd = {static_cast<size_t>(c), ygridsize, 1};
+
+    if(bn_mode == miopenBNSpatial)
+    {
+        kernel_name += "SpatialEst";
+    }
+    else
+    {
+        kernel_name += "PerActEst";
+    }
+
+    parms += "-DMIO_BN_N=" + std::to_string(n);
+    parms += " -DMIO_BN_HW=" + std::to_string(in_cstride);
+    parms += " -DMIO_BN_CHW=" + std::to_string(in_nstride);
+    parms += " -DMIO_BN_GRP0=" + std::to_string(1);
+    parms += " -DMIO_BN_GRP1=" + std::to_string(ylocalsize);
+    parms += " -DMIO_BN_GRP2=" + std::to_string(1);
+    parms += " -DMIO_BN_ACTIV=" + std::to_string(static_cast<int>(activDesc.GetMode()));
+    parms += bnBlendKernelParams(beta);
+
+    handle.GetKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+        x,
+        y,
+        estimatedMean,
+        estimatedVariance,
+        bnScale,
+        bnBias,
+        *(static_cast<const float*>(alpha)),
+        *(static_cast<const float*>(beta)),
+        epsilon,
+        static_cast<float>(activDesc.GetAlpha()),
+        static_cast<float>(activDesc.GetBeta()),
+        static_cast<float>(activDesc.GetPower()));
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, yDesc, y);
+    }
+}
 //================= END FORWARD INFERENCE ====================
 
 //=============== BEGIN BACKWARDS PROPAGATION ================
@@ -639,6 +831,10 @@ void BatchNormBackward(Handle& handle,
                        ConstData_t savedMean,
                        ConstData_t savedInvVariance)
 {
+    if(xDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
 
     //#if(MIO_BN_TIME_EVERYTHING == 1)
     auto t_start = std::chrono::high_resolution_clock::now();
@@ -719,7 +915,21 @@ void BatchNormBackward(Handle& handle,
 
     bool useSaved = false;
 
-    if(bn_mode == miopenBNSpatial)
+    if(bnUseGenericKernels(bn_mode, n, c, h, w))
+    {
+        bnBwdSpatialGeneric(handle,
+                            xDesc,
+                            x,
+                            dy,
+                            dx,
+                            bnScale,
+                            resultBnScaleDiff,
+                            resultBnBiasDiff,
+                            epsilon,
+                            savedMean,
+                            savedInvVariance);
+    }
+    else if(bn_mode == miopenBNSpatial)
     { // SPATIAL kernels
 
         if(savedMean != nullptr && savedInvVariance != nullptr)
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/check_numerics.hpp>
+#include <miopen/conv_bias_activ_plan.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+
+#include <algorithm>
+#include <ostream>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT)
+
+ConvBiasActivPlan::ConvBiasActivPlan(Handle& handle,
+                                     const ConvolutionDescriptor& c,
+                                     const TensorDescriptor& x_desc,
+                                     const TensorDescriptor& w_desc,
+                                     const TensorDescriptor& bDesc,
+                                     const ActivationDescriptor& a,
+                                     const TensorDescriptor& y_desc,
+                                     miopenConvFwdAlgorithm_t al)
+    : conv(c), xDesc(x_desc), wDesc(w_desc), yDesc(y_desc), activ(a), algo(al)
+{
+    if(yDesc.GetSize() != 4 || yDesc.GetElementSpace() != yDesc.GetElementSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Output tensor must be packed NCHW");
+    }
+    if(bDesc.GetType() != yDesc.GetType() || bDesc.GetElementSize() != yDesc.GetLengths()[1])
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Bias must have one element per output channel");
+    }
+
+    if(!ResolveEpilogue(handle))
+    {
+        conv_plan = make_unique<ConvolutionPlan>(handle, conv, xDesc, wDesc, yDesc, al);
+        ResolveBiasActiv(handle);
+    }
+    MIOPEN_LOG_I2("Resolved " << *this);
+}
+
+bool ConvBiasActivPlan::ResolveEpilogue(Handle& handle)
+{
+    const auto mode = activ.GetMode();
+    if(algo != miopenConvolutionFwdAlgoDirect || conv.mode != miopenConvolution ||
+       (mode != miopenActivationPATHTRU && mode != miopenActivationLOGISTIC &&
+        mode != miopenActivationTANH && mode != miopenActivationRELU))
+        return false;
+    if(!conv.IsDirectSupported(wDesc) || miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}))
+        return false;
+    if(xDesc.GetLengths()[1] != wDesc.GetLengths()[1])
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    try
+    {
+        mlo_construct_direct2D construct_params(1, true); // forward, with bias
+        // The epilogue adds kernel arguments the exhaustive search does not know about.
+        construct_params.doSearch(false);
+        construct_params.setGeneralCompOptions(" -DMLO_CONV_ACTIV=" +
+                                               std::to_string(static_cast<int>(mode)) +
+                                               GetDataTypeKernelParams(xDesc.GetType()));
+        construct_params.setStream(&handle);
+
+        construct_params.setOutputDescFromMLDesc(yDesc);
+        construct_params.setInputDescFromMLDesc(xDesc);
+        construct_params.setWeightDescFromMLDesc(wDesc);
+        construct_params.setConvDescr(
+            conv.pad_h, conv.pad_w, conv.u, conv.v, conv.dilation_h, conv.dilation_w);
+
+        if(construct_params.mloIsCompilerWorkarounds())
+            return false;
+
+        mloConstruct(construct_params);
+
+        // Only the generic direct kernel has the bias+activation epilogue.
+        if(construct_params.getKernelFile() != "MIOpenConvDirUni.cl")
+            return false;
+
+        construct_params.mloBuildConf_Key(network_config);
+        network_config += "xb1xa" + std::to_string(static_cast<int>(mode));
+
+        handle.GetKernel("miopenConvolutionBiasActivFwdDirect",
+                         network_config,
+                         construct_params.getKernelFile(),
+                         construct_params.getKernelName(),
+                         construct_params.getLocalWkSize(),
+                         construct_params.getGlobalWkSize(),
+                         construct_params.getCompilerOptions());
+        return true;
+    }
+    catch(miopen::Exception&)
+    {
+        network_config.clear();
+        return false;
+    }
+}
+
+void ConvBiasActivPlan::ResolveBiasActiv(Handle& handle)
+{
+    const std::size_t lcl_sz   = 256;
+    const std::size_t max_grps = 1024;
+    const std::size_t total    = yDesc.GetElementSize();
+    const std::size_t n_grps   = std::min((total + lcl_sz - 1) / lcl_sz, max_grps);
+
+    const std::vector<size_t> vld = {lcl_sz, 1, 1};
+    const std::vector<size_t> vgd = {n_grps * lcl_sz, 1, 1};
+
+    const auto mode = static_cast<int>(activ.GetMode());
+    network_config  = "a" + std::to_string(mode) + "xg" + std::to_string(n_grps) + "xt" +
+                     std::to_string(static_cast<int>(yDesc.GetType()));
+    std::string parms = " -DMIO_BIAS=1 -DMIO_ACTIV_MODE=" + std::to_string(mode) +
+                        GetDataTypeKernelParams(yDesc.GetType());
+
+    handle.GetKernel("miopenBiasActivationForward",
+                     network_config,
+                     "MIOpenBiasActiv.cl",
+                     "MIOpenBiasActivFwd",
+                     vld,
+                     vgd,
+                     parms);
+}
+
+void ConvBiasActivPlan::Execute(Handle& handle,
+                                ConstData_t x,
+                                ConstData_t w,
+                                ConstData_t b,
+                                Data_t y,
+                                Data_t workSpace,
+                                size_t workSpaceSize)
+{
+    if(x == nullptr || w == nullptr || b == nullptr || y == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    const auto activ_alpha = static_cast<float>(activ.GetAlpha());
+    const auto activ_beta  = static_cast<float>(activ.GetBeta());
+    const auto activ_power = static_cast<float>(activ.GetPower());
+
+    if(conv_plan == nullptr)
+    {
+        if(miopen::CheckNumericsEnabled())
+        {
+            miopen::checkNumericsInput(handle, xDesc, x);
+            miopen::checkNumericsInput(handle, wDesc, w);
+        }
+
+        float padding_val = 0;
+        auto kernel       = handle.GetKernel("miopenConvolutionBiasActivFwdDirect", network_config);
+        kernel(x, w, b, y, padding_val, activ_alpha, activ_beta);
+    }
+    else
+    {
+        conv_plan->Execute(handle, x, w, y, workSpace, workSpaceSize);
+        float time0 = handle.GetKernelTime();
+
+        int c, h, wd;
+        std::tie(std::ignore, c, h, wd) = tien<4>(yDesc.GetLengths());
+        auto kernel = handle.GetKernel("miopenBiasActivationForward", network_config);
+        kernel(y,
+               b,
+               static_cast<unsigned int>(c),
+               static_cast<unsigned int>(h * wd),
+               static_cast<unsigned int>(yDesc.GetElementSize()),
+               activ_alpha,
+               activ_beta,
+               activ_power);
+        handle.AccumKernelTime(time0);
+    }
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, yDesc, y);
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const ConvBiasActivPlan& p)
+{
+    stream << p.algo << ", ";
+    stream << (p.IsEpilogueFused() ? "epilogue" : "bias_activ") << ", ";
+    stream << p.activ << ", ";
+    stream << p.conv;
+    return stream;
+}
+
+} // namespace miopen
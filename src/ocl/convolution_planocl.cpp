@@ -0,0 +1,307 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/check_numerics.hpp>
+#include <miopen/convolution_plan.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <ostream>
+
+namespace miopen {
+
+ConvolutionPlan::ConvolutionPlan(Handle& handle,
+                                 const ConvolutionDescriptor& c,
+                                 const TensorDescriptor& xDesc,
+                                 const TensorDescriptor& w_desc,
+                                 const TensorDescriptor& yDesc,
+                                 miopenConvFwdAlgorithm_t a)
+    : conv(c), inDesc(xDesc), wDesc(w_desc), outDesc(yDesc), direction(1), algo(a)
+{
+    if(inDesc.GetSize() != outDesc.GetSize() || inDesc.GetSize() != wDesc.GetSize() ||
+       inDesc.GetSize() < 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(inDesc.GetType() != outDesc.GetType() || inDesc.GetType() != wDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    if(conv.mode == miopenConvolution)
+    {
+        if(inDesc.GetLengths()[1] != wDesc.GetLengths()[1])
+            MIOPEN_THROW(miopenStatusBadParm);
+
+        switch(a)
+        {
+        case miopenConvolutionFwdAlgoGEMM:
+            workspace_size = conv.ForwardGetWorkSpaceSizeGEMM(handle, wDesc, outDesc);
+            break;
+        case miopenConvolutionFwdAlgoFFT:
+            workspace_size = conv.ForwardGetWorkSpaceSizeFFT(wDesc, inDesc, outDesc);
+            break;
+        case miopenConvolutionFwdAlgoDirect:
+        case miopenConvolutionFwdAlgoWinograd: resolvable = true; break;
+        }
+    }
+    else if(conv.mode == miopenTranspose)
+    {
+        if(inDesc.GetLengths()[1] != wDesc.GetLengths()[0])
+            MIOPEN_THROW(miopenStatusBadParm);
+        workspace_size = conv.BackwardDataGetWorkSpaceSizeGEMM(handle, wDesc, inDesc);
+    }
+
+    if(resolvable)
+        Resolve(handle);
+}
+
+ConvolutionPlan::ConvolutionPlan(Handle& handle,
+                                 const ConvolutionDescriptor& c,
+                                 const TensorDescriptor& dyDesc,
+                                 const TensorDescriptor& w_desc,
+                                 const TensorDescriptor& dxDesc,
+                                 miopenConvBwdDataAlgorithm_t a)
+    : conv(c), inDesc(dyDesc), wDesc(w_desc), outDesc(dxDesc), direction(0), algo(a)
+{
+    if(inDesc.GetSize() != outDesc.GetSize() || inDesc.GetSize() != wDesc.GetSize() ||
+       inDesc.GetSize() < 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(inDesc.GetType() != outDesc.GetType() || inDesc.GetType() != wDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    if(conv.mode == miopenConvolution)
+    {
+        if(inDesc.GetLengths()[1] != wDesc.GetLengths()[0])
+            MIOPEN_THROW(miopenStatusBadParm);
+
+        switch(a)
+        {
+        case miopenConvolutionBwdDataAlgoGEMM:
+            workspace_size = conv.BackwardDataGetWorkSpaceSizeGEMM(handle, wDesc, inDesc);
+            break;
+        case miopenConvolutionBwdDataAlgoFFT:
+            workspace_size = conv.BackwardGetWorkSpaceSizeFFT(wDesc, inDesc, outDesc);
+            break;
+        case miopenConvolutionBwdDataAlgoDirect:
+        case miopenConvolutionBwdDataAlgoWinograd: resolvable = true; break;
+        case miopenTransposeBwdDataAlgoGEMM:
+            MIOPEN_THROW(miopenStatusNotImplemented,
+                         "Transpose GEMM requires a miopenTranspose convolution");
+        }
+    }
+    else if(conv.mode == miopenTranspose)
+    {
+        workspace_size = conv.ForwardGetWorkSpaceSizeGEMM(handle, wDesc, inDesc);
+    }
+
+    if(resolvable)
+        Resolve(handle);
+}
+
+void ConvolutionPlan::Resolve(Handle& handle)
+{
+    // The tensor descriptors as seen by the kernel lookups: for backward data
+    // the "input" of the mlo_construct_* objects is dx and the "output" is dy.
+    const TensorDescriptor& xDesc = IsForward() ? inDesc : outDesc;
+    const TensorDescriptor& yDesc = IsForward() ? outDesc : inDesc;
+
+    kernels.clear();
+    // Both directions share the enum values of the algorithms resolved here.
+    if(algo == miopenConvolutionFwdAlgoWinograd)
+    {
+        KernelInvoke kernel;
+        if(conv.FindWinogradKernel(handle, xDesc, wDesc, yDesc, winograd_params, kernel, direction) !=
+           0)
+        {
+            MIOPEN_THROW(miopenStatusBadParm, "Winograd is not applicable to this problem");
+        }
+        kernels.push_back(kernel);
+        is_winograd = true;
+    }
+    else
+    {
+        if(conv.FindDirectKernel(handle, xDesc, wDesc, yDesc, kernels, false, direction) != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Direct convolution is not applicable to this problem");
+    }
+
+    bound_stream             = handle.GetStream();
+    bound_profiling          = handle.IsProfilingEnabled();
+    bound_deferred_profiling = handle.IsDeferredProfilingEnabled();
+    MIOPEN_LOG_I2("Resolved " << kernels.size() << " kernel(s) for " << *this);
+}
+
+void ConvolutionPlan::Execute(Handle& handle,
+                              ConstData_t in,
+                              ConstData_t w,
+                              Data_t out,
+                              Data_t workSpace,
+                              size_t workSpaceSize)
+{
+    if(in == nullptr || w == nullptr || out == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    if(!resolvable)
+    {
+        ExecuteUnresolved(handle, in, w, out, workSpace, workSpaceSize);
+        return;
+    }
+
+    if(bound_stream != handle.GetStream() || bound_profiling != handle.IsProfilingEnabled() ||
+       bound_deferred_profiling != handle.IsDeferredProfilingEnabled())
+        Resolve(handle);
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, inDesc, in);
+        miopen::checkNumericsInput(handle, wDesc, w);
+    }
+
+    if(is_winograd)
+    {
+        static const int F_REVERSE_R = 1 << 0;
+        static const int F_REVERSE_S = 1 << 1;
+        static const int F_FLIP_K_C  = 1 << 2;
+        int flags                    = IsForward() ? 0 : F_REVERSE_R + F_REVERSE_S + F_FLIP_K_C;
+        int reserved                 = 0;
+        int* return_addr             = nullptr;
+        bool isRxS;
+        int N, C, H, W, K, n_groups, out_H, out_W, R, S, pad_H, pad_W;
+        std::tie(N, C, H, W, K, n_groups, out_H, out_W, R, S, pad_H, pad_W, isRxS) =
+            winograd_params;
+        if(IsForward())
+        {
+            pad_H = conv.pad_h;
+            pad_W = conv.pad_w;
+        }
+
+        const auto& kernel = kernels.front();
+        if(isRxS)
+        {
+            kernel(N,
+                   C,
+                   H,
+                   W,
+                   K,
+                   n_groups,
+                   flags,
+                   reserved,
+                   in,
+                   w,
+                   out,
+                   return_addr,
+                   R,
+                   S,
+                   pad_H,
+                   pad_W,
+                   out_H,
+                   out_W);
+        }
+        else
+        {
+            kernel(N, C, H, W, K, n_groups, flags, reserved, in, w, out, return_addr);
+        }
+    }
+    else
+    {
+        float padding_val = 0;
+        if(kernels.size() == 1)
+        {
+            kernels.front()(in, w, out, padding_val);
+        }
+        else
+        {
+            // 11x11 forward is done in two passes
+            handle.ResetKernelTime();
+            kernels[0](in, w, out, padding_val);
+            float time0 = handle.GetKernelTime();
+            kernels[1](in, w, out, padding_val);
+            handle.AccumKernelTime(time0);
+        }
+    }
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, outDesc, out);
+    }
+}
+
+void ConvolutionPlan::ExecuteUnresolved(Handle& handle,
+                                        ConstData_t in,
+                                        ConstData_t w,
+                                        Data_t out,
+                                        Data_t workSpace,
+                                        size_t workSpaceSize) const
+{
+    float alpha = 1;
+    float beta  = 0;
+    if(IsForward())
+    {
+        conv.ConvolutionForward(handle,
+                                &alpha,
+                                inDesc,
+                                in,
+                                wDesc,
+                                w,
+                                static_cast<miopenConvFwdAlgorithm_t>(algo),
+                                &beta,
+                                outDesc,
+                                out,
+                                workSpace,
+                                workSpaceSize);
+    }
+    else
+    {
+        conv.ConvolutionBackwardData(handle,
+                                     &alpha,
+                                     inDesc,
+                                     in,
+                                     wDesc,
+                                     w,
+                                     static_cast<miopenConvBwdDataAlgorithm_t>(algo),
+                                     &beta,
+                                     outDesc,
+                                     out,
+                                     workSpace,
+                                     workSpaceSize);
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const ConvolutionPlan& p)
+{
+    stream << (p.IsForward() ? "fwd" : "bwd") << ", ";
+    stream << p.algo << ", ";
+    stream << p.conv;
+    stream << p.workspace_size << ", ";
+    return stream;
+}
+
+} // namespace miopen
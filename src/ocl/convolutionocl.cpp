@@ -25,12 +25,14 @@
  *******************************************************************************/
 #include <miopen/config.h>
 #include <miopen/convolution.hpp>
+#include <miopen/datatype.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/util.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
+#include <miopen/trace.hpp>
 
 #if MIOPEN_USE_MIOPENGEMM
 #include <miopen/gemm.hpp>
@@ -59,6 +61,15 @@ struct AutoEnableProfiling
     bool prev_state;
 };
 
+// Each candidate span covers the time since the previous candidate finished.
+static void TraceCandidate(TraceSequence& trace, const PerfField& candidate)
+{
+    trace.Mark(candidate.name,
+               TraceArgs{}
+                   .Add("kernel_ms", candidate.time)
+                   .Add("workspace", static_cast<double>(candidate.workspace)));
+}
+
 int ConvolutionDescriptor::FindWinogradKernel(Handle& handle,
                                               const TensorDescriptor& xDesc,
                                               const TensorDescriptor& wDesc,
@@ -67,6 +78,9 @@ int ConvolutionDescriptor::FindWinogradKernel(Handle& handle,
                                               KernelInvoke& kernel,
                                               int direction) const
 {
+    if(xDesc.GetLayout() != "NCHW")
+        return -1;
+
     try
     {
         mlo_construct_winograd construct_params(direction);
@@ -130,11 +144,15 @@ int ConvolutionDescriptor::FindDirectKernel(Handle& handle,
     if(!IsDirectSupported(wDesc) || miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}))
         return -1;
 
+    // the direct kernels index NCHW tensors only
+    if(xDesc.GetLayout() != "NCHW")
+        return -1;
+
     mlo_construct_direct2D construct_params(direction);
     construct_params.doSearch(exhaustiveSearch);
     construct_params.saveSearchRequest(true);
 
-    construct_params.setGeneralCompOptions("");
+    construct_params.setGeneralCompOptions(GetDataTypeKernelParams(xDesc.GetType()));
 
     construct_params.setStream(&handle);
 
@@ -235,6 +253,87 @@ int ConvolutionDescriptor::FindDirectKernel(Handle& handle,
     return 0;
 }
 
+// MIOpenGEMM has no half type, so half problems keep float copies in the workspace:
+// the columns of one image, the weights and the output of one image, in that order.
+// The GEMM accumulates in float and only the final result is rounded to half.
+float ConvolutionDescriptor::ExecuteFwdGemmHalf(Handle& handle,
+                                                const TensorDescriptor& xDesc,
+                                                ConstData_t x,
+                                                const TensorDescriptor& wDesc,
+                                                ConstData_t w,
+                                                const TensorDescriptor& yDesc,
+                                                Data_t y,
+                                                Data_t workSpace) const
+{
+#if MIOPEN_USE_MIOPENGEMM
+    int in_n, in_c, in_h, in_w;
+    std::tie(in_n, in_c, in_h, in_w) = tien<4>(xDesc.GetLengths());
+
+    int wei_n, wei_h, wei_w;
+    std::tie(wei_n, std::ignore, wei_h, wei_w) = tien<4>(wDesc.GetLengths());
+
+    int out_h, out_w;
+    std::tie(std::ignore, std::ignore, out_h, out_w) = tien<4>(yDesc.GetLengths());
+
+    std::string network_config;
+    CreateGemmGeometryConvFwd(xDesc, wDesc, yDesc, false, network_config);
+    GemmGeometry gg = GetGemmGeometry("miopenConvolutionFwdAlgoGEMM", network_config);
+
+    const int col_sz = in_c * wei_h * wei_w * out_h * out_w;
+    const int wei_sz = wDesc.GetElementSize();
+    const int out_sz = wei_n * out_h * out_w;
+
+    float time = CastGPU(handle, wei_sz, w, 0, wDesc.GetType(), workSpace, col_sz, miopenFloat);
+    for(int i = 0; i < in_n; i++)
+    {
+        size_t in_offset = i * in_c * in_h * in_w;
+        time += Im2ColGPU(handle,
+                          xDesc.GetElementSize(),
+                          x,
+                          in_offset,
+                          in_c,
+                          in_h,
+                          in_w,
+                          wei_h,
+                          wei_w,
+                          out_h,
+                          out_w,
+                          pad_h,
+                          pad_w,
+                          u,
+                          v,
+                          dilation_h,
+                          dilation_w,
+                          workSpace,
+                          xDesc.GetType(),
+                          xDesc.GetLayout());
+
+        gg.RunGemm(handle, workSpace, workSpace, workSpace, 0, col_sz, col_sz + wei_sz);
+        time += handle.GetKernelTime();
+
+        time += CastGPU(handle,
+                        out_sz,
+                        workSpace,
+                        col_sz + wei_sz,
+                        miopenFloat,
+                        y,
+                        i * out_sz,
+                        yDesc.GetType());
+    }
+    return time;
+#else
+    (void)handle;
+    (void)xDesc;
+    (void)x;
+    (void)wDesc;
+    (void)w;
+    (void)yDesc;
+    (void)y;
+    (void)workSpace;
+    MIOPEN_THROW("GEMM is not supported");
+#endif
+}
+
 void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                  const TensorDescriptor& xDesc,
                                                  ConstData_t x,
@@ -258,15 +357,26 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "perfResults cannot be nullptr");
     if(requestAlgoCount < 1)
         MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
+    if(xDesc.GetType() == miopenHalf && mode != miopenConvolution)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Half precision requires miopenConvolution mode");
+    if(xDesc.GetLayout() != yDesc.GetLayout() || wDesc.GetLayout() != "NCHW")
+        MIOPEN_THROW(miopenStatusNotImplemented, "Mixed tensor layouts are not supported");
+    if(xDesc.GetLayout() == "NHWC" && mode != miopenConvolution)
+        MIOPEN_THROW(miopenStatusNotImplemented, "NHWC requires miopenConvolution mode");
+
+    handle.UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+        return ForwardGetWorkSpaceSize(handle, wDesc, xDesc, yDesc);
+    });
 
     AutoEnableProfiling enableProfiling{handle};
 
     // create a dummy buffer for use as output for the kernel calls
     // because kernels are called purely for timing purposes
-    auto tmp_y = handle.Create(yDesc.GetElementSize() * sizeof(yDesc.GetType()));
+    auto tmp_y = handle.Create(yDesc.GetElementSize() * GetTypeSize(yDesc.GetType()));
 
     // < algorith_name, <time, workspace_size> >
     std::vector<PerfField> perf_db;
+    TraceSequence find_trace{"find"};
 
     // GEMM based
     int in_n, in_c, in_h, in_w;
@@ -296,6 +406,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
 
             time_gemm = in_n * handle.GetKernelTime();
             perf_db.push_back(PerfField{"miopenConvolutionFwdAlgoGEMM", time_gemm, 0});
+            TraceCandidate(find_trace, perf_db.back());
         }
 
         // if not 1x1
@@ -329,6 +440,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
             time_gemm += in_n * time_col2im;
 
             perf_db.push_back(PerfField{"miopenConvolutionFwdAlgoGEMM", time_gemm, workspace_req});
+            TraceCandidate(find_trace, perf_db.back());
         }
 #else
         (void)workSpace;     // Suppress warning
@@ -344,14 +456,31 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
         float time_gemm      = 0;
         GemmGeometry gg = CreateGemmGeometryConvFwd(xDesc, wDesc, yDesc, false, network_config);
 
-        // 1x1 does not require im2col or workspace
-        if(wei_h == 1 && wei_w == 1 && v == 1 && u == 1)
+        if(xDesc.GetType() == miopenHalf)
+        {
+            if(workSpace != nullptr && workspace_req > 0 && workSpaceSize >= workspace_req)
+            {
+                // The float GEMM is tuned on scratch weights and output of one image
+                auto w_gemm = handle.Create(wDesc.GetElementSize() * sizeof(float));
+                auto y_gemm = handle.Create(wei_n * out_h * out_w * sizeof(float));
+                gg.FindSolution(.003, handle, workSpace, w_gemm.get(), y_gemm.get(), false);
+
+                time_gemm = ExecuteFwdGemmHalf(
+                    handle, xDesc, x, wDesc, w, yDesc, tmp_y.get(), workSpace);
+                perf_db.push_back(
+                    PerfField{"miopenConvolutionFwdAlgoGEMM", time_gemm, workspace_req});
+                TraceCandidate(find_trace, perf_db.back());
+            }
+        }
+        // 1x1 does not require im2col or workspace, unless the input is NHWC
+        else if(wei_h == 1 && wei_w == 1 && v == 1 && u == 1 && xDesc.GetLayout() == "NCHW")
         {
             gg.FindSolution(.003, handle, x, w, tmp_y.get(), false);
             gg.RunGemm(handle, x, w, tmp_y.get(), 0, 0, 0);
 
             time_gemm = in_n * handle.GetKernelTime();
             perf_db.push_back(PerfField{"miopenConvolutionFwdAlgoGEMM", time_gemm, 0});
+            TraceCandidate(find_trace, perf_db.back());
         }
 
         // if not 1x1
@@ -376,12 +505,15 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                     v,
                                     dilation_h,
                                     dilation_w,
-                                    workSpace);
+                                    workSpace,
+                                    xDesc.GetType(),
+                                    xDesc.GetLayout());
 
             gg.FindSolution(.003, handle, workSpace, w, tmp_y.get(), false);
             gg.RunGemm(handle, workSpace, w, tmp_y.get(), 0, 0, 0);
             time_gemm = in_n * (time_im2col + handle.GetKernelTime());
             perf_db.push_back(PerfField{"miopenConvolutionFwdAlgoGEMM", time_gemm, workspace_req});
+            TraceCandidate(find_trace, perf_db.back());
         }
 #else
         (void)workSpace;     // Suppress warning
@@ -435,6 +567,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                 }
                 time_wino = handle.GetKernelTime();
                 perf_db.push_back(PerfField{"miopenConvolutionFwdAlgoWinograd", time_wino, 0});
+                TraceCandidate(find_trace, perf_db.back());
             }
 
             // Direct algo
@@ -453,6 +586,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                 }
 
                 perf_db.push_back(PerfField{"miopenConvolutionFwdAlgoDirect", time_direct, 0});
+                TraceCandidate(find_trace, perf_db.back());
             }
 
             // FFT algo
@@ -475,6 +609,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                          true);
                     perf_db.push_back(
                         PerfField{"miopenConvolutionFwdAlgoFFT", time_fft, workspace_fft});
+                    TraceCandidate(find_trace, perf_db.back());
                 }
             }
         }
@@ -524,6 +659,27 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
+    if(xDesc.GetType() == miopenHalf &&
+       (mode != miopenConvolution ||
+        (algo != miopenConvolutionFwdAlgoDirect && algo != miopenConvolutionFwdAlgoGEMM)))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Half precision supports only direct and GEMM forward convolutions");
+    }
+    if(xDesc.GetLayout() != yDesc.GetLayout() || wDesc.GetLayout() != "NCHW")
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Mixed tensor layouts are not supported");
+    }
+    if(xDesc.GetLayout() == "NHWC" &&
+       (mode != miopenConvolution || algo != miopenConvolutionFwdAlgoGEMM))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "NHWC supports only GEMM forward convolutions");
+    }
+
+    handle.UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+        return ForwardGetWorkSpaceSize(handle, wDesc, xDesc, yDesc);
+    });
+
     //    if(xDesc.GetLengths()[1] != wDesc.GetLengths()[1]) {
     //        MIOPEN_THROW(miopenStatusBadParm);
     //    }
@@ -676,7 +832,9 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
             int out_h, out_w;
             std::tie(std::ignore, std::ignore, out_h, out_w) = tien<4>(yDesc.GetLengths());
 
-            if((wei_h != 1 || wei_w != 1 || u != 1 || v != 1) &&
+            const bool use_im2col =
+                wei_h != 1 || wei_w != 1 || u != 1 || v != 1 || xDesc.GetLayout() == "NHWC";
+            if((use_im2col || xDesc.GetType() == miopenHalf) &&
                (workSpace == nullptr ||
                 workSpaceSize < ForwardGetWorkSpaceSize(handle, wDesc, xDesc, yDesc)))
             {
@@ -685,6 +843,17 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
 
             std::string network_config;
 #if MIOPEN_USE_MIOPENGEMM
+            if(xDesc.GetType() == miopenHalf)
+            {
+                float timev = ExecuteFwdGemmHalf(handle, xDesc, x, wDesc, w, yDesc, y, workSpace);
+                if(handle.IsProfilingEnabled())
+                {
+                    handle.ResetKernelTime();
+                    handle.AccumKernelTime(timev);
+                }
+                break;
+            }
+
             CreateGemmGeometryConvFwd(xDesc, wDesc, yDesc, false, network_config);
             GemmGeometry gg = GetGemmGeometry("miopenConvolutionFwdAlgoGEMM", network_config);
 
@@ -693,7 +862,7 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
             for(int i = 0; i < in_n; i++)
             {
                 int out_offset = i * wei_n * out_h * out_w;
-                if(wei_h != 1 || wei_w != 1 || v != 1 || u != 1)
+                if(use_im2col)
                 {
                     size_t in_offset = i * in_c * in_h * in_w;
                     Im2ColGPU(handle,
@@ -713,7 +882,9 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                               v,
                               dilation_h,
                               dilation_w,
-                              workSpace);
+                              workSpace,
+                              xDesc.GetType(),
+                              xDesc.GetLayout());
                     if(handle.IsProfilingEnabled())
                         t1 = handle.GetKernelTime();
 
@@ -729,7 +900,7 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                         time_0 += handle.GetKernelTime();
                     }
                 }
-                else if(wei_h == 1 && wei_w == 1 && v == 1 && u == 1)
+                else
                 {
                     int in_offset = i * in_c * in_h * in_w;
                     gg.RunGemm(handle, x, w, y, in_offset, 0, out_offset);
@@ -879,6 +1050,14 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                                                      size_t workSpaceSize,
                                                      bool exhaustiveSearch) const
 {
+    if(dyDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
+    if(dyDesc.GetLayout() != "NCHW")
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only NCHW layout is supported");
+    }
 
     if(dx == nullptr || w == nullptr || dy == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
@@ -889,14 +1068,19 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
     if(requestAlgoCount < 1)
         MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
 
+    handle.UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+        return BackwardDataGetWorkSpaceSize(handle, wDesc, dyDesc, dxDesc);
+    });
+
     // create a dummy buffer for use as output for the kernel calls
     // because kernels are called purely for timing purposes
-    auto tmp_dx = handle.Create(dxDesc.GetElementSize() * sizeof(dxDesc.GetType()));
+    auto tmp_dx = handle.Create(dxDesc.GetElementSize() * GetTypeSize(dxDesc.GetType()));
 
     AutoEnableProfiling enableProfiling{handle};
 
     // < algorith_name, <time, workspace_size> >
     std::vector<PerfField> perf_db;
+    TraceSequence find_trace{"find"};
 
     // GEMM based
     int in_n, in_c, in_h, in_w;
@@ -928,6 +1112,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
 
             time_gemm = in_n * handle.GetKernelTime();
             perf_db.push_back(PerfField{"miopenTransposeBwdDataAlgoGEMM", time_gemm, 0});
+            TraceCandidate(find_trace, perf_db.back());
         }
 
         // if not 1x1
@@ -959,6 +1144,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
             time_gemm = in_n * (time_im2col + handle.GetKernelTime());
             perf_db.push_back(
                 PerfField{"miopenTransposeBwdDataAlgoGEMM", time_gemm, workspace_req});
+            TraceCandidate(find_trace, perf_db.back());
         }
 #else
         (void)workSpace;     // Suppress warning
@@ -1043,6 +1229,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                 }
                 time_wino = handle.GetKernelTime();
                 perf_db.push_back(PerfField{"miopenConvolutionBwdDataAlgoWinograd", time_wino, 0});
+                TraceCandidate(find_trace, perf_db.back());
             }
 
             // Direct algo
@@ -1060,6 +1247,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                 }
 
                 perf_db.push_back(PerfField{"miopenConvolutionBwdDataAlgoDirect", time_direct, 0});
+                TraceCandidate(find_trace, perf_db.back());
             }
 
             // FFT algo
@@ -1082,6 +1270,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                                                          true);
                     perf_db.push_back(
                         PerfField{"miopenConvolutionBwdDataAlgoFFT", time_fft, workspace_fft});
+                    TraceCandidate(find_trace, perf_db.back());
                 }
             }
         }
@@ -1103,6 +1292,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
 
             time_gemm = in_n * handle.GetKernelTime();
             perf_db.push_back(PerfField{"miopenConvolutionBwdDataAlgoGEMM", time_gemm, 0});
+            TraceCandidate(find_trace, perf_db.back());
         }
         // if not 1x1
         else if(workSpace != nullptr && workSpaceSize >= workspace_req)
@@ -1136,6 +1326,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
 
             perf_db.push_back(
                 PerfField{"miopenConvolutionBwdDataAlgoGEMM", time_gemm, workspace_req});
+            TraceCandidate(find_trace, perf_db.back());
         }
 #else
         (void)workSpace;     // Suppress warning
@@ -1175,6 +1366,14 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
                                                     Data_t workSpace,
                                                     size_t workSpaceSize) const
 {
+    if(dyDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
+    if(dyDesc.GetLayout() != "NCHW")
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only NCHW layout is supported");
+    }
 
     if(dx == nullptr || w == nullptr || dy == nullptr)
     {
@@ -1188,6 +1387,11 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
+
+    handle.UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+        return BackwardDataGetWorkSpaceSize(handle, wDesc, dyDesc, dxDesc);
+    });
+
     //    if(dyDesc.GetLengths()[1] != wDesc.GetLengths()[0]) {
     //       MIOPEN_THROW(miopenStatusBadParm);
     //    }
@@ -1511,6 +1715,14 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                                                         size_t workSpaceSize,
                                                         bool exhaustiveSearch) const
 {
+    if(dyDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
+    if(dyDesc.GetLayout() != "NCHW")
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only NCHW layout is supported");
+    }
 
     if(x == nullptr || dw == nullptr || dy == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
@@ -1521,14 +1733,19 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
     if(requestAlgoCount < 1)
         MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
 
+    handle.UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+        return ConvolutionBackwardWeightsGetWorkSpaceSize(handle, dyDesc, xDesc, dwDesc);
+    });
+
     // create a dummy buffer for use as output for the kernel calls
     // because kernels are called purely for timing purposes
-    auto tmp_dw = handle.Create(dwDesc.GetElementSize() * sizeof(dwDesc.GetType()));
+    auto tmp_dw = handle.Create(dwDesc.GetElementSize() * GetTypeSize(dwDesc.GetType()));
 
     AutoEnableProfiling enableProfiling{handle};
 
     // < algorith_name, <time, workspace_size> >
     std::vector<PerfField> perf_db;
+    TraceSequence find_trace{"find"};
 
     // GEMM based
     int in_n, in_c, in_h, in_w;
@@ -1560,6 +1777,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
             time_gemm = in_n * handle.GetKernelTime();
             perf_db.push_back(PerfField{"miopenConvolutionBwdWeightsAlgoGEMM", time_gemm, 0});
+            TraceCandidate(find_trace, perf_db.back());
         }
         // if not 1x1
         else if(workSpace != nullptr && workSpaceSize >= workspace_req)
@@ -1590,6 +1808,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             time_gemm = in_n * (time_im2col + handle.GetKernelTime());
             perf_db.push_back(
                 PerfField{"miopenConvolutionBwdWeightsAlgoGEMM", time_gemm, workspace_req});
+            TraceCandidate(find_trace, perf_db.back());
         }
 #else
         (void)workSpace;     // Suppress warning
@@ -1614,6 +1833,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
             time_gemm = in_n * handle.GetKernelTime();
             perf_db.push_back(PerfField{"miopenConvolutionBwdWeightsAlgoGEMM", time_gemm, 0});
+            TraceCandidate(find_trace, perf_db.back());
         }
         // if not 1x1
         else if(workSpace != nullptr && workSpaceSize >= workspace_req)
@@ -1644,6 +1864,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             time_gemm = in_n * (time_im2col + handle.GetKernelTime());
             perf_db.push_back(
                 PerfField{"miopenConvolutionBwdWeightsAlgoGEMM", time_gemm, workspace_req});
+            TraceCandidate(find_trace, perf_db.back());
         }
 #else
         (void)workSpace;     // Suppress warning
@@ -1719,6 +1940,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                         time_direct = handle.GetKernelTime();
                         perf_db.push_back(
                             PerfField{"miopenConvolutionBwdWeightsAlgoDirect", time_direct, 0});
+                        TraceCandidate(find_trace, perf_db.back());
                     }
                     else
                     {
@@ -1794,6 +2016,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                             perf_db.push_back(PerfField{"miopenConvolutionBwdWeightsAlgoDirect",
                                                         time_direct,
                                                         workspace_req});
+                            TraceCandidate(find_trace, perf_db.back());
                         }
                     }
                 }
@@ -1833,6 +2056,14 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
                                                        Data_t workSpace,
                                                        size_t workSpaceSize) const
 {
+    if(dyDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
+    if(dyDesc.GetLayout() != "NCHW")
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only NCHW layout is supported");
+    }
 
     if(x == nullptr || dw == nullptr || dy == nullptr)
     {
@@ -1846,6 +2077,11 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
+
+    handle.UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+        return ConvolutionBackwardWeightsGetWorkSpaceSize(handle, dyDesc, xDesc, dwDesc);
+    });
+
     if(dyDesc.GetLengths()[0] != xDesc.GetLengths()[0])
     {
         MIOPEN_THROW(miopenStatusBadParm);
@@ -2138,6 +2374,10 @@ void ConvolutionBackwardBias(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
+    if(dyDesc.GetType() != miopenFloat || dbDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
     if(dyDesc.GetLengths()[1] != dbDesc.GetLengths()[1])
     {
         MIOPEN_THROW(miopenStatusBadParm);
@@ -129,6 +129,10 @@ static int FindFFTKernel(Handle& handle,
     if(workSpaceSize == 0)
         return -1;
 
+    // the FFT kernels are float and NCHW only
+    if(xDesc.GetType() != miopenFloat || xDesc.GetLayout() != "NCHW")
+        return -1;
+
     // disable running any FFT based convolutions by checking this env variable
     if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{}))
         return -1;
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/elementwise.hpp>
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace miopen {
+
+static bool IsUnary(ElementwiseOp op)
+{
+    return op >= ElementwiseOp::Neg && op < ElementwiseOp::Add;
+}
+
+static bool IsBinary(ElementwiseOp op) { return op >= ElementwiseOp::Add; }
+
+static std::string UnaryExpr(ElementwiseOp op, const std::string& a)
+{
+    switch(op)
+    {
+    case ElementwiseOp::Neg: return "-" + a;
+    case ElementwiseOp::Abs: return "fabs(" + a + ")";
+    case ElementwiseOp::Exp: return "exp(" + a + ")";
+    case ElementwiseOp::Log: return "log(" + a + ")";
+    case ElementwiseOp::Sqrt: return "sqrt(" + a + ")";
+    case ElementwiseOp::Tanh: return "tanh(" + a + ")";
+    case ElementwiseOp::Sigmoid: return "1.0f / (1.0f + exp(-" + a + "))";
+    case ElementwiseOp::Relu: return "fmax(" + a + ", 0.0f)";
+    default: MIOPEN_THROW("Not a unary elementwise op");
+    }
+}
+
+static std::string BinaryExpr(ElementwiseOp op, const std::string& a, const std::string& b)
+{
+    switch(op)
+    {
+    case ElementwiseOp::Add: return a + " + " + b;
+    case ElementwiseOp::Sub: return a + " - " + b;
+    case ElementwiseOp::Mul: return a + " * " + b;
+    case ElementwiseOp::Div: return a + " / " + b;
+    case ElementwiseOp::Min: return "fmin(" + a + ", " + b + ")";
+    case ElementwiseOp::Max: return "fmax(" + a + ", " + b + ")";
+    default: MIOPEN_THROW("Not a binary elementwise op");
+    }
+}
+
+ElementwiseExpression::Node ElementwiseExpression::Append(ElementwiseOp op, int a, int b)
+{
+    nodes.push_back({op, a, b});
+    return static_cast<Node>(nodes.size() - 1);
+}
+
+ElementwiseExpression::Node ElementwiseExpression::Input(int index)
+{
+    if(index < 0 || index >= MaxInputs)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Elementwise expressions take at most " + std::to_string(MaxInputs) +
+                         " inputs");
+    }
+    return Append(ElementwiseOp::Input, index, -1);
+}
+
+ElementwiseExpression::Node ElementwiseExpression::Constant(float value)
+{
+    if(constants.size() >= MaxConstants)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Elementwise expressions take at most " + std::to_string(MaxConstants) +
+                         " constants");
+    }
+    constants.push_back(value);
+    return Append(ElementwiseOp::Constant, static_cast<int>(constants.size() - 1), -1);
+}
+
+ElementwiseExpression::Node ElementwiseExpression::Unary(ElementwiseOp op, Node a)
+{
+    if(!IsUnary(op) || a < 0 || a >= static_cast<int>(nodes.size()))
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    return Append(op, a, -1);
+}
+
+ElementwiseExpression::Node ElementwiseExpression::Binary(ElementwiseOp op, Node a, Node b)
+{
+    const int n_nodes = nodes.size();
+    if(!IsBinary(op) || a < 0 || a >= n_nodes || b < 0 || b >= n_nodes)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    return Append(op, a, b);
+}
+
+int ElementwiseExpression::GetInputCount() const
+{
+    int count = 0;
+    for(auto&& node : nodes)
+    {
+        if(node.op == ElementwiseOp::Input)
+            count = std::max(count, node.a + 1);
+    }
+    return count;
+}
+
+// Lengths are right aligned to MaxDims. Bit d of an input's bitmap is set when
+// it runs along dim d of the output, otherwise it is broadcast over that dim.
+static std::vector<std::size_t> AlignLengths(const TensorDescriptor& desc)
+{
+    auto lens = desc.GetLengths();
+    if(lens.size() > ElementwiseExpression::MaxDims)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Elementwise tensors can have at most 5 dims");
+    }
+    if(desc.GetElementSpace() != desc.GetElementSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Elementwise tensors must be packed");
+    }
+    std::vector<std::size_t> result(ElementwiseExpression::MaxDims - lens.size(), 1);
+    result.insert(result.end(), lens.begin(), lens.end());
+    return result;
+}
+
+static std::vector<unsigned int> GetBitmaps(const std::vector<ElementwiseInput>& inputs,
+                                            const TensorDescriptor& yDesc)
+{
+    auto ylens = AlignLengths(yDesc);
+    std::vector<unsigned int> bitmaps;
+    for(auto&& input : inputs)
+    {
+        if(input.desc.GetType() != yDesc.GetType())
+        {
+            MIOPEN_THROW(miopenStatusBadParm, "Elementwise tensors must have the same data type");
+        }
+        auto lens           = AlignLengths(input.desc);
+        unsigned int bitmap = 0;
+        for(int d = 0; d < ElementwiseExpression::MaxDims; d++)
+        {
+            if(lens[d] == ylens[d] && lens[d] != 1)
+                bitmap |= 1u << d;
+            else if(lens[d] != 1)
+                MIOPEN_THROW(miopenStatusBadParm,
+                             "Elementwise input dims must be 1 or match the output");
+        }
+        bitmaps.push_back(bitmap);
+    }
+    return bitmaps;
+}
+
+std::string ElementwiseExpression::Signature(const std::vector<ElementwiseInput>& inputs,
+                                             const TensorDescriptor& yDesc) const
+{
+    std::ostringstream ss;
+    ss << "t" << yDesc.GetType();
+    for(auto&& bitmap : GetBitmaps(inputs, yDesc))
+        ss << "b" << bitmap;
+    for(auto&& node : nodes)
+        ss << "n" << static_cast<int>(node.op) << "," << node.a << "," << node.b;
+    return ss.str();
+}
+
+std::string ElementwiseExpression::GenerateSource(const std::vector<unsigned int>& bitmaps,
+                                                  int dims) const
+{
+    std::ostringstream ss;
+    ss << "__kernel void MIOpenElementwise(global MIOPEN_TYPE* out,\n"
+       << "                                const long out_off,\n";
+    for(int i = 0; i < MaxInputs; i++)
+    {
+        ss << "                                const global MIOPEN_TYPE* in" << i << ",\n"
+           << "                                const long in" << i << "_off,\n";
+    }
+    for(int i = 0; i < MaxConstants; i++)
+        ss << "                                const float c" << i << ",\n";
+    ss << "                                const uint total";
+    for(int d = 0; d < dims; d++)
+        ss << ",\n                                const uint l" << d;
+    ss << ")\n{\n"
+       << "    for(uint gid = get_global_id(0); gid < total; gid += get_global_size(0))\n"
+       << "    {\n"
+       << "        uint r = gid;\n";
+    for(int d = dims - 1; d >= 0; d--)
+    {
+        ss << "        const uint i" << d << " = r % l" << d << ";\n";
+        if(d > 0)
+            ss << "        r /= l" << d << ";\n";
+    }
+    for(std::size_t i = 0; i < bitmaps.size(); i++)
+    {
+        ss << "        uint x" << i << " = 0;\n";
+        for(int d = 0; d < dims; d++)
+        {
+            if(bitmaps[i] & (1u << d))
+                ss << "        x" << i << " = x" << i << " * l" << d << " + i" << d << ";\n";
+        }
+    }
+    for(std::size_t n = 0; n < nodes.size(); n++)
+    {
+        const auto& node = nodes[n];
+        const auto a     = "v" + std::to_string(node.a);
+        const auto b     = "v" + std::to_string(node.b);
+        ss << "        const float v" << n << " = ";
+        if(node.op == ElementwiseOp::Input)
+            ss << "(float)in" << node.a << "[in" << node.a << "_off + x" << node.a << "]";
+        else if(node.op == ElementwiseOp::Constant)
+            ss << "c" << node.a;
+        else if(IsUnary(node.op))
+            ss << UnaryExpr(node.op, a);
+        else
+            ss << BinaryExpr(node.op, a, b);
+        ss << ";\n";
+    }
+    ss << "        out[out_off + gid] = (MIOPEN_TYPE)v" << nodes.size() - 1 << ";\n"
+       << "    }\n"
+       << "}\n";
+    return ss.str();
+}
+
+void ElementwiseExpression::Run(Handle& handle,
+                                const std::vector<ElementwiseInput>& inputs,
+                                const TensorDescriptor& yDesc,
+                                Data_t y,
+                                size_t yOffset) const
+{
+    if(nodes.empty() || y == nullptr || inputs.size() != static_cast<std::size_t>(GetInputCount()))
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(std::any_of(inputs.begin(), inputs.end(), [](const ElementwiseInput& input) {
+           return input.data == nullptr;
+       }))
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(yDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented);
+    }
+
+    const auto lens  = AlignLengths(yDesc);
+    const auto total = yDesc.GetElementSize();
+    if(total == 0)
+        return;
+
+    const std::size_t lcl_sz   = 256;
+    const std::size_t max_grps = 1024;
+    const std::size_t n_grps   = std::min((total + lcl_sz - 1) / lcl_sz, max_grps);
+
+    const std::vector<size_t> vld = {lcl_sz, 1, 1};
+    const std::vector<size_t> vgd = {n_grps * lcl_sz, 1, 1};
+
+    // Unused slots repeat the first input so every argument is a valid buffer.
+    const int n_inputs = inputs.size();
+    auto data          = [&](int i) { return inputs[i < n_inputs ? i : 0].data; };
+    auto offset        = [&](int i) { return i < n_inputs ? long(inputs[i].offset) : 0L; };
+    auto constant = [&](std::size_t i) { return i < constants.size() ? constants[i] : 0.0f; };
+
+    // The generated source is the program name. The signature already fixes that
+    // source, so it keys the kernel cache and repeated calls skip generating it.
+    const std::string algo_name      = "miopenGeneratedElementwise";
+    const std::string network_config = Signature(inputs, yDesc) + "g" + std::to_string(n_grps);
+
+    auto kernel = handle.HasKernel(algo_name, network_config)
+                      ? handle.GetKernel(algo_name, network_config)
+                      : handle.GetKernel(algo_name,
+                                         network_config,
+                                         GenerateSource(GetBitmaps(inputs, yDesc), MaxDims),
+                                         "MIOpenElementwise",
+                                         vld,
+                                         vgd,
+                                         " -DMIOPEN_TYPE=float");
+    kernel(y,
+           long(yOffset),
+           data(0),
+           offset(0),
+           data(1),
+           offset(1),
+           data(2),
+           offset(2),
+           data(3),
+           offset(3),
+           constant(0),
+           constant(1),
+           constant(2),
+           constant(3),
+           static_cast<unsigned int>(total),
+           static_cast<unsigned int>(lens[0]),
+           static_cast<unsigned int>(lens[1]),
+           static_cast<unsigned int>(lens[2]),
+           static_cast<unsigned int>(lens[3]),
+           static_cast<unsigned int>(lens[4]));
+}
+
+} // namespace miopen
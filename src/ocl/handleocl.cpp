@@ -24,13 +24,16 @@
  *
  *******************************************************************************/
 #include <miopen/device_name.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/manage_ptr.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/binary_cache.hpp>
 #include <miopen/load_file.hpp>
+#include <miopen/trace.hpp>
 #include <boost/filesystem.hpp>
 #include <string>
 
@@ -40,6 +43,9 @@
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEMORY_POOL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_WORKSPACE_ARENA_MB)
+
 #ifndef NDEBUG
 void dumpKernel(cl_kernel kern,
                 const std::string& kernel_name,
@@ -258,9 +264,13 @@ struct HandleImpl
     ContextPtr context;
     AqPtr queue;
     Allocator allocator{};
+    WorkspaceArena workspace;
     KernelCache cache;
-    bool enable_profiling  = false;
-    float profiling_result = 0.0;
+    bool enable_profiling   = false;
+    bool deferred_profiling = false;
+    float profiling_result  = 0.0;
+    KernelProfiler profiler;
+    KernelProfiler trace_profiler;
 
     ContextPtr create_context()
     {
@@ -336,6 +346,64 @@ struct HandleImpl
         clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_START, sizeof(size_t), &st, nullptr);
         clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_END, sizeof(size_t), &end, nullptr);
         profiling_result = ((end - st) * 1e-6);
+        RecordDeviceTime(profiling_result);
+    }
+
+    std::function<void(cl_event&)> DeferredProfilingHandler(KernelProfiler& target,
+                                                            const Kernel& k,
+                                                            const std::string& algorithm,
+                                                            const std::string& network_config)
+    {
+        KernelProfile profile;
+        profile.kernel_name    = k.GetName();
+        profile.algorithm      = algorithm;
+        profile.network_config = network_config;
+        return [=, &target](cl_event& e) {
+            clRetainEvent(e);
+            std::shared_ptr<std::remove_pointer<cl_event>::type> ev{e, &clReleaseEvent};
+            auto launched = profile;
+            if(IsTracingEnabled())
+                launched.enqueue_ns = TraceNow();
+            target.Record(launched, [=](KernelProfile& p) {
+                cl_event x = ev.get();
+                clWaitForEvents(1, &x);
+                cl_ulong st = 0, end = 0;
+                clGetEventProfilingInfo(
+                    x, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &st, nullptr);
+                clGetEventProfilingInfo(
+                    x, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &end, nullptr);
+                p.start_ns = st;
+                p.end_ns   = end;
+            });
+        };
+    }
+
+    KernelInvoke Invoke(const Kernel& k,
+                        miopenAcceleratorQueue_t q,
+                        const std::string& algorithm,
+                        const std::string& network_config)
+    {
+        if(enable_profiling)
+        {
+            return k.Invoke(q,
+                            std::bind(&HandleImpl::SetProfilingResult,
+                                      std::ref(*this),
+                                      std::placeholders::_1));
+        }
+        else if(deferred_profiling)
+        {
+            return k.Invoke(
+                q, DeferredProfilingHandler(profiler, k, algorithm, network_config), false);
+        }
+        else if(IsTracingEnabled())
+        {
+            return k.Invoke(
+                q, DeferredProfilingHandler(trace_profiler, k, algorithm, network_config), false);
+        }
+        else
+        {
+            return k.Invoke(q);
+        }
     }
 };
 
@@ -346,6 +414,8 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
     impl->context = impl->create_context_from_queue();
 
     this->SetAllocator(nullptr, nullptr, nullptr);
+    this->EnableMemoryPool(miopen::IsEnabled(MIOPEN_MEMORY_POOL{}));
+    this->SetWorkspaceArenaLimit(std::size_t(miopen::Value(MIOPEN_WORKSPACE_ARENA_MB{})) << 20);
 }
 
 Handle::Handle() : impl(new HandleImpl())
@@ -421,10 +491,20 @@ Handle::Handle() : impl(new HandleImpl())
         MIOPEN_THROW("Creating Command Queue. (clCreateCommandQueue)");
     }
     this->SetAllocator(nullptr, nullptr, nullptr);
+    this->EnableMemoryPool(miopen::IsEnabled(MIOPEN_MEMORY_POOL{}));
+    this->SetWorkspaceArenaLimit(std::size_t(miopen::Value(MIOPEN_WORKSPACE_ARENA_MB{})) << 20);
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+
+Handle::~Handle()
+{
+    if(impl != nullptr && IsTracingEnabled())
+    {
+        TraceKernels(impl->queue.get(), impl->trace_profiler.Collect());
+        FlushTrace();
+    }
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -452,6 +532,38 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
 
     this->impl->allocator.context =
         allocatorContext == nullptr ? this->impl->context.get() : allocatorContext;
+    // Cached buffers belong to the previous allocator
+    const bool pooled          = this->impl->allocator.pool != nullptr;
+    this->impl->allocator.pool = nullptr;
+    this->impl->allocator.EnablePool(pooled);
+}
+
+void Handle::EnableMemoryPool(bool enable) const { this->impl->allocator.EnablePool(enable); }
+
+MemoryPoolStats Handle::GetMemoryPoolStats() const
+{
+    const auto& pool = this->impl->allocator.pool;
+    return pool == nullptr ? MemoryPoolStats{} : pool->GetStats();
+}
+
+void Handle::TrimMemoryPool() const
+{
+    if(this->impl->allocator.pool != nullptr)
+        this->impl->allocator.pool->Trim();
+}
+
+void Handle::SetWorkspaceArenaLimit(std::size_t limit) const
+{
+    this->impl->workspace.SetLimit(limit);
+}
+
+std::size_t Handle::GetWorkspaceArenaLimit() const { return this->impl->workspace.limit; }
+
+std::size_t Handle::GetWorkspaceArenaSize() const { return this->impl->workspace.size; }
+
+Data_t Handle::GetWorkspaceArena(std::size_t sz)
+{
+    return this->impl->workspace.Get(this->impl->allocator, sz);
 }
 
 void Handle::EnableProfiling(bool enable) { this->impl->enable_profiling = enable; }
@@ -476,40 +588,28 @@ KernelInvoke Handle::GetKernel(const std::string& algorithm,
 #ifndef NDEBUG
 // dumpKernel(obj.GetKernel(), kernel_name, vld, vgd, params);
 #endif
-    if(this->impl->enable_profiling)
-    {
-        return obj.Invoke(q,
-                          std::bind(&HandleImpl::SetProfilingResult,
-                                    std::ref(*this->impl),
-                                    std::placeholders::_1));
-    }
-    else
-    {
-        return obj.Invoke(q);
-    }
+    return this->impl->Invoke(obj, q, algorithm, network_config);
 }
 
 KernelInvoke Handle::GetKernel(const std::string& algorithm, const std::string& network_config)
 {
     auto q         = this->GetStream();
     const auto obj = this->impl->cache.GetKernel(algorithm, network_config);
-    if(this->impl->enable_profiling)
-    {
-        return obj.Invoke(q,
-                          std::bind(&HandleImpl::SetProfilingResult,
-                                    std::ref(*this->impl),
-                                    std::placeholders::_1));
-    }
-    else
-    {
-        return obj.Invoke(q);
-    }
+    return this->impl->Invoke(obj, q, algorithm, network_config);
+}
+
+bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
+{
+    return this->impl->cache.HasKernel(algorithm, network_config);
 }
 
 Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
 {
+    TraceSpan span{"program", "Handle::LoadProgram"};
+    span.Arg("program", program_name).Arg("params", params);
     auto cache_file =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
+    span.Arg("binary_cache", cache_file.empty() ? "miss" : "hit");
     if(cache_file.empty())
     {
         auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
@@ -534,12 +634,32 @@ Program Handle::LoadProgram(const std::string& program_name, std::string params,
     }
 }
 
-void Handle::Finish() const { clFinish(this->GetStream()); }
+void Handle::Finish() const
+{
+    clFinish(this->GetStream());
+    // The queue is idle, so draining the traced launches costs nothing here.
+    if(IsTracingEnabled())
+    {
+        TraceKernels(impl->queue.get(), impl->trace_profiler.Collect());
+        impl->trace_profiler.Reset();
+    }
+}
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
+void Handle::EnableDeferredProfiling(bool enable) { this->impl->deferred_profiling = enable; }
+
+bool Handle::IsDeferredProfilingEnabled() const { return this->impl->deferred_profiling; }
+
+const std::vector<KernelProfile>& Handle::GetKernelProfiles()
+{
+    return this->impl->profiler.Collect();
+}
+
+void Handle::ResetKernelProfiles() { this->impl->profiler.Reset(); }
+
 std::size_t Handle::GetLocalMemorySize()
 {
     return miopen::GetDeviceInfo<CL_DEVICE_LOCAL_MEM_SIZE>(miopen::GetDevice(this->GetStream()));
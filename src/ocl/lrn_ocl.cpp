@@ -39,6 +39,10 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
                                       bool do_backward,
                                       Data_t workSpace)
 {
+    if(xDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
 
     miopenStatus_t status = miopenStatusSuccess;
     mlo_construct_norm construct_params(1); // forward
@@ -141,6 +145,10 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
                                        Data_t dx,
                                        ConstData_t workSpace)
 {
+    if(xDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
+    }
     miopenStatus_t status = miopenStatusSuccess;
     mlo_construct_norm construct_params(0); // backward
 
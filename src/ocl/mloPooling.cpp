@@ -73,6 +73,15 @@ int mlo_construct_pooling2D::mloConstructFwd()
 {
     int ret = 0;
 
+    // the window covers the whole input plane, every output is the reduction of one plane
+    if(_search_params.out_width == 1 && _search_params.out_height == 1 &&
+       _search_params.kernel_size0 == _search_params.in_width &&
+       _search_params.kernel_size1 == _search_params.in_height && _search_params.pad0 == 0 &&
+       _search_params.pad1 == 0)
+    {
+        return (mloConstructFwdGlobal());
+    }
+
     _grp_tile0 = 8;
     _grp_tile1 = 8;
 
@@ -121,12 +130,16 @@ int mlo_construct_pooling2D::mloConstructFwd()
                     std::to_string(static_cast<long long>(_search_params.in_channel_stride)) +
                     std::string(" -DMLO_POOLING_BOT_STRIDE=") +
                     std::to_string(static_cast<long long>(_search_params.in_stride)) +
+                    std::string(" -DMLO_POOLING_BOT_PIX_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_pix_stride)) +
                     std::string(" -DMLO_POOLING_TOP_BATCH_STRIDE=") +
                     std::to_string(static_cast<long long>(_search_params.out_batch_stride)) +
                     std::string(" -DMLO_POOLING_TOP_CHANNEL_STRIDE=") +
                     std::to_string(static_cast<long long>(_search_params.out_channel_stride)) +
                     std::string(" -DMLO_POOLING_TOP_STRIDE=") +
                     std::to_string(static_cast<long long>(_search_params.out_stride)) +
+                    std::string(" -DMLO_POOLING_TOP_PIX_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.out_pix_stride)) +
                     std::string(" -DMLO_POOLING_BOT_WIDTH=") +
                     std::to_string(static_cast<long long>(_search_params.in_width)) +
                     std::string(" -DMLO_POOLING_BOT_HEIGHT=") +
@@ -160,6 +173,66 @@ int mlo_construct_pooling2D::mloConstructFwd()
     return (ret);
 }
 
+int mlo_construct_pooling2D::mloConstructFwdGlobal()
+{
+    int ret = 0;
+
+    const int group_sz = 256;
+    const int plane_sz = _search_params.in_width * _search_params.in_height;
+
+    // work items per plane, so that small planes share a work group and large ones get all of it
+    int lanes = 16;
+    while(lanes < plane_sz && lanes < group_sz)
+    {
+        lanes <<= 1;
+    }
+    int n_planes = _search_params.batch_sz * _search_params.n_outputs;
+    int n_groups = (n_planes + group_sz / lanes - 1) / (group_sz / lanes);
+
+    _comp_options = std::string(" -DMLO_POOLING_OP_ID=") +
+                    std::to_string(static_cast<long long>(_pooling_method)) +
+                    std::string(" -DMLO_POOLING_N_OUTPUTS=") +
+                    std::to_string(static_cast<long long>(_search_params.n_outputs)) +
+                    std::string(" -DMLO_POOLING_BATCH_SZ=") +
+                    std::to_string(static_cast<long long>(_search_params.batch_sz)) +
+                    std::string(" -DMLO_POOLING_GLOBAL_LANES=") +
+                    std::to_string(static_cast<long long>(lanes)) +
+                    std::string(" -DMLO_POOLING_BOT_BATCH_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_batch_stride)) +
+                    std::string(" -DMLO_POOLING_BOT_CHANNEL_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_channel_stride)) +
+                    std::string(" -DMLO_POOLING_BOT_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_stride)) +
+                    std::string(" -DMLO_POOLING_BOT_PIX_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_pix_stride)) +
+                    std::string(" -DMLO_POOLING_TOP_BATCH_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.out_batch_stride)) +
+                    std::string(" -DMLO_POOLING_TOP_CHANNEL_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.out_channel_stride)) +
+                    std::string(" -DMLO_POOLING_BOT_WIDTH=") +
+                    std::to_string(static_cast<long long>(_search_params.in_width)) +
+                    std::string(" -DMLO_POOLING_BOT_HEIGHT=") +
+                    std::to_string(static_cast<long long>(_search_params.in_height)) +
+                    std::string(_do_backward ? " -DMLO_POOLING_DO_BACKWARD" : "") +
+                    getGeneralCompOptions();
+
+    _l_wk.clear();
+    _l_wk.push_back(group_sz);
+    _l_wk.push_back(1);
+    _l_wk.push_back(1);
+
+    _g_wk.clear();
+    _g_wk.push_back(n_groups * group_sz);
+    _g_wk.push_back(1);
+    _g_wk.push_back(1);
+
+    _kernel_file = "MIOpenPoolingGlobal.cl";
+
+    _kernel_name = "mloPoolingGlobalFwd";
+
+    return (ret);
+}
+
 int mlo_construct_pooling2D::mloConstructBwd()
 {
     int ret = 0;
@@ -172,6 +245,14 @@ int mlo_construct_pooling2D::mloConstructBwd()
     _out_pix_tile0 = (_search_params.out_width < _grp_tile0 * 2) ? 1 : 2;
     _out_pix_tile1 = (_search_params.out_height < _grp_tile1 * 2) ? 1 : 2;
 
+    // one top pixel per work item, its window is scanned from global memory
+    const bool index_free = _index_free && _pooling_method == MLO_POOLING_OP_MAX;
+    if(index_free)
+    {
+        _out_pix_tile0 = 1;
+        _out_pix_tile1 = 1;
+    }
+
     _comp_options = std::string(" -DMLO_POOLING_KERNEL_SZ1=") +
                     std::to_string(static_cast<long long>(_search_params.kernel_size1)) +
                     std::string(" -DMLO_POOLING_PAD1=") +
@@ -208,19 +289,33 @@ int mlo_construct_pooling2D::mloConstructBwd()
                     std::to_string(static_cast<long long>(_in_df_channel_stride)) +
                     std::string(" -DMLO_POOLBWD_BOTDF_STRIDE=") +
                     std::to_string(static_cast<long long>(_in_df_stride)) +
+                    std::string(" -DMLO_POOLBWD_BOTDF_PIX_STRIDE=") +
+                    std::to_string(static_cast<long long>(_in_df_pix_stride)) +
                     std::string(" -DMLO_POOLBWD_TOPDF_BATCH_STRIDE=") +
                     std::to_string(static_cast<long long>(_out_df_batch_stride)) +
                     std::string(" -DMLO_POOLBWD_TOPDF_CHANNEL_STRIDE=") +
                     std::to_string(static_cast<long long>(_out_df_channel_stride)) +
                     std::string(" -DMLO_POOLBWD_TOPDF_STRIDE=") +
-                    std::to_string(static_cast<long long>(_out_df_stride))
+                    std::to_string(static_cast<long long>(_out_df_stride)) +
+                    std::string(" -DMLO_POOLBWD_TOPDF_PIX_STRIDE=") +
+                    std::to_string(static_cast<long long>(_out_df_pix_stride)) +
+                    std::string(" -DMLO_POOLBWD_BOT_BATCH_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_batch_stride)) +
+                    std::string(" -DMLO_POOLBWD_BOT_CHANNEL_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_channel_stride)) +
+                    std::string(" -DMLO_POOLBWD_BOT_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_stride)) +
+                    std::string(" -DMLO_POOLBWD_BOT_PIX_STRIDE=") +
+                    std::to_string(static_cast<long long>(_search_params.in_pix_stride))
 
                     + getGeneralCompOptions();
 
-    int g_wk_width = ((_search_params.in_width + _grp_tile0 * _out_pix_tile0 - 1) /
-                      (_grp_tile0 * _out_pix_tile0));
-    int g_wk_height = ((_search_params.in_height + _grp_tile1 * _out_pix_tile1 - 1) /
-                       (_grp_tile1 * _out_pix_tile1));
+    const int grid_width  = index_free ? _search_params.out_width : _search_params.in_width;
+    const int grid_height = index_free ? _search_params.out_height : _search_params.in_height;
+    int g_wk_width =
+        ((grid_width + _grp_tile0 * _out_pix_tile0 - 1) / (_grp_tile0 * _out_pix_tile0));
+    int g_wk_height =
+        ((grid_height + _grp_tile1 * _out_pix_tile1 - 1) / (_grp_tile1 * _out_pix_tile1));
 
     _l_wk.clear();
     _l_wk.push_back(_grp_tile0);
@@ -235,7 +330,7 @@ int mlo_construct_pooling2D::mloConstructBwd()
     _kernel_file = "MIOpenPoolingBwd.cl";
     if(_pooling_method == MLO_POOLING_OP_MAX)
     {
-        _kernel_name = "mloPoolingMaxBwd";
+        _kernel_name = _index_free ? "mloPoolingMaxBwdIndexFree" : "mloPoolingMaxBwd";
     }
     else if(_pooling_method == MLO_POOLING_OP_AVE)
     {
@@ -28,12 +28,31 @@
 #include <miopen/pooling.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
+#include <miopen/datatype.hpp>
 
 namespace miopen {
 
+// Type of the max pooling indices in the kernels, which default to uchar
+static std::string GetIndexKernelParams(miopenIndexType_t index_type)
+{
+    switch(index_type)
+    {
+    case miopenIndexUint8: return "";
+    case miopenIndexUint16:
+        return " -DMLO_POOLING_INDEX_TYPE=ushort -DMLO_POOLING_INDEX_MAX=USHRT_MAX";
+    case miopenIndexUint32:
+        return " -DMLO_POOLING_INDEX_TYPE=uint -DMLO_POOLING_INDEX_MAX=UINT_MAX";
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Unknown pooling index type");
+}
+
 std::size_t PoolingDescriptor::GetWorkSpaceSize(const TensorDescriptor& tensorDesc) const
 {
-    return tensorDesc.GetElementSize() * sizeof(uint8_t);
+    if(IsIndexFreeBackward(tensorDesc))
+    {
+        return 0;
+    }
+    return tensorDesc.GetElementSize() * GetIndexSize();
 }
 
 miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
@@ -45,18 +64,23 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
                                           Data_t y,
                                           bool do_backward,
                                           Data_t workSpace,
-                                          size_t /*workSpaceSize*/) const
+                                          size_t workSpaceSize) const
 {
 
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    if(alpha == nullptr || beta == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "alpha and beta must not be null");
+    }
+    const float miopen_alpha = *(static_cast<const float*>(alpha));
+    const float miopen_beta  = *(static_cast<const float*>(beta));
+    if(xDesc.GetType() != yDesc.GetType())
     {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+        MIOPEN_THROW(miopenStatusBadParm, "Input and output tensor types do not match.");
     }
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, xDesc, x);
-        if(!float_equal(*(static_cast<const float*>(beta)), 0))
+        if(!float_equal(miopen_beta, 0))
         {
             miopen::checkNumericsInput(handle, yDesc, y);
         }
@@ -78,8 +102,16 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     std::tie(nOut, cOut, hOut, wOut)                         = tien<4>(yDesc.GetLengths());
     std::tie(nOutStride, cOutStride, hOutStride, wOutStride) = tien<4>(yDesc.GetStrides());
 
-    construct_params.setTopDescr(
-        "NCHW", "FP32", nOut, cOut, hOut, wOut, nOutStride, cOutStride, hOutStride, wOutStride);
+    construct_params.setTopDescr(yDesc.GetLayout(),
+                                 GetMloDataType(yDesc.GetType()),
+                                 nOut,
+                                 cOut,
+                                 hOut,
+                                 wOut,
+                                 nOutStride,
+                                 cOutStride,
+                                 hOutStride,
+                                 wOutStride);
     int nIn;
     int cIn;
     int hIn;
@@ -92,24 +124,37 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     std::tie(nIn, cIn, hIn, wIn)                         = tien<4>(xDesc.GetLengths());
     std::tie(nInStride, cInStride, hInStride, wInStride) = tien<4>(xDesc.GetStrides());
 
-    if(((lens[0] * lens[1]) >= std::numeric_limits<uint8_t>::max()) && do_backward)
+    construct_params.setBotDescr(xDesc.GetLayout(),
+                                 GetMloDataType(xDesc.GetType()),
+                                 nIn,
+                                 cIn,
+                                 hIn,
+                                 wIn,
+                                 nInStride,
+                                 cInStride,
+                                 hInStride,
+                                 wInStride);
+
+    // Without a workspace, or when it is not needed, the backward pass recomputes the argmax
+    const bool save_index = mode == miopenPoolingMax && do_backward && workSpace != nullptr &&
+                            !IsIndexFreeBackward(yDesc);
+
+    // Backward reads the indices whenever it gets a workspace, so a short one cannot be skipped
+    // here. This also catches the 8-bit size of miopenPoolingGetWorkSpaceSize used with wider
+    // indices.
+    if(save_index && workSpaceSize < GetWorkSpaceSize(yDesc))
     {
-        MIOPEN_THROW("Pooling window too large to do backwards");
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Pooling workspace of " + std::to_string(workSpaceSize) +
+                         " bytes is smaller than the " + std::to_string(GetWorkSpaceSize(yDesc)) +
+                         " bytes the indices need");
     }
 
-    construct_params.setBotDescr(
-        "NCHW", "FP32", nIn, cIn, hIn, wIn, nInStride, cInStride, hInStride, wInStride);
-
-    if(mode == miopenPoolingMax && do_backward && workSpace == nullptr)
-    {
-        throw std::invalid_argument(
-            "workSpace cannot be NULL in Forward Pooling MAX mode when backward pass is requested");
-    }
     int pooling_method = (mode == miopenPoolingMax) ? MLO_POOLING_OP_MAX : MLO_POOLING_OP_AVE;
     construct_params.setPoolingDescr(
         pooling_method, lens[0], lens[1], pads[0], pads[1], strides[0], strides[1]);
 
-    construct_params.doBackward(do_backward);
+    construct_params.doBackward(save_index);
 
     if(construct_params.mloConstruct() != 0)
     {
@@ -119,6 +164,11 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     std::string program_name = construct_params.getKernelFile();      // CL kernel filename
     std::string kernel_name  = construct_params.getKernelName();      // kernel name
     std::string parms        = construct_params.getCompilerOptions(); // kernel parameters
+    parms += GetDataTypeKernelParams(xDesc.GetType());
+    if(save_index)
+    {
+        parms += GetIndexKernelParams(GetWorkSpaceIndexType());
+    }
 
     std::string network_config;
     construct_params.mloBuildConf_Key(network_config);
@@ -127,7 +177,7 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
     handle.GetKernel("miopenPooling2dDForward", "", program_name, kernel_name, vld, vgd, parms)(
-        x, y, workSpace);
+        x, y, workSpace, miopen_alpha, miopen_beta);
 
     if(miopen::CheckNumericsEnabled())
     {
@@ -144,24 +194,29 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
                                            const TensorDescriptor& dyDesc,
                                            ConstData_t dy,
                                            const TensorDescriptor& xDesc,
-                                           ConstData_t /*x*/,
+                                           ConstData_t x,
                                            const void* beta,
                                            const TensorDescriptor& dxDesc,
                                            Data_t dx,
                                            ConstData_t workSpace) const
 {
 
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    if(alpha == nullptr || beta == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "alpha and beta must not be null");
+    }
+    const float miopen_alpha = *(static_cast<const float*>(alpha));
+    const float miopen_beta  = *(static_cast<const float*>(beta));
+    if(dyDesc.GetType() != dxDesc.GetType())
     {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+        MIOPEN_THROW(miopenStatusBadParm, "Input and output tensor types do not match.");
     }
     if(miopen::CheckNumericsEnabled())
     {
         // miopen::checkNumericsInput(handle, yDesc, y); // not actually used?
         miopen::checkNumericsInput(handle, dyDesc, dy);
         // miopen::checkNumericsInput(handle, xDesc, x); // not actually used?
-        if(!float_equal(*(static_cast<const float*>(beta)), 0))
+        if(!float_equal(miopen_beta, 0))
         {
             miopen::checkNumericsInput(handle, dxDesc, dx);
         }
@@ -184,8 +239,8 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     std::tie(ndOut, cdOut, hdOut, wdOut)                         = tien<4>(dyDesc.GetLengths());
     std::tie(ndOutStride, cdOutStride, hdOutStride, wdOutStride) = tien<4>(dyDesc.GetStrides());
 
-    construct_params.setTopDfDescr("NCHW",
-                                   "FP32",
+    construct_params.setTopDfDescr(dyDesc.GetLayout(),
+                                   GetMloDataType(dyDesc.GetType()),
                                    ndOut,
                                    cdOut,
                                    hdOut,
@@ -207,8 +262,16 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     std::tie(nOut, cOut, hOut, wOut)                         = tien<4>(yDesc.GetLengths());
     std::tie(nOutStride, cOutStride, hOutStride, wOutStride) = tien<4>(yDesc.GetStrides());
 
-    construct_params.setTopDescr(
-        "NCHW", "FP32", nOut, cOut, hOut, wOut, nOutStride, cOutStride, hOutStride, wOutStride);
+    construct_params.setTopDescr(yDesc.GetLayout(),
+                                 GetMloDataType(yDesc.GetType()),
+                                 nOut,
+                                 cOut,
+                                 hOut,
+                                 wOut,
+                                 nOutStride,
+                                 cOutStride,
+                                 hOutStride,
+                                 wOutStride);
 
     int ndIn;
     int cdIn;
@@ -222,8 +285,16 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     std::tie(ndIn, cdIn, hdIn, wdIn)                         = tien<4>(dxDesc.GetLengths());
     std::tie(ndInStride, cdInStride, hdInStride, wdInStride) = tien<4>(dxDesc.GetStrides());
 
-    construct_params.setBotDfDescr(
-        "NCHW", "FP32", ndIn, cdIn, hdIn, wdIn, ndInStride, cdInStride, hdInStride, wdInStride);
+    construct_params.setBotDfDescr(dxDesc.GetLayout(),
+                                   GetMloDataType(dxDesc.GetType()),
+                                   ndIn,
+                                   cdIn,
+                                   hdIn,
+                                   wdIn,
+                                   ndInStride,
+                                   cdInStride,
+                                   hdInStride,
+                                   wdInStride);
 
     int nIn;
     int cIn;
@@ -237,21 +308,54 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     std::tie(nIn, cIn, hIn, wIn)                         = tien<4>(xDesc.GetLengths());
     std::tie(nInStride, cInStride, hInStride, wInStride) = tien<4>(xDesc.GetStrides());
 
-    if(((lens[0] * lens[1]) >= std::numeric_limits<uint8_t>::max()))
+    construct_params.setBotDescr(xDesc.GetLayout(),
+                                 GetMloDataType(xDesc.GetType()),
+                                 nIn,
+                                 cIn,
+                                 hIn,
+                                 wIn,
+                                 nInStride,
+                                 cInStride,
+                                 hInStride,
+                                 wInStride);
+
+    // Same choice as the forward pass made about saving the indices
+    const bool recompute =
+        mode == miopenPoolingMax && (workSpace == nullptr || IsIndexFreeBackward(yDesc));
+    if(recompute && x == nullptr)
     {
-        MIOPEN_THROW("Pooling window too large to do backwards");
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "x cannot be NULL in Backward Pooling MAX mode without a workspace");
     }
 
-    construct_params.setBotDescr(
-        "NCHW", "FP32", nIn, cIn, hIn, wIn, nInStride, cInStride, hInStride, wInStride);
-
-    if(mode == miopenPoolingMax && workSpace == nullptr)
+    // Overlapping windows cannot each write their part of dx, so their indices are saved to a
+    // scratch workspace by a forward pass first
+    const bool index_free = recompute && !HasOverlappingWindows();
+    Allocator::ManageDataPtr scratch_y;
+    Allocator::ManageDataPtr scratch_index;
+    float time0 = 0;
+    if(recompute && !index_free)
     {
-        throw std::invalid_argument("workSpace cannot be NULL in Backward Pooling MAX mode");
+        const float one = 1, zero = 0;
+        scratch_y       = handle.Create(yDesc.GetElementSpace() * GetTypeSize(yDesc.GetType()));
+        scratch_index   = handle.Create(GetWorkSpaceSize(yDesc));
+        Forward(handle,
+                &one,
+                xDesc,
+                x,
+                &zero,
+                yDesc,
+                scratch_y.get(),
+                true,
+                scratch_index.get(),
+                GetWorkSpaceSize(yDesc));
+        time0     = handle.GetKernelTime();
+        workSpace = scratch_index.get();
     }
     int pooling_method = (mode == miopenPoolingMax) ? MLO_POOLING_OP_MAX : MLO_POOLING_OP_AVE;
     construct_params.setPoolingDescr(
         pooling_method, lens[0], lens[1], pads[0], pads[1], strides[0], strides[1]);
+    construct_params.setIndexFree(index_free);
 
     if(construct_params.mloConstruct() != 0)
     {
@@ -261,6 +365,11 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     std::string program_name = construct_params.getKernelFile();      // CL kernel filename
     std::string kernel_name  = construct_params.getKernelName();      // kernel name
     std::string parms        = construct_params.getCompilerOptions(); // kernel parameters
+    parms += GetDataTypeKernelParams(dyDesc.GetType());
+    if(mode == miopenPoolingMax && !index_free)
+    {
+        parms += GetIndexKernelParams(GetWorkSpaceIndexType());
+    }
 
     std::string network_config;
     construct_params.mloBuildConf_Key(network_config);
@@ -274,13 +383,21 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
 
     // Set kernel arguments
     // Use proper arguments
-    if(mode == miopenPoolingMax)
+    if(index_free)
+    {
+        k(dy, dx, x, miopen_alpha, miopen_beta);
+    }
+    else if(mode == miopenPoolingMax)
     {
-        k(dy, dx, workSpace);
+        k(dy, dx, workSpace, miopen_alpha, miopen_beta);
     }
     else
     {
-        k(dy, dx);
+        k(dy, dx, miopen_alpha, miopen_beta);
+    }
+    if(scratch_index != nullptr)
+    {
+        handle.AccumKernelTime(time0);
     }
 
     if(miopen::CheckNumericsEnabled())
@@ -72,6 +72,9 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
+    // Inference workspace is scratch, the training ones carry state to the backward passes
+    handle.UseWorkspaceArena(
+        workSpace, workSpaceSize, [&] { return GetWorkspaceSize(handle, seqLen, xDesc); });
     if(workSpaceSize < GetWorkspaceSize(handle, seqLen, xDesc))
     {
         MIOPEN_THROW("Workspace is required");
@@ -25,8 +25,11 @@
  *******************************************************************************/
 #include <miopen/kernel_cache.hpp>
 #include <miopen/softmax.hpp>
-#include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
+#include <miopen/datatype.hpp>
+
+#include <algorithm>
+#include <numeric>
 
 namespace miopen {
 
@@ -50,30 +53,50 @@ int nextPow2(int v)
     }
 }
 
-miopenStatus_t SoftmaxForward(
-    Handle& handle, const void* alpha, const void* beta, const TensorDescriptor& yDesc, Data_t y)
+// Softmax reduces over one axis of a packed tensor, which the kernels see as
+// n x c x spatial_dim with c the reduced axis.
+static std::tuple<int, int, int> GetSoftmaxDims(const TensorDescriptor& desc, int axis)
 {
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    const auto& lens = desc.GetLengths();
+    if(axis < 0 || axis >= static_cast<int>(lens.size()))
     {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+        MIOPEN_THROW(miopenStatusBadParm, "Softmax axis is out of range");
     }
-    int n, c, h, w;
-    std::tie(n, c, h, w) = tien<4>(yDesc.GetLengths());
-
-    std::string program_name = "MIOpenSoftmax.cl";
-    std::string kernel_name  = "SoftmaxForward";
+    if(desc.GetElementSpace() != desc.GetElementSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Softmax tensors must be packed");
+    }
+    auto prod = [&](int first, int last) {
+        return std::accumulate(
+            lens.begin() + first, lens.begin() + last, 1, std::multiplies<int>());
+    };
+    return std::make_tuple(prod(0, axis), lens[axis], prod(axis + 1, lens.size()));
+}
 
-    // using workgroup size of 256 by default
-    int grid_size   = n * h * w;
-    int spatial_dim = h * w;
+static std::string
+GetSoftmaxParms(int c, miopenSoftmaxAlgorithm_t algorithm, miopenDataType_t type)
+{
     // num_spatial_dims or pixels each workgroup can compute
-    int num_batch = c < 256 ? nextPow2(256 / c) : 1;
+    int num_batch     = c < 256 ? nextPow2(256 / c) : 1;
+    std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DUSE_SOFTMAX_LOG=" +
+                        std::to_string(algorithm == miopenSoftmaxLog ? 1 : 0) +
+                        GetDataTypeKernelParams(type);
+    if(num_batch > 1)
+    {
+        // num_threads iterating over channels for one spatial_dim
+        int batch_size = 256 / num_batch;
+        // num_channels each threads iterates over to cover all the channels
+        int u_batch_size = c > batch_size ? nextPow2(c / batch_size) : 1;
 
-    const std::vector<size_t> vld{256, 1, 1};
+        parms += " -DBATCH_SIZE=" + std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
+                 std::to_string(u_batch_size);
+    }
+    return parms;
+}
 
-    // compile parameters
-    std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch);
+static size_t GetSoftmaxWorkgroups(int c, int grid_size)
+{
+    int num_batch = c < 256 ? nextPow2(256 / c) : 1;
 
     // See Kernels/MIOpenSoftmax.cl for description
     if(num_batch == 1)
@@ -81,29 +104,103 @@ miopenStatus_t SoftmaxForward(
 
         // Control the max. number of workgroups launched so that we do not
         // start getting workgroup scheduling overheads
-        size_t workgroups = std::min(grid_size, 64 * 40 * 8);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
-
-        handle.GetKernel("miopenSoftmaxForward", "", program_name, kernel_name, vld, vgd, parms)(
-            y, c, grid_size, spatial_dim);
+        return std::min(grid_size, 64 * 40 * 8);
     }
     else
     { // CSR-Stream like approach
+        return grid_size % num_batch == 0 ? grid_size / num_batch : grid_size / num_batch + 1;
+    }
+}
 
-        // num_threads iterating over channels for one spatial_dim
-        int batch_size = 256 / num_batch;
-        // num_channels each threads iterates over to cover all the channels
-        int u_batch_size = c > batch_size ? nextPow2(c / batch_size) : 1;
+// Number of workgroups sharing one row in the wide row kernels, or 0 when a
+// single workgroup per row already fills the GPU.
+static int GetSoftmaxWideParts(int c, int grid_size)
+{
+    if(c < 8192 || grid_size >= 256)
+        return 0;
+    return std::min((c + 1023) / 1024, 64);
+}
 
-        size_t workgroups =
-            grid_size % num_batch == 0 ? grid_size / num_batch : grid_size / num_batch + 1;
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
+miopenStatus_t SoftmaxForward(Handle& handle,
+                              const void* alpha,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              const void* beta,
+                              const TensorDescriptor& yDesc,
+                              Data_t y,
+                              miopenSoftmaxAlgorithm_t algorithm,
+                              int axis)
+{
+    if(x == nullptr || y == nullptr || alpha == nullptr || beta == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetLengths() != yDesc.GetLengths() || xDesc.GetType() != yDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+    }
 
-        parms += " -DBATCH_SIZE=" + std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
-                 std::to_string(u_batch_size);
+    int n, c, spatial_dim;
+    std::tie(n, c, spatial_dim) = GetSoftmaxDims(yDesc, axis);
+
+    const float miopen_alpha = *(static_cast<const float*>(alpha));
+    const float miopen_beta  = *(static_cast<const float*>(beta));
+
+    std::string program_name = "MIOpenSoftmax.cl";
 
-        handle.GetKernel("miopenSoftmaxForward", "", program_name, kernel_name, vld, vgd, parms)(
-            y, c, grid_size, spatial_dim);
+    // using workgroup size of 256 by default
+    int grid_size = n * spatial_dim;
+    int num_parts = GetSoftmaxWideParts(c, grid_size);
+
+    const std::vector<size_t> vld{256, 1, 1};
+
+    if(num_parts > 0)
+    { // A few wide rows, each one is split across num_parts workgroups
+        // The partial stats live in the handle's workspace arena when one is
+        // configured, otherwise in a buffer that the memory pool can recycle.
+        const std::size_t partial_sz = 2 * grid_size * num_parts * sizeof(float);
+        Allocator::ManageDataPtr partial_buf;
+        Data_t partial = handle.GetWorkspaceArena(partial_sz);
+        if(partial == nullptr)
+        {
+            partial_buf = handle.Create(partial_sz);
+            partial     = partial_buf.get();
+        }
+
+        const std::vector<size_t> vgd{size_t(grid_size) * num_parts * vld[0], 1, 1};
+        std::string parms = GetSoftmaxParms(c, algorithm, yDesc.GetType()) + " -DNUM_PARTS=" +
+                            std::to_string(num_parts);
+
+        handle.GetKernel("miopenSoftmaxForwardWideStats",
+                         "",
+                         program_name,
+                         "SoftmaxForwardWideStats",
+                         vld,
+                         vgd,
+                         parms)(x, partial, c, spatial_dim);
+        float time0 = handle.GetKernelTime();
+
+        handle.GetKernel(
+            "miopenSoftmaxForwardWide", "", program_name, "SoftmaxForwardWide", vld, vgd, parms)(
+            x, y, partial, c, spatial_dim, miopen_alpha, miopen_beta);
+        handle.AccumKernelTime(time0);
+    }
+    else
+    {
+        const std::vector<size_t> vgd{GetSoftmaxWorkgroups(c, grid_size) * vld[0], 1, 1};
+
+        handle.GetKernel("miopenSoftmaxForward",
+                         "",
+                         program_name,
+                         "SoftmaxForward",
+                         vld,
+                         vgd,
+                         GetSoftmaxParms(c, algorithm, yDesc.GetType()))(
+            x, y, c, grid_size, spatial_dim, miopen_alpha, miopen_beta);
     }
     if(miopen::CheckNumericsEnabled())
     {
@@ -112,72 +209,61 @@ miopenStatus_t SoftmaxForward(
     return miopenStatusSuccess;
 }
 
+miopenStatus_t SoftmaxForward(
+    Handle& handle, const void* alpha, const void* beta, const TensorDescriptor& yDesc, Data_t y)
+{
+    return SoftmaxForward(handle, alpha, yDesc, y, beta, yDesc, y);
+}
+
 miopenStatus_t SoftmaxBackward(Handle& handle,
                                const void* alpha,
                                const TensorDescriptor& yDesc,
                                ConstData_t y,
+                               const TensorDescriptor& dyDesc,
+                               ConstData_t dy,
                                const void* beta,
                                const TensorDescriptor& dxDesc,
-                               Data_t dx)
+                               Data_t dx,
+                               miopenSoftmaxAlgorithm_t algorithm,
+                               int axis)
 {
-    if(yDesc != dxDesc)
+    if(y == nullptr || dy == nullptr || dx == nullptr || alpha == nullptr || beta == nullptr)
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    if(yDesc != dxDesc || yDesc != dyDesc)
     {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+        MIOPEN_THROW(miopenStatusBadParm);
     }
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, yDesc, y);
+        miopen::checkNumericsInput(handle, dyDesc, dy);
     }
 
-    int n, c, h, w;
-    std::tie(n, c, h, w) = tien<4>(dxDesc.GetLengths());
+    int n, c, spatial_dim;
+    std::tie(n, c, spatial_dim) = GetSoftmaxDims(dxDesc, axis);
+
+    const float miopen_alpha = *(static_cast<const float*>(alpha));
+    const float miopen_beta  = *(static_cast<const float*>(beta));
 
     std::string program_name = "MIOpenSoftmax.cl";
-    std::string kernel_name  = "SoftmaxBackward";
 
     // using workgroup size of 256 by default
-    int grid_size   = n * h * w;
-    int spatial_dim = h * w;
-    int num_batch   = c < 256 ? nextPow2(256 / c) : 1;
+    int grid_size = n * spatial_dim;
 
     const std::vector<size_t> vld{256, 1, 1};
+    const std::vector<size_t> vgd{GetSoftmaxWorkgroups(c, grid_size) * vld[0], 1, 1};
 
-    // compile parameters
-    std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch);
-
-    // See Kernels/MIOpenSoftmax.cl for description
-    if(num_batch == 1)
-    { // CSR-Vector like approach
+    handle.GetKernel("miopenSoftmaxBackward",
+                     "",
+                     program_name,
+                     "SoftmaxBackward",
+                     vld,
+                     vgd,
+                     GetSoftmaxParms(c, algorithm, dxDesc.GetType()))(
+        y, dy, dx, c, grid_size, spatial_dim, miopen_alpha, miopen_beta);
 
-        // Control the max. number of workgroups launched so that we do not
-        // start getting workgroup scheduling overheads
-        size_t workgroups = std::min(grid_size, 64 * 40 * 8);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
-
-        handle.GetKernel("miopenSoftmaxBackward", "", program_name, kernel_name, vld, vgd, parms)(
-            y, dx, c, grid_size, spatial_dim);
-    }
-    else
-    { // CSR-Stream like approach
-
-        int batch_size   = 256 / num_batch;
-        int u_batch_size = c > batch_size ? nextPow2(c / batch_size) : 1;
-
-        size_t workgroups =
-            grid_size % num_batch == 0 ? grid_size / num_batch : grid_size / num_batch + 1;
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
-
-        parms += " -DBATCH_SIZE=" + std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
-                 std::to_string(u_batch_size);
-
-        handle.GetKernel("miopenSoftmaxBackward", "", program_name, kernel_name, vld, vgd, parms)(
-            y, dx, c, grid_size, spatial_dim);
-    }
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsOutput(handle, dxDesc, dx);
@@ -186,4 +272,15 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
     return miopenStatusSuccess;
 }
 
+miopenStatus_t SoftmaxBackward(Handle& handle,
+                               const void* alpha,
+                               const TensorDescriptor& yDesc,
+                               ConstData_t y,
+                               const void* beta,
+                               const TensorDescriptor& dxDesc,
+                               Data_t dx)
+{
+    return SoftmaxBackward(handle, alpha, yDesc, y, dxDesc, dx, beta, dxDesc, dx);
+}
+
 } // namespace miopen
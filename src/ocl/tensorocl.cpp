@@ -25,7 +25,9 @@
  *******************************************************************************/
 #include <cassert>
 #include <algorithm>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/float_equal.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <numeric>
@@ -54,8 +56,9 @@ void SetTensor(Handle& handle, const TensorDescriptor& yDesc, Data_t y, const vo
     case miopenHalf:
     {
         float miopen_alpha = *(static_cast<const float*>(alpha));
-        std::string parms =
-            " -DMIOPEN_TYPE=" + GetDataType(yDesc.GetType()) + " -DMIOPEN_ALPHA_TYPE=float";
+        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(yDesc.GetType()) +
+                            " -DMIOPEN_ALPHA_TYPE=float" +
+                            GetDataTypeKernelParams(yDesc.GetType());
 
         handle.GetKernel("SetTensor", "", program_name, "SetTensor", vld, vgd, parms)(
             y, miopen_alpha, global_threads);
@@ -84,8 +87,9 @@ void ScaleTensor(Handle& handle, const TensorDescriptor& yDesc, Data_t y, const
     case miopenHalf:
     {
         float miopen_alpha = *(static_cast<const float*>(alpha));
-        std::string parms =
-            " -DMIOPEN_TYPE=" + GetDataType(yDesc.GetType()) + " -DMIOPEN_ALPHA_TYPE=float";
+        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(yDesc.GetType()) +
+                            " -DMIOPEN_ALPHA_TYPE=float" +
+                            GetDataTypeKernelParams(yDesc.GetType());
 
         handle.GetKernel("ScaleTensor", "", program_name, "ScaleTensor", vld, vgd, parms)(
             y, miopen_alpha, global_threads);
@@ -258,7 +262,8 @@ void OpTensor(Handle& handle,
                         std::to_string(leading_ones) + " -DMIOPEN_TYPE=" +
                         GetDataType(bTensorDesc.GetType()) + " -DFIRST_NOT_ONE=" +
                         std::to_string(d - 1) + " -DMIOPEN_TENSOR_DIMS=" + std::to_string(bsize) +
-                        " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
+                        " -DMAX_NUM_WG=" + std::to_string(max_num_wg) +
+                        GetDataTypeKernelParams(bTensorDesc.GetType());
 
     parms += " -DMIOPEN_TENSOR_OP=";
     switch(tensorOp)
@@ -598,8 +603,8 @@ void CopyTensor(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension sizes unsupported.");
     }
 
-    size_t srcSize = srcDesc.GetElementSize();
-    std::string parms{};
+    std::string parms = " -DMIOPEN_TYPE=" + GetDataType(srcDesc.GetType()) +
+                        GetDataTypeKernelParams(srcDesc.GetType());
 
     if(srcOffset > 0 || destOffset > 0 || srcDesc != destDesc ||
        (srcDesc.GetElementSpace() != srcDesc.GetElementSize() ||
@@ -695,7 +700,158 @@ void CopyTensor(Handle& handle,
         //            printf("srcStrides[%d]: %d\n",i,srcDesc.GetStrides()[i]);
         //            printf("destStrides[%d]: %d\n",i,destDesc.GetStrides()[i]);
         //        }
-        handle.Copy(src, dest, srcSize * sizeof(srcDesc.GetType()));
+        handle.Copy(src, dest, srcDesc.GetNumBytes());
+    }
+}
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TRANSFORM_TILED)
+
+void TransformTensor(Handle& handle,
+                     const void* alpha,
+                     const TensorDescriptor& xDesc,
+                     ConstData_t x,
+                     const void* beta,
+                     const TensorDescriptor& yDesc,
+                     Data_t y,
+                     size_t xOffset,
+                     size_t yOffset)
+{
+    if(x == nullptr || y == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Null pointer for tensor.");
+    }
+    if(xDesc.GetLengths() != yDesc.GetLengths())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
+    }
+    if(xDesc.GetSize() > 5)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension sizes unsupported.");
+    }
+
+    const auto& lens      = xDesc.GetLengths();
+    const auto& x_strides = xDesc.GetStrides();
+    const auto& y_strides = yDesc.GetStrides();
+    const int dims        = lens.size();
+    float miopen_alpha    = *(static_cast<const float*>(alpha));
+    float miopen_beta     = *(static_cast<const float*>(beta));
+
+    std::string parms = " -DMIOPEN_SRC_TYPE=" + GetDataType(xDesc.GetType()) +
+                        " -DMIOPEN_DST_TYPE=" + GetDataType(yDesc.GetType()) +
+                        " -DMIOPEN_TRANSFORM_USE_BETA=" +
+                        std::to_string(static_cast<int>(!float_equal(miopen_beta, 0)));
+    if(xDesc.GetType() == miopenHalf || yDesc.GetType() == miopenHalf)
+        parms += " -DMIOPEN_USE_FP16=1";
+
+    std::string program_name = "MIOpenTransformTensor.cl";
+
+    // The innermost dimension of a tensor, dimensions of length 1 do not count
+    auto unit_dim = [&](const std::vector<std::size_t>& strides) {
+        for(int i = 0; i < dims; i++)
+        {
+            if(strides[i] == 1 && lens[i] > 1)
+                return i;
+        }
+        return -1;
+    };
+    const int a = unit_dim(x_strides);
+    const int b = unit_dim(y_strides);
+
+    if(a >= 0 && b >= 0 && a != b && !miopen::IsDisabled(MIOPEN_DEBUG_TRANSFORM_TILED{}))
+    {
+        // The other dimensions select the slice to transpose, padded to three
+        std::vector<int> slice_lens(3, 1);
+        std::vector<int> slice_x_strides(3, 0);
+        std::vector<int> slice_y_strides(3, 0);
+        int slice_dim = 3 - (dims - 2);
+        for(int i = 0; i < dims; i++)
+        {
+            if(i == a || i == b)
+                continue;
+            slice_lens[slice_dim]      = lens[i];
+            slice_x_strides[slice_dim] = x_strides[i];
+            slice_y_strides[slice_dim] = y_strides[i];
+            slice_dim++;
+        }
+        std::size_t slices = slice_lens[0] * slice_lens[1] * slice_lens[2];
+
+        const std::vector<size_t> vld{32, 8, 1};
+        const std::vector<size_t> vgd{
+            (lens[a] + 31) / 32 * 32, (lens[b] + 31) / 32 * 8, slices};
+
+        handle.GetKernel("miopenTransformTensorTiled",
+                         "",
+                         program_name,
+                         "TransformTensorTiled",
+                         vld,
+                         vgd,
+                         parms)(x,
+                                long(xOffset),
+                                y,
+                                long(yOffset),
+                                miopen_alpha,
+                                miopen_beta,
+                                int(lens[a]),
+                                int(lens[b]),
+                                int(x_strides[b]),
+                                int(y_strides[a]),
+                                slice_lens[1],
+                                slice_lens[2],
+                                slice_x_strides[0],
+                                slice_x_strides[1],
+                                slice_x_strides[2],
+                                slice_y_strides[0],
+                                slice_y_strides[1],
+                                slice_y_strides[2]);
+    }
+    else
+    {
+        // Walk the dimensions in the order of y, padded to five
+        std::vector<int> order(dims);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int i, int j) {
+            return y_strides[i] > y_strides[j];
+        });
+
+        std::vector<int> elem_lens(5, 1);
+        std::vector<int> elem_x_strides(5, 0);
+        std::vector<int> elem_y_strides(5, 0);
+        for(int i = 0; i < dims; i++)
+        {
+            elem_lens[5 - dims + i]      = lens[order[i]];
+            elem_x_strides[5 - dims + i] = x_strides[order[i]];
+            elem_y_strides[5 - dims + i] = y_strides[order[i]];
+        }
+
+        std::size_t n = xDesc.GetElementSize();
+        const std::vector<size_t> vld{256, 1, 1};
+        const std::vector<size_t> vgd{std::min((n + 255) / 256 * 256, std::size_t{256 * 1024}),
+                                      1,
+                                      1};
+
+        handle.GetKernel(
+            "miopenTransformTensor", "", program_name, "TransformTensor", vld, vgd, parms)(
+            x,
+            long(xOffset),
+            y,
+            long(yOffset),
+            miopen_alpha,
+            miopen_beta,
+            long(n),
+            elem_lens[1],
+            elem_lens[2],
+            elem_lens[3],
+            elem_lens[4],
+            elem_x_strides[0],
+            elem_x_strides[1],
+            elem_x_strides[2],
+            elem_x_strides[3],
+            elem_x_strides[4],
+            elem_y_strides[0],
+            elem_y_strides[1],
+            elem_y_strides[2],
+            elem_y_strides[3],
+            elem_y_strides[4]);
     }
 }
 
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <cmath>
+#include <miopen/datatype.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/util.hpp>
 
@@ -46,8 +47,41 @@ float Im2ColGPU(Handle& handle,
                 const int stride_w,
                 const int dilation_h,
                 const int dilation_w,
-                Data_t col)
+                Data_t col,
+                miopenDataType_t type,
+                const std::string& layout)
 {
+    if(layout == "NHWC")
+    {
+        std::string params = GetDataTypeKernelParams(type);
+
+        const std::vector<size_t> vld{256, 1, 1};
+        const int col_sz      = c * wei_h * wei_w * out_h * out_w;
+        size_t global_threads = std::min(((col_sz + 255) / 256) * 256, 256 * 1024);
+        const std::vector<size_t> vgd{global_threads, 1, 1};
+
+        handle.GetKernel(
+            "miopenIm2ColNHWC", "", "MIOpenUtilKernels2.cl", "Im2ColNHWC", vld, vgd, params)(
+            im,
+            im_offset,
+            c,
+            h,
+            w,
+            wei_h,
+            wei_w,
+            out_h,
+            out_w,
+            pad_h,
+            pad_w,
+            stride_h,
+            stride_w,
+            dilation_h,
+            dilation_w,
+            col);
+
+        return handle.GetKernelTime();
+    }
+
     std::string program_name = "MIOpenUtilKernels.cl";
     std::string kernel_name  = "Im2Col";
 
@@ -85,6 +119,7 @@ float Im2ColGPU(Handle& handle,
     params += " -DTILE_SZ_X=" + std::to_string(tile_sz_x);
     params += " -DTILE_SZ_Y=" + std::to_string(tile_sz_y);
     params += " -DUSE_IM_OFF_GUARD=1";
+    params += GetDataTypeKernelParams(type);
 
     const std::vector<size_t> vld{256, 1, 1};
     size_t global_threads = 256 * std::max(1, (c / num_ch_per_wg)) * num_blks;
@@ -155,4 +190,33 @@ float Col2ImGPU(Handle& handle,
     return handle.GetKernelTime();
 }
 
+float CastGPU(Handle& handle,
+              const int n,
+              ConstData_t src,
+              size_t src_offset,
+              miopenDataType_t src_type,
+              Data_t dst,
+              size_t dst_offset,
+              miopenDataType_t dst_type)
+{
+    if(src_type != miopenFloat && dst_type != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only casts to or from float are supported");
+    }
+
+    std::string program_name = "MIOpenUtilKernels2.cl";
+    std::string kernel_name  = src_type == miopenFloat ? "CastFromFloat" : "CastToFloat";
+
+    std::string params = GetDataTypeKernelParams(src_type == miopenFloat ? dst_type : src_type);
+
+    const std::vector<size_t> vld{256, 1, 1};
+    size_t global_threads = std::min(((n + 255) / 256) * 256, 256 * 1024);
+    const std::vector<size_t> vgd{global_threads, 1, 1};
+
+    handle.GetKernel("miopenCast", "", program_name, kernel_name, vld, vgd, params)(
+        src, src_offset, dst, dst_offset, n);
+
+    return handle.GetKernelTime();
+}
+
 } // namespace miopen
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <miopen/oclkernel.hpp>
+#include <miopen/trace.hpp>
 
 namespace miopen {
 
@@ -60,6 +61,10 @@ void OCLKernelInvoke::run() const
     std::cout << std::endl;
 #endif // !NDEBUG
 
+    TraceSpan span{"enqueue"};
+    if(span.IsActive())
+        span.SetName(GetName());
+
     cl_event ev;
     /* way to run OCL group larger than 256
      * hack to ensure local_size == 0, just checking that the 1st dim is 0
@@ -81,9 +86,13 @@ void OCLKernelInvoke::run() const
     }
     else if(callback)
     {
-        clFinish(queue);
-        clWaitForEvents(1, &ev);
+        if(blocking_callback)
+        {
+            clFinish(queue);
+            clWaitForEvents(1, &ev);
+        }
         callback(ev);
+        clReleaseEvent(ev);
     }
 }
 
@@ -101,14 +110,16 @@ std::string OCLKernelInvoke::GetName() const
     return buffer.data();
 }
 
-OCLKernelInvoke OCLKernel::Invoke(cl_command_queue q, std::function<void(cl_event&)> callback) const
+OCLKernelInvoke OCLKernel::Invoke(cl_command_queue q,
+                                  std::function<void(cl_event&)> callback,
+                                  bool blocking_callback) const
 {
 #ifndef NDEBUG
     std::cout << "Info: "
               << "Invoking kernel: " << GetName(); // grid size + \n in OCLKernelInvoke::run()
 #endif                                             // !NDEBUG
 
-    OCLKernelInvoke result{q, kernel, gdims.size(), {}, {}, {}, callback};
+    OCLKernelInvoke result{q, kernel, gdims.size(), {}, {}, {}, callback, blocking_callback};
     std::copy(gdims.begin(), gdims.end(), result.global_work_dim.begin());
     std::copy(ldims.begin(), ldims.end(), result.local_work_dim.begin());
     return result;
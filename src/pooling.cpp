@@ -25,7 +25,7 @@
  *******************************************************************************/
 #include <cassert>
 #include <cmath>
-#include <cmath>
+#include <limits>
 #include <miopen/logger.hpp>
 #include <miopen/pooling.hpp>
 
@@ -81,6 +81,46 @@ int PoolingDescriptor::GetSize() const
     return lens.size();
 }
 
+void PoolingDescriptor::SetIndexType(miopenIndexType_t t) { index_type = t; }
+miopenIndexType_t PoolingDescriptor::GetIndexType() const { return index_type; }
+
+miopenIndexType_t PoolingDescriptor::GetWorkSpaceIndexType() const
+{
+    // The largest index value marks windows without a maximum
+    const std::size_t window = std::size_t(lens[0]) * lens[1];
+    if(index_type == miopenIndexUint8 && window < std::numeric_limits<uint8_t>::max())
+        return miopenIndexUint8;
+    if(index_type != miopenIndexUint32 && window < std::numeric_limits<uint16_t>::max())
+        return miopenIndexUint16;
+    return miopenIndexUint32;
+}
+
+std::size_t PoolingDescriptor::GetIndexSize() const
+{
+    switch(GetWorkSpaceIndexType())
+    {
+    case miopenIndexUint8: return sizeof(uint8_t);
+    case miopenIndexUint16: return sizeof(uint16_t);
+    case miopenIndexUint32: return sizeof(uint32_t);
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Unknown pooling index type");
+}
+
+bool PoolingDescriptor::HasOverlappingWindows() const
+{
+    return strides[0] < lens[0] || strides[1] < lens[1];
+}
+
+bool PoolingDescriptor::IsIndexFreeBackward(const TensorDescriptor& yDesc) const
+{
+    // Without overlapping windows the backward pass finds the argmax of each window once and
+    // writes its part of dx, reading every element of x once, so large outputs give up the index
+    // buffer for a little extra traffic
+    const std::size_t min_outputs = std::size_t{1} << 24;
+    return mode == miopenPoolingMax && !HasOverlappingWindows() &&
+           yDesc.GetElementSize() >= min_outputs;
+}
+
 std::tuple<std::size_t, std::size_t, std::size_t, std::size_t>
 PoolingDescriptor::GetForwardOutputDim(const TensorDescriptor& tensorDesc) const
 {
@@ -133,6 +173,8 @@ std::ostream& operator<<(std::ostream& stream, const PoolingDescriptor& x)
     LogRange(stream, x.lens, ", ") << ", ";
     LogRange(stream, x.pads, ", ") << ", ";
     LogRange(stream, x.strides, ", ") << ", ";
+    MIOPEN_LOG_ENUM(stream, x.index_type, miopenIndexUint8, miopenIndexUint16, miopenIndexUint32)
+        << ", ";
     return stream;
 }
 
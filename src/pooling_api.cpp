@@ -34,7 +34,9 @@
 extern "C" miopenStatus_t miopenCreatePoolingDescriptor(miopenPoolingDescriptor_t* poolDesc)
 {
     MIOPEN_LOG_FUNCTION(poolDesc);
-    return miopen::try_([&] { miopen::deref(poolDesc) = new miopen::PoolingDescriptor(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(poolDesc) = new miopen::PoolingDescriptor(); });
 }
 
 extern "C" miopenStatus_t miopenSet2dPoolingDescriptor(miopenPoolingDescriptor_t poolDesc,
@@ -48,7 +50,7 @@ extern "C" miopenStatus_t miopenSet2dPoolingDescriptor(miopenPoolingDescriptor_t
 {
 
     MIOPEN_LOG_FUNCTION(poolDesc, mode, windowHeight, windowWidth, pad_h, pad_w, u, v);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         std::initializer_list<int> lens    = {windowHeight, windowWidth};
         std::initializer_list<int> pads    = {pad_h, pad_w};
         std::initializer_list<int> strides = {u, v};
@@ -68,7 +70,7 @@ extern "C" miopenStatus_t miopenGet2dPoolingDescriptor(const miopenPoolingDescri
 {
 
     MIOPEN_LOG_FUNCTION(poolDesc, mode, windowHeight, windowWidth, pad_h, pad_w, u, v);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(mode) = miopen::deref(poolDesc).mode;
         std::tie(miopen::deref(windowHeight), miopen::deref(windowWidth)) =
             miopen::tien<2>(miopen::deref(poolDesc).GetLengths());
@@ -88,7 +90,7 @@ extern "C" miopenStatus_t miopenSetNdPoolingDescriptor(miopenPoolingDescriptor_t
                                                        int* stridesA)
 {
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(poolDesc) =
             miopen::PoolingDescriptor(mode, pmode, windowDimA, padA, stridesA, nbDims);
     });
@@ -103,7 +105,7 @@ extern "C" miopenStatus_t miopenGetNdPoolingDescriptor(miopenPoolingDescriptor_t
                                                        int* stridesA)
 {
 
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         if(mode != nullptr)
         {
             *mode = miopen::deref(poolDesc).mode;
@@ -149,24 +151,52 @@ miopenGetPoolingForwardOutputDim(const miopenPoolingDescriptor_t poolDesc,
 {
 
     MIOPEN_LOG_FUNCTION(poolDesc, tensorDesc, n, c, h, w);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::tie_deref(n, c, h, w) =
             miopen::deref(poolDesc).GetForwardOutputDim(miopen::deref(tensorDesc));
     });
 }
 
+extern "C" miopenStatus_t miopenSetPoolingIndexType(miopenPoolingDescriptor_t poolDesc,
+                                                    miopenIndexType_t index_type)
+{
+    MIOPEN_LOG_FUNCTION(poolDesc, index_type);
+    return miopen::try_(__func__, [&] { miopen::deref(poolDesc).SetIndexType(index_type); });
+}
+
+extern "C" miopenStatus_t miopenGetPoolingIndexType(miopenPoolingDescriptor_t poolDesc,
+                                                    miopenIndexType_t* index_type)
+{
+    MIOPEN_LOG_FUNCTION(poolDesc, index_type);
+    return miopen::try_(
+        __func__, [&] { miopen::deref(index_type) = miopen::deref(poolDesc).GetIndexType(); });
+}
+
 extern "C" miopenStatus_t miopenPoolingGetWorkSpaceSize(const miopenTensorDescriptor_t yDesc,
                                                         size_t* workSpaceSize)
 {
 
     MIOPEN_LOG_FUNCTION(yDesc, workSpaceSize);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         auto len  = miopen::deref(yDesc).GetLengths();
         size_t sz = std::accumulate(len.begin(), len.end(), 1, std::multiplies<int>());
         miopen::deref(workSpaceSize) = sz * sizeof(uint8_t);
     });
 }
 
+extern "C" miopenStatus_t
+miopenPoolingGetWorkSpaceSizeV2(const miopenPoolingDescriptor_t poolDesc,
+                                const miopenTensorDescriptor_t yDesc,
+                                size_t* workSpaceSize)
+{
+
+    MIOPEN_LOG_FUNCTION(poolDesc, yDesc, workSpaceSize);
+    return miopen::try_(__func__, [&] {
+        miopen::deref(workSpaceSize) =
+            miopen::deref(poolDesc).GetWorkSpaceSize(miopen::deref(yDesc));
+    });
+}
+
 extern "C" miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
                                                const miopenPoolingDescriptor_t poolDesc,
                                                const void* alpha,
@@ -182,7 +212,7 @@ extern "C" miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
 
     MIOPEN_LOG_FUNCTION(
         poolDesc, alpha, xDesc, x, beta, yDesc, y, do_backward, workSpace, workSpaceSize);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(poolDesc).Forward(miopen::deref(handle),
                                         alpha,
                                         miopen::deref(xDesc),
@@ -213,7 +243,7 @@ extern "C" miopenStatus_t miopenPoolingBackward(miopenHandle_t handle,
 
     MIOPEN_LOG_FUNCTION(
         poolDesc, alpha, yDesc, y, dyDesc, dy, xDesc, x, beta, dxDesc, dx, workSpace);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(poolDesc).Backward(miopen::deref(handle),
                                          alpha,
                                          miopen::deref(yDesc),
@@ -232,5 +262,5 @@ extern "C" miopenStatus_t miopenPoolingBackward(miopenHandle_t handle,
 extern "C" miopenStatus_t miopenDestroyPoolingDescriptor(miopenPoolingDescriptor_t poolDesc)
 {
     MIOPEN_LOG_FUNCTION(poolDesc);
-    return miopen::try_([&] { miopen_destroy_object(poolDesc); });
+    return miopen::try_(__func__, [&] { miopen_destroy_object(poolDesc); });
 }
@@ -33,13 +33,13 @@
 extern "C" miopenStatus_t miopenCreateRNNDescriptor(miopenRNNDescriptor_t* rnnDesc)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc);
-    return miopen::try_([&] { miopen::deref(rnnDesc) = new miopen::RNNDescriptor(); });
+    return miopen::try_(__func__, [&] { miopen::deref(rnnDesc) = new miopen::RNNDescriptor(); });
 }
 
 extern "C" miopenStatus_t miopenDestroyRNNDescriptor(miopenRNNDescriptor_t rnnDesc)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc);
-    return miopen::try_([&] { miopen_destroy_object(rnnDesc); });
+    return miopen::try_(__func__, [&] { miopen_destroy_object(rnnDesc); });
 }
 
 extern "C" miopenStatus_t miopenGetRNNDescriptor(miopenRNNDescriptor_t rnnDesc,
@@ -54,7 +54,7 @@ extern "C" miopenStatus_t miopenGetRNNDescriptor(miopenRNNDescriptor_t rnnDesc,
 
     MIOPEN_LOG_FUNCTION(
         rnnDesc, rnnMode, algoMode, inputMode, dirMode, biasMode, hiddenSize, layer);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         if(rnnMode != nullptr)
         {
             miopen::deref(rnnMode) = miopen::deref(rnnDesc).rnnMode;
@@ -100,7 +100,7 @@ extern "C" miopenStatus_t miopenSetRNNDescriptor(miopenRNNDescriptor_t rnnDesc,
 
     MIOPEN_LOG_FUNCTION(
         rnnDesc, hsize, nlayers, inMode, direction, rnnMode, biasMode, algo, dataType);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
 
         miopen::deref(rnnDesc) = miopen::RNNDescriptor(
             hsize, nlayers, rnnMode, inMode, direction, biasMode, algo, dataType);
@@ -115,7 +115,7 @@ extern "C" miopenStatus_t miopenGetRNNWorkspaceSize(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, sequenceLen, xDesc, numBytes);
     miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(numBytes) =
             miopen::deref(rnnDesc).GetWorkspaceSize(miopen::deref(handle), sequenceLen, xDescArray);
     });
@@ -129,7 +129,7 @@ extern "C" miopenStatus_t miopenGetRNNTrainingReserveSize(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, sequenceLen, xDesc, numBytes);
     miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(numBytes) =
             miopen::deref(rnnDesc).GetReserveSize(miopen::deref(handle), sequenceLen, xDescArray);
     });
@@ -142,7 +142,7 @@ extern "C" miopenStatus_t miopenGetRNNParamsDescriptor(miopenHandle_t handle,
                                                        miopenDataType_t dtype)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, xDesc, wDesc, dtype);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(rnnDesc).GetParamsDescriptor(
             miopen::deref(handle), miopen::deref(xDesc), miopen::deref(wDesc), dtype);
     });
@@ -155,7 +155,7 @@ extern "C" miopenStatus_t miopenGetRNNParamsSize(miopenHandle_t handle,
                                                  miopenDataType_t dtype)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, xDesc, numBytes, dtype);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(numBytes) = miopen::deref(rnnDesc).GetParamsSize(
             miopen::deref(handle), miopen::deref(xDesc), dtype);
     });
@@ -169,7 +169,7 @@ extern "C" miopenStatus_t miopenGetRNNInputTensorSize(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, seqLen, xDesc, numBytes);
     miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(seqLen)};
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(numBytes) = miopen::deref(rnnDesc).GetRNNInputSuperTensorSize(
             miopen::deref(handle), seqLen, xDescArray);
     });
@@ -183,7 +183,7 @@ extern "C" miopenStatus_t miopenGetRNNHiddenTensorSize(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, xDesc, numBytes);
     miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(seqLen)};
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(numBytes) =
             miopen::deref(rnnDesc).GetRNNHiddenSuperTensorSize(miopen::deref(handle), xDescArray);
     });
@@ -197,7 +197,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerParamSize(miopenHandle_t handle,
                                                      size_t* numBytes)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, paramID, numBytes);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(numBytes) = miopen::deref(rnnDesc).GetLayerParamSize(
             miopen::deref(handle), layer, miopen::deref(xDesc), paramID);
     });
@@ -210,7 +210,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerBiasSize(miopenHandle_t handle,
                                                     size_t* numBytes)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, biasID, numBytes);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(numBytes) =
             miopen::deref(rnnDesc).GetLayerBiasSize(miopen::deref(handle), layer, biasID);
     });
@@ -227,7 +227,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerParam(miopenHandle_t handle,
                                                  void* layerParam)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, paramID, paramDesc, layerParam);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(rnnDesc).GetLayerParam(miopen::deref(handle),
                                              layer,
                                              miopen::deref(xDesc),
@@ -250,7 +250,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerBias(miopenHandle_t handle,
                                                 void* layerBias)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, biasID, biasDesc, layerBias);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(rnnDesc).GetLayerBias(miopen::deref(handle),
                                             layer,
                                             miopen::deref(xDesc),
@@ -273,7 +273,7 @@ extern "C" miopenStatus_t miopenSetRNNLayerParam(miopenHandle_t handle,
                                                  const void* layerParam)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, paramID, paramDesc, layerParam);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(rnnDesc).SetLayerParam(miopen::deref(handle),
                                              layer,
                                              miopen::deref(xDesc),
@@ -296,7 +296,7 @@ extern "C" miopenStatus_t miopenSetRNNLayerBias(miopenHandle_t handle,
                                                 const void* layerBias)
 {
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, biasID, biasDesc, layerBias);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(rnnDesc).SetLayerBias(miopen::deref(handle),
                                             layer,
                                             miopen::deref(xDesc),
@@ -351,7 +351,7 @@ extern "C" miopenStatus_t miopenRNNForwardTraining(miopenHandle_t handle,
                         workSpaceNumBytes,
                         reserveSpace,
                         reserveSpaceNumBytes);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
 
         miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
         miopen::c_array_view<miopenTensorDescriptor_t> yDescArray{yDesc, size_t(sequenceLen)};
@@ -432,7 +432,7 @@ extern "C" miopenStatus_t miopenRNNBackwardData(miopenHandle_t handle,
                         workSpaceNumBytes,
                         reserveSpace,
                         reserveSpaceNumBytes);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
 
         miopen::c_array_view<miopenTensorDescriptor_t> yDescArray{yDesc, size_t(sequenceLen)};
         miopen::c_array_view<miopenTensorDescriptor_t> dyDescArray{dyDesc, size_t(sequenceLen)};
@@ -496,7 +496,7 @@ miopenStatus_t miopenRNNBackwardWeights(miopenHandle_t handle,
                         workSpaceNumBytes,
                         reserveSpace,
                         reserveSpaceNumBytes);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
 
         miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
         miopen::c_array_view<miopenTensorDescriptor_t> yDescArray{yDesc, size_t(sequenceLen)};
@@ -556,7 +556,7 @@ extern "C" miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
                         cy,
                         workSpace,
                         workSpaceNumBytes);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
         miopen::c_array_view<miopenTensorDescriptor_t> yDescArray{yDesc, size_t(sequenceLen)};
         miopen::deref(rnnDesc).RNNForwardInference(miopen::deref(handle),
@@ -36,15 +36,38 @@ extern "C" miopenStatus_t miopenSoftmaxForward(miopenHandle_t handle,
                                                void* y)
 {
     MIOPEN_LOG_FUNCTION(alpha, xDesc, x, beta, yDesc, y);
-    return miopen::try_([&] {
-        CopyTensor(miopen::deref(handle),
-                   miopen::deref(xDesc),
-                   DataCast(x),
-                   miopen::deref(yDesc),
-                   DataCast(y));
+    return miopen::try_(__func__, [&] {
+        miopen::SoftmaxForward(miopen::deref(handle),
+                               alpha,
+                               miopen::deref(xDesc),
+                               DataCast(x),
+                               beta,
+                               miopen::deref(yDesc),
+                               DataCast(y));
+    });
+}
 
-        miopen::SoftmaxForward(
-            miopen::deref(handle), alpha, beta, miopen::deref(yDesc), DataCast(y));
+extern "C" miopenStatus_t miopenSoftmaxForwardEx(miopenHandle_t handle,
+                                                 const void* alpha,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const void* x,
+                                                 const void* beta,
+                                                 const miopenTensorDescriptor_t yDesc,
+                                                 void* y,
+                                                 miopenSoftmaxAlgorithm_t algorithm,
+                                                 int axis)
+{
+    MIOPEN_LOG_FUNCTION(alpha, xDesc, x, beta, yDesc, y, algorithm, axis);
+    return miopen::try_(__func__, [&] {
+        miopen::SoftmaxForward(miopen::deref(handle),
+                               alpha,
+                               miopen::deref(xDesc),
+                               DataCast(x),
+                               beta,
+                               miopen::deref(yDesc),
+                               DataCast(y),
+                               algorithm,
+                               axis);
     });
 }
 
@@ -60,19 +83,43 @@ miopenStatus_t miopenSoftmaxBackward(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(alpha, yDesc, y, dyDesc, dy, beta, dxDesc, dx);
-    return miopen::try_([&] {
-        CopyTensor(miopen::deref(handle),
-                   miopen::deref(dyDesc),
-                   DataCast(dy),
-                   miopen::deref(dxDesc),
-                   DataCast(dx));
-
+    return miopen::try_(__func__, [&] {
         miopen::SoftmaxBackward(miopen::deref(handle),
                                 alpha,
                                 miopen::deref(yDesc),
                                 DataCast(y),
+                                miopen::deref(dyDesc),
+                                DataCast(dy),
                                 beta,
                                 miopen::deref(dxDesc),
                                 DataCast(dx));
     });
 }
+
+extern "C" miopenStatus_t miopenSoftmaxBackwardEx(miopenHandle_t handle,
+                                                  const void* alpha,
+                                                  const miopenTensorDescriptor_t yDesc,
+                                                  const void* y,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const void* dy,
+                                                  const void* beta,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  void* dx,
+                                                  miopenSoftmaxAlgorithm_t algorithm,
+                                                  int axis)
+{
+    MIOPEN_LOG_FUNCTION(alpha, yDesc, y, dyDesc, dy, beta, dxDesc, dx, algorithm, axis);
+    return miopen::try_(__func__, [&] {
+        miopen::SoftmaxBackward(miopen::deref(handle),
+                                alpha,
+                                miopen::deref(yDesc),
+                                DataCast(y),
+                                miopen::deref(dyDesc),
+                                DataCast(dy),
+                                beta,
+                                miopen::deref(dxDesc),
+                                DataCast(dx),
+                                algorithm,
+                                axis);
+    });
+}
@@ -82,6 +82,13 @@ ConvSolution ConvOclDirectFwd::GetSolution(const ConvolutionContext& params,
     result.n_stacks = std::min(result.n_stacks, (n_alus_total + alu_tiles_sz - 1) / alu_tiles_sz);
     result.n_stacks = std::min(params.batch_sz, result.n_stacks);
 
+    // With dynamic batching each group handles a single image and the program is built for
+    // the batch bound, so that only the launch grid depends on the actual batch size.
+    const bool dynamic_batch = IsDynamicBatch(*this, params);
+    const int batch_sz       = dynamic_batch ? GetDynamicBatchBound() : params.batch_sz;
+    if(dynamic_batch)
+        result.n_stacks = 1;
+
     int n_alus_perstack = (n_alus_total + result.n_stacks - 1) / result.n_stacks;
 
     int n_read_procs;
@@ -126,7 +133,7 @@ ConvSolution ConvOclDirectFwd::GetSolution(const ConvolutionContext& params,
         std::string(" -DMLO_N_OUTPUTS=") +
         std::to_string(static_cast<long long>(params.n_outputs)) + std::string(" -DMLO_N_INPUTS=") +
         std::to_string(static_cast<long long>(params.n_inputs)) + std::string(" -DMLO_BATCH_SZ=") +
-        std::to_string(static_cast<long long>(params.batch_sz)) + std::string(" -DMLO_OUT_WIDTH=") +
+        std::to_string(static_cast<long long>(batch_sz)) + std::string(" -DMLO_OUT_WIDTH=") +
         std::to_string(static_cast<long long>(params.out_width)) +
         std::string(" -DMLO_OUT_HEIGHT=") +
         std::to_string(static_cast<long long>(params.out_height)) +
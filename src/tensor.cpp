@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <algorithm>
 #include <cassert>
+#include <miopen/datatype.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor.hpp>
@@ -38,10 +39,6 @@ TensorDescriptor::TensorDescriptor() {}
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, std::initializer_list<std::size_t> plens)
     : lens(plens), type(t)
 {
-    if(t != miopenFloat)
-    {
-        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
-    }
     this->CalculateStrides();
 }
 
@@ -50,19 +47,11 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    std::initializer_list<std::size_t> pstrides)
     : lens(plens), strides(pstrides), type(t)
 {
-    if(t != miopenFloat)
-    {
-        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
-    }
 }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, const int* plens, int size)
     : lens(plens, plens + size), type(t)
 {
-    if(t != miopenFloat)
-    {
-        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
-    }
     if(!std::all_of(plens, plens + size, [](int x) { return x >= 0; }))
         MIOPEN_THROW("Invalid length. Length must be greater than 0.");
     this->CalculateStrides();
@@ -73,10 +62,6 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    int size)
     : lens(plens, plens + size), strides(pstrides, pstrides + size), type(t)
 {
-    if(t != miopenFloat)
-    {
-        MIOPEN_THROW(miopenStatusNotImplemented, "Only float datatype is supported");
-    }
     if(!std::all_of(plens, plens + size, [](int x) { return x >= 0; }))
         MIOPEN_THROW("Invalid length. Length must be greater than 0.");
     if(!std::all_of(pstrides, pstrides + size, [](int x) { return x >= 0; }))
@@ -128,13 +113,19 @@ std::size_t TensorDescriptor::GetElementSpace() const
 
 std::size_t TensorDescriptor::GetNumBytes() const
 {
-    std::size_t typesize = 0;
-    switch(this->type)
+    return GetTypeSize(this->type) * this->GetElementSpace();
+}
+
+std::string TensorDescriptor::GetLayout() const
+{
+    if(lens.size() == 4 && lens[1] > 1)
     {
-    case miopenHalf: typesize  = 2; break;
-    case miopenFloat: typesize = 4; break;
+        const std::vector<std::size_t> nhwc_strides{
+            lens[1] * lens[2] * lens[3], 1, lens[1] * lens[3], lens[1]};
+        if(strides == nhwc_strides)
+            return "NHWC";
     }
-    return typesize * this->GetElementSpace();
+    return "NCHW";
 }
 
 bool TensorDescriptor::operator==(const TensorDescriptor& rhs) const
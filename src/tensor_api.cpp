@@ -33,7 +33,9 @@
 extern "C" miopenStatus_t miopenCreateTensorDescriptor(miopenTensorDescriptor_t* tensorDesc)
 {
     MIOPEN_LOG_FUNCTION(tensorDesc);
-    return miopen::try_([&] { miopen::deref(tensorDesc) = new miopen::TensorDescriptor(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(tensorDesc) = new miopen::TensorDescriptor(); });
 }
 
 extern "C" miopenStatus_t miopenSet4dTensorDescriptor(
@@ -41,7 +43,7 @@ extern "C" miopenStatus_t miopenSet4dTensorDescriptor(
 {
 
     MIOPEN_LOG_FUNCTION(tensorDesc, dataType, n, c, h, w);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         std::initializer_list<int> lens = {n, c, h, w};
         miopen::deref(tensorDesc)       = miopen::TensorDescriptor(dataType, lens.begin(), 4);
     });
@@ -60,7 +62,7 @@ extern "C" miopenStatus_t miopenGet4dTensorDescriptor(miopenTensorDescriptor_t t
 {
 
     MIOPEN_LOG_FUNCTION(tensorDesc, dataType, n, c, h, w, nStride, cStride, hStride, wStride);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::deref(dataType) = miopen::deref(tensorDesc).GetType();
         miopen::tie_deref(n, c, h, w) = miopen::tien<4>(miopen::deref(tensorDesc).GetLengths());
         miopen::tie_deref(nStride, cStride, hStride, wStride) =
@@ -75,7 +77,7 @@ MIOPEN_EXPORT miopenStatus_t miopenGet4dTensorDescriptorLengths(
 {
 
     MIOPEN_LOG_FUNCTION(tensorDesc, n, c, h, w);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::tie_deref(n, c, h, w) = miopen::tien<4>(miopen::deref(tensorDesc).GetLengths());
     });
 }
@@ -86,7 +88,7 @@ MIOPEN_EXPORT miopenStatus_t miopenGet4dTensorDescriptorStrides(
 {
 
     MIOPEN_LOG_FUNCTION(tensorDesc, nStride, cStride, hStride, wStride);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         miopen::tie_deref(nStride, cStride, hStride, wStride) =
             miopen::tien<4>(miopen::deref(tensorDesc).GetStrides());
     });
@@ -100,7 +102,7 @@ extern "C" miopenStatus_t miopenSetTensorDescriptor(miopenTensorDescriptor_t ten
 {
 
     MIOPEN_LOG_FUNCTION(tensorDesc, dataType, nbDims, dimsA, stridesA);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         if(stridesA == nullptr)
         {
             miopen::deref(tensorDesc) = miopen::TensorDescriptor(dataType, dimsA, nbDims);
@@ -117,7 +119,9 @@ extern "C" miopenStatus_t miopenGetTensorNumBytes(miopenTensorDescriptor_t tenso
 {
 
     MIOPEN_LOG_FUNCTION(tensorDesc, numBytes);
-    return miopen::try_([&] { miopen::deref(numBytes) = miopen::deref(tensorDesc).GetNumBytes(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(numBytes) = miopen::deref(tensorDesc).GetNumBytes(); });
 }
 
 // Internal API
@@ -130,7 +134,9 @@ extern "C" miopenStatus_t miopenGetTensorDescriptorSize(miopenTensorDescriptor_t
                                                         int* size)
 {
     MIOPEN_LOG_FUNCTION(tensorDesc, size);
-    return miopen::try_([&] { miopen::deref(size) = miopen::deref(tensorDesc).GetSize(); });
+    return miopen::try_(
+        __func__,
+        [&] { miopen::deref(size) = miopen::deref(tensorDesc).GetSize(); });
 }
 
 extern "C" miopenStatus_t miopenGetTensorDescriptor(miopenTensorDescriptor_t tensorDesc,
@@ -140,7 +146,7 @@ extern "C" miopenStatus_t miopenGetTensorDescriptor(miopenTensorDescriptor_t ten
 {
 
     MIOPEN_LOG_FUNCTION(tensorDesc, dataType, dimsA, stridesA);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         if(dataType != nullptr)
         {
             *dataType = miopen::deref(tensorDesc).GetType();
@@ -163,7 +169,7 @@ extern "C" miopenStatus_t miopenGetTensorDescriptor(miopenTensorDescriptor_t ten
 extern "C" miopenStatus_t miopenDestroyTensorDescriptor(miopenTensorDescriptor_t tensorDesc)
 {
     MIOPEN_LOG_FUNCTION(tensorDesc);
-    return miopen::try_([&] { miopen_destroy_object(tensorDesc); });
+    return miopen::try_(__func__, [&] { miopen_destroy_object(tensorDesc); });
 }
 
 extern "C" miopenStatus_t miopenOpTensor(miopenHandle_t handle,
@@ -180,7 +186,7 @@ extern "C" miopenStatus_t miopenOpTensor(miopenHandle_t handle,
 {
 
     MIOPEN_LOG_FUNCTION(tensorOp, alpha1, aDesc, A, alpha2, bDesc, B, beta, cDesc, C);
-    return miopen::try_([&] {
+    return miopen::try_(__func__, [&] {
         OpTensor(miopen::deref(handle),
                  tensorOp,
                  alpha1,
@@ -203,6 +209,7 @@ extern "C" miopenStatus_t miopenSetTensor(miopenHandle_t handle,
 
     MIOPEN_LOG_FUNCTION(yDesc, y, alpha);
     return miopen::try_(
+        __func__,
         [&] { SetTensor(miopen::deref(handle), miopen::deref(yDesc), DataCast(y), alpha); });
 }
 
@@ -214,5 +221,27 @@ extern "C" miopenStatus_t miopenScaleTensor(miopenHandle_t handle,
 
     MIOPEN_LOG_FUNCTION(yDesc, y, alpha);
     return miopen::try_(
+        __func__,
         [&] { ScaleTensor(miopen::deref(handle), miopen::deref(yDesc), DataCast(y), alpha); });
 }
+
+extern "C" miopenStatus_t miopenTransformTensor(miopenHandle_t handle,
+                                                const void* alpha,
+                                                const miopenTensorDescriptor_t xDesc,
+                                                const void* x,
+                                                const void* beta,
+                                                const miopenTensorDescriptor_t yDesc,
+                                                void* y)
+{
+
+    MIOPEN_LOG_FUNCTION(alpha, xDesc, x, beta, yDesc, y);
+    return miopen::try_(__func__, [&] {
+        TransformTensor(miopen::deref(handle),
+                        alpha,
+                        miopen::deref(xDesc),
+                        DataCast(x),
+                        beta,
+                        miopen::deref(yDesc),
+                        DataCast(y));
+    });
+}
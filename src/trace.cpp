@@ -0,0 +1,353 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE)
+
+namespace {
+
+constexpr int HostPid   = 1;
+constexpr int DevicePid = 2;
+
+struct Event
+{
+    const char* category;
+    std::string name;
+    std::uint64_t start_ns;
+    std::uint64_t end_ns;
+    int pid;
+    int tid;
+    std::string args;
+};
+
+std::string GetTracePath()
+{
+    const auto value = GetStringEnv(MIOPEN_TRACE{});
+    if(value == nullptr || *value == '\0' || IsEnvvarValueDisabled(MIOPEN_TRACE::value()))
+        return {};
+    if(IsEnvvarValueEnabled(MIOPEN_TRACE::value()))
+        return "miopen_trace.json";
+    return value;
+}
+
+void WriteString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for(auto c : s)
+    {
+        switch(c)
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                os << buf;
+            }
+            else
+            {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+// Chrome expects microseconds; keep the nanoseconds as decimals.
+void WriteTime(std::ostream& os, std::uint64_t ns)
+{
+    char buf[32];
+    std::snprintf(buf,
+                  sizeof(buf),
+                  "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    os << buf;
+}
+
+void WriteMetadata(std::ostream& os, const char* type, int pid, int tid, const std::string& name)
+{
+    os << "{\"ph\":\"M\",\"name\":\"" << type << "\",\"pid\":" << pid << ",\"tid\":" << tid
+       << ",\"args\":{\"name\":";
+    WriteString(os, name);
+    os << "}}";
+}
+
+/// Never destroyed, so handles released during static destruction can
+/// still flush into it.
+class Tracer
+{
+    public:
+    Tracer() : path(GetTracePath()), origin(std::chrono::steady_clock::now())
+    {
+        if(!path.empty())
+            std::atexit([] { Get().Flush(); });
+    }
+
+    static Tracer& Get()
+    {
+        static auto* tracer = new Tracer();
+        return *tracer;
+    }
+
+    bool IsEnabled() const { return !path.empty(); }
+
+    std::uint64_t Now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - origin)
+            .count();
+    }
+
+    void AddHost(Event e)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto id = std::this_thread::get_id();
+        auto it       = threads.find(id);
+        if(it == threads.end())
+            it = threads.emplace(id, static_cast<int>(threads.size())).first;
+        e.pid = HostPid;
+        e.tid = it->second;
+        events.push_back(std::move(e));
+    }
+
+    void AddDevice(const void* queue, std::vector<Event> device_events)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find(tracks.begin(), tracks.end(), queue);
+        if(it == tracks.end())
+            it = tracks.insert(tracks.end(), queue);
+        const auto tid = static_cast<int>(it - tracks.begin());
+        for(auto&& e : device_events)
+        {
+            e.pid = DevicePid;
+            e.tid = tid;
+            events.push_back(std::move(e));
+        }
+    }
+
+    void Flush()
+    {
+        if(!IsEnabled())
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ofstream file(path);
+        if(!file)
+        {
+            MIOPEN_LOG_E("Unable to write trace file: " << path);
+            return;
+        }
+
+        file << "{\"traceEvents\":[\n";
+        WriteMetadata(file, "process_name", HostPid, 0, "MIOpen host");
+        file << ",\n";
+        WriteMetadata(file, "process_name", DevicePid, 0, "MIOpen device");
+        for(auto&& t : threads)
+        {
+            file << ",\n";
+            WriteMetadata(
+                file, "thread_name", HostPid, t.second, "thread " + std::to_string(t.second));
+        }
+        for(std::size_t i = 0; i < tracks.size(); i++)
+        {
+            file << ",\n";
+            WriteMetadata(
+                file, "thread_name", DevicePid, static_cast<int>(i), "queue " + std::to_string(i));
+        }
+        for(auto&& e : events)
+        {
+            file << ",\n{\"ph\":\"X\",\"cat\":\"" << e.category << "\",\"name\":";
+            WriteString(file, e.name);
+            file << ",\"pid\":" << e.pid << ",\"tid\":" << e.tid << ",\"ts\":";
+            WriteTime(file, e.start_ns);
+            file << ",\"dur\":";
+            WriteTime(file, e.end_ns > e.start_ns ? e.end_ns - e.start_ns : 0);
+            if(!e.args.empty())
+                file << ",\"args\":{" << e.args << "}";
+            file << "}";
+        }
+        file << "\n]}\n";
+    }
+
+    private:
+    std::string path;
+    std::chrono::steady_clock::time_point origin;
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::map<std::thread::id, int> threads;
+    std::vector<const void*> tracks;
+};
+
+} // namespace
+
+bool IsTracingEnabled()
+{
+    static const bool result = Tracer::Get().IsEnabled();
+    return result;
+}
+
+std::uint64_t TraceNow() { return Tracer::Get().Now(); }
+
+TraceArgs& TraceArgs::Add(const char* name, const std::string& value)
+{
+    std::ostringstream ss;
+    if(!json.empty())
+        ss << ',';
+    WriteString(ss, name);
+    ss << ':';
+    WriteString(ss, value);
+    json += ss.str();
+    return *this;
+}
+
+TraceArgs& TraceArgs::Add(const char* name, double value)
+{
+    std::ostringstream ss;
+    if(!json.empty())
+        ss << ',';
+    WriteString(ss, name);
+    ss << ':' << value;
+    json += ss.str();
+    return *this;
+}
+
+void TraceEvent(const char* category,
+                const std::string& name,
+                std::uint64_t start_ns,
+                std::uint64_t end_ns,
+                const TraceArgs& args)
+{
+    if(!IsTracingEnabled())
+        return;
+    Tracer::Get().AddHost({category, name, start_ns, end_ns, 0, 0, args.Get()});
+}
+
+void TraceKernels(const void* queue, const std::vector<KernelProfile>& profiles)
+{
+    if(!IsTracingEnabled() || profiles.empty())
+        return;
+
+    // The device clock has its own origin. Use the smallest shift that keeps
+    // every kernel from starting before its launch on the host.
+    auto offset = std::numeric_limits<std::int64_t>::min();
+    for(auto&& p : profiles)
+        offset = std::max(offset,
+                          static_cast<std::int64_t>(p.enqueue_ns) -
+                              static_cast<std::int64_t>(p.start_ns));
+
+    std::vector<Event> events;
+    events.reserve(profiles.size());
+    for(auto&& p : profiles)
+    {
+        TraceArgs args;
+        args.Add("algorithm", p.algorithm);
+        args.Add("network_config", p.network_config);
+        args.Add("queued_us", (p.start_ns + offset - p.enqueue_ns) * 1e-3);
+        events.push_back({"kernel",
+                          p.kernel_name,
+                          p.start_ns + offset,
+                          p.end_ns + offset,
+                          0,
+                          0,
+                          args.Get()});
+    }
+    Tracer::Get().AddDevice(queue, std::move(events));
+}
+
+void FlushTrace() { Tracer::Get().Flush(); }
+
+TraceSpan::TraceSpan(const char* pcategory, std::string pname)
+    : active(IsTracingEnabled()), category(pcategory)
+{
+    if(active)
+    {
+        name  = std::move(pname);
+        start = TraceNow();
+    }
+}
+
+TraceSpan::~TraceSpan()
+{
+    if(active)
+        TraceEvent(category, name, start, TraceNow(), args);
+}
+
+void TraceSpan::SetName(std::string pname)
+{
+    if(active)
+        name = std::move(pname);
+}
+
+TraceSpan& TraceSpan::Arg(const char* arg_name, const std::string& value)
+{
+    if(active)
+        args.Add(arg_name, value);
+    return *this;
+}
+
+TraceSpan& TraceSpan::Arg(const char* arg_name, double value)
+{
+    if(active)
+        args.Add(arg_name, value);
+    return *this;
+}
+
+TraceSequence::TraceSequence(const char* pcategory)
+    : active(IsTracingEnabled()), category(pcategory)
+{
+    if(active)
+        last = TraceNow();
+}
+
+void TraceSequence::Mark(const std::string& name, const TraceArgs& args)
+{
+    if(!active)
+        return;
+    const auto now = TraceNow();
+    TraceEvent(category, name, last, now, args);
+    last = now;
+}
+
+} // namespace miopen
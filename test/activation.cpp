@@ -62,14 +62,19 @@ struct verify_forward_activation
 {
     tensor<T> input;
     miopen::ActivationDescriptor desc;
+    float blend_alpha = 1;
+    float blend_beta  = 0;
 
+    // The output buffer starts out as a copy of the input, which is what beta blends with
     template <class A>
     tensor<T> cpu(A a)
     {
         auto out = input;
 
-        input.par_for_each(
-            [&](int o, int w, int i, int j) { out(o, w, i, j) = a(input(o, w, i, j)); });
+        input.par_for_each([&](int o, int w, int i, int j) {
+            out(o, w, i, j) =
+                blend_alpha * a(input(o, w, i, j)) + blend_beta * input(o, w, i, j);
+        });
 
         return out;
     }
@@ -82,9 +87,8 @@ struct verify_forward_activation
         auto in_dev   = handle.Write(input.data);
         auto out_dev  = handle.Write(out.data);
 
-        float alpha = 1, beta = 0;
-
-        desc.Forward(handle, &alpha, input.desc, in_dev.get(), &beta, out.desc, out_dev.get());
+        desc.Forward(
+            handle, &blend_alpha, input.desc, in_dev.get(), &blend_beta, out.desc, out_dev.get());
 
         out.data = handle.Read<T>(out_dev, out.data.size());
         return out;
@@ -94,6 +98,7 @@ struct verify_forward_activation
     void fail(float, A)
     {
         std::cout << "Forward Activation: " << to_name(desc.GetMode()) << std::endl;
+        std::cout << "Blend: alpha=" << blend_alpha << ", beta=" << blend_beta << std::endl;
         std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
     }
 };
@@ -105,14 +110,19 @@ struct verify_backwards_activation
     tensor<T> dout;
     tensor<T> out;
     miopen::ActivationDescriptor desc;
+    float blend_alpha = 1;
+    float blend_beta  = 0;
 
+    // dx starts out as a copy of the input, which is what beta blends with
     template <class A>
     tensor<T> cpu(A a)
     {
         auto dinput = input;
 
         input.par_for_each([&](int o, int w, int i, int j) {
-            dinput(o, w, i, j) = a(dout(o, w, i, j), input(o, w, i, j), out(o, w, i, j));
+            dinput(o, w, i, j) =
+                blend_alpha * a(dout(o, w, i, j), input(o, w, i, j), out(o, w, i, j)) +
+                blend_beta * input(o, w, i, j);
         });
 
         return dinput;
@@ -133,7 +143,7 @@ struct verify_backwards_activation
 
         desc.Forward(handle, &alpha, input.desc, in_dev.get(), &beta, out.desc, out_dev.get());
         desc.Backward(handle,
-                      &alpha,
+                      &blend_alpha,
                       // y
                       out.desc,
                       out_dev.get(),
@@ -143,7 +153,7 @@ struct verify_backwards_activation
                       // x
                       input.desc,
                       in_dev.get(),
-                      &beta,
+                      &blend_beta,
                       // dx
                       dinput.desc,
                       din_dev.get());
@@ -156,6 +166,7 @@ struct verify_backwards_activation
     void fail(float, A)
     {
         std::cout << "Backwards Activation: " << to_name(desc.GetMode()) << std::endl;
+        std::cout << "Blend: alpha=" << blend_alpha << ", beta=" << blend_beta << std::endl;
         std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
     }
 };
@@ -170,10 +181,12 @@ template <class T>
 struct activation_driver : test_driver
 {
     tensor<T> input;
-    double alpha     = 1;
-    double beta      = 1;
-    double power     = 1;
-    std::string mode = "PATHTRU";
+    double alpha       = 1;
+    double beta        = 1;
+    double power       = 1;
+    double blend_alpha = 1;
+    double blend_beta  = 0;
+    std::string mode   = "PATHTRU";
     std::unordered_map<std::string, std::function<void()>> lookup;
 
     template <class A>
@@ -220,6 +233,8 @@ struct activation_driver : test_driver
         add(alpha, "alpha");
         add(beta, "beta");
         add(power, "power");
+        add(blend_alpha, "blend-alpha", generate_data({1.0, 2.0}));
+        add(blend_beta, "blend-beta", generate_data({0.0, 1.0}));
         add(mode, "mode", generate_data(modes()));
     }
 
@@ -242,18 +257,43 @@ struct activation_driver : test_driver
 
     void run() { lookup[transform_mode(mode)](); }
 
+    // Same values as input with padded rows, so the strided kernel is verified as well as the
+    // packed one
+    tensor<T> make_padded_input() const
+    {
+        std::size_t n, c, h, w;
+        std::tie(n, c, h, w) = miopen::tien<4>(input.desc.GetLengths());
+        tensor<T> padded{miopen::TensorDescriptor{
+            miopenFloat, {n, c, h, w}, {c * h * (w + 1), h * (w + 1), w + 1, 1}}};
+        padded.for_each(
+            [&](int i, int j, int k, int l) { padded(i, j, k, l) = input(i, j, k, l); });
+        return padded;
+    }
+
     template <class Forward, class Backward>
     void run(miopenActivationMode_t m, Forward f, Backward b)
     {
         auto desc = make_descriptor(m);
-        auto out  = verify(verify_forward_activation<T>{input, desc}, f);
+        // The unblended output is the y the backward pass is computed from
+        auto out = verify(verify_forward_activation<T>{input, desc}, f);
+        verify(verify_forward_activation<T>{make_padded_input(), desc}, f);
+        if(!miopen::float_equal(blend_alpha, 1) || !miopen::float_equal(blend_beta, 0))
+        {
+            verify(verify_forward_activation<T>{input, desc, float(blend_alpha), float(blend_beta)},
+                   f);
+        }
+        // Always cover the read-modify-write of the destination, the sweep starts unblended
+        verify(verify_forward_activation<T>{input, desc, 2, 1}, f);
         auto dout = out.first;
         dout.generate([&](int n, int c, int h, int w) {
             T x      = out.first(n, c, h, w);
             double y = (877 * n + 547 * c + 701 * h + 1049 * w + static_cast<int>(769 * x)) % 2503;
             return ((x * y) / 1301.0);
         });
-        verify(verify_backwards_activation<T>{input, dout, out.first, desc}, b);
+        verify(verify_backwards_activation<T>{
+                   input, dout, out.first, desc, float(blend_alpha), float(blend_beta)},
+               b);
+        verify(verify_backwards_activation<T>{input, dout, out.first, desc, 0.5, 1}, b);
     }
 };
 
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_BENCH_HPP
+#define GUARD_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Helpers of the host side tests that can also time what they check.
+
+// Whether the test was asked to report timings with --bench
+inline bool bench_requested(int argc, const char* argv[])
+{
+    return std::any_of(
+        argv + 1, argv + argc, [](const char* arg) { return std::string(arg) == "--bench"; });
+}
+
+// Average wall time of iters calls of f
+template <class F>
+double time_ms(F f, int iters = 1)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iters; i++)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iters;
+}
+
+inline std::vector<float> random_vector(std::size_t n)
+{
+    std::vector<float> result(n);
+    std::generate(result.begin(), result.end(), [] { return float(std::rand() % 17) / 17 - 0.5; });
+    return result;
+}
+
+#endif
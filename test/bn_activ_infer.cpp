@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+#include <cmath>
+#include <iostream>
+#include <miopen/activ.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+
+#define MIO_BN_TEST_EPSILON 1e-5
+
+template <class T>
+struct verify_forward_infer_bn_activ
+{
+    const tensor<T> input;
+    const tensor<T> scale;
+    const tensor<T> shift;
+    const tensor<T> estMean;
+    const tensor<T> estVar;
+    miopenBatchNormMode_t bn_mode;
+    miopen::ActivationDescriptor activ;
+
+    double activation(double x) const
+    {
+        double alpha = activ.GetAlpha();
+        double beta  = activ.GetBeta();
+        switch(activ.GetMode())
+        {
+        case miopenActivationLOGISTIC: return 1 / (1 + std::exp(-x));
+        case miopenActivationTANH: return alpha * std::tanh(beta * x);
+        case miopenActivationRELU: return (x > 0) ? x : x * beta;
+        case miopenActivationSOFTRELU: return std::log(1 + std::exp(x));
+        case miopenActivationABS: return std::abs(x);
+        case miopenActivationPOWER: return std::pow(alpha + beta * x, activ.GetPower());
+        case miopenActivationPATHTRU: break;
+        }
+        return x;
+    }
+
+    tensor<T> cpu() const
+    {
+        double epsilon = MIO_BN_TEST_EPSILON;
+        auto out       = input;
+        // per-activation parameters are 1xCxHxW, spatial ones 1xCx1x1
+        bool spatial = bn_mode == miopenBNSpatial;
+        out.par_for_each([&](int n, int c, int h, int w) {
+            int ph          = spatial ? 0 : h;
+            int pw          = spatial ? 0 : w;
+            double invVar   = 1.0 / std::sqrt(estVar(0, c, ph, pw) + epsilon);
+            double inhat    = (input(n, c, h, w) - estMean(0, c, ph, pw)) * invVar;
+            out(n, c, h, w) = activation(scale(0, c, ph, pw) * inhat + shift(0, c, ph, pw));
+        });
+        return out;
+    }
+
+    tensor<T> gpu() const
+    {
+        auto&& handle = get_handle();
+        auto out      = input;
+        std::fill(out.begin(), out.end(), 0);
+
+        auto in_dev      = handle.Write(input.data);
+        auto estMean_dev = handle.Write(estMean.data);
+        auto estVar_dev  = handle.Write(estVar.data);
+        auto scale_dev   = handle.Write(scale.data);
+        auto shift_dev   = handle.Write(shift.data);
+        auto out_dev     = handle.Write(out.data);
+
+        T alpha = 1, beta = 0;
+        miopen::BatchNormActivForwardInference(handle,
+                                               bn_mode,
+                                               &alpha,
+                                               &beta,
+                                               input.desc,
+                                               in_dev.get(),
+                                               out.desc,
+                                               out_dev.get(),
+                                               scale.desc,
+                                               scale_dev.get(),
+                                               shift_dev.get(),
+                                               estMean_dev.get(),
+                                               estVar_dev.get(),
+                                               MIO_BN_TEST_EPSILON,
+                                               activ);
+        out.data = handle.Read<T>(out_dev, out.data.size());
+        return out;
+    }
+
+    void fail(int) const
+    {
+        std::cout << "Forward Inference Batch Normalization with Activation: " << std::endl;
+        std::cout << "Mode: " << (bn_mode == miopenBNSpatial ? "spatial" : "per-activation")
+                  << ", activation: " << activ << std::endl;
+        std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
+    }
+};
+
+template <class T>
+struct batch_norm_activ_infer_driver : test_driver
+{
+    tensor<T> input;
+
+    batch_norm_activ_infer_driver()
+    {
+        this->batch_factor = 4;
+        add(input, "input", get_bn_spatial_input_tensor());
+    }
+
+    void run()
+    {
+        const miopen::ActivationDescriptor activs[] = {{miopenActivationRELU, 1, 0, 1},
+                                                       {miopenActivationTANH, 1, 1, 1},
+                                                       {miopenActivationTANH, 0.5, 2, 1},
+                                                       {miopenActivationLOGISTIC, 1, 1, 1},
+                                                       {miopenActivationPOWER, 0.5, 2, 1}};
+
+        for(auto bn_mode : {miopenBNSpatial, miopenBNPerActivation})
+        {
+            std::size_t ssn, ssc, ssh, ssw;
+            auto derivedBnDesc = miopen::TensorDescriptor{};
+            miopen::DeriveBNTensorDescriptor(derivedBnDesc, input.desc, bn_mode);
+            std::tie(ssn, ssc, ssh, ssw) = miopen::tien<4>(derivedBnDesc.GetLengths());
+
+            // Keep the normalized values in the range where the activations are not saturated
+            auto scale = tensor<T>{ssn, ssc, ssh, ssw}.generate(
+                [](auto... is) { return rand_gen{}(is...) / 16; });
+            auto shift = tensor<T>{ssn, ssc, ssh, ssw}.generate(
+                [](auto... is) { return rand_gen{}(is...) / 16 - 0.5; });
+            auto estMean = tensor<T>{ssn, ssc, ssh, ssw}.generate(rand_gen{});
+            auto estVar  = tensor<T>{ssn, ssc, ssh, ssw}.generate(
+                [](auto... is) { return rand_gen{}(is...) + 1; });
+
+            for(auto&& activ : activs)
+            {
+                verify(verify_forward_infer_bn_activ<T>{
+                    input, scale, shift, estMean, estVar, bn_mode, activ});
+            }
+        }
+    }
+};
+
+int main(int argc, const char* argv[])
+{
+    test_drive<batch_norm_activ_infer_driver<float>>(argc, argv);
+}
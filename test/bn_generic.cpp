@@ -0,0 +1,328 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/batch_norm.hpp>
+#include <miopen/metrics.hpp>
+#include <miopen/tensor.hpp>
+#include "get_handle.hpp"
+#include "test.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define MIO_BN_TEST_EXPAVGFACTOR 0.1
+#define MIO_BN_TEST_EPSILON 1e-5
+
+struct bn_shape
+{
+    std::size_t n, c, h, w;
+};
+
+std::vector<float> make_data(std::size_t size, std::size_t seed)
+{
+    std::vector<float> result(size);
+    for(std::size_t i = 0; i < size; i++)
+        result[i] = float((i * 613 + seed * 547) % 17) / 4.0f - 2.0f;
+    return result;
+}
+
+bool near(double gpu, double cpu) { return std::fabs(gpu - cpu) <= 1e-3 * (1.0 + std::fabs(cpu)); }
+
+std::size_t programs_loaded()
+{
+    return miopen::GetCacheMetrics()[static_cast<std::size_t>(
+        miopen::MetricsCounter::KernelCacheMiss)];
+}
+
+void run_shape(const bn_shape& s)
+{
+    auto&& handle     = get_handle();
+    const auto hw     = s.h * s.w;
+    const auto size   = s.n * s.c * hw;
+    const auto nhw    = double(s.n * hw);
+    const float alpha = 1, beta = 0;
+
+    const miopen::TensorDescriptor xDesc{miopenFloat, {s.n, s.c, s.h, s.w}};
+    miopen::TensorDescriptor bnDesc{};
+    miopen::DeriveBNTensorDescriptor(bnDesc, xDesc, miopenBNSpatial);
+
+    const auto x      = make_data(size, 1);
+    const auto dy     = make_data(size, 2);
+    const auto scale  = make_data(s.c, 3);
+    const auto bias   = make_data(s.c, 4);
+    const auto runVar = std::vector<float>(s.c, 1.0f);
+
+    auto x_dev       = handle.Write(x);
+    auto dy_dev      = handle.Write(dy);
+    auto y_dev       = handle.Write(std::vector<float>(size));
+    auto dx_dev      = handle.Write(std::vector<float>(size));
+    auto scale_dev   = handle.Write(scale);
+    auto bias_dev    = handle.Write(bias);
+    auto runMean_dev = handle.Write(std::vector<float>(s.c));
+    auto runVar_dev  = handle.Write(runVar);
+    auto mean_dev    = handle.Write(std::vector<float>(s.c));
+    auto invVar_dev  = handle.Write(std::vector<float>(s.c));
+    auto dscale_dev  = handle.Write(std::vector<float>(s.c));
+    auto dbias_dev   = handle.Write(std::vector<float>(s.c));
+
+    miopen::BatchNormForwardTraining(handle,
+                                     miopenBNSpatial,
+                                     &alpha,
+                                     &beta,
+                                     xDesc,
+                                     x_dev.get(),
+                                     xDesc,
+                                     y_dev.get(),
+                                     bnDesc,
+                                     scale_dev.get(),
+                                     bias_dev.get(),
+                                     MIO_BN_TEST_EXPAVGFACTOR,
+                                     runMean_dev.get(),
+                                     runVar_dev.get(),
+                                     MIO_BN_TEST_EPSILON,
+                                     mean_dev.get(),
+                                     invVar_dev.get());
+    miopen::BatchNormForwardInference(handle,
+                                      miopenBNSpatial,
+                                      &alpha,
+                                      &beta,
+                                      xDesc,
+                                      x_dev.get(),
+                                      xDesc,
+                                      dx_dev.get(),
+                                      bnDesc,
+                                      scale_dev.get(),
+                                      bias_dev.get(),
+                                      mean_dev.get(),
+                                      runVar_dev.get(),
+                                      MIO_BN_TEST_EPSILON);
+    const auto infer = handle.Read<float>(dx_dev, size);
+    miopen::BatchNormBackward(handle,
+                              miopenBNSpatial,
+                              &alpha,
+                              &beta,
+                              &alpha,
+                              &beta,
+                              xDesc,
+                              x_dev.get(),
+                              xDesc,
+                              dy_dev.get(),
+                              xDesc,
+                              dx_dev.get(),
+                              bnDesc,
+                              scale_dev.get(),
+                              dscale_dev.get(),
+                              dbias_dev.get(),
+                              MIO_BN_TEST_EPSILON,
+                              mean_dev.get(),
+                              invVar_dev.get());
+
+    const auto y       = handle.Read<float>(y_dev, size);
+    const auto dx      = handle.Read<float>(dx_dev, size);
+    const auto runMean = handle.Read<float>(runMean_dev, s.c);
+    const auto newVar  = handle.Read<float>(runVar_dev, s.c);
+    const auto dscale  = handle.Read<float>(dscale_dev, s.c);
+    const auto dbias   = handle.Read<float>(dbias_dev, s.c);
+
+    for(std::size_t c = 0; c < s.c; c++)
+    {
+        auto index = [&](std::size_t n, std::size_t i) { return (n * s.c + c) * hw + i; };
+
+        double mean = 0, variance = 0;
+        for(std::size_t n = 0; n < s.n; n++)
+            for(std::size_t i = 0; i < hw; i++)
+                mean += x[index(n, i)];
+        mean /= nhw;
+        for(std::size_t n = 0; n < s.n; n++)
+            for(std::size_t i = 0; i < hw; i++)
+                variance += (x[index(n, i)] - mean) * (x[index(n, i)] - mean);
+        variance /= nhw;
+        const double invVar    = 1.0 / std::sqrt(variance + MIO_BN_TEST_EPSILON);
+        const double adjust    = (nhw == 1) ? variance : variance * nhw / (nhw - 1);
+        const double estInvVar = 1.0 / std::sqrt(newVar[c] + MIO_BN_TEST_EPSILON);
+
+        CHECK(near(runMean[c], MIO_BN_TEST_EXPAVGFACTOR * mean));
+        CHECK(near(newVar[c],
+                   (1 - MIO_BN_TEST_EXPAVGFACTOR) * runVar[c] + MIO_BN_TEST_EXPAVGFACTOR * adjust));
+
+        double sum_dy = 0, sum_dy_xhat = 0;
+        for(std::size_t n = 0; n < s.n; n++)
+        {
+            for(std::size_t i = 0; i < hw; i++)
+            {
+                const auto k    = index(n, i);
+                const auto xhat = (x[k] - mean) * invVar;
+                CHECK(near(y[k], scale[c] * xhat + bias[c]));
+                CHECK(near(infer[k], scale[c] * (x[k] - mean) * estInvVar + bias[c]));
+                sum_dy += dy[k];
+                sum_dy_xhat += dy[k] * xhat;
+            }
+        }
+        CHECK(near(dbias[c], sum_dy));
+        CHECK(near(dscale[c], sum_dy_xhat));
+
+        for(std::size_t n = 0; n < s.n; n++)
+        {
+            for(std::size_t i = 0; i < hw; i++)
+            {
+                const auto k    = index(n, i);
+                const auto xhat = (x[k] - mean) * invVar;
+                CHECK(near(dx[k],
+                           scale[c] * invVar / nhw * (nhw * dy[k] - sum_dy - xhat * sum_dy_xhat)));
+            }
+        }
+    }
+}
+
+// Blends into a destination that already holds data, y = alpha * bn(x) + beta * y
+void run_blended(const bn_shape& s)
+{
+    auto&& handle     = get_handle();
+    const auto hw     = s.h * s.w;
+    const auto size   = s.n * s.c * hw;
+    const auto nhw    = double(s.n * hw);
+    const float alpha = 0.5, beta = 1;
+
+    const miopen::TensorDescriptor xDesc{miopenFloat, {s.n, s.c, s.h, s.w}};
+    miopen::TensorDescriptor bnDesc{};
+    miopen::DeriveBNTensorDescriptor(bnDesc, xDesc, miopenBNSpatial);
+
+    const auto x       = make_data(size, 1);
+    const auto y_init  = make_data(size, 5);
+    const auto scale   = make_data(s.c, 3);
+    const auto bias    = make_data(s.c, 4);
+    const auto estMean = make_data(s.c, 6);
+    const auto estVar  = std::vector<float>(s.c, 2.0f);
+
+    auto x_dev       = handle.Write(x);
+    auto y_dev       = handle.Write(y_init);
+    auto infer_dev   = handle.Write(y_init);
+    auto scale_dev   = handle.Write(scale);
+    auto bias_dev    = handle.Write(bias);
+    auto estMean_dev = handle.Write(estMean);
+    auto estVar_dev  = handle.Write(estVar);
+
+    miopen::BatchNormForwardTraining(handle,
+                                     miopenBNSpatial,
+                                     &alpha,
+                                     &beta,
+                                     xDesc,
+                                     x_dev.get(),
+                                     xDesc,
+                                     y_dev.get(),
+                                     bnDesc,
+                                     scale_dev.get(),
+                                     bias_dev.get(),
+                                     MIO_BN_TEST_EXPAVGFACTOR,
+                                     nullptr,
+                                     nullptr,
+                                     MIO_BN_TEST_EPSILON,
+                                     nullptr,
+                                     nullptr);
+    miopen::BatchNormForwardInference(handle,
+                                      miopenBNSpatial,
+                                      &alpha,
+                                      &beta,
+                                      xDesc,
+                                      x_dev.get(),
+                                      xDesc,
+                                      infer_dev.get(),
+                                      bnDesc,
+                                      scale_dev.get(),
+                                      bias_dev.get(),
+                                      estMean_dev.get(),
+                                      estVar_dev.get(),
+                                      MIO_BN_TEST_EPSILON);
+
+    const auto y     = handle.Read<float>(y_dev, size);
+    const auto infer = handle.Read<float>(infer_dev, size);
+
+    for(std::size_t c = 0; c < s.c; c++)
+    {
+        auto index = [&](std::size_t n, std::size_t i) { return (n * s.c + c) * hw + i; };
+
+        double mean = 0, variance = 0;
+        for(std::size_t n = 0; n < s.n; n++)
+            for(std::size_t i = 0; i < hw; i++)
+                mean += x[index(n, i)];
+        mean /= nhw;
+        for(std::size_t n = 0; n < s.n; n++)
+            for(std::size_t i = 0; i < hw; i++)
+                variance += (x[index(n, i)] - mean) * (x[index(n, i)] - mean);
+        variance /= nhw;
+        const double invVar    = 1.0 / std::sqrt(variance + MIO_BN_TEST_EPSILON);
+        const double estInvVar = 1.0 / std::sqrt(estVar[c] + MIO_BN_TEST_EPSILON);
+
+        for(std::size_t n = 0; n < s.n; n++)
+        {
+            for(std::size_t i = 0; i < hw; i++)
+            {
+                const auto k = index(n, i);
+                CHECK(near(y[k],
+                           alpha * (scale[c] * (x[k] - mean) * invVar + bias[c]) +
+                               beta * y_init[k]));
+                CHECK(near(infer[k],
+                           alpha * (scale[c] * (x[k] - estMean[c]) * estInvVar + bias[c]) +
+                               beta * y_init[k]));
+            }
+        }
+    }
+}
+
+int main()
+{
+    // Only a shape outside the sweep is specialized, so the whole sweep runs on the generic kernels
+    setenv("MIOPEN_BN_SPECIALIZE", "64x64x56x56, 1x2x3", 1);
+    CHECK(!miopen::bnUseGenericKernels(miopenBNSpatial, 64, 64, 56, 56));
+    CHECK(miopen::bnUseGenericKernels(miopenBNSpatial, 64, 64, 56, 57));
+    CHECK(!miopen::bnUseGenericKernels(miopenBNPerActivation, 1, 3, 1, 1));
+
+    const std::vector<bn_shape> sweep = {{1, 3, 1, 1},
+                                         {2, 3, 7, 7},
+                                         {3, 4, 14, 14},
+                                         {5, 2, 33, 17},
+                                         {8, 4, 16, 16},
+                                         {16, 2, 5, 40},
+                                         {4, 1, 64, 64}};
+
+    miopen::EnableMetrics();
+    miopen::ResetMetrics();
+    run_shape(sweep.front());
+    // Forward training, inference and backward each load one program
+    const auto programs = programs_loaded();
+    CHECK(programs == 3);
+
+    for(auto&& s : sweep)
+        run_shape(s);
+
+    std::cout << "Distinct programs loaded for " << sweep.size() << " shapes: " << programs_loaded()
+              << std::endl;
+    CHECK(programs_loaded() == programs);
+    miopen::EnableMetrics(false);
+
+    for(auto&& s : sweep)
+        run_blended(s);
+}
@@ -467,6 +467,9 @@ struct verify_forward_infer_bn_spatial_use_est
     const tensor<T> shift;
     const tensor<T> estMean;
     const tensor<T> estVar;
+    // y starts out as a copy of the input, which is what beta blends with
+    const T blend_alpha = 1;
+    const T blend_beta  = 0;
     tensor<T> cpu()
     {
 
@@ -480,7 +483,6 @@ struct verify_forward_infer_bn_spatial_use_est
         std::tie(n_batch, channels, height, width) = miopen::tien<4>(input.desc.GetLengths());
 
         auto out = input;
-        std::fill(out.begin(), out.end(), 0);
 
         par_for(channels, 1, [&](int cidx) {
             double elemStd  = 0.;
@@ -503,7 +505,8 @@ struct verify_forward_infer_bn_spatial_use_est
                         elemStd = input(bidx, cidx, row, column) - mean;
                         inhat   = elemStd * invVar;
                         out(bidx, cidx, row, column) =
-                            scale(0, cidx, 0, 0) * inhat + shift(0, cidx, 0, 0);
+                            blend_alpha * (scale(0, cidx, 0, 0) * inhat + shift(0, cidx, 0, 0)) +
+                            blend_beta * input(bidx, cidx, row, column);
                     }
                 }
             }
@@ -526,7 +529,6 @@ struct verify_forward_infer_bn_spatial_use_est
 #endif
         auto&& handle = get_handle();
         auto out      = input;
-        std::fill(out.begin(), out.end(), 0);
 
         auto in_dev      = handle.Write(input.data);
         auto estMean_dev = handle.Write(estMean.data);
@@ -535,14 +537,12 @@ struct verify_forward_infer_bn_spatial_use_est
         auto shift_dev   = handle.Write(shift.data);
         auto out_dev     = handle.Write(out.data);
 
-        T alpha = 1, beta = 0;
-
         double epsilon = MIO_BN_TEST_EPSILON;
 
         miopen::BatchNormForwardInference(handle,
                                           miopenBNSpatial,
-                                          &alpha,
-                                          &beta,
+                                          &blend_alpha,
+                                          &blend_beta,
                                           input.desc,
                                           in_dev.get(),
                                           out.desc,
@@ -567,6 +567,7 @@ struct verify_forward_infer_bn_spatial_use_est
     void fail(int)
     {
         std::cout << "Forward Inference Spatial Batch Normalization Use Estimated: " << std::endl;
+        std::cout << "Blend: alpha=" << blend_alpha << ", beta=" << blend_beta << std::endl;
         std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
     }
 };
@@ -1118,6 +1119,8 @@ struct batch_norm_spatial_driver : test_driver
         std::cout << "Running forward inference spatial with R set." << std::endl;
 #endif
         verify(verify_forward_infer_bn_spatial_use_est<T>{input, scale, shift, estMean, estVar});
+        verify(verify_forward_infer_bn_spatial_use_est<T>{
+            input, scale, shift, estMean, estVar, T(0.5), T(1)});
 
         // backprop recalc
         auto dy_input = std::get<0>(outpair.second);
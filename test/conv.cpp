@@ -35,6 +35,7 @@
 #include <utility>
 
 // #include "network_data.hpp"
+#include "cpu_conv.hpp"
 #include "driver.hpp"
 #include "get_handle.hpp"
 #include "tensor_holder.hpp"
@@ -58,6 +59,22 @@ struct conv_base
     int bias{};
     int search{};
 
+    cpu_conv_problem problem() const
+    {
+        cpu_conv_problem p{};
+        std::tie(p.n, p.c, p.h, p.w) = miopen::tien<4>(input.desc.GetLengths());
+        std::tie(p.k, std::ignore, p.y, p.x) = miopen::tien<4>(weights.desc.GetLengths());
+        std::tie(std::ignore, std::ignore, p.out_h, p.out_w) =
+            miopen::tien<4>(out.desc.GetLengths());
+        p.pad_h      = filter.pad_h;
+        p.pad_w      = filter.pad_w;
+        p.u          = filter.u;
+        p.v          = filter.v;
+        p.dilation_h = filter.dilation_h;
+        p.dilation_w = filter.dilation_w;
+        return p;
+    }
+
     void fail(float = 0)
     {
         std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
@@ -94,27 +111,10 @@ struct verify_forward_conv : conv_base<T>
     {
         out = get_output_tensor(filter, input, weights);
 
-        int in_h, in_w;
-        std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
-
-        int wei_c, wei_h, wei_w;
-        std::tie(std::ignore, wei_c, wei_h, wei_w) = miopen::tien<4>(weights.desc.GetLengths());
-
-        out.par_for_each([&](int o, int w, int i, int j) {
-            const int start_x = i * filter.u - filter.pad_h;
-            const int start_y = j * filter.v - filter.pad_w;
-
-            double acc = bias;
-            ford(wei_c, wei_h, wei_w)([&](int k, int x, int y) {
-                const int in_x = start_x + x;
-                const int in_y = start_y + y;
-                if(in_x >= 0 && in_x < in_h && in_y >= 0 && in_y < in_w)
-                {
-                    acc += input(o, k, in_x, in_y) * weights(w, k, x, y);
-                }
-            });
-            out(o, w, i, j) = acc;
-        });
+        cpu_convolution_forward(
+            this->problem(), input.data.data(), weights.data.data(), out.data.data());
+        if(bias != 0)
+            std::for_each(out.begin(), out.end(), [&](T& x) { x += bias; });
         return out;
     }
 
@@ -203,29 +203,8 @@ struct verify_backward_conv : conv_base<T>
 
     tensor<T> cpu()
     {
-        std::fill(input.begin(), input.end(), 0);
-
-        int in_h, in_w;
-        std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
-
-        int wei_c, wei_h, wei_w;
-        std::tie(std::ignore, wei_c, wei_h, wei_w) = miopen::tien<4>(weights.desc.GetLengths());
-
-        int out_n, out_c, out_h, out_w;
-        std::tie(out_n, out_c, out_h, out_w) = miopen::tien<4>(out.desc.GetLengths());
-
-        par_ford(out_n, wei_c)([&](int o, int k) {
-            ford(out_c, out_h, out_w, wei_h, wei_w)([&](int w, int i, int j, int x, int y) {
-                const int start_x = i * filter.u - filter.pad_h;
-                const int start_y = j * filter.v - filter.pad_w;
-                const int in_x    = start_x + x;
-                const int in_y    = start_y + y;
-                if(in_x >= 0 && in_x < in_h && in_y >= 0 && in_y < in_w)
-                {
-                    input(o, k, in_x, in_y) += out(o, w, i, j) * weights(w, k, x, y);
-                }
-            });
-        });
+        cpu_convolution_backward_data(
+            this->problem(), out.data.data(), weights.data.data(), input.data.data());
         return input;
     }
 
@@ -314,31 +293,8 @@ struct verify_backward_weights_conv : conv_base<T>
 
     tensor<T> cpu()
     {
-        std::fill(weights.begin(), weights.end(), 0);
-
-        int in_h, in_w;
-        std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
-
-        int wei_c, wei_h, wei_w;
-        std::tie(std::ignore, wei_c, wei_h, wei_w) = miopen::tien<4>(weights.desc.GetLengths());
-
-        int out_n, out_c, out_h, out_w;
-        std::tie(out_n, out_c, out_h, out_w) = miopen::tien<4>(out.desc.GetLengths());
-
-        par_ford(out_c, wei_c, wei_h, wei_w)([&](int w, int k, int x, int y) {
-            double acc = 0.0;
-            ford(out_n, out_h, out_w)([&](int o, int i, int j) {
-                const int start_x = i * filter.u - filter.pad_h;
-                const int start_y = j * filter.v - filter.pad_w;
-                const int in_x    = start_x + x;
-                const int in_y    = start_y + y;
-                if(in_x >= 0 && in_x < in_h && in_y >= 0 && in_y < in_w)
-                {
-                    acc += input(o, k, in_x, in_y) * out(o, w, i, j);
-                }
-            });
-            weights(w, k, x, y) = acc;
-        });
+        cpu_convolution_backward_weights(
+            this->problem(), input.data.data(), out.data.data(), weights.data.data());
         return weights;
     }
 
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "conv_fixture.hpp"
+#include <miopen/activ.hpp>
+#include <miopen/conv_bias_activ_plan.hpp>
+#include <algorithm>
+#include <cmath>
+
+float gen_bias(int, int c, int, int) { return (c % 5) / 5.0 - 0.4; }
+
+bool all_close(const std::vector<float>& result, const std::vector<float>& expected)
+{
+    return std::equal(result.begin(), result.end(), expected.begin(), [](float x, float y) {
+        return std::abs(x - y) <= 1e-4f * std::max(1.0f, std::abs(y));
+    });
+}
+
+float host_activ(const miopen::ActivationDescriptor& desc, float x)
+{
+    auto alpha = desc.GetAlpha();
+    auto beta  = desc.GetBeta();
+    switch(desc.GetMode())
+    {
+    case miopenActivationLOGISTIC: return 1 / (1 + std::exp(-x));
+    case miopenActivationTANH: return alpha * std::tanh(beta * x);
+    case miopenActivationRELU: return (x > 0) ? x : x * beta;
+    case miopenActivationABS: return std::abs(x);
+    default: return x;
+    }
+}
+
+struct conv_bias_activ_fixture : conv_fixture
+{
+    tensor<float> bias;
+
+    conv_bias_activ_fixture(int pad, int stride, std::size_t c, std::size_t k, std::size_t fil)
+        : conv_fixture(pad, stride, c, k, fil),
+          bias(tensor<float>{1, k, 1, 1}.generate(gen_bias))
+    {
+    }
+
+    // Only the MIOpenConvDirUni.cl solver carries the epilogue. 1x1 and strided
+    // filters always go to other direct solvers, and ABS has no fused form, so
+    // those cases take the separate bias and activation kernels by construction.
+    bool must_fall_back(const miopen::ActivationDescriptor& activ,
+                        miopenConvFwdAlgorithm_t algo) const
+    {
+        return algo != miopenConvolutionFwdAlgoDirect ||
+               activ.GetMode() == miopenActivationABS || weights.desc.GetLengths()[2] == 1 ||
+               filter.u > 1 || filter.v > 1;
+    }
+
+    void run(const miopen::ActivationDescriptor& activ, bool direct)
+    {
+        auto&& handle = get_handle();
+        std::vector<float> expected;
+        auto fastest  = forward_reference(expected);
+        auto bias_dev = handle.Write(bias.data);
+
+        std::size_t map_sz = out.desc.GetLengths()[2] * out.desc.GetLengths()[3];
+        for(std::size_t i = 0; i < expected.size(); i++)
+        {
+            auto k = (i / map_sz) % bias.data.size();
+            expected[i] += bias.data[k];
+        }
+
+        // The fused kernels must agree with the unfused activation on the same descriptor
+        auto preactiv_dev = handle.Write(expected);
+        auto unfused_dev  = handle.Write(expected);
+        float alpha       = 1, beta = 0;
+        auto unfused_desc = activ;
+        unfused_desc.Forward(
+            handle, &alpha, out.desc, preactiv_dev.get(), &beta, out.desc, unfused_dev.get());
+        auto unfused = handle.Read<float>(unfused_dev, expected.size());
+
+        for(auto&& x : expected)
+            x = host_activ(activ, x);
+        CHECK(all_close(unfused, expected));
+
+        auto algo = direct ? miopenConvolutionFwdAlgoDirect : fastest;
+        miopen::ConvBiasActivPlan plan(
+            handle, filter, input.desc, weights.desc, bias.desc, activ, out.desc, algo);
+        CHECK(plan.GetWorkSpaceSize() <= workspace_size);
+        CHECK(!must_fall_back(activ, algo) || !plan.IsEpilogueFused());
+
+        // Run twice to make sure the resolved kernels can be reused.
+        for(int i = 0; i < 2; i++)
+        {
+            out_dev = handle.Write(out.data);
+            plan.Execute(handle,
+                         in_dev.get(),
+                         wei_dev.get(),
+                         bias_dev.get(),
+                         out_dev.get(),
+                         workspace_dev.get(),
+                         workspace_size);
+            auto result = handle.Read<float>(out_dev, out.data.size());
+            CHECK(all_close(result, expected));
+        }
+    }
+
+    void run()
+    {
+        const miopen::ActivationDescriptor activs[] = {{miopenActivationRELU, 1, 0, 1},
+                                                       {miopenActivationTANH, 1, 1, 1},
+                                                       {miopenActivationTANH, 0.5, 2, 1},
+                                                       {miopenActivationLOGISTIC, 1, 1, 1},
+                                                       {miopenActivationABS, 1, 1, 1}};
+        for(auto&& activ : activs)
+        {
+            run(activ, true);
+            run(activ, false);
+        }
+    }
+};
+
+int main()
+{
+    run_test<conv_1x1<conv_bias_activ_fixture>>();
+    run_test<conv_3x3<conv_bias_activ_fixture>>();
+    run_test<conv_5x5_stride2<conv_bias_activ_fixture>>();
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CONV_FIXTURE_HPP
+#define GUARD_CONV_FIXTURE_HPP
+
+#include "test.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include <miopen/convolution.hpp>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+#include <vector>
+
+// Forward convolution fixture shared by the plan tests. It owns a 2-image
+// 16x16 input, the weights and the output tensor, and computes the reference
+// result through ConvolutionDescriptor with whichever algorithm Find picks.
+
+inline float conv_gen_value(int n, int c, int h, int w)
+{
+    return ((n * 7 + c * 5 + h * 3 + w) % 13) / 13.0 - 0.5;
+}
+
+struct conv_fixture
+{
+    miopen::ConvolutionDescriptor filter;
+    tensor<float> input;
+    tensor<float> weights;
+    tensor<float> out;
+
+    miopen::Allocator::ManageDataPtr in_dev;
+    miopen::Allocator::ManageDataPtr wei_dev;
+    miopen::Allocator::ManageDataPtr out_dev;
+    miopen::Allocator::ManageDataPtr workspace_dev;
+    std::size_t workspace_size = 0;
+
+    conv_fixture(int pad, int stride, std::size_t c, std::size_t k, std::size_t fil)
+        : filter(pad, pad, stride, stride),
+          input(tensor<float>{2, c, 16, 16}.generate(conv_gen_value)),
+          weights(tensor<float>{k, c, fil, fil}.generate(conv_gen_value))
+    {
+        out = tensor<float>{filter.GetForwardOutputTensor(input.desc, weights.desc)};
+    }
+
+    // Uploads the tensors and a forward workspace, then runs the convolution
+    // with the fastest algorithm. Returns that algorithm; the reference output
+    // is left in `expected`.
+    miopenConvFwdAlgorithm_t forward_reference(std::vector<float>& expected)
+    {
+        auto&& handle = get_handle();
+        in_dev        = handle.Write(input.data);
+        wei_dev       = handle.Write(weights.data);
+        out_dev       = handle.Write(out.data);
+
+        workspace_size = filter.ForwardGetWorkSpaceSize(handle, weights.desc, input.desc, out.desc);
+        std::vector<char> workspace(workspace_size);
+        workspace_dev = workspace_size != 0 ? handle.Write(workspace) : nullptr;
+
+        int ret_algo_count;
+        miopenConvAlgoPerf_t perf;
+        filter.FindConvFwdAlgorithm(handle,
+                                    input.desc,
+                                    in_dev.get(),
+                                    weights.desc,
+                                    wei_dev.get(),
+                                    out.desc,
+                                    out_dev.get(),
+                                    1,
+                                    &ret_algo_count,
+                                    &perf,
+                                    workspace_dev.get(),
+                                    workspace_size,
+                                    false);
+
+        float alpha = 1, beta = 0;
+        filter.ConvolutionForward(handle,
+                                  &alpha,
+                                  input.desc,
+                                  in_dev.get(),
+                                  weights.desc,
+                                  wei_dev.get(),
+                                  perf.fwd_algo,
+                                  &beta,
+                                  out.desc,
+                                  out_dev.get(),
+                                  workspace_dev.get(),
+                                  workspace_size);
+        expected = handle.Read<float>(out_dev, out.data.size());
+        return perf.fwd_algo;
+    }
+};
+
+// The geometries every plan test runs. The 5x5 stride 2 case is picked up by
+// ConvOclDirectFwdGen rather than the MIOpenConvDirUni.cl solver.
+
+template <class Fixture>
+struct conv_1x1 : Fixture
+{
+    conv_1x1() : Fixture(0, 1, 16, 16, 1) {}
+};
+
+template <class Fixture>
+struct conv_3x3 : Fixture
+{
+    conv_3x3() : Fixture(1, 1, 16, 16, 3) {}
+};
+
+template <class Fixture>
+struct conv_5x5_stride2 : Fixture
+{
+    conv_5x5_stride2() : Fixture(2, 2, 8, 16, 5) {}
+};
+
+#endif
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "cpu_conv.hpp"
+#include "get_handle.hpp"
+#include "half.hpp"
+#include <miopen/activ.hpp>
+#include <miopen/config.h>
+#include <miopen/conv_bias_activ_plan.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+// The inputs are exact in half and their products are exact in float, so only
+// the final rounding of the output to half is expected to differ from the reference.
+void check(const std::vector<float>& result, const std::vector<float>& expected)
+{
+    CHECK(all_close(result, expected, 2e-3f));
+}
+
+std::string problem_key(const miopen::TensorDescriptor& x,
+                        const miopen::TensorDescriptor& w,
+                        const miopen::TensorDescriptor& y)
+{
+    mlo_construct_direct2D construct_params(1);
+    construct_params.setOutputDescFromMLDesc(y);
+    construct_params.setInputDescFromMLDesc(x);
+    construct_params.setWeightDescFromMLDesc(w);
+    construct_params.setConvDescr(1, 1, 1, 1, 1, 1);
+
+    miopen::ConvolutionContext context;
+    construct_params.mloCopyTo(context);
+    std::ostringstream ss;
+    ss << context;
+    return ss.str();
+}
+
+// FP16 and FP32 tunings of the same shape must not share a perf db record
+void test_problem_key()
+{
+    std::vector<int> in_lens{2, 8, 12, 12};
+    std::vector<int> wei_lens{6, 8, 3, 3};
+    std::vector<int> out_lens{2, 6, 12, 12};
+    auto key = [&](miopenDataType_t type) {
+        return problem_key({type, in_lens.data(), 4},
+                           {type, wei_lens.data(), 4},
+                           {type, out_lens.data(), 4});
+    };
+    CHECK(key(miopenHalf) != key(miopenFloat));
+    CHECK(key(miopenHalf).find("FP16") != std::string::npos);
+}
+
+void test_conv(std::vector<int> in_lens, std::vector<int> wei_lens, int pad, int stride)
+{
+    auto&& handle = get_handle();
+    miopen::ConvolutionDescriptor filter(pad, pad, stride, stride);
+    half_tensor x(in_lens);
+    half_tensor w(wei_lens, 1);
+
+    auto out_desc = filter.GetForwardOutputTensor(x.desc, w.desc);
+    std::vector<int> out_lens(out_desc.GetLengths().begin(), out_desc.GetLengths().end());
+    half_tensor y(out_lens);
+
+    cpu_conv_problem p{in_lens[0],
+                       in_lens[1],
+                       in_lens[2],
+                       in_lens[3],
+                       wei_lens[0],
+                       wei_lens[2],
+                       wei_lens[3],
+                       out_lens[2],
+                       out_lens[3],
+                       pad,
+                       pad,
+                       stride,
+                       stride,
+                       1,
+                       1};
+    std::vector<float> expected(y.host.size());
+    cpu_convolution_forward(p, x.host.data(), w.host.data(), expected.data());
+
+    size_t workspace_size = filter.ForwardGetWorkSpaceSize(handle, w.desc, x.desc, y.desc);
+    std::vector<char> workspace(workspace_size);
+    auto workspace_dev = workspace_size != 0 ? handle.Write(workspace) : nullptr;
+
+    int ret_algo_count;
+    miopenConvAlgoPerf_t perf[4];
+    filter.FindConvFwdAlgorithm(handle,
+                                x.desc,
+                                x.dev.get(),
+                                w.desc,
+                                w.dev.get(),
+                                y.desc,
+                                y.dev.get(),
+                                4,
+                                &ret_algo_count,
+                                perf,
+                                workspace_dev.get(),
+                                workspace_size,
+                                false);
+
+    auto run = [&](miopenConvFwdAlgorithm_t algo) {
+        float alpha = 1, beta = 0;
+        filter.ConvolutionForward(handle,
+                                  &alpha,
+                                  x.desc,
+                                  x.dev.get(),
+                                  w.desc,
+                                  w.dev.get(),
+                                  algo,
+                                  &beta,
+                                  y.desc,
+                                  y.dev.get(),
+                                  workspace_dev.get(),
+                                  workspace_size);
+        return y.read();
+    };
+
+    for(int i = 0; i < ret_algo_count; i++)
+    {
+        CHECK(perf[i].fwd_algo == miopenConvolutionFwdAlgoDirect ||
+              perf[i].fwd_algo == miopenConvolutionFwdAlgoGEMM);
+    }
+
+    check(run(miopenConvolutionFwdAlgoDirect), expected);
+#if MIOPEN_USE_MIOPENGEMM
+    check(run(miopenConvolutionFwdAlgoGEMM), expected);
+#endif
+    CHECK(throws([&] { run(miopenConvolutionFwdAlgoFFT); }));
+}
+
+// 1x1 filters have no fused epilogue, so this goes through the separate half bias+activation kernel
+void test_bias_activ_fallback()
+{
+    auto&& handle = get_handle();
+    std::vector<int> in_lens{2, 16, 7, 7};
+    std::vector<int> wei_lens{8, 16, 1, 1};
+    miopen::ConvolutionDescriptor filter(0, 0, 1, 1);
+    half_tensor x(in_lens);
+    half_tensor w(wei_lens, 1);
+    half_tensor b({1, 8, 1, 1}, 2);
+    half_tensor y({2, 8, 7, 7});
+
+    cpu_conv_problem p{2, 16, 7, 7, 8, 1, 1, 7, 7, 0, 0, 1, 1, 1, 1};
+    std::vector<float> expected(y.host.size());
+    cpu_convolution_forward(p, x.host.data(), w.host.data(), expected.data());
+    for(std::size_t i = 0; i < expected.size(); i++)
+    {
+        auto v      = expected[i] + b.host[(i / 49) % 8];
+        expected[i] = (v > 0) ? v : v * 0.5f;
+    }
+
+    miopen::ActivationDescriptor activ{miopenActivationRELU, 1, 0.5, 1};
+    miopen::ConvBiasActivPlan plan(handle,
+                                   filter,
+                                   x.desc,
+                                   w.desc,
+                                   b.desc,
+                                   activ,
+                                   y.desc,
+                                   miopenConvolutionFwdAlgoDirect);
+    CHECK(!plan.IsEpilogueFused());
+    size_t workspace_size = plan.GetWorkSpaceSize();
+    std::vector<char> workspace(workspace_size);
+    auto workspace_dev = workspace_size != 0 ? handle.Write(workspace) : nullptr;
+    plan.Execute(handle,
+                 x.dev.get(),
+                 w.dev.get(),
+                 b.dev.get(),
+                 y.dev.get(),
+                 workspace_dev.get(),
+                 workspace_size);
+    check(y.read(), expected);
+}
+
+int main()
+{
+    test_problem_key();
+    test_conv({2, 8, 12, 12}, {6, 8, 3, 3}, 1, 1);
+    test_conv({2, 16, 7, 7}, {8, 16, 1, 1}, 0, 1);
+    test_conv({1, 3, 17, 15}, {4, 3, 5, 5}, 2, 2);
+    test_bias_activ_fallback();
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "conv_fixture.hpp"
+#include <miopen/convolution_plan.hpp>
+
+struct conv_plan_fixture : conv_fixture
+{
+    using conv_fixture::conv_fixture;
+
+    void run()
+    {
+        auto&& handle = get_handle();
+        std::vector<float> expected;
+        auto algo = forward_reference(expected);
+
+        miopen::ConvolutionPlan plan(handle, filter, input.desc, weights.desc, out.desc, algo);
+        CHECK(plan.IsForward());
+        CHECK(plan.GetWorkSpaceSize() <= workspace_size);
+
+        // Run twice to make sure the resolved kernels can be reused.
+        for(int i = 0; i < 2; i++)
+        {
+            out_dev = handle.Write(out.data);
+            plan.Execute(handle,
+                         in_dev.get(),
+                         wei_dev.get(),
+                         out_dev.get(),
+                         workspace_dev.get(),
+                         workspace_size);
+            auto result = handle.Read<float>(out_dev, out.data.size());
+            CHECK(result == expected);
+        }
+
+        run_backward_data(out_dev);
+    }
+
+    void run_backward_data(const miopen::Allocator::ManageDataPtr& dy_dev) const
+    {
+        auto&& handle = get_handle();
+        auto dx_dev   = handle.Write(input.data);
+
+        size_t bwd_workspace_size =
+            filter.BackwardDataGetWorkSpaceSize(handle, weights.desc, out.desc, input.desc);
+        std::vector<char> workspace(bwd_workspace_size);
+        auto bwd_workspace_dev = bwd_workspace_size != 0 ? handle.Write(workspace) : nullptr;
+
+        int ret_algo_count;
+        miopenConvAlgoPerf_t perf;
+        filter.FindConvBwdDataAlgorithm(handle,
+                                        out.desc,
+                                        dy_dev.get(),
+                                        weights.desc,
+                                        wei_dev.get(),
+                                        input.desc,
+                                        dx_dev.get(),
+                                        1,
+                                        &ret_algo_count,
+                                        &perf,
+                                        bwd_workspace_dev.get(),
+                                        bwd_workspace_size,
+                                        false);
+
+        float alpha = 1, beta = 0;
+        filter.ConvolutionBackwardData(handle,
+                                       &alpha,
+                                       out.desc,
+                                       dy_dev.get(),
+                                       weights.desc,
+                                       wei_dev.get(),
+                                       perf.bwd_data_algo,
+                                       &beta,
+                                       input.desc,
+                                       dx_dev.get(),
+                                       bwd_workspace_dev.get(),
+                                       bwd_workspace_size);
+        auto expected = handle.Read<float>(dx_dev, input.data.size());
+
+        miopen::ConvolutionPlan plan(
+            handle, filter, out.desc, weights.desc, input.desc, perf.bwd_data_algo);
+        CHECK(!plan.IsForward());
+        CHECK(plan.GetWorkSpaceSize() <= bwd_workspace_size);
+
+        for(int i = 0; i < 2; i++)
+        {
+            dx_dev = handle.Write(input.data);
+            plan.Execute(handle,
+                         dy_dev.get(),
+                         wei_dev.get(),
+                         dx_dev.get(),
+                         bwd_workspace_dev.get(),
+                         bwd_workspace_size);
+            auto result = handle.Read<float>(dx_dev, input.data.size());
+            CHECK(result == expected);
+        }
+    }
+};
+
+int main()
+{
+    run_test<conv_1x1<conv_plan_fixture>>();
+    run_test<conv_3x3<conv_plan_fixture>>();
+    run_test<conv_5x5_stride2<conv_plan_fixture>>();
+}
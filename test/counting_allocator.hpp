@@ -0,0 +1,50 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_COUNTING_ALLOCATOR_HPP
+#define GUARD_COUNTING_ALLOCATOR_HPP
+
+#include <cstddef>
+
+// Counts calls and hands out host memory, the buffers are never used by a kernel.
+struct counting_allocator
+{
+    std::size_t allocs = 0;
+    std::size_t frees  = 0;
+
+    static void* allocate(void* context, size_t size)
+    {
+        static_cast<counting_allocator*>(context)->allocs++;
+        return new char[size];
+    }
+
+    static void deallocate(void* context, void* memory)
+    {
+        static_cast<counting_allocator*>(context)->frees++;
+        delete[] static_cast<char*>(memory);
+    }
+};
+
+#endif
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "bench.hpp"
+#include "cpu_conv.hpp"
+#include "verify.hpp"
+#include <iostream>
+#include <vector>
+
+// Checks the im2col + blocked GEMM host references against straightforward
+// loops. With --bench it also reports how long each takes.
+
+struct naive_conv
+{
+    const cpu_conv_problem& p;
+
+    template <class F>
+    void for_each_tap(F f) const
+    {
+        ford(p.n, p.k, p.c, p.out_h, p.out_w, p.y, p.x)(
+            [&](int n, int k, int c, int oh, int ow, int ky, int kx) {
+                const int ih = oh * p.u - p.pad_h + ky * p.dilation_h;
+                const int iw = ow * p.v - p.pad_w + kx * p.dilation_w;
+                if(ih >= 0 && ih < p.h && iw >= 0 && iw < p.w)
+                {
+                    f(((std::size_t(n) * p.c + c) * p.h + ih) * p.w + iw,
+                      ((std::size_t(k) * p.c + c) * p.y + ky) * p.x + kx,
+                      ((std::size_t(n) * p.k + k) * p.out_h + oh) * p.out_w + ow);
+                }
+            });
+    }
+
+    std::vector<float> forward(const std::vector<float>& in, const std::vector<float>& wei) const
+    {
+        std::vector<double> out(p.n * p.out_size(), 0.0);
+        for_each_tap([&](std::size_t i, std::size_t w, std::size_t o) {
+            out[o] += double(in[i]) * wei[w];
+        });
+        return {out.begin(), out.end()};
+    }
+
+    std::vector<float> backward_data(const std::vector<float>& dout,
+                                     const std::vector<float>& wei) const
+    {
+        std::vector<double> din(p.n * p.in_size(), 0.0);
+        for_each_tap([&](std::size_t i, std::size_t w, std::size_t o) {
+            din[i] += double(dout[o]) * wei[w];
+        });
+        return {din.begin(), din.end()};
+    }
+
+    std::vector<float> backward_weights(const std::vector<float>& in,
+                                        const std::vector<float>& dout) const
+    {
+        std::vector<double> dwei(p.k * p.col_rows(), 0.0);
+        for_each_tap([&](std::size_t i, std::size_t w, std::size_t o) {
+            dwei[w] += double(in[i]) * dout[o];
+        });
+        return {dwei.begin(), dwei.end()};
+    }
+};
+
+void check(const char* name, const std::vector<float>& expected, const std::vector<float>& actual)
+{
+    double error = miopen::rms_range(expected, actual);
+    if(error > 1e-6)
+    {
+        std::cout << name << ": rms error " << error << std::endl;
+        FAIL(name);
+    }
+}
+
+cpu_conv_problem make_problem(
+    int n, int c, int h, int w, int k, int y, int x, int pad, int stride, int dilation)
+{
+    cpu_conv_problem p{};
+    p.n          = n;
+    p.c          = c;
+    p.h          = h;
+    p.w          = w;
+    p.k          = k;
+    p.y          = y;
+    p.x          = x;
+    p.pad_h      = pad;
+    p.pad_w      = pad;
+    p.u          = stride;
+    p.v          = stride;
+    p.dilation_h = dilation;
+    p.dilation_w = dilation;
+    p.out_h      = (h + 2 * pad - dilation * (y - 1) - 1) / stride + 1;
+    p.out_w      = (w + 2 * pad - dilation * (x - 1) - 1) / stride + 1;
+    return p;
+}
+
+void run_problem(const cpu_conv_problem& p, bool bench)
+{
+    naive_conv naive{p};
+    auto in   = random_vector(p.n * p.in_size());
+    auto wei  = random_vector(p.k * p.col_rows());
+    auto dout = random_vector(p.n * p.out_size());
+
+    std::vector<float> out(dout.size());
+    std::vector<float> din(in.size());
+    std::vector<float> dwei(wei.size());
+    std::vector<float> ref_out, ref_din, ref_dwei;
+
+    double naive_fwd = time_ms([&] { ref_out = naive.forward(in, wei); });
+    double fast_fwd =
+        time_ms([&] { cpu_convolution_forward(p, in.data(), wei.data(), out.data()); });
+    double naive_bwd = time_ms([&] { ref_din = naive.backward_data(dout, wei); });
+    double fast_bwd  = time_ms(
+        [&] { cpu_convolution_backward_data(p, dout.data(), wei.data(), din.data()); });
+    double naive_wrw = time_ms([&] { ref_dwei = naive.backward_weights(in, dout); });
+    double fast_wrw  = time_ms(
+        [&] { cpu_convolution_backward_weights(p, in.data(), dout.data(), dwei.data()); });
+
+    if(bench)
+    {
+        std::cout << "n=" << p.n << " c=" << p.c << " h=" << p.h << " w=" << p.w << " k=" << p.k
+                  << " y=" << p.y << " x=" << p.x << " pad=" << p.pad_h << " stride=" << p.u
+                  << " dilation=" << p.dilation_h << std::endl;
+        std::cout << "    fwd " << naive_fwd << " ms -> " << fast_fwd << " ms, bwd " << naive_bwd
+                  << " ms -> " << fast_bwd << " ms, wrw " << naive_wrw << " ms -> " << fast_wrw
+                  << " ms" << std::endl;
+    }
+
+    check("forward", ref_out, out);
+    check("backward data", ref_din, din);
+    check("backward weights", ref_dwei, dwei);
+}
+
+int main(int argc, const char* argv[])
+{
+    const bool bench = bench_requested(argc, argv);
+
+    run_problem(make_problem(2, 3, 9, 9, 4, 3, 3, 1, 2, 1), bench);
+    run_problem(make_problem(4, 8, 14, 14, 16, 1, 1, 0, 1, 1), bench);
+    run_problem(make_problem(1, 5, 17, 13, 3, 1, 1, 0, 2, 1), bench);
+    run_problem(make_problem(3, 6, 20, 20, 7, 3, 3, 2, 1, 2), bench);
+    run_problem(make_problem(2, 4, 31, 27, 5, 5, 3, 2, 3, 1), bench);
+    run_problem(make_problem(16, 32, 28, 28, 64, 3, 3, 1, 1, 1), bench);
+    run_problem(make_problem(1, 1, 161, 700, 32, 5, 20, 0, 2, 1), bench);
+}
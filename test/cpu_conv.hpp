@@ -0,0 +1,276 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_CONV_HPP
+#define GUARD_CPU_CONV_HPP
+
+#include "cpu_gemm.hpp"
+#include "ford.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Host reference convolutions shared by the tests and MIOpenDriver.
+//
+// All tensors are packed NCHW, weights are packed KCYX. Every direction is
+// lowered to im2col/col2im plus a cache-blocked GEMM that is parallelized over
+// output tiles (or over the batch when there are enough images to keep every
+// thread busy). Products are accumulated in double.
+
+struct cpu_conv_problem
+{
+    int n;
+    int c;
+    int h;
+    int w;
+    int k;
+    int y; // filter height
+    int x; // filter width
+    int out_h;
+    int out_w;
+    int pad_h;
+    int pad_w;
+    int u;
+    int v;
+    int dilation_h;
+    int dilation_w;
+
+    std::size_t in_size() const { return std::size_t(c) * h * w; }
+    std::size_t out_size() const { return std::size_t(k) * out_h * out_w; }
+    std::size_t col_rows() const { return std::size_t(c) * y * x; }
+    std::size_t col_cols() const { return std::size_t(out_h) * out_w; }
+
+    bool is_1x1_identity() const
+    {
+        return y == 1 && x == 1 && u == 1 && v == 1 && pad_h == 0 && pad_w == 0;
+    }
+
+    bool parallel_batch() const
+    {
+        return static_cast<unsigned>(n) >= std::thread::hardware_concurrency();
+    }
+};
+
+template <class T>
+void cpu_im2col(const cpu_conv_problem& p, const T* im, T* col, bool parallel = true)
+{
+    auto row = [&](std::size_t r) {
+        const int ci = static_cast<int>(r / (p.y * p.x));
+        const int ky = static_cast<int>((r / p.x) % p.y);
+        const int kx = static_cast<int>(r % p.x);
+        T* col_row   = col + r * p.col_cols();
+        for(int oh = 0; oh < p.out_h; oh++)
+        {
+            const int ih = oh * p.u - p.pad_h + ky * p.dilation_h;
+            for(int ow = 0; ow < p.out_w; ow++)
+            {
+                const int iw = ow * p.v - p.pad_w + kx * p.dilation_w;
+                col_row[oh * p.out_w + ow] = (ih >= 0 && ih < p.h && iw >= 0 && iw < p.w)
+                                                 ? im[(std::size_t(ci) * p.h + ih) * p.w + iw]
+                                                 : T(0);
+            }
+        }
+    };
+    if(parallel)
+        par_for(p.col_rows(), 1, row);
+    else
+        for(std::size_t r = 0; r < p.col_rows(); r++)
+            row(r);
+}
+
+// Overwrites im. Rows of one channel only touch that channel, so channels are
+// independent.
+template <class T>
+void cpu_col2im(const cpu_conv_problem& p, const T* col, T* im, bool parallel = true)
+{
+    auto channel = [&](std::size_t ci) {
+        T* im_c = im + ci * p.h * p.w;
+        std::fill(im_c, im_c + std::size_t(p.h) * p.w, T(0));
+        for(int ky = 0; ky < p.y; ky++)
+        {
+            for(int kx = 0; kx < p.x; kx++)
+            {
+                const T* col_row = col + ((ci * p.y + ky) * p.x + kx) * p.col_cols();
+                for(int oh = 0; oh < p.out_h; oh++)
+                {
+                    const int ih = oh * p.u - p.pad_h + ky * p.dilation_h;
+                    if(ih < 0 || ih >= p.h)
+                        continue;
+                    for(int ow = 0; ow < p.out_w; ow++)
+                    {
+                        const int iw = ow * p.v - p.pad_w + kx * p.dilation_w;
+                        if(iw >= 0 && iw < p.w)
+                            im_c[ih * p.w + iw] += col_row[oh * p.out_w + ow];
+                    }
+                }
+            }
+        }
+    };
+    if(parallel)
+        par_for(p.c, 1, channel);
+    else
+        for(int ci = 0; ci < p.c; ci++)
+            channel(ci);
+}
+
+template <class F>
+void cpu_conv_for_each_image(const cpu_conv_problem& p, F f)
+{
+    if(p.parallel_batch())
+        par_for(p.n, 1, [&](std::size_t i) { f(i, false); });
+    else
+        for(int i = 0; i < p.n; i++)
+            f(i, true);
+}
+
+// out = conv(in, wei) (+ bias[k])
+template <class T>
+void cpu_convolution_forward(const cpu_conv_problem& p,
+                             const T* in,
+                             const T* wei,
+                             T* out,
+                             const T* bias = nullptr)
+{
+    cpu_conv_for_each_image(p, [&](std::size_t i, bool parallel) {
+        const T* in_i = in + i * p.in_size();
+        T* out_i      = out + i * p.out_size();
+
+        std::vector<T> col;
+        const T* b = in_i;
+        if(!p.is_1x1_identity())
+        {
+            col.resize(p.col_rows() * p.col_cols());
+            cpu_im2col(p, in_i, col.data(), parallel);
+            b = col.data();
+        }
+        cpu_gemm(false,
+                 false,
+                 p.k,
+                 p.col_cols(),
+                 p.col_rows(),
+                 1,
+                 wei,
+                 p.col_rows(),
+                 b,
+                 p.col_cols(),
+                 0,
+                 out_i,
+                 p.col_cols(),
+                 parallel);
+
+        if(bias != nullptr)
+        {
+            for(int o = 0; o < p.k; o++)
+                for(std::size_t j = 0; j < p.col_cols(); j++)
+                    out_i[o * p.col_cols() + j] += bias[o];
+        }
+    });
+}
+
+// din = conv^T(dout, wei)
+template <class T>
+void cpu_convolution_backward_data(const cpu_conv_problem& p, const T* dout, const T* wei, T* din)
+{
+    cpu_conv_for_each_image(p, [&](std::size_t i, bool parallel) {
+        const T* dout_i = dout + i * p.out_size();
+        T* din_i        = din + i * p.in_size();
+
+        if(p.is_1x1_identity())
+        {
+            cpu_gemm(true,
+                     false,
+                     p.col_rows(),
+                     p.col_cols(),
+                     p.k,
+                     1,
+                     wei,
+                     p.col_rows(),
+                     dout_i,
+                     p.col_cols(),
+                     0,
+                     din_i,
+                     p.col_cols(),
+                     parallel);
+            return;
+        }
+
+        std::vector<T> col(p.col_rows() * p.col_cols());
+        cpu_gemm(true,
+                 false,
+                 p.col_rows(),
+                 p.col_cols(),
+                 p.k,
+                 1,
+                 wei,
+                 p.col_rows(),
+                 dout_i,
+                 p.col_cols(),
+                 0,
+                 col.data(),
+                 p.col_cols(),
+                 parallel);
+        cpu_col2im(p, col.data(), din_i, parallel);
+    });
+}
+
+// dwei = sum over the batch of dout * im2col(in)^T
+template <class T>
+void cpu_convolution_backward_weights(const cpu_conv_problem& p,
+                                      const T* in,
+                                      const T* dout,
+                                      T* dwei)
+{
+    std::vector<double> acc(p.k * p.col_rows(), 0.0);
+    std::vector<T> col(p.is_1x1_identity() ? 0 : p.col_rows() * p.col_cols());
+    for(int i = 0; i < p.n; i++)
+    {
+        const T* in_i   = in + i * p.in_size();
+        const T* dout_i = dout + i * p.out_size();
+
+        const T* b = in_i;
+        if(!p.is_1x1_identity())
+        {
+            cpu_im2col(p, in_i, col.data());
+            b = col.data();
+        }
+        cpu_gemm(false,
+                 true,
+                 p.k,
+                 p.col_rows(),
+                 p.col_cols(),
+                 1,
+                 dout_i,
+                 p.col_cols(),
+                 b,
+                 p.col_cols(),
+                 1,
+                 acc.data(),
+                 p.col_rows());
+    }
+    std::transform(acc.begin(), acc.end(), dwei, [](double x) { return T(x); });
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "bench.hpp"
+#include "cpu_gemm.hpp"
+#include "verify.hpp"
+#include <iostream>
+#include <vector>
+
+// Checks the blocked host GEMM against the triple loop it replaced, for every
+// transpose variant. With --bench it also reports how long each takes.
+
+bool bench = false;
+
+template <class T>
+void naive_gemm(bool trans_a,
+                bool trans_b,
+                std::size_t m,
+                std::size_t n,
+                std::size_t k,
+                double alpha,
+                const T* a,
+                std::size_t lda,
+                const T* b,
+                std::size_t ldb,
+                double beta,
+                T* c,
+                std::size_t ldc)
+{
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            double acc = 0;
+            for(std::size_t kk = 0; kk < k; ++kk)
+                acc += (trans_a ? a[kk * lda + i] : a[i * lda + kk]) *
+                       (trans_b ? b[j * ldb + kk] : b[kk * ldb + j]);
+            c[i * ldc + j] = T(beta * c[i * ldc + j] + alpha * acc);
+        }
+    }
+}
+
+void run_gemm(bool trans_a,
+              bool trans_b,
+              std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              double alpha,
+              double beta,
+              int bench_iters = 1)
+{
+    const int iters = bench ? bench_iters : 1;
+
+    // Pad the leading dimensions so that strided access is exercised too.
+    const std::size_t lda = (trans_a ? m : k) + 3;
+    const std::size_t ldb = (trans_b ? k : n) + 1;
+    const std::size_t ldc = n + 2;
+
+    auto a = random_vector((trans_a ? k : m) * lda);
+    auto b = random_vector((trans_b ? n : k) * ldb);
+    auto c = random_vector(m * ldc);
+
+    auto expected = c;
+    auto actual   = c;
+
+    double naive_time = time_ms(
+        [&] {
+            expected = c;
+            naive_gemm(trans_a,
+                       trans_b,
+                       m,
+                       n,
+                       k,
+                       alpha,
+                       a.data(),
+                       lda,
+                       b.data(),
+                       ldb,
+                       beta,
+                       expected.data(),
+                       ldc);
+        },
+        iters);
+    double blocked_time = time_ms(
+        [&] {
+            actual = c;
+            cpu_gemm(trans_a,
+                     trans_b,
+                     m,
+                     n,
+                     k,
+                     alpha,
+                     a.data(),
+                     lda,
+                     b.data(),
+                     ldb,
+                     beta,
+                     actual.data(),
+                     ldc);
+        },
+        iters);
+
+    if(bench)
+    {
+        std::cout << (trans_a ? "T" : "N") << (trans_b ? "T" : "N") << " m=" << m << " n=" << n
+                  << " k=" << k << " alpha=" << alpha << " beta=" << beta << ": " << naive_time
+                  << " ms -> " << blocked_time << " ms" << std::endl;
+    }
+
+    double error = miopen::rms_range(expected, actual);
+    if(error > 1e-6)
+    {
+        std::cout << "rms error " << error << std::endl;
+        FAIL("gemm");
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    bench = bench_requested(argc, argv);
+
+    for(bool trans_a : {false, true})
+    {
+        for(bool trans_b : {false, true})
+        {
+            run_gemm(trans_a, trans_b, 1, 1, 1, 1, 0);
+            run_gemm(trans_a, trans_b, 7, 300, 5, 1, 1);
+            run_gemm(trans_a, trans_b, 33, 257, 129, 0.5, 2);
+            run_gemm(trans_a, trans_b, 512, 512, 512, 1, 0);
+        }
+    }
+    // Shapes seen in the LSTM/GRU verification: many small products per step.
+    run_gemm(false, true, 32, 1024, 256, 1, 1, 50);
+    run_gemm(true, false, 256, 1024, 32, 1, 1, 50);
+}
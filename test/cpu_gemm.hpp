@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_GEMM_HPP
+#define GUARD_CPU_GEMM_HPP
+
+#include "ford.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Host GEMM shared by the reference implementations in the tests and the
+// driver. Products are accumulated in double.
+
+// C[m x n] = alpha * A[m x k] * B[k x n] + beta * C. Each operand is addressed
+// through a row and a column stride, which covers every transpose variant
+// without copies. C is not read when beta is zero.
+template <class T, class TC>
+void cpu_gemm_blocked(std::size_t m,
+                      std::size_t n,
+                      std::size_t k,
+                      double alpha,
+                      const T* a,
+                      std::size_t a_row_stride,
+                      std::size_t a_col_stride,
+                      const T* b,
+                      std::size_t b_row_stride,
+                      std::size_t b_col_stride,
+                      double beta,
+                      TC* c,
+                      std::size_t ldc,
+                      bool parallel = true)
+{
+    // Packing only pays off once the operands stop fitting in L1.
+    if(m * n * k <= 16 * 16 * 16)
+    {
+        for(std::size_t i = 0; i < m; i++)
+        {
+            for(std::size_t j = 0; j < n; j++)
+            {
+                double acc = 0.0;
+                for(std::size_t kk = 0; kk < k; kk++)
+                    acc += double(a[i * a_row_stride + kk * a_col_stride]) *
+                           b[kk * b_row_stride + j * b_col_stride];
+                TC& x = c[i * ldc + j];
+                x     = beta == 0 ? TC(alpha * acc) : TC(alpha * acc + beta * x);
+            }
+        }
+        return;
+    }
+
+    const std::size_t mb = 32;
+    const std::size_t nb = 256;
+    const std::size_t kb = std::min<std::size_t>(128, k);
+
+    const std::size_t m_tiles = (m + mb - 1) / mb;
+    const std::size_t n_tiles = (n + nb - 1) / nb;
+
+    auto tile = [&](std::size_t t) {
+        const std::size_t i0 = (t / n_tiles) * mb;
+        const std::size_t j0 = (t % n_tiles) * nb;
+        const std::size_t mi = std::min(mb, m - i0);
+        const std::size_t nj = std::min(nb, n - j0);
+
+        std::vector<double> acc(mi * nj, 0.0);
+        std::vector<double> a_pack(mi * kb);
+        std::vector<T> b_pack(kb * nj);
+        for(std::size_t k0 = 0; k0 < k; k0 += kb)
+        {
+            const std::size_t kk_len = std::min(kb, k - k0);
+            // Pack both panels so that every inner loop is contiguous.
+            for(std::size_t i = 0; i < mi; i++)
+                for(std::size_t kk = 0; kk < kk_len; kk++)
+                    a_pack[i * kb + kk] = a[(i0 + i) * a_row_stride + (k0 + kk) * a_col_stride];
+            for(std::size_t kk = 0; kk < kk_len; kk++)
+                for(std::size_t j = 0; j < nj; j++)
+                    b_pack[kk * nj + j] = b[(k0 + kk) * b_row_stride + (j0 + j) * b_col_stride];
+
+            for(std::size_t i = 0; i < mi; i++)
+            {
+                double* acc_row     = &acc[i * nj];
+                const double* a_row = &a_pack[i * kb];
+                for(std::size_t kk = 0; kk < kk_len; kk++)
+                {
+                    const double a_val = a_row[kk];
+                    const T* b_row     = &b_pack[kk * nj];
+                    for(std::size_t j = 0; j < nj; j++)
+                        acc_row[j] += a_val * b_row[j];
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < mi; i++)
+        {
+            TC* c_row            = c + (i0 + i) * ldc + j0;
+            const double* result = &acc[i * nj];
+            if(beta == 0)
+                for(std::size_t j = 0; j < nj; j++)
+                    c_row[j] = TC(alpha * result[j]);
+            else
+                for(std::size_t j = 0; j < nj; j++)
+                    c_row[j] = TC(alpha * result[j] + beta * c_row[j]);
+        }
+    };
+
+    // Spawning threads costs more than a small product, so those stay serial.
+    const std::size_t tiles = m_tiles * n_tiles;
+    if(parallel && tiles > 1 && m * n * k > 64 * 64 * 64)
+        par_for(tiles, 1, tile);
+    else
+        for(std::size_t t = 0; t < tiles; t++)
+            tile(t);
+}
+
+// Row-major C[m x n] = alpha * op(A) * op(B) + beta * C, where op(A) is
+// m x k and op(B) is k x n. lda, ldb and ldc are the row strides of the
+// stored (untransposed) matrices.
+template <class T, class TC>
+void cpu_gemm(bool trans_a,
+              bool trans_b,
+              std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              double alpha,
+              const T* a,
+              std::size_t lda,
+              const T* b,
+              std::size_t ldb,
+              double beta,
+              TC* c,
+              std::size_t ldc,
+              bool parallel = true)
+{
+    cpu_gemm_blocked(m,
+                     n,
+                     k,
+                     alpha,
+                     a,
+                     trans_a ? 1 : lda,
+                     trans_a ? lda : 1,
+                     b,
+                     trans_b ? 1 : ldb,
+                     trans_b ? ldb : 1,
+                     beta,
+                     c,
+                     ldc,
+                     parallel);
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include <miopen/elementwise.hpp>
+#include <miopen/metrics.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <cmath>
+
+using miopen::ElementwiseOp;
+
+float gen_value(int n, int c, int h, int w)
+{
+    return ((n * 7 + c * 5 + h * 3 + w) % 17) / 4.0 - 2.0;
+}
+
+std::size_t programs_loaded()
+{
+    return miopen::GetCacheMetrics()[static_cast<std::size_t>(
+        miopen::MetricsCounter::KernelCacheMiss)];
+}
+
+// Reads x at the output coordinate, broadcasting every dim of length 1
+float at(const tensor<float>& x, int n, int c, int h, int w)
+{
+    auto lens = x.desc.GetLengths();
+    return x(n % lens[0], c % lens[1], h % lens[2], w % lens[3]);
+}
+
+struct elementwise_fixture
+{
+    std::vector<tensor<float>> inputs;
+    tensor<float> out;
+
+    template <class F>
+    void verify(const miopen::ElementwiseExpression& expr, F host)
+    {
+        auto&& handle = get_handle();
+        std::vector<miopen::Allocator::ManageDataPtr> inputs_dev;
+        std::vector<miopen::ElementwiseInput> args;
+        for(auto&& input : inputs)
+        {
+            inputs_dev.push_back(handle.Write(input.data));
+            args.push_back({input.desc, inputs_dev.back().get(), 0});
+        }
+        auto out_dev = handle.Write(out.data);
+        expr.Run(handle, args, out.desc, out_dev.get());
+        auto result = handle.Read<float>(out_dev, out.data.size());
+
+        auto expected = out;
+        expected.for_each(
+            [&](int n, int c, int h, int w) { expected(n, c, h, w) = host(n, c, h, w); });
+        CHECK(std::equal(result.begin(), result.end(), expected.begin(), [](float x, float y) {
+            return std::abs(x - y) <= 1e-5f * std::max(1.0f, std::abs(y));
+        }));
+    }
+};
+
+// relu(a * scale + bias), with scale and bias broadcast per channel
+struct test_scale_bias_relu : elementwise_fixture
+{
+    void run(std::size_t n, std::size_t c, std::size_t h, std::size_t w)
+    {
+        inputs = {tensor<float>{n, c, h, w}.generate(gen_value),
+                  tensor<float>{1, c, 1, 1}.generate(gen_value),
+                  tensor<float>{1, c, 1, 1}.generate(gen_value)};
+        out    = tensor<float>{n, c, h, w};
+
+        miopen::ElementwiseExpression expr;
+        auto x     = expr.Input(0);
+        auto scale = expr.Input(1);
+        auto bias  = expr.Input(2);
+        auto y     = expr.Binary(ElementwiseOp::Mul, x, scale);
+        y          = expr.Binary(ElementwiseOp::Add, y, bias);
+        expr.Unary(ElementwiseOp::Relu, y);
+
+        verify(expr, [&](int in, int ic, int ih, int iw) {
+            auto v = at(inputs[0], in, ic, ih, iw) * at(inputs[1], in, ic, ih, iw) +
+                     at(inputs[2], in, ic, ih, iw);
+            return std::max(v, 0.0f);
+        });
+    }
+
+    void run()
+    {
+        miopen::EnableMetrics();
+        miopen::ResetMetrics();
+        run(2, 3, 5, 7);
+        // Other shapes with the same broadcast pattern reuse the program
+        const auto programs = programs_loaded();
+        run(4, 16, 8, 8);
+        run(3, 5, 33, 9);
+        CHECK(programs_loaded() == programs);
+        miopen::EnableMetrics(false);
+    }
+};
+
+// An LSTM style cell update: sigmoid(f) * c + sigmoid(i) * tanh(g), with
+// constants and an input broadcast over the batch
+struct test_cell_update : elementwise_fixture
+{
+    void run()
+    {
+        inputs = {tensor<float>{4, 8, 3, 3}.generate(gen_value),
+                  tensor<float>{4, 8, 3, 3}.generate([](auto n, auto c, auto h, auto w) {
+                      return gen_value(c, n, w, h);
+                  }),
+                  tensor<float>{4, 8, 3, 3}.generate([](auto n, auto c, auto h, auto w) {
+                      return gen_value(w, h, c, n);
+                  }),
+                  tensor<float>{1, 8, 3, 3}.generate(gen_value)};
+        out = tensor<float>{4, 8, 3, 3};
+
+        miopen::ElementwiseExpression expr;
+        auto f    = expr.Unary(ElementwiseOp::Sigmoid, expr.Input(0));
+        auto i    = expr.Unary(ElementwiseOp::Sigmoid, expr.Input(1));
+        auto g    = expr.Unary(ElementwiseOp::Tanh, expr.Input(2));
+        auto c    = expr.Binary(ElementwiseOp::Mul, expr.Constant(0.5f), expr.Input(3));
+        auto keep = expr.Binary(ElementwiseOp::Mul, f, c);
+        auto add  = expr.Binary(ElementwiseOp::Mul, i, g);
+        expr.Binary(ElementwiseOp::Min,
+                    expr.Binary(ElementwiseOp::Add, keep, add),
+                    expr.Constant(1.25f));
+
+        auto sigmoid = [](float x) { return 1 / (1 + std::exp(-x)); };
+        verify(expr, [&](int n, int ch, int h, int w) {
+            auto v = sigmoid(at(inputs[0], n, ch, h, w)) * 0.5f * at(inputs[3], n, ch, h, w) +
+                     sigmoid(at(inputs[1], n, ch, h, w)) * std::tanh(at(inputs[2], n, ch, h, w));
+            return std::min(v, 1.25f);
+        });
+    }
+};
+
+struct test_bad_broadcast
+{
+    void run()
+    {
+        auto&& handle = get_handle();
+        tensor<float> x{2, 3, 4, 4};
+        tensor<float> y{2, 3, 4, 5};
+        auto x_dev = handle.Write(x.data);
+        auto y_dev = handle.Write(y.data);
+
+        miopen::ElementwiseExpression expr;
+        expr.Unary(ElementwiseOp::Abs, expr.Input(0));
+        CHECK(throws([&] { expr.Run(handle, {{x.desc, x_dev.get(), 0}}, y.desc, y_dev.get()); }));
+        // Missing input
+        CHECK(throws([&] { expr.Run(handle, {}, y.desc, y_dev.get()); }));
+    }
+};
+
+int main()
+{
+    run_test<test_scale_bias_relu>();
+    run_test<test_cell_update>();
+    run_test<test_bad_broadcast>();
+}
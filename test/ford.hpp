@@ -36,9 +36,16 @@
 #include <numeric>
 #include <vector>
 
+#include <atomic>
+#include <exception>
+
 #ifdef __MINGW32__
+#include <mingw.condition_variable.h>
+#include <mingw.mutex.h>
 #include <mingw.thread.h>
 #else
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #endif
 
@@ -59,43 +66,155 @@ struct joinable_thread : std::thread
     }
 };
 
-struct thread_factory
+// Process-wide pool backing par_for. The workers are created on first use and
+// live until exit. Each loop is split into chunks that are handed out on
+// demand, so threads that finish early keep taking work from the slow ones.
+// The calling thread takes part as well, and a par_for issued from inside a
+// worker runs serially rather than waiting on the pool it is part of.
+struct par_for_pool
 {
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
+    struct job
     {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
+        std::size_t n;
+        std::size_t chunk;
+        std::function<void(std::size_t)> f;
+        std::atomic<std::size_t> next{0};
+        std::size_t active = 0;
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        void work()
+        {
+            for(;;)
             {
-                f(i);
+                const std::size_t start = next.fetch_add(chunk);
+                if(start >= n)
+                    return;
+                const std::size_t last = std::min(n, start + chunk);
+                try
+                {
+                    for(std::size_t i = start; i < last; i++)
+                        f(i);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if(!error)
+                        error = std::current_exception();
+                    next = n;
+                }
             }
-        });
-        work += grainsize;
+        }
+    };
+
+    par_for_pool()
+    {
+        const std::size_t n = std::thread::hardware_concurrency();
+        for(std::size_t i = 1; i < n; i++)
+            workers.emplace_back([this] { this->worker(); });
+    }
+
+    par_for_pool(const par_for_pool&) = delete;
+    par_for_pool& operator=(const par_for_pool&) = delete;
+
+    ~par_for_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        ready.notify_all();
+        workers.clear();
+    }
+
+    static bool& in_worker()
+    {
+        static thread_local bool result = false;
         return result;
     }
-};
 
-template <class F>
-void par_for_impl(std::size_t n, std::size_t threadsize, F f)
-{
-    if(threadsize <= 1)
+    std::size_t size() const { return workers.size() + 1; }
+
+    template <class F>
+    void run(std::size_t n, std::size_t threadsize, F f)
     {
-        for(std::size_t i = 0; i < n; i++)
-            f(i);
+        if(threadsize <= 1 || workers.empty() || in_worker())
+        {
+            for(std::size_t i = 0; i < n; i++)
+                f(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit_lock(submit);
+        job j;
+        j.n = n;
+        // Several chunks per thread so that uneven iterations even out.
+        j.chunk = std::max<std::size_t>(1, n / (threadsize * 8));
+        j.f     = f;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            current = &j;
+            generation++;
+        }
+        ready.notify_all();
+
+        in_worker() = true;
+        j.work();
+        in_worker() = false;
+
+        {
+            std::unique_lock<std::mutex> lock(m);
+            current = nullptr;
+            done.wait(lock, [&] { return j.active == 0; });
+        }
+        if(j.error)
+            std::rethrow_exception(j.error);
     }
-    else
+
+    private:
+    void worker()
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        in_worker()           = true;
+        std::size_t last_seen = 0;
+        std::unique_lock<std::mutex> lock(m);
+        for(;;)
+        {
+            ready.wait(lock, [&] {
+                return stop || (current != nullptr && generation != last_seen);
+            });
+            if(stop)
+                return;
+            last_seen = generation;
+            job* j    = current;
+            j->active++;
+            lock.unlock();
+            j->work();
+            lock.lock();
+            if(--j->active == 0)
+                done.notify_all();
+        }
     }
+
+    std::vector<joinable_thread> workers;
+    std::mutex submit;
+    std::mutex m;
+    std::condition_variable ready;
+    std::condition_variable done;
+    job* current           = nullptr;
+    std::size_t generation = 0;
+    bool stop              = false;
+};
+
+inline par_for_pool& get_par_for_pool()
+{
+    static par_for_pool pool;
+    return pool;
+}
+
+template <class F>
+void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+{
+    get_par_for_pool().run(n, threadsize, f);
 }
 
 template <class F>
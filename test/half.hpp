@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_HALF_HPP
+#define GUARD_HALF_HPP
+
+#include "get_handle.hpp"
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// IEEE binary16 conversions, denormals are flushed to zero.
+inline uint16_t to_half(float f)
+{
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    uint16_t sign = (x >> 16) & 0x8000;
+    int exp       = int((x >> 23) & 0xff) - 127 + 15;
+    uint32_t mant = x & 0x7fffff;
+    if(exp <= 0)
+        return sign;
+    if(exp >= 31)
+        return sign | 0x7c00;
+    uint32_t h   = (uint32_t(exp) << 10) | (mant >> 13);
+    uint32_t rem = mant & 0x1fff;
+    if(rem > 0x1000 || (rem == 0x1000 && (h & 1) != 0))
+        h++;
+    return sign | h;
+}
+
+inline float from_half(uint16_t h)
+{
+    uint32_t sign = uint32_t(h & 0x8000) << 16;
+    uint32_t exp  = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    uint32_t x    = sign;
+    if(exp == 31)
+        x |= 0x7f800000 | (mant << 13);
+    else if(exp != 0)
+        x |= ((exp - 15 + 127) << 23) | (mant << 13);
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+// Values that are exact in half, so conversions do not change the expected results
+inline std::vector<float> half_exact_data(std::size_t n, int seed)
+{
+    std::vector<float> result(n);
+    for(std::size_t i = 0; i < n; i++)
+        result[i] = (static_cast<int>((i * 37 + seed * 11) % 129) - 64) / 32.0f;
+    return result;
+}
+
+// Whether every result is within tolerance of its reference, relative to references above 1
+inline bool all_close(const std::vector<float>& result,
+                      const std::vector<float>& expected,
+                      float tolerance)
+{
+    return result.size() == expected.size() &&
+           std::equal(result.begin(), result.end(), expected.begin(), [&](float x, float y) {
+               return std::abs(x - y) <= tolerance * std::max(1.0f, std::abs(y));
+           });
+}
+
+// A half tensor on the device together with its values on the host, which are
+// all exactly representable so that the host reference sees the same input.
+struct half_tensor
+{
+    miopen::TensorDescriptor desc;
+    std::vector<float> host;
+    miopen::Allocator::ManageDataPtr dev;
+
+    half_tensor(std::vector<int> lens, int seed = 0)
+        : desc(miopenHalf, lens.data(), static_cast<int>(lens.size())),
+          host(half_exact_data(desc.GetElementSize(), seed))
+    {
+        std::vector<uint16_t> h(host.size());
+        std::transform(host.begin(), host.end(), h.begin(), &to_half);
+        dev = get_handle().Write(h);
+    }
+
+    std::vector<float> read() const
+    {
+        auto h = get_handle().Read<uint16_t>(dev, host.size());
+        std::vector<float> result(h.size());
+        std::transform(h.begin(), h.end(), result.begin(), &from_half);
+        return result;
+    }
+};
+
+#endif
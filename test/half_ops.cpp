@@ -0,0 +1,234 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "get_handle.hpp"
+#include "half.hpp"
+#include <miopen/activ.hpp>
+#include <miopen/check_numerics.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/softmax.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_ops.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+
+// Results are rounded to half once, everything before is computed in float
+void check(const std::vector<float>& result, const std::vector<float>& expected)
+{
+    CHECK(all_close(result, expected, 2e-3f));
+}
+
+template <class F>
+std::vector<float> transform(const std::vector<float>& v, F f)
+{
+    std::vector<float> result(v.size());
+    std::transform(v.begin(), v.end(), result.begin(), f);
+    return result;
+}
+
+void test_activation()
+{
+    auto&& handle = get_handle();
+    float alpha = 1, beta = 0;
+    half_tensor x({2, 3, 7, 5});
+    half_tensor y({2, 3, 7, 5});
+
+    miopen::ActivationDescriptor relu{miopenActivationRELU, 1, 0, 1};
+    relu.Forward(handle, &alpha, x.desc, x.dev.get(), &beta, y.desc, y.dev.get());
+    check(y.read(), transform(x.host, [](float v) { return v > 0 ? v : 0; }));
+
+    miopen::ActivationDescriptor tanh_desc{miopenActivationTANH, 1, 1, 1};
+    tanh_desc.Forward(handle, &alpha, x.desc, x.dev.get(), &beta, y.desc, y.dev.get());
+    check(y.read(), transform(x.host, [](float v) { return std::tanh(v); }));
+
+    miopen::ActivationDescriptor logistic{miopenActivationLOGISTIC, 1, 1, 1};
+    logistic.Forward(handle, &alpha, x.desc, x.dev.get(), &beta, y.desc, y.dev.get());
+    auto sigmoid = y.read();
+    check(sigmoid, transform(x.host, [](float v) { return 1 / (1 + std::exp(-v)); }));
+
+    // The backward pass reads y back from half
+    half_tensor dy({2, 3, 7, 5}, 1);
+    half_tensor dx({2, 3, 7, 5});
+    logistic.Backward(handle,
+                      &alpha,
+                      y.desc,
+                      y.dev.get(),
+                      dy.desc,
+                      dy.dev.get(),
+                      x.desc,
+                      x.dev.get(),
+                      &beta,
+                      dx.desc,
+                      dx.dev.get());
+    std::vector<float> expected(dx.host.size());
+    for(std::size_t i = 0; i < expected.size(); i++)
+        expected[i] = dy.host[i] * sigmoid[i] * (1 - sigmoid[i]);
+    check(dx.read(), expected);
+}
+
+void test_pooling()
+{
+    auto&& handle = get_handle();
+    float alpha = 1, beta = 0;
+    half_tensor x({2, 3, 8, 6});
+
+    for(auto mode : {miopenPoolingMax, miopenPoolingAverage})
+    {
+        miopen::PoolingDescriptor pooling{mode, miopenPaddingDefault, {2, 2}, {2, 2}, {0, 0}};
+        auto y_desc = pooling.GetForwardOutputTensor(x.desc);
+        CHECK(y_desc.GetType() == miopenHalf);
+        half_tensor y({2, 3, 4, 3});
+        pooling.Forward(
+            handle, &alpha, x.desc, x.dev.get(), &beta, y.desc, y.dev.get(), false, nullptr, 0);
+
+        std::vector<float> expected(y.host.size());
+        for(std::size_t i = 0; i < expected.size(); i++)
+        {
+            std::size_t ow = i % 3, oh = (i / 3) % 4, nc = i / 12;
+            std::vector<float> window;
+            for(std::size_t j = 0; j < 4; j++)
+                window.push_back(x.host[nc * 48 + (oh * 2 + j / 2) * 6 + ow * 2 + j % 2]);
+            expected[i] = mode == miopenPoolingMax
+                              ? *std::max_element(window.begin(), window.end())
+                              : std::accumulate(window.begin(), window.end(), 0.0f) / 4;
+        }
+        check(y.read(), expected);
+    }
+}
+
+void test_softmax()
+{
+    auto&& handle = get_handle();
+    float alpha = 1, beta = 0;
+    half_tensor x({3, 10, 2, 3});
+    half_tensor y({3, 10, 2, 3});
+
+    for(auto algorithm : {miopenSoftmaxAccurate, miopenSoftmaxLog})
+    {
+        miopen::SoftmaxForward(
+            handle, &alpha, x.desc, x.dev.get(), &beta, y.desc, y.dev.get(), algorithm);
+
+        std::vector<float> expected(y.host.size());
+        for(std::size_t n = 0; n < 3; n++)
+        {
+            for(std::size_t s = 0; s < 6; s++)
+            {
+                auto at = [&](std::size_t c) { return n * 60 + c * 6 + s; };
+                float m = -INFINITY, sum = 0;
+                for(std::size_t c = 0; c < 10; c++)
+                    m = std::max(m, x.host[at(c)]);
+                for(std::size_t c = 0; c < 10; c++)
+                    sum += std::exp(x.host[at(c)] - m);
+                for(std::size_t c = 0; c < 10; c++)
+                    expected[at(c)] = algorithm == miopenSoftmaxLog
+                                          ? x.host[at(c)] - m - std::log(sum)
+                                          : std::exp(x.host[at(c)] - m) / sum;
+            }
+        }
+        check(y.read(), expected);
+    }
+}
+
+void test_tensor_ops()
+{
+    auto&& handle = get_handle();
+    float alpha0 = 1, alpha1 = 0.5, beta = 0;
+    half_tensor a({2, 4, 5, 3});
+    half_tensor b({1, 4, 1, 1}, 1);
+    half_tensor c({2, 4, 5, 3});
+
+    miopen::OpTensor(handle,
+                     miopenTensorOpAdd,
+                     &alpha0,
+                     a.desc,
+                     a.dev.get(),
+                     &alpha1,
+                     b.desc,
+                     b.dev.get(),
+                     &beta,
+                     c.desc,
+                     c.dev.get());
+    std::vector<float> expected(c.host.size());
+    for(std::size_t i = 0; i < expected.size(); i++)
+        expected[i] = a.host[i] + 0.5f * b.host[(i / 15) % 4];
+    check(c.read(), expected);
+
+    float scale = 2;
+    miopen::ScaleTensor(handle, c.desc, c.dev.get(), &scale);
+    check(c.read(), transform(expected, [](float v) { return 2 * v; }));
+
+    // Packed copies are a plain buffer copy, offsets go through the kernel
+    half_tensor d({2, 4, 5, 3}, 2);
+    miopen::CopyTensor(handle, a.desc, a.dev.get(), d.desc, d.dev.get());
+    check(d.read(), a.host);
+
+    half_tensor f({60}, 4);
+    miopen::TensorDescriptor half_desc(miopenHalf, {30});
+    miopen::CopyTensor(handle, half_desc, a.dev.get(), half_desc, f.dev.get(), 30, 0);
+    auto result = f.read();
+    CHECK(std::equal(result.begin(), result.begin() + 30, a.host.begin() + 30));
+    CHECK(std::equal(result.begin() + 30, result.end(), f.host.begin() + 30));
+}
+
+void test_check_numerics()
+{
+    auto&& handle = get_handle();
+    const int mode = miopen::CheckNumerics::Throw | miopen::CheckNumerics::ComputeStats;
+    half_tensor x({2, 3, 4, 5});
+    CHECK(!miopen::checkNumericsImpl(handle, mode, x.desc, x.dev.get(), true));
+
+    std::vector<uint16_t> h(x.host.size(), to_half(1));
+    h[7]         = 0x7e00; // NaN
+    auto nan_dev = handle.Write(h);
+    CHECK(throws([&] { miopen::checkNumericsImpl(handle, mode, x.desc, nan_dev.get(), true); }));
+}
+
+void test_backward_bias_rejected()
+{
+    auto&& handle = get_handle();
+    float alpha = 1, beta = 0;
+    half_tensor dy({2, 4, 5, 3});
+    half_tensor db({1, 4, 1, 1});
+    CHECK(throws([&] {
+        miopen::ConvolutionBackwardBias(
+            handle, &alpha, dy.desc, dy.dev.get(), &beta, db.desc, db.dev.get());
+    }));
+}
+
+int main()
+{
+    test_activation();
+    test_pooling();
+    test_softmax();
+    test_tensor_ops();
+    test_check_numerics();
+    test_backward_bias_rejected();
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/handle.hpp>
+#include <miopen/kernel_profiler.hpp>
+#include "get_handle.hpp"
+#include "test.hpp"
+#include <vector>
+
+std::string Write2s()
+{
+    return "__kernel void write(__global int* data) { data[get_global_id(0)] *= 2; }\n";
+}
+
+void check_ring()
+{
+    miopen::KernelProfiler profiler{3};
+    int resolved = 0;
+    for(int i = 0; i < 5; i++)
+    {
+        miopen::KernelProfile p;
+        p.kernel_name = "k" + std::to_string(i);
+        profiler.Record(p, [&resolved, i](miopen::KernelProfile& x) {
+            resolved++;
+            x.start_ns = 10 * i;
+            x.end_ns   = 10 * i + 5;
+        });
+    }
+    CHECK(resolved == 0);
+    CHECK(profiler.GetDropped() == 2);
+
+    const auto& records = profiler.Collect();
+    CHECK(resolved == 3);
+    CHECK(records.size() == 3);
+    CHECK(records.front().kernel_name == "k2");
+    CHECK(records.back().kernel_name == "k4");
+    CHECK(records.back().start_ns == 40);
+    CHECK(records.back().end_ns == 45);
+
+    // Records are only resolved once.
+    profiler.Collect();
+    CHECK(resolved == 3);
+
+    profiler.Reset();
+    CHECK(profiler.Collect().empty());
+    CHECK(profiler.GetDropped() == 0);
+}
+
+void check_handle()
+{
+    auto&& h = get_handle();
+    const std::size_t n = 64;
+    std::vector<int> data_in(n, 1);
+    auto data_dev = h.Write(data_in);
+
+    h.ResetKernelProfiles();
+    h.EnableDeferredProfiling();
+    for(int i = 0; i < 3; i++)
+        h.GetKernel(
+            "miopenGeneratedProfile", "write", Write2s(), "write", {n, 1, 1}, {n, 1, 1}, "")(
+            data_dev.get());
+    h.EnableDeferredProfiling(false);
+    h.GetKernel("miopenGeneratedProfile", "write")(data_dev.get());
+
+    const auto& records = h.GetKernelProfiles();
+    CHECK(records.size() == 3);
+    for(auto&& r : records)
+    {
+        CHECK(r.kernel_name == "write");
+        CHECK(r.algorithm == "miopenGeneratedProfile");
+        CHECK(r.network_config == "write");
+        CHECK(r.end_ns >= r.start_ns);
+    }
+    CHECK(records[1].start_ns >= records[0].end_ns);
+
+    auto data_out = h.Read<int>(data_dev, n);
+    CHECK(data_out == std::vector<int>(n, 16));
+
+    h.ResetKernelProfiles();
+    CHECK(h.GetKernelProfiles().empty());
+}
+
+int main()
+{
+    check_ring();
+    check_handle();
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "counting_allocator.hpp"
+#include <miopen/handle.hpp>
+#include <miopen/memory_pool.hpp>
+#include <miopen/miopen.h>
+
+miopenMemoryPoolStats_t get_stats(miopenHandle_t handle)
+{
+    miopenMemoryPoolStats_t stats;
+    CHECK(miopenGetMemoryPoolStats(handle, &stats) == miopenStatusSuccess);
+    return stats;
+}
+
+void test_size_classes()
+{
+    CHECK(miopen::MemoryPool::GetSizeClass(1) == 256);
+    CHECK(miopen::MemoryPool::GetSizeClass(256) == 256);
+    CHECK(miopen::MemoryPool::GetSizeClass(257) == 320);
+    CHECK(miopen::MemoryPool::GetSizeClass(512) == 512);
+    CHECK(miopen::MemoryPool::GetSizeClass(513) == 640);
+    CHECK(miopen::MemoryPool::GetSizeClass(1000) == 1024);
+    CHECK(miopen::MemoryPool::GetSizeClass(1 << 20) == 1 << 20);
+    CHECK(miopen::MemoryPool::GetSizeClass((1 << 20) + 1) == (1 << 20) + (1 << 18));
+}
+
+void test_pool()
+{
+    miopenHandle_t handle;
+    CHECK(miopenCreate(&handle) == miopenStatusSuccess);
+    auto&& h = miopen::deref(handle);
+
+    counting_allocator counter;
+    miopenSetAllocator(
+        handle, &counting_allocator::allocate, &counting_allocator::deallocate, &counter);
+    miopenEnableMemoryPool(handle, false);
+
+    // Without the pool every request reaches the allocator
+    for(int i = 0; i < 10; i++)
+        h.Create(1000);
+    CHECK(counter.allocs == 10);
+    CHECK(counter.frees == 10);
+
+    // With the pool one buffer is recycled, also across sizes of the same class
+    miopenEnableMemoryPool(handle, true);
+    for(int i = 0; i < 10; i++)
+        h.Create(i % 2 == 0 ? 1000 : 900);
+    CHECK(counter.allocs == 11);
+    CHECK(counter.frees == 10);
+
+    auto stats = get_stats(handle);
+    CHECK(stats.allocations == 1);
+    CHECK(stats.reuses == 9);
+    CHECK(stats.bytes_in_use == 0);
+    CHECK(stats.bytes_cached == 1024);
+    CHECK(stats.high_water_mark == 1024);
+
+    {
+        auto a = h.Create(1000);
+        auto b = h.Create(1000);
+        auto c = h.Create(5000);
+        stats  = get_stats(handle);
+        CHECK(stats.bytes_in_use == 1024 + 1024 + 5120);
+        CHECK(stats.bytes_cached == 0);
+    }
+    stats = get_stats(handle);
+    CHECK(counter.allocs == 13);
+    CHECK(stats.bytes_in_use == 0);
+    CHECK(stats.high_water_mark == 1024 + 1024 + 5120);
+
+    // Trim returns everything to the allocator
+    miopenTrimMemoryPool(handle);
+    CHECK(counter.frees == counter.allocs);
+    CHECK(get_stats(handle).bytes_cached == 0);
+
+    // Buffers outliving a disabled pool are still freed
+    {
+        auto a = h.Create(1000);
+        miopenEnableMemoryPool(handle, false);
+        CHECK(get_stats(handle).allocations == 0);
+    }
+    CHECK(counter.frees == counter.allocs);
+
+    miopenDestroy(handle);
+}
+
+int main()
+{
+    test_size_classes();
+    test_pool();
+}
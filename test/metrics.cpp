@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/metrics.hpp>
+#include <miopen/miopen.h>
+#include "get_handle.hpp"
+#include "test.hpp"
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+std::string Write2s()
+{
+    return "__kernel void write(__global int* data) { data[get_global_id(0)] *= 2; }\n";
+}
+
+const miopenApiMetrics_t* find_api(const std::vector<miopenApiMetrics_t>& apis, const char* name)
+{
+    for(auto&& m : apis)
+        if(std::string(m.name) == name)
+            return &m;
+    return nullptr;
+}
+
+std::vector<miopenApiMetrics_t> get_api_metrics()
+{
+    std::size_t count = 0;
+    CHECK(miopenGetApiMetrics(nullptr, &count) == miopenStatusSuccess);
+    std::vector<miopenApiMetrics_t> result(count);
+    CHECK(miopenGetApiMetrics(result.data(), &count) == miopenStatusSuccess);
+    result.resize(count);
+    return result;
+}
+
+void check_disabled()
+{
+    CHECK(miopenEnableMetrics(false) == miopenStatusSuccess);
+    CHECK(miopenResetMetrics() == miopenStatusSuccess);
+    miopenTensorDescriptor_t desc;
+    CHECK(miopenCreateTensorDescriptor(&desc) == miopenStatusSuccess);
+    CHECK(miopenDestroyTensorDescriptor(desc) == miopenStatusSuccess);
+    miopen::IncrementMetric(miopen::MetricsCounter::PerfDbHit);
+    CHECK(get_api_metrics().empty());
+    miopenCacheMetrics_t cache;
+    CHECK(miopenGetCacheMetrics(&cache) == miopenStatusSuccess);
+    CHECK(cache.perf_db_hits == 0);
+}
+
+void check_api_calls()
+{
+    CHECK(miopenEnableMetrics(true) == miopenStatusSuccess);
+    CHECK(miopenResetMetrics() == miopenStatusSuccess);
+    for(int i = 0; i < 3; i++)
+    {
+        miopenTensorDescriptor_t desc;
+        CHECK(miopenCreateTensorDescriptor(&desc) == miopenStatusSuccess);
+        CHECK(miopenSet4dTensorDescriptor(desc, miopenFloat, 1, 2, 3, 4) == miopenStatusSuccess);
+        CHECK(miopenDestroyTensorDescriptor(desc) == miopenStatusSuccess);
+    }
+    CHECK(miopenCreateTensorDescriptor(nullptr) != miopenStatusSuccess);
+
+    const auto apis = get_api_metrics();
+    const auto* create = find_api(apis, "miopenCreateTensorDescriptor");
+    CHECK(create != nullptr);
+    CHECK(create->calls == 4);
+    CHECK(create->errors == 1);
+    CHECK(create->host_us >= create->max_host_us);
+    CHECK(std::accumulate(create->host_histogram,
+                          create->host_histogram + MIOPEN_METRICS_HISTOGRAM_BUCKETS,
+                          std::size_t{0}) == create->calls);
+    const auto* set = find_api(apis, "miopenSet4dTensorDescriptor");
+    CHECK(set != nullptr);
+    CHECK(set->calls == 3);
+    CHECK(set->errors == 0);
+
+    // Sorted by name
+    for(std::size_t i = 1; i < apis.size(); i++)
+        CHECK(std::string(apis[i - 1].name) < apis[i].name);
+
+    CHECK(miopenResetMetrics() == miopenStatusSuccess);
+    CHECK(find_api(get_api_metrics(), "miopenSet4dTensorDescriptor") == nullptr);
+}
+
+void check_internal()
+{
+    miopen::EnableMetrics();
+    miopen::ResetMetrics();
+
+    CHECK(miopen::ApiMetrics::GetBucket(0.5) == 0);
+    CHECK(miopen::ApiMetrics::GetBucket(3) == 1);
+    CHECK(miopen::ApiMetrics::GetBucket(1024) == 10);
+    CHECK(miopen::ApiMetrics::GetBucket(1e30) == MIOPEN_METRICS_HISTOGRAM_BUCKETS - 1);
+
+    // Device time is attributed to the call in progress only
+    miopen::RecordDeviceTime(1.0f);
+    CHECK(miopen::try_("outer", [] {
+              miopen::RecordDeviceTime(0.5f);
+              miopen::RecordDeviceTime(0.25f);
+          }) == miopenStatusSuccess);
+    miopen::RecordDeviceTime(1.0f);
+    const auto apis = miopen::GetApiMetrics();
+    CHECK(apis.size() == 1);
+    CHECK(apis.front().device_us == 750.0);
+
+    miopen::IncrementMetric(miopen::MetricsCounter::PerfDbMiss);
+    miopen::IncrementMetric(miopen::MetricsCounter::PerfDbMiss);
+    miopenCacheMetrics_t cache;
+    CHECK(miopenGetCacheMetrics(&cache) == miopenStatusSuccess);
+    CHECK(cache.perf_db_misses == 2);
+
+    std::stringstream ss;
+    miopen::DumpMetrics(ss);
+    CHECK(ss.str().find("outer: calls = 1") != std::string::npos);
+    CHECK(ss.str().find("perf_db_misses = 2") != std::string::npos);
+    miopen::ResetMetrics();
+}
+
+void check_kernel_cache()
+{
+    auto&& h            = get_handle();
+    const std::size_t n = 64;
+    std::vector<int> data_in(n, 1);
+    auto data_dev = h.Write(data_in);
+
+    miopen::EnableMetrics();
+    miopen::ResetMetrics();
+    for(int i = 0; i < 2; i++)
+        h.GetKernel(
+            "miopenGeneratedMetrics", "write", Write2s(), "write", {n, 1, 1}, {n, 1, 1}, "")(
+            data_dev.get());
+    h.GetKernel("miopenGeneratedMetrics", "write")(data_dev.get());
+
+    const auto cache = miopen::GetCacheMetrics();
+    CHECK(cache[static_cast<std::size_t>(miopen::MetricsCounter::KernelCacheMiss)] == 1);
+    CHECK(cache[static_cast<std::size_t>(miopen::MetricsCounter::KernelCacheHit)] == 2);
+    miopen::EnableMetrics(false);
+}
+
+int main()
+{
+    check_disabled();
+    check_api_calls();
+    check_internal();
+    check_kernel_cache();
+}
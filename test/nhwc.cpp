@@ -0,0 +1,241 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "cpu_conv.hpp"
+#include "get_handle.hpp"
+#include "half.hpp"
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+miopen::TensorDescriptor make_desc(std::vector<int> lens, bool nhwc)
+{
+    if(!nhwc)
+        return {miopenFloat, lens.data(), 4};
+    std::vector<int> strides{lens[1] * lens[2] * lens[3], 1, lens[1] * lens[3], lens[1]};
+    return {miopenFloat, lens.data(), strides.data(), 4};
+}
+
+// Reorders packed NCHW data into the element order of desc
+std::vector<float> reorder(const std::vector<float>& nchw, const miopen::TensorDescriptor& desc)
+{
+    int n, c, h, w;
+    std::tie(n, c, h, w) = miopen::tien<4>(desc.GetLengths());
+    std::vector<float> result(nchw.size());
+    for(int in = 0; in < n; in++)
+        for(int ic = 0; ic < c; ic++)
+            for(int ih = 0; ih < h; ih++)
+                for(int iw = 0; iw < w; iw++)
+                    result[desc.GetIndex(in, ic, ih, iw)] =
+                        nchw[((in * c + ic) * h + ih) * w + iw];
+    return result;
+}
+
+void check(const std::vector<float>& result, const std::vector<float>& expected)
+{
+    CHECK(all_close(result, expected, 1e-4f));
+}
+
+void test_layout()
+{
+    CHECK(make_desc({2, 3, 4, 5}, false).GetLayout() == "NCHW");
+    CHECK(make_desc({2, 3, 4, 5}, true).GetLayout() == "NHWC");
+    // a single channel is the same in both layouts
+    CHECK(make_desc({2, 1, 4, 5}, true).GetLayout() == "NCHW");
+}
+
+// NCHW and NHWC tunings of the same shape must not share a perf db record
+void test_problem_key()
+{
+    auto key = [](bool nhwc) {
+        mlo_construct_direct2D construct_params(1);
+        construct_params.setOutputDescFromMLDesc(make_desc({2, 6, 12, 12}, nhwc));
+        construct_params.setInputDescFromMLDesc(make_desc({2, 8, 12, 12}, nhwc));
+        construct_params.setWeightDescFromMLDesc(make_desc({6, 8, 3, 3}, false));
+        construct_params.setConvDescr(1, 1, 1, 1, 1, 1);
+
+        miopen::ConvolutionContext context;
+        construct_params.mloCopyTo(context);
+        std::ostringstream ss;
+        ss << context;
+        return ss.str();
+    };
+    CHECK(key(true) != key(false));
+    CHECK(key(true).find("NHWC") != std::string::npos);
+}
+
+void test_conv(std::vector<int> in_lens, std::vector<int> wei_lens, int pad, int stride)
+{
+    auto&& handle = get_handle();
+    miopen::ConvolutionDescriptor filter(pad, pad, stride, stride);
+    auto x_desc     = make_desc(in_lens, true);
+    auto w_desc     = make_desc(wei_lens, false);
+    auto out_lens_t = filter.GetForwardOutputTensor(x_desc, w_desc).GetLengths();
+    std::vector<int> out_lens(out_lens_t.begin(), out_lens_t.end());
+    auto y_desc = make_desc(out_lens, true);
+
+    auto x = half_exact_data(x_desc.GetElementSize(), 0);
+    auto w = half_exact_data(w_desc.GetElementSize(), 1);
+    std::vector<float> expected(y_desc.GetElementSize());
+    cpu_conv_problem p{in_lens[0],
+                       in_lens[1],
+                       in_lens[2],
+                       in_lens[3],
+                       wei_lens[0],
+                       wei_lens[2],
+                       wei_lens[3],
+                       out_lens[2],
+                       out_lens[3],
+                       pad,
+                       pad,
+                       stride,
+                       stride,
+                       1,
+                       1};
+    cpu_convolution_forward(p, x.data(), w.data(), expected.data());
+
+    auto x_dev = handle.Write(reorder(x, x_desc));
+    auto w_dev = handle.Write(w);
+    auto y_dev = handle.Create<float>(expected.size());
+
+    size_t workspace_size = filter.ForwardGetWorkSpaceSize(handle, w_desc, x_desc, y_desc);
+    CHECK(workspace_size > 0);
+    auto workspace_dev = handle.Create<char>(workspace_size);
+
+    auto run = [&](miopenConvFwdAlgorithm_t algo) {
+        float alpha = 1, beta = 0;
+        filter.ConvolutionForward(handle,
+                                  &alpha,
+                                  x_desc,
+                                  x_dev.get(),
+                                  w_desc,
+                                  w_dev.get(),
+                                  algo,
+                                  &beta,
+                                  y_desc,
+                                  y_dev.get(),
+                                  workspace_dev.get(),
+                                  workspace_size);
+        return handle.Read<float>(y_dev, expected.size());
+    };
+
+#if MIOPEN_USE_MIOPENGEMM
+    int ret_algo_count;
+    miopenConvAlgoPerf_t perf[4];
+    filter.FindConvFwdAlgorithm(handle,
+                                x_desc,
+                                x_dev.get(),
+                                w_desc,
+                                w_dev.get(),
+                                y_desc,
+                                y_dev.get(),
+                                4,
+                                &ret_algo_count,
+                                perf,
+                                workspace_dev.get(),
+                                workspace_size,
+                                false);
+    CHECK(ret_algo_count == 1);
+    CHECK(perf[0].fwd_algo == miopenConvolutionFwdAlgoGEMM);
+
+    check(run(miopenConvolutionFwdAlgoGEMM), reorder(expected, y_desc));
+#endif
+    CHECK(throws([&] { run(miopenConvolutionFwdAlgoDirect); }));
+}
+
+// Runs the same pooling on NCHW and NHWC copies of the input and compares both directions
+void test_pooling(miopenPoolingMode_t mode, std::vector<int> in_lens, int window, int stride)
+{
+    auto&& handle = get_handle();
+    miopen::PoolingDescriptor filter{
+        mode, miopenPaddingDefault, {window, window}, {stride, stride}, {0, 0}};
+
+    auto y_lens_t = filter.GetForwardOutputTensor(make_desc(in_lens, false)).GetLengths();
+    std::vector<int> y_lens(y_lens_t.begin(), y_lens_t.end());
+    auto x  = half_exact_data(make_desc(in_lens, false).GetElementSize(), 2);
+    auto dy = half_exact_data(make_desc(y_lens, false).GetElementSize(), 3);
+
+    auto run = [&](bool nhwc) {
+        auto x_desc = make_desc(in_lens, nhwc);
+        auto y_desc = make_desc(y_lens, nhwc);
+
+        auto x_dev         = handle.Write(reorder(x, x_desc));
+        auto y_dev         = handle.Create<float>(dy.size());
+        auto dy_dev        = handle.Write(reorder(dy, y_desc));
+        auto dx_dev        = handle.Create<float>(x.size());
+        auto workspace_dev = handle.Create<uint8_t>(filter.GetWorkSpaceSize(y_desc));
+
+        float alpha = 1, beta = 0;
+        filter.Forward(handle,
+                       &alpha,
+                       x_desc,
+                       x_dev.get(),
+                       &beta,
+                       y_desc,
+                       y_dev.get(),
+                       true,
+                       workspace_dev.get(),
+                       filter.GetWorkSpaceSize(y_desc));
+        filter.Backward(handle,
+                        &alpha,
+                        y_desc,
+                        y_dev.get(),
+                        y_desc,
+                        dy_dev.get(),
+                        x_desc,
+                        x_dev.get(),
+                        &beta,
+                        x_desc,
+                        dx_dev.get(),
+                        workspace_dev.get());
+
+        return std::make_pair(handle.Read<float>(y_dev, dy.size()),
+                              handle.Read<float>(dx_dev, x.size()));
+    };
+
+    auto nchw = run(false);
+    auto nhwc = run(true);
+    check(nhwc.first, reorder(nchw.first, make_desc(y_lens, true)));
+    check(nhwc.second, reorder(nchw.second, make_desc(in_lens, true)));
+}
+
+int main()
+{
+    test_layout();
+    test_problem_key();
+    test_conv({2, 8, 12, 12}, {6, 8, 3, 3}, 1, 1);
+    test_conv({2, 16, 7, 7}, {8, 16, 1, 1}, 0, 1);
+    test_conv({1, 3, 17, 15}, {4, 3, 5, 5}, 2, 2);
+    test_pooling(miopenPoolingMax, {2, 5, 12, 12}, 2, 2);
+    test_pooling(miopenPoolingMax, {1, 3, 13, 11}, 3, 2);
+    test_pooling(miopenPoolingAverage, {2, 5, 12, 12}, 2, 2);
+    test_pooling(miopenPoolingAverage, {1, 3, 13, 11}, 3, 1);
+}
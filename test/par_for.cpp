@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "bench.hpp"
+#include "ford.hpp"
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Checks the pooled par_for. With --bench it also compares a sweep of small
+// parallel loops against spawning fresh threads for every loop, which is what
+// par_for used to do.
+
+template <class F>
+void spawn_par_for(std::size_t n, std::size_t min_grain, F f)
+{
+    const std::size_t threadsize =
+        std::min<std::size_t>(std::thread::hardware_concurrency(), n / min_grain);
+    if(threadsize <= 1)
+    {
+        for(std::size_t i = 0; i < n; i++)
+            f(i);
+        return;
+    }
+    std::vector<joinable_thread> threads;
+    const std::size_t grainsize = (n + threadsize - 1) / threadsize;
+    for(std::size_t start = 0; start < n; start += grainsize)
+    {
+        threads.emplace_back([=] {
+            for(std::size_t i = start; i < std::min(n, start + grainsize); i++)
+                f(i);
+        });
+    }
+}
+
+void check_each_index_once(std::size_t n, std::size_t min_grain)
+{
+    std::vector<std::atomic<int>> visits(n);
+    for(auto& v : visits)
+        v = 0;
+    par_for(n, min_grain, [&](std::size_t i) { visits[i]++; });
+    CHECK(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) {
+        return v == 1;
+    }));
+}
+
+void check_nested()
+{
+    std::atomic<std::size_t> total{0};
+    par_for(64, 1, [&](std::size_t) { par_for(100, 1, [&](std::size_t i) { total += i; }); });
+    CHECK(total == 64 * 4950);
+
+    std::vector<int> grid(13 * 17 * 5, 0);
+    par_ford(13, 17, 5)([&](int i, int j, int k) { grid[(i * 17 + j) * 5 + k]++; });
+    CHECK(std::all_of(grid.begin(), grid.end(), [](int x) { return x == 1; }));
+}
+
+void check_exception()
+{
+    bool caught = false;
+    try
+    {
+        par_for(1000, 1, [](std::size_t i) {
+            if(i == 500)
+                throw std::runtime_error("par_for");
+        });
+    }
+    catch(const std::runtime_error&)
+    {
+        caught = true;
+    }
+    CHECK(caught);
+    // The pool is still usable afterwards.
+    check_each_index_once(1000, 1);
+}
+
+// Mimics a verification sweep: many small loops whose iterations are uneven,
+// like the border rows of a padded convolution.
+template <class ParFor>
+double sweep(ParFor pf)
+{
+    std::atomic<std::size_t> sink{0};
+    return time_ms([&] {
+        for(int c = 0; c < 2000; c++)
+        {
+            pf(64, 1, [&](std::size_t i) {
+                std::size_t x     = 0;
+                std::size_t count = (i < 8) ? 4000 : 200;
+                for(std::size_t j = 0; j < count; j++)
+                    x += j * i;
+                sink += x;
+            });
+        }
+    });
+}
+
+int main(int argc, const char* argv[])
+{
+    for(std::size_t n : {0, 1, 7, 64, 1000, 100003})
+    {
+        check_each_index_once(n, 1);
+        check_each_index_once(n, 8);
+    }
+    check_nested();
+    check_exception();
+
+    if(!bench_requested(argc, argv))
+        return 0;
+
+    double spawn = sweep([](std::size_t n, std::size_t g, std::function<void(std::size_t)> f) {
+        spawn_par_for(n, g, f);
+    });
+    double pool = sweep([](std::size_t n, std::size_t g, std::function<void(std::size_t)> f) {
+        par_for(n, g, f);
+    });
+    std::cout << "2000 small parallel loops on " << get_par_for_pool().size()
+              << " threads: spawning " << spawn << " ms, pool " << pool << " ms" << std::endl;
+}
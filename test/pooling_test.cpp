@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include "test.hpp"
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <iterator>
@@ -48,6 +49,65 @@ tensor<T> get_output_tensor(const miopen::PoolingDescriptor& filter, const tenso
     return tensor<T>{filter.GetForwardOutputTensor(input.desc)};
 }
 
+// Values the destination holds before the call, so that beta has something to blend with
+template <class T>
+void fill_blend_destination(tensor<T>& t)
+{
+    t.generate([](int n, int c, int h, int w) { return T((n + 3 * c + 5 * h + 7 * w) % 11) - 5; });
+}
+
+// The argmax index max pooling saved in the workspace for output element i
+inline std::ptrdiff_t
+get_index(const std::vector<char>& workspace, miopenIndexType_t index_type, std::size_t i)
+{
+    switch(index_type)
+    {
+    case miopenIndexUint8: return reinterpret_cast<const uint8_t*>(workspace.data())[i];
+    case miopenIndexUint16: return reinterpret_cast<const uint16_t*>(workspace.data())[i];
+    case miopenIndexUint32: return reinterpret_cast<const uint32_t*>(workspace.data())[i];
+    }
+    throw std::runtime_error("Unknown pooling index type");
+}
+
+// Index of the first maximum in the window of output (n, c, i, j), which is the one max pooling
+// saves. Used when the forward pass saves no indices because the backward pass recomputes them.
+template <class T>
+std::ptrdiff_t first_max_index(const tensor<T>& input,
+                               const miopen::PoolingDescriptor& filter,
+                               int n,
+                               int c,
+                               int i,
+                               int j)
+{
+    int in_h, in_w;
+    std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
+
+    int u, v, pad_h, pad_w, window_h, window_w;
+    std::tie(u, v)               = miopen::tien<2>(filter.GetStrides());
+    std::tie(pad_h, pad_w)       = miopen::tien<2>(filter.GetPads());
+    std::tie(window_h, window_w) = miopen::tien<2>(filter.GetLengths());
+
+    std::ptrdiff_t idx = std::numeric_limits<std::ptrdiff_t>::max();
+    T max_val          = std::numeric_limits<T>::lowest();
+    ford(window_h, window_w)([&](int x, int y) {
+        const int in_y = i * v - pad_h + x;
+        const int in_x = j * u - pad_w + y;
+        if(in_y >= 0 && in_x >= 0 && in_y < in_h && in_x < in_w &&
+           input(n, c, in_y, in_x) > max_val)
+        {
+            max_val = input(n, c, in_y, in_x);
+            idx     = x * window_w + y;
+        }
+    });
+    return idx;
+}
+
+// Device copy of the workspace, which may be empty
+inline miopen::Allocator::ManageDataPtr write_workspace(const std::vector<char>& workspace)
+{
+    return get_handle().Write(workspace.empty() ? std::vector<char>(1) : workspace);
+}
+
 template <class T>
 struct pooling_operators
 {
@@ -81,11 +141,16 @@ struct pooling_operators
 
 struct verify_forward_pooling
 {
+    float blend_alpha = 1;
+    float blend_beta  = 0;
+
     template <class T>
     tensor<T>
-    cpu(const tensor<T>& input, const miopen::PoolingDescriptor& filter, std::vector<uint8_t>&)
+    cpu(const tensor<T>& input, const miopen::PoolingDescriptor& filter, std::vector<char>&)
     {
         auto out = get_output_tensor(filter, input);
+        auto dst = out;
+        fill_blend_destination(dst);
 
         int in_h, in_w;
         std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
@@ -115,7 +180,8 @@ struct verify_forward_pooling
                     acc = op(acc, input(o, w, in_x, in_y));
                 }
             });
-            out(o, w, i, j) = op.final(acc, pool_size);
+            out(o, w, i, j) =
+                blend_alpha * op.final(acc, pool_size) + blend_beta * dst(o, w, i, j);
         });
         return out;
     }
@@ -123,30 +189,31 @@ struct verify_forward_pooling
     template <class T>
     tensor<T> gpu(const tensor<T>& input,
                   const miopen::PoolingDescriptor& filter,
-                  std::vector<uint8_t>& indices)
+                  std::vector<char>& workspace)
     {
         auto&& handle = get_handle();
         auto out      = get_output_tensor(filter, input);
-        indices.resize(out.data.size(), 0);
+        workspace.resize(filter.GetWorkSpaceSize(out.desc), 0);
+        fill_blend_destination(out);
 
         auto in_dev        = handle.Write(input.data);
-        auto out_dev       = handle.Create<T>(out.data.size());
-        auto workspace_dev = handle.Write(indices);
+        auto out_dev       = handle.Write(out.data);
+        auto workspace_dev = write_workspace(workspace);
 
-        float alpha = 1, beta = 0;
         filter.Forward(handle,
-                       &alpha,
+                       &blend_alpha,
                        input.desc,
                        in_dev.get(),
-                       &beta,
+                       &blend_beta,
                        out.desc,
                        out_dev.get(),
                        true,
-                       workspace_dev.get(),
-                       indices.size() * sizeof(uint8_t));
+                       workspace.empty() ? nullptr : workspace_dev.get(),
+                       workspace.size());
 
-        indices  = handle.Read<uint8_t>(workspace_dev, indices.size());
-        out.data = handle.Read<T>(out_dev, out.data.size());
+        if(!workspace.empty())
+            workspace = handle.Read<char>(workspace_dev, workspace.size());
+        out.data  = handle.Read<T>(out_dev, out.data.size());
         return out;
     }
 
@@ -154,7 +221,7 @@ struct verify_forward_pooling
     void fail(float,
               const tensor<T>& input,
               const miopen::PoolingDescriptor& filter,
-              const std::vector<uint8_t>&)
+              const std::vector<char>&)
     {
         std::cout << "Forward pooling: ";
         if(filter.GetMode() == miopenPoolingAverage)
@@ -162,6 +229,7 @@ struct verify_forward_pooling
         else
             std::cout << "Max";
         std::cout << std::endl;
+        std::cout << "Blend: alpha=" << blend_alpha << ", beta=" << blend_beta << std::endl;
         std::cout << "Lengths: ";
         miopen::LogRange(std::cout, filter.GetLengths(), ", ") << std::endl;
         std::cout << "Pads: ";
@@ -176,16 +244,23 @@ struct verify_forward_pooling
 
 struct verify_backward_pooling
 {
+    float blend_alpha = 1;
+    float blend_beta  = 0;
+    // Max pooling recomputes the argmax from x instead of reading the workspace
+    bool index_free = false;
+
     template <class T>
     tensor<T> cpu(const tensor<T>& input,
                   const tensor<T>& dout,
                   const tensor<T>& out,
                   const miopen::PoolingDescriptor& filter,
-                  const std::vector<uint8_t>& indices)
+                  const std::vector<char>& workspace)
     {
         auto dinput = input;
         CHECK(dout.desc == out.desc);
         std::fill(dinput.begin(), dinput.end(), 0.0);
+        auto dst = dinput;
+        fill_blend_destination(dst);
 
         int in_h, in_w;
         std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(dinput.desc.GetLengths());
@@ -202,7 +277,10 @@ struct verify_backward_pooling
             if(filter.GetMode() == miopenPoolingMax)
             {
                 ford(out_h, out_w)([&](int i, int j) {
-                    auto idx   = indices.at(dout.desc.GetIndex(o, w, i, j));
+                    auto idx   = workspace.empty() ? first_max_index(input, filter, o, w, i, j)
+                                                     : get_index(workspace,
+                                                                 filter.GetWorkSpaceIndexType(),
+                                                                 dout.desc.GetIndex(o, w, i, j));
                     auto idx_h = idx / window_w;
                     auto idx_w = idx % window_w;
                     auto in_y  = i * v - pad_h + idx_h;
@@ -234,6 +312,9 @@ struct verify_backward_pooling
                 });
             }
         });
+        dinput.par_for_each([&](int o, int w, int i, int j) {
+            dinput(o, w, i, j) = blend_alpha * dinput(o, w, i, j) + blend_beta * dst(o, w, i, j);
+        });
         return dinput;
     }
 
@@ -242,23 +323,21 @@ struct verify_backward_pooling
                   const tensor<T>& dout,
                   const tensor<T>& out,
                   const miopen::PoolingDescriptor& filter,
-                  const std::vector<uint8_t>& indices)
+                  const std::vector<char>& workspace)
     {
         auto&& handle = get_handle();
         auto dinput   = input;
+        fill_blend_destination(dinput);
 
         auto in_dev   = handle.Write(input.data);
         auto dout_dev = handle.Write(dout.data);
         auto out_dev  = handle.Write(out.data);
-        auto din_dev  = handle.Create<T>(dinput.data.size());
+        auto din_dev  = handle.Write(dinput.data);
 
-        // std::vector<char> workspace(filter.GetWorkSpaceSize(out.desc));
-        // auto workspace_dev = handle.Write(workspace);
-        auto workspace_dev = handle.Write(indices);
+        auto workspace_dev = write_workspace(workspace);
 
-        float alpha = 1, beta = 0;
         filter.Backward(handle,
-                        &alpha,
+                        &blend_alpha,
                         // y
                         out.desc,
                         out_dev.get(),
@@ -268,11 +347,11 @@ struct verify_backward_pooling
                         // x
                         input.desc,
                         in_dev.get(),
-                        &beta,
+                        &blend_beta,
                         // dx
                         dinput.desc,
                         din_dev.get(),
-                        workspace_dev.get());
+                        index_free || workspace.empty() ? nullptr : workspace_dev.get());
 
         dinput.data = handle.Read<T>(din_dev, dinput.data.size());
         return dinput;
@@ -284,7 +363,7 @@ struct verify_backward_pooling
               const tensor<T>&,
               const tensor<T>& out,
               const miopen::PoolingDescriptor& filter,
-              const std::vector<uint8_t>&)
+              const std::vector<char>&)
     {
         std::cout << "Backward pooling: ";
         if(filter.GetMode() == miopenPoolingAverage)
@@ -292,6 +371,9 @@ struct verify_backward_pooling
         else
             std::cout << "Max";
         std::cout << std::endl;
+        std::cout << "Blend: alpha=" << blend_alpha << ", beta=" << blend_beta << std::endl;
+        std::cout << "Index type: " << filter.GetIndexType()
+                  << (index_free ? ", index free" : "") << std::endl;
         std::cout << "Lengths: ";
         miopen::LogRange(std::cout, filter.GetLengths(), ", ") << std::endl;
         std::cout << "Pads: ";
@@ -312,6 +394,9 @@ struct pooling_driver : test_driver
     std::vector<int> strides;
     std::string mode;
     std::string pmode;
+    std::string index_type;
+    double blend_alpha = 1;
+    double blend_beta  = 0;
     std::unordered_map<std::string, miopenPoolingMode_t> mode_lookup = {
         {"MAX", miopenPoolingMax},
         {"MIOPENPOOLINGMAX", miopenPoolingMax},
@@ -325,6 +410,12 @@ struct pooling_driver : test_driver
         {"VALID", miopenPaddingValid},
     };
 
+    std::unordered_map<std::string, miopenIndexType_t> index_type_lookup = {
+        {"UINT8", miopenIndexUint8},
+        {"UINT16", miopenIndexUint16},
+        {"UINT32", miopenIndexUint32},
+    };
+
     pooling_driver()
     {
         add(input, "input", get_input_tensor());
@@ -333,6 +424,37 @@ struct pooling_driver : test_driver
         add(pads, "pads", generate_data({{0, 0}, {1, 1}}));
         add(mode, "mode", generate_data({"miopenPoolingMax", "miopenPoolingAverage"}));
         add(pmode, "pmode", generate_data({"default", "same", "valid"}));
+        add(index_type, "index-type", generate_data({"uint8", "uint32"}));
+        add(blend_alpha, "blend-alpha", generate_data({1.0, 0.5}));
+        add(blend_beta, "blend-beta", generate_data({0.0, 1.0}));
+    }
+
+    // A workspace smaller than the saved indices need, like the 8-bit size of the V1 query used
+    // with wider indices, is rejected instead of overrun
+    void check_short_workspace(const miopen::PoolingDescriptor& filter) const
+    {
+        auto out                  = get_output_tensor(filter, input);
+        const std::size_t ws_size = filter.GetWorkSpaceSize(out.desc);
+        if(ws_size == 0)
+            return;
+
+        auto&& handle      = get_handle();
+        auto in_dev        = handle.Write(input.data);
+        auto out_dev       = handle.Write(out.data);
+        auto workspace_dev = handle.Write(std::vector<char>(ws_size));
+        float alpha = 1, beta = 0;
+        CHECK(throws([&] {
+            filter.Forward(handle,
+                           &alpha,
+                           input.desc,
+                           in_dev.get(),
+                           &beta,
+                           out.desc,
+                           out_dev.get(),
+                           true,
+                           workspace_dev.get(),
+                           ws_size - 1);
+        }));
     }
 
     void run()
@@ -345,6 +467,10 @@ struct pooling_driver : test_driver
                                          lens,
                                          strides,
                                          pads};
+        filter.SetIndexType(index_type_lookup.at(miopen::ToUpper(index_type)));
+        // Only max pooling saves indices
+        if(filter.GetMode() != miopenPoolingMax && filter.GetIndexType() != miopenIndexUint8)
+            return;
 
         std::tie(window_h, window_w) = miopen::tien<2>(filter.GetLengths());
         if(filter.pmode == miopenPaddingSame)
@@ -381,15 +507,62 @@ struct pooling_driver : test_driver
                 return;
         }
 
-        std::vector<uint8_t> indices{};
-        auto out  = verify(verify_forward_pooling{}, input, filter, indices);
+        run(filter);
+
+        // Once per input and mode: a window over the whole plane, which the global pooling kernel
+        // computes
+        if(filter.pmode == miopenPaddingDefault && lens == strides &&
+           std::all_of(pads.begin(), pads.end(), [](int p) { return p == 0; }))
+        {
+            miopen::PoolingDescriptor global{
+                filter.GetMode(), miopenPaddingDefault, {in_h, in_w}, {1, 1}, {0, 0}};
+            global.SetIndexType(filter.GetIndexType());
+            // Windows of 255 elements or more do not fit 8 bit indices
+            CHECK(in_h * in_w < 255 || global.GetWorkSpaceIndexType() != miopenIndexUint8);
+            run(global);
+        }
+    }
+
+    void run(const miopen::PoolingDescriptor& filter)
+    {
+        check_short_workspace(filter);
+
+        // The unblended output is the y the backward pass is computed from
+        std::vector<char> workspace{};
+        auto out = verify(verify_forward_pooling{}, input, filter, workspace);
+        if(!miopen::float_equal(blend_alpha, 1) || !miopen::float_equal(blend_beta, 0))
+        {
+            std::vector<char> blend_workspace{};
+            verify(verify_forward_pooling{float(blend_alpha), float(blend_beta)},
+                   input,
+                   filter,
+                   blend_workspace);
+        }
+        // Always cover the read-modify-write of the destination, the sweep starts unblended
+        std::vector<char> rmw_workspace{};
+        verify(verify_forward_pooling{0.5, 1}, input, filter, rmw_workspace);
         auto dout = out.first;
         dout.generate([&](int n, int c, int h, int w) {
             T x      = out.first(n, c, h, w);
             double y = (877 * n + 547 * c + 701 * h + 1049 * w + static_cast<int>(769 * x)) % 2503;
             return ((x * y) / 1301.0);
         });
-        verify(verify_backward_pooling{}, input, dout, out.first, filter, indices);
+        verify(verify_backward_pooling{float(blend_alpha), float(blend_beta)},
+               input,
+               dout,
+               out.first,
+               filter,
+               workspace);
+        verify(verify_backward_pooling{0.5, 1}, input, dout, out.first, filter, workspace);
+        if(filter.GetMode() == miopenPoolingMax)
+        {
+            verify(verify_backward_pooling{float(blend_alpha), float(blend_beta), true},
+                   input,
+                   dout,
+                   out.first,
+                   filter,
+                   workspace);
+        }
     }
 };
 
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include <miopen/softmax.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+std::vector<float> make_data(std::size_t size, std::size_t seed)
+{
+    std::vector<float> result(size);
+    for(std::size_t i = 0; i < size; i++)
+        result[i] = float((i * 613 + seed * 547) % 29) / 4.0f - 3.0f;
+    return result;
+}
+
+bool near(float gpu, double cpu) { return std::fabs(gpu - cpu) <= 1e-4 * (1.0 + std::fabs(cpu)); }
+
+// Host softmax over one axis, the tensor is viewed as outer x c x inner
+struct softmax_case
+{
+    std::vector<std::size_t> lens;
+    int axis;
+    miopenSoftmaxAlgorithm_t algorithm;
+    float alpha;
+    float beta;
+
+    std::size_t outer() const
+    {
+        return std::accumulate(
+            lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    std::size_t inner() const
+    {
+        return std::accumulate(
+            lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    std::vector<double> forward(const std::vector<float>& x) const
+    {
+        const std::size_t c = lens[axis];
+        std::vector<double> y(x.size());
+        for(std::size_t o = 0; o < outer(); o++)
+        {
+            for(std::size_t s = 0; s < inner(); s++)
+            {
+                auto idx    = [&](std::size_t i) { return (o * c + i) * inner() + s; };
+                double xmax = x[idx(0)];
+                for(std::size_t i = 0; i < c; i++)
+                    xmax = std::max<double>(xmax, x[idx(i)]);
+                double sum = 0;
+                for(std::size_t i = 0; i < c; i++)
+                    sum += std::exp(x[idx(i)] - xmax);
+                for(std::size_t i = 0; i < c; i++)
+                {
+                    y[idx(i)] = algorithm == miopenSoftmaxLog ? x[idx(i)] - xmax - std::log(sum)
+                                                              : std::exp(x[idx(i)] - xmax) / sum;
+                }
+            }
+        }
+        return y;
+    }
+
+    std::vector<double> backward(const std::vector<double>& y, const std::vector<float>& dy) const
+    {
+        const std::size_t c = lens[axis];
+        std::vector<double> dx(y.size());
+        for(std::size_t o = 0; o < outer(); o++)
+        {
+            for(std::size_t s = 0; s < inner(); s++)
+            {
+                auto idx   = [&](std::size_t i) { return (o * c + i) * inner() + s; };
+                double dot = 0;
+                for(std::size_t i = 0; i < c; i++)
+                    dot += algorithm == miopenSoftmaxLog ? dy[idx(i)] : y[idx(i)] * dy[idx(i)];
+                for(std::size_t i = 0; i < c; i++)
+                {
+                    dx[idx(i)] = algorithm == miopenSoftmaxLog
+                                     ? dy[idx(i)] - std::exp(y[idx(i)]) * dot
+                                     : y[idx(i)] * (dy[idx(i)] - dot);
+                }
+            }
+        }
+        return dx;
+    }
+
+    void run() const
+    {
+        auto&& handle = get_handle();
+        std::vector<int> ilens(lens.begin(), lens.end());
+        miopen::TensorDescriptor desc{miopenFloat, ilens.data(), static_cast<int>(ilens.size())};
+        const auto size = desc.GetElementSize();
+
+        auto x      = make_data(size, 1);
+        auto y_init = make_data(size, 2);
+        auto dy     = make_data(size, 3);
+
+        auto x_dev = handle.Write(x);
+        auto y_dev = handle.Write(y_init);
+        miopen::SoftmaxForward(
+            handle, &alpha, desc, x_dev.get(), &beta, desc, y_dev.get(), algorithm, axis);
+        auto y = handle.Read<float>(y_dev, size);
+
+        auto y_ref = forward(x);
+        for(std::size_t i = 0; i < size; i++)
+            CHECK(near(y[i], alpha * y_ref[i] + beta * y_init[i]));
+
+        // Backward from the unblended output
+        const float one = 1, zero = 0;
+        std::vector<float> y_fwd(y_ref.begin(), y_ref.end());
+        auto y_fwd_dev = handle.Write(y_fwd);
+        auto dy_dev    = handle.Write(dy);
+        auto dx_dev    = handle.Write(y_init);
+        miopen::SoftmaxBackward(handle,
+                                &alpha,
+                                desc,
+                                y_fwd_dev.get(),
+                                desc,
+                                dy_dev.get(),
+                                &beta,
+                                desc,
+                                dx_dev.get(),
+                                algorithm,
+                                axis);
+        auto dx = handle.Read<float>(dx_dev, size);
+
+        auto dx_ref = backward(y_ref, dy);
+        for(std::size_t i = 0; i < size; i++)
+            CHECK(near(dx[i], alpha * dx_ref[i] + beta * y_init[i]));
+
+        // In place forward gives the same result
+        miopen::SoftmaxForward(
+            handle, &one, desc, x_dev.get(), &zero, desc, x_dev.get(), algorithm, axis);
+        auto x_out = handle.Read<float>(x_dev, size);
+        for(std::size_t i = 0; i < size; i++)
+            CHECK(near(x_out[i], y_ref[i]));
+    }
+};
+
+int main()
+{
+    const std::vector<softmax_case> cases = {
+        // Channel axis on both the CSR-Stream and CSR-Vector paths
+        {{4, 10, 3, 5}, 1, miopenSoftmaxLog, 1, 0},
+        {{2, 300, 2, 2}, 1, miopenSoftmaxLog, 1, 0},
+        {{4, 10, 3, 5}, 1, miopenSoftmaxAccurate, 0.5, 0.25},
+        // Other axes and ranks
+        {{4, 10, 3, 5}, 3, miopenSoftmaxAccurate, 1, 0},
+        {{4, 10, 3, 5}, 0, miopenSoftmaxLog, 1, 0},
+        {{6, 7, 33}, 2, miopenSoftmaxLog, 2, -1},
+        {{1000}, 0, miopenSoftmaxAccurate, 1, 0},
+        // Few wide rows are split across workgroups
+        {{2, 20000}, 1, miopenSoftmaxAccurate, 1, 0},
+        {{3, 100000, 1, 1}, 1, miopenSoftmaxLog, 1, 0.5},
+    };
+    for(auto&& c : cases)
+        c.run();
+
+    // Bad axis
+    auto&& handle = get_handle();
+    miopen::TensorDescriptor desc{miopenFloat, {2, 3, 4, 5}};
+    auto data       = make_data(desc.GetElementSize(), 0);
+    auto dev        = handle.Write(data);
+    const float one = 1, zero = 0;
+    CHECK(throws([&] {
+        miopen::SoftmaxForward(
+            handle, &one, desc, dev.get(), &zero, desc, dev.get(), miopenSoftmaxAccurate, 4);
+    }));
+}
@@ -134,6 +134,12 @@ class SearchableTestSolver : public solver::SolverBase<ConvolutionContext>
 
 int SearchableTestSolver::_serches_done = 0;
 
+class BatchAgnosticTestSolver : public SearchableTestSolver
+{
+    public:
+    bool IsBatchAgnostic(const ConvolutionContext&) const { return true; }
+};
+
 class TrivialConstruct : public mlo_construct_direct2D
 {
     public:
@@ -192,9 +198,118 @@ class SolverTest
         });
         // Checking no more searches were done.
         EXPECT_EQUAL(searches, searchable_solver.searches_done());
+
+        DynamicBatchTest();
+        NearestProblemTest();
     }
 
     private:
+    static ConvolutionContext MakeContext(int batch_sz)
+    {
+        ConvolutionContext context;
+        context.n_inputs     = 16;
+        context.in_height    = 14;
+        context.in_width     = 14;
+        context.kernel_size0 = 3;
+        context.kernel_size1 = 3;
+        context.n_outputs    = 32;
+        context.out_height   = 14;
+        context.out_width    = 14;
+        context.batch_sz     = batch_sz;
+        context.in_layout    = "NCHW";
+        context.in_data_type = "FP32";
+        context.direction.Set(1);
+        return context;
+    }
+
+    static std::string GetKernelFile(const solver::ConvSolution& solution)
+    {
+        return solution.construction_params.front().kernel_file;
+    }
+
+    void DynamicBatchTest() const
+    {
+        TempFilePath db_file("/tmp/miopen.tests.solver.XXXXXX");
+        const std::string db_path = static_cast<const char*>(db_file);
+        const auto& id            = solver::SolverDbId(BatchAgnosticTestSolver{});
+
+        std::ostringstream key;
+        MakeContext(8).Serialize(key);
+        ProblemDescription parsed;
+        EXPECT(parsed.ParseKey(key.str()));
+        std::ostringstream reserialized;
+        parsed.Serialize(reserialized);
+        EXPECT_EQUAL(key.str(), reserialized.str());
+        EXPECT(!parsed.ParseKey("16-14-14"));
+
+        TestConfig b8, b32;
+        b8.str  = "b8";
+        b32.str = "b32";
+        EXPECT(DbRecord(db_path, MakeContext(8)).Store(id, b8));
+        EXPECT(DbRecord(db_path, MakeContext(32)).Store(id, b32));
+
+        const auto find = [&](auto solver, int batch_sz) {
+            const auto context = MakeContext(batch_sz);
+            DbRecord record(db_path, context);
+            return GetKernelFile(solver::FindSolution(solver, context, record));
+        };
+
+        // Untuned batch sizes fall back to the nearest tuned one
+        EXPECT_EQUAL(find(BatchAgnosticTestSolver{}, 8), b8.str);
+        EXPECT_EQUAL(find(BatchAgnosticTestSolver{}, 10), b8.str);
+        EXPECT_EQUAL(find(BatchAgnosticTestSolver{}, 24), b32.str);
+        // Beyond the bound and for solvers that depend on the batch size there is no fallback
+        EXPECT_EQUAL(find(BatchAgnosticTestSolver{}, 128),
+                     SearchableTestSolver::NoSearchFileName());
+        EXPECT_EQUAL(find(SearchableTestSolver{}, 10), SearchableTestSolver::NoSearchFileName());
+    }
+
+    void NearestProblemTest() const
+    {
+        TempFilePath db_file("/tmp/miopen.tests.solver.XXXXXX");
+        const std::string db_path = static_cast<const char*>(db_file);
+        const auto& id            = solver::SolverDbId(SearchableTestSolver{});
+
+        const auto resize = [](ConvolutionContext context, int size, int channels) {
+            context.in_height = context.in_width = context.out_height = context.out_width = size;
+            context.n_inputs = context.n_outputs = channels;
+            return context;
+        };
+        auto filter5         = MakeContext(8);
+        filter5.kernel_size0 = filter5.kernel_size1 = 5;
+
+        EXPECT(MakeContext(8).Distance(MakeContext(8)) == 0);
+        EXPECT(MakeContext(8).Distance(filter5) < 0);
+        EXPECT(MakeContext(8).Distance(MakeContext(4)) ==
+               MakeContext(4).Distance(MakeContext(8)));
+        EXPECT(MakeContext(8).Distance(MakeContext(4)) <
+               MakeContext(8).Distance(resize(MakeContext(8), 7, 16)));
+
+        TestConfig small, large, wide;
+        small.str = "small";
+        large.str = "large";
+        wide.str  = "wide";
+        EXPECT(DbRecord(db_path, resize(MakeContext(8), 14, 16)).Store(id, small));
+        EXPECT(DbRecord(db_path, resize(MakeContext(8), 56, 64)).Store(id, large));
+        EXPECT(DbRecord(db_path, filter5).Store(id, wide));
+
+        const auto nearest = [&](const ConvolutionContext& context) {
+            DbRecord record(db_path, context);
+            TestConfig config;
+            if(!solver::LoadNearestProblem(SearchableTestSolver{}, context, record, config))
+                return std::string{};
+            return config.str;
+        };
+
+        EXPECT_EQUAL(nearest(resize(MakeContext(4), 15, 16)), small.str);
+        EXPECT_EQUAL(nearest(resize(MakeContext(16), 48, 64)), large.str);
+        filter5.batch_sz = 2;
+        EXPECT_EQUAL(nearest(filter5), wide.str);
+        auto filter7         = MakeContext(8);
+        filter7.kernel_size0 = filter7.kernel_size1 = 7;
+        EXPECT_EQUAL(nearest(filter7), std::string{});
+    }
+
     void ConstructTest(const char* db_path,
                        const char* expected_kernel,
                        std::function<void(mlo_construct_direct2D&)> context_filler) const
@@ -211,4 +326,8 @@ class SolverTest
 } // namespace tests
 } // namespace miopen
 
-int main() { miopen::tests::SolverTest().Run(); }
+int main()
+{
+    setenv("MIOPEN_CONV_DYNAMIC_BATCH", "64", 1);
+    miopen::tests::SolverTest().Run();
+}
@@ -0,0 +1,845 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// A stand-in for the OpenCL runtime with a single fake GPU. It is loaded with
+// LD_PRELOAD in front of the real ICD loader, so MIOpen runs unmodified while
+// programs are never compiled and kernels are never launched. Buffers live in
+// host memory, so writes and reads still round trip. Events complete at once
+// and report a zero length execution.
+//
+// This is only meant for measuring the host side of the API (see the overhead
+// driver), the numerical results are meaningless.
+
+#define CL_USE_DEPRECATED_OPENCL_1_2_APIS
+#include <CL/cl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct stub_object
+{
+    std::atomic<int> refs{1};
+    virtual ~stub_object() {}
+};
+
+struct _cl_platform_id
+{
+};
+
+struct _cl_device_id
+{
+};
+
+struct _cl_context : stub_object
+{
+};
+
+struct _cl_command_queue : stub_object
+{
+    cl_context context;
+    cl_device_id device;
+    cl_command_queue_properties properties;
+};
+
+struct _cl_mem : stub_object
+{
+    std::shared_ptr<std::vector<char>> storage;
+    cl_context context;
+    size_t offset;
+    size_t size;
+
+    char* data() { return storage->data() + offset; }
+};
+
+struct _cl_program : stub_object
+{
+    cl_context context;
+    std::string source;
+};
+
+struct _cl_kernel : stub_object
+{
+    cl_program program;
+    std::string name;
+    cl_uint num_args = 0;
+};
+
+struct _cl_event : stub_object
+{
+    cl_command_queue queue;
+    cl_ulong timestamp;
+};
+
+namespace {
+
+_cl_platform_id stub_platform;
+_cl_device_id stub_device;
+
+template <class T>
+cl_int retain(T* x)
+{
+    if(x == nullptr)
+        return CL_INVALID_VALUE;
+    ++x->refs;
+    return CL_SUCCESS;
+}
+
+template <class T>
+cl_int release(T* x)
+{
+    if(x == nullptr)
+        return CL_INVALID_VALUE;
+    if(--x->refs == 0)
+        delete x;
+    return CL_SUCCESS;
+}
+
+void set_error(cl_int* errcode_ret, cl_int status)
+{
+    if(errcode_ret != nullptr)
+        *errcode_ret = status;
+}
+
+cl_int get_bytes(const void* x,
+                 size_t n,
+                 size_t param_value_size,
+                 void* param_value,
+                 size_t* param_value_size_ret)
+{
+    if(param_value_size_ret != nullptr)
+        *param_value_size_ret = n;
+    if(param_value != nullptr)
+    {
+        if(param_value_size < n)
+            return CL_INVALID_VALUE;
+        std::memcpy(param_value, x, n);
+    }
+    return CL_SUCCESS;
+}
+
+template <class T>
+cl_int
+get_info(const T& x, size_t param_value_size, void* param_value, size_t* param_value_size_ret)
+{
+    return get_bytes(&x, sizeof(T), param_value_size, param_value, param_value_size_ret);
+}
+
+cl_int get_string(const std::string& x,
+                  size_t param_value_size,
+                  void* param_value,
+                  size_t* param_value_size_ret)
+{
+    return get_bytes(
+        x.c_str(), x.size() + 1, param_value_size, param_value, param_value_size_ret);
+}
+
+// Queries nobody looks at closely get zeros of whatever size was asked for.
+cl_int get_zeros(size_t param_value_size, void* param_value, size_t* param_value_size_ret)
+{
+    if(param_value_size_ret != nullptr)
+        *param_value_size_ret = param_value_size == 0 ? sizeof(cl_ulong) : param_value_size;
+    if(param_value != nullptr)
+        std::memset(param_value, 0, param_value_size);
+    return CL_SUCCESS;
+}
+
+cl_ulong now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+cl_int complete(cl_command_queue queue, cl_event* event)
+{
+    if(queue == nullptr)
+        return CL_INVALID_COMMAND_QUEUE;
+    if(event != nullptr)
+    {
+        auto e       = new _cl_event{};
+        e->queue     = queue;
+        e->timestamp = now();
+        *event       = e;
+    }
+    return CL_SUCCESS;
+}
+
+cl_mem create_buffer(cl_context context, size_t size)
+{
+    auto mem     = new _cl_mem{};
+    mem->storage = std::make_shared<std::vector<char>>(size);
+    mem->context = context;
+    mem->offset  = 0;
+    mem->size    = size;
+    return mem;
+}
+
+} // namespace
+
+extern "C" {
+
+CL_API_ENTRY cl_int CL_API_CALL clGetPlatformIDs(cl_uint num_entries,
+                                                 cl_platform_id* platforms,
+                                                 cl_uint* num_platforms)
+{
+    if(num_platforms != nullptr)
+        *num_platforms = 1;
+    if(platforms != nullptr && num_entries > 0)
+        platforms[0] = &stub_platform;
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetPlatformInfo(cl_platform_id,
+                                                  cl_platform_info param_name,
+                                                  size_t param_value_size,
+                                                  void* param_value,
+                                                  size_t* param_value_size_ret)
+{
+    switch(param_name)
+    {
+    case CL_PLATFORM_PROFILE:
+        return get_string("FULL_PROFILE", param_value_size, param_value, param_value_size_ret);
+    case CL_PLATFORM_VERSION:
+        return get_string("OpenCL 1.2 stub", param_value_size, param_value, param_value_size_ret);
+    case CL_PLATFORM_NAME:
+    case CL_PLATFORM_VENDOR:
+        return get_string("MIOpen stub", param_value_size, param_value, param_value_size_ret);
+    case CL_PLATFORM_EXTENSIONS:
+        return get_string("", param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetDeviceIDs(cl_platform_id,
+                                               cl_device_type,
+                                               cl_uint num_entries,
+                                               cl_device_id* devices,
+                                               cl_uint* num_devices)
+{
+    if(num_devices != nullptr)
+        *num_devices = 1;
+    if(devices != nullptr && num_entries > 0)
+        devices[0] = &stub_device;
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetDeviceInfo(cl_device_id,
+                                                cl_device_info param_name,
+                                                size_t param_value_size,
+                                                void* param_value,
+                                                size_t* param_value_size_ret)
+{
+    const size_t max_work_item_sizes[3] = {1024, 1024, 1024};
+    switch(param_name)
+    {
+    case CL_DEVICE_NAME:
+        return get_string("stub", param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_VENDOR:
+        return get_string("MIOpen stub", param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_VERSION:
+        return get_string("OpenCL 1.2 stub", param_value_size, param_value, param_value_size_ret);
+    case CL_DRIVER_VERSION:
+        return get_string("stub", param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_OPENCL_C_VERSION:
+        return get_string("OpenCL C 1.2", param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_PROFILE:
+        return get_string("FULL_PROFILE", param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_EXTENSIONS:
+    case CL_DEVICE_BUILT_IN_KERNELS:
+        return get_string("", param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_TYPE:
+        return get_info(cl_device_type{CL_DEVICE_TYPE_GPU},
+                        param_value_size,
+                        param_value,
+                        param_value_size_ret);
+    case CL_DEVICE_PLATFORM:
+        return get_info(
+            cl_platform_id{&stub_platform}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_COMPUTE_UNITS:
+        return get_info(cl_uint{64}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_CLOCK_FREQUENCY:
+        return get_info(cl_uint{1000}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_ADDRESS_BITS:
+        return get_info(cl_uint{64}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS:
+        return get_info(cl_uint{3}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_WORK_ITEM_SIZES:
+        return get_info(max_work_item_sizes, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_WORK_GROUP_SIZE:
+        return get_info(size_t{1024}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_LOCAL_MEM_SIZE:
+        return get_info(cl_ulong{65536}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_GLOBAL_MEM_SIZE:
+        return get_info(cl_ulong{1} << 34, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_MEM_ALLOC_SIZE:
+        return get_info(cl_ulong{1} << 32, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MEM_BASE_ADDR_ALIGN:
+        return get_info(cl_uint{2048}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_AVAILABLE:
+    case CL_DEVICE_COMPILER_AVAILABLE:
+    case CL_DEVICE_LINKER_AVAILABLE:
+    case CL_DEVICE_ENDIAN_LITTLE:
+        return get_info(cl_bool{CL_TRUE}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_QUEUE_PROPERTIES:
+        return get_info(cl_command_queue_properties{CL_QUEUE_PROFILING_ENABLE},
+                        param_value_size,
+                        param_value,
+                        param_value_size_ret);
+    default: return get_zeros(param_value_size, param_value, param_value_size_ret);
+    }
+}
+
+CL_API_ENTRY cl_context CL_API_CALL
+clCreateContext(const cl_context_properties*,
+                cl_uint,
+                const cl_device_id*,
+                void(CL_CALLBACK*)(const char*, const void*, size_t, void*),
+                void*,
+                cl_int* errcode_ret)
+{
+    set_error(errcode_ret, CL_SUCCESS);
+    return new _cl_context{};
+}
+
+CL_API_ENTRY cl_context CL_API_CALL
+clCreateContextFromType(const cl_context_properties*,
+                        cl_device_type,
+                        void(CL_CALLBACK*)(const char*, const void*, size_t, void*),
+                        void*,
+                        cl_int* errcode_ret)
+{
+    set_error(errcode_ret, CL_SUCCESS);
+    return new _cl_context{};
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainContext(cl_context context) { return retain(context); }
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseContext(cl_context context) { return release(context); }
+
+CL_API_ENTRY cl_int CL_API_CALL clGetContextInfo(cl_context context,
+                                                 cl_context_info param_name,
+                                                 size_t param_value_size,
+                                                 void* param_value,
+                                                 size_t* param_value_size_ret)
+{
+    if(context == nullptr)
+        return CL_INVALID_CONTEXT;
+    switch(param_name)
+    {
+    case CL_CONTEXT_NUM_DEVICES:
+        return get_info(cl_uint{1}, param_value_size, param_value, param_value_size_ret);
+    case CL_CONTEXT_DEVICES:
+        return get_info(
+            cl_device_id{&stub_device}, param_value_size, param_value, param_value_size_ret);
+    case CL_CONTEXT_REFERENCE_COUNT:
+        return get_info(
+            cl_uint(context->refs), param_value_size, param_value, param_value_size_ret);
+    default: return get_zeros(param_value_size, param_value, param_value_size_ret);
+    }
+}
+
+CL_API_ENTRY cl_command_queue CL_API_CALL
+clCreateCommandQueue(cl_context context,
+                     cl_device_id device,
+                     cl_command_queue_properties properties,
+                     cl_int* errcode_ret)
+{
+    if(context == nullptr)
+    {
+        set_error(errcode_ret, CL_INVALID_CONTEXT);
+        return nullptr;
+    }
+    auto queue        = new _cl_command_queue{};
+    queue->context    = context;
+    queue->device     = device;
+    queue->properties = properties;
+    set_error(errcode_ret, CL_SUCCESS);
+    return queue;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainCommandQueue(cl_command_queue queue)
+{
+    return retain(queue);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseCommandQueue(cl_command_queue queue)
+{
+    return release(queue);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetCommandQueueInfo(cl_command_queue queue,
+                                                      cl_command_queue_info param_name,
+                                                      size_t param_value_size,
+                                                      void* param_value,
+                                                      size_t* param_value_size_ret)
+{
+    if(queue == nullptr)
+        return CL_INVALID_COMMAND_QUEUE;
+    switch(param_name)
+    {
+    case CL_QUEUE_CONTEXT:
+        return get_info(queue->context, param_value_size, param_value, param_value_size_ret);
+    case CL_QUEUE_DEVICE:
+        return get_info(queue->device, param_value_size, param_value, param_value_size_ret);
+    case CL_QUEUE_PROPERTIES:
+        return get_info(queue->properties, param_value_size, param_value, param_value_size_ret);
+    case CL_QUEUE_REFERENCE_COUNT:
+        return get_info(cl_uint(queue->refs), param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_mem CL_API_CALL clCreateBuffer(
+    cl_context context, cl_mem_flags flags, size_t size, void* host_ptr, cl_int* errcode_ret)
+{
+    if(context == nullptr)
+    {
+        set_error(errcode_ret, CL_INVALID_CONTEXT);
+        return nullptr;
+    }
+    auto mem = create_buffer(context, size);
+    if(host_ptr != nullptr && (flags & CL_MEM_COPY_HOST_PTR) != 0)
+        std::memcpy(mem->data(), host_ptr, size);
+    set_error(errcode_ret, CL_SUCCESS);
+    return mem;
+}
+
+CL_API_ENTRY cl_mem CL_API_CALL clCreateSubBuffer(cl_mem buffer,
+                                                  cl_mem_flags,
+                                                  cl_buffer_create_type,
+                                                  const void* buffer_create_info,
+                                                  cl_int* errcode_ret)
+{
+    const auto* region = static_cast<const cl_buffer_region*>(buffer_create_info);
+    if(buffer == nullptr || region == nullptr || region->origin + region->size > buffer->size)
+    {
+        set_error(errcode_ret, CL_INVALID_VALUE);
+        return nullptr;
+    }
+    auto mem     = new _cl_mem{};
+    mem->storage = buffer->storage;
+    mem->context = buffer->context;
+    mem->offset  = buffer->offset + region->origin;
+    mem->size    = region->size;
+    set_error(errcode_ret, CL_SUCCESS);
+    return mem;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainMemObject(cl_mem mem) { return retain(mem); }
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseMemObject(cl_mem mem) { return release(mem); }
+
+CL_API_ENTRY cl_int CL_API_CALL clGetMemObjectInfo(cl_mem mem,
+                                                   cl_mem_info param_name,
+                                                   size_t param_value_size,
+                                                   void* param_value,
+                                                   size_t* param_value_size_ret)
+{
+    if(mem == nullptr)
+        return CL_INVALID_MEM_OBJECT;
+    switch(param_name)
+    {
+    case CL_MEM_SIZE:
+        return get_info(mem->size, param_value_size, param_value, param_value_size_ret);
+    case CL_MEM_OFFSET:
+        return get_info(mem->offset, param_value_size, param_value, param_value_size_ret);
+    case CL_MEM_CONTEXT:
+        return get_info(mem->context, param_value_size, param_value, param_value_size_ret);
+    default: return get_zeros(param_value_size, param_value, param_value_size_ret);
+    }
+}
+
+CL_API_ENTRY cl_program CL_API_CALL clCreateProgramWithSource(cl_context context,
+                                                              cl_uint count,
+                                                              const char** strings,
+                                                              const size_t* lengths,
+                                                              cl_int* errcode_ret)
+{
+    if(context == nullptr || strings == nullptr)
+    {
+        set_error(errcode_ret, CL_INVALID_VALUE);
+        return nullptr;
+    }
+    auto program     = new _cl_program{};
+    program->context = context;
+    for(cl_uint i = 0; i < count; i++)
+    {
+        if(lengths == nullptr || lengths[i] == 0)
+            program->source += strings[i];
+        else
+            program->source.append(strings[i], lengths[i]);
+    }
+    set_error(errcode_ret, CL_SUCCESS);
+    return program;
+}
+
+CL_API_ENTRY cl_program CL_API_CALL clCreateProgramWithBinary(cl_context context,
+                                                              cl_uint num_devices,
+                                                              const cl_device_id*,
+                                                              const size_t* lengths,
+                                                              const unsigned char** binaries,
+                                                              cl_int* binary_status,
+                                                              cl_int* errcode_ret)
+{
+    if(context == nullptr || num_devices != 1 || lengths == nullptr || binaries == nullptr)
+    {
+        set_error(errcode_ret, CL_INVALID_VALUE);
+        return nullptr;
+    }
+    auto program     = new _cl_program{};
+    program->context = context;
+    program->source.assign(reinterpret_cast<const char*>(binaries[0]), lengths[0]);
+    if(binary_status != nullptr)
+        binary_status[0] = CL_SUCCESS;
+    set_error(errcode_ret, CL_SUCCESS);
+    return program;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainProgram(cl_program program) { return retain(program); }
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseProgram(cl_program program) { return release(program); }
+
+CL_API_ENTRY cl_int CL_API_CALL clBuildProgram(cl_program program,
+                                               cl_uint,
+                                               const cl_device_id*,
+                                               const char*,
+                                               void(CL_CALLBACK* pfn_notify)(cl_program, void*),
+                                               void* user_data)
+{
+    if(program == nullptr)
+        return CL_INVALID_PROGRAM;
+    if(pfn_notify != nullptr)
+        pfn_notify(program, user_data);
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetProgramInfo(cl_program program,
+                                                 cl_program_info param_name,
+                                                 size_t param_value_size,
+                                                 void* param_value,
+                                                 size_t* param_value_size_ret)
+{
+    if(program == nullptr)
+        return CL_INVALID_PROGRAM;
+    switch(param_name)
+    {
+    case CL_PROGRAM_SOURCE:
+        return get_string(program->source, param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_CONTEXT:
+        return get_info(program->context, param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_NUM_DEVICES:
+        return get_info(cl_uint{1}, param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_DEVICES:
+        return get_info(
+            cl_device_id{&stub_device}, param_value_size, param_value, param_value_size_ret);
+    // The "binary" is the source, which is what clCreateProgramWithBinary expects back.
+    case CL_PROGRAM_BINARY_SIZES:
+        return get_info(
+            program->source.size(), param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_BINARIES:
+        if(param_value_size_ret != nullptr)
+            *param_value_size_ret = sizeof(char*);
+        if(param_value != nullptr)
+        {
+            if(param_value_size < sizeof(char*))
+                return CL_INVALID_VALUE;
+            char* binary = static_cast<char**>(param_value)[0];
+            if(binary != nullptr)
+                std::copy(program->source.begin(), program->source.end(), binary);
+        }
+        return CL_SUCCESS;
+    default: return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetProgramBuildInfo(cl_program program,
+                                                      cl_device_id,
+                                                      cl_program_build_info param_name,
+                                                      size_t param_value_size,
+                                                      void* param_value,
+                                                      size_t* param_value_size_ret)
+{
+    if(program == nullptr)
+        return CL_INVALID_PROGRAM;
+    switch(param_name)
+    {
+    case CL_PROGRAM_BUILD_STATUS:
+        return get_info(cl_build_status{CL_BUILD_SUCCESS},
+                        param_value_size,
+                        param_value,
+                        param_value_size_ret);
+    case CL_PROGRAM_BUILD_OPTIONS:
+    case CL_PROGRAM_BUILD_LOG:
+        return get_string("", param_value_size, param_value, param_value_size_ret);
+    default: return get_zeros(param_value_size, param_value, param_value_size_ret);
+    }
+}
+
+CL_API_ENTRY cl_kernel CL_API_CALL clCreateKernel(cl_program program,
+                                                  const char* kernel_name,
+                                                  cl_int* errcode_ret)
+{
+    if(program == nullptr || kernel_name == nullptr)
+    {
+        set_error(errcode_ret, CL_INVALID_VALUE);
+        return nullptr;
+    }
+    retain(program);
+    auto kernel     = new _cl_kernel{};
+    kernel->program = program;
+    kernel->name    = kernel_name;
+    set_error(errcode_ret, CL_SUCCESS);
+    return kernel;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainKernel(cl_kernel kernel) { return retain(kernel); }
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseKernel(cl_kernel kernel)
+{
+    if(kernel == nullptr)
+        return CL_INVALID_KERNEL;
+    auto program = kernel->program;
+    if(--kernel->refs == 0)
+    {
+        delete kernel;
+        release(program);
+    }
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clSetKernelArg(cl_kernel kernel,
+                                               cl_uint arg_index,
+                                               size_t,
+                                               const void*)
+{
+    if(kernel == nullptr)
+        return CL_INVALID_KERNEL;
+    kernel->num_args = std::max(kernel->num_args, arg_index + 1);
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetKernelInfo(cl_kernel kernel,
+                                                cl_kernel_info param_name,
+                                                size_t param_value_size,
+                                                void* param_value,
+                                                size_t* param_value_size_ret)
+{
+    if(kernel == nullptr)
+        return CL_INVALID_KERNEL;
+    switch(param_name)
+    {
+    case CL_KERNEL_FUNCTION_NAME:
+        return get_string(kernel->name, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_NUM_ARGS:
+        return get_info(kernel->num_args, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_PROGRAM:
+        return get_info(kernel->program, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_CONTEXT:
+        return get_info(
+            kernel->program->context, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_REFERENCE_COUNT:
+        return get_info(cl_uint(kernel->refs), param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetKernelWorkGroupInfo(cl_kernel kernel,
+                                                         cl_device_id,
+                                                         cl_kernel_work_group_info param_name,
+                                                         size_t param_value_size,
+                                                         void* param_value,
+                                                         size_t* param_value_size_ret)
+{
+    if(kernel == nullptr)
+        return CL_INVALID_KERNEL;
+    switch(param_name)
+    {
+    case CL_KERNEL_WORK_GROUP_SIZE:
+        return get_info(size_t{1024}, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE:
+        return get_info(size_t{64}, param_value_size, param_value, param_value_size_ret);
+    default: return get_zeros(param_value_size, param_value, param_value_size_ret);
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clWaitForEvents(cl_uint num_events, const cl_event* event_list)
+{
+    for(cl_uint i = 0; i < num_events; i++)
+    {
+        if(event_list[i] == nullptr)
+            return CL_INVALID_EVENT;
+    }
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetEventInfo(cl_event event,
+                                               cl_event_info param_name,
+                                               size_t param_value_size,
+                                               void* param_value,
+                                               size_t* param_value_size_ret)
+{
+    if(event == nullptr)
+        return CL_INVALID_EVENT;
+    switch(param_name)
+    {
+    case CL_EVENT_COMMAND_QUEUE:
+        return get_info(event->queue, param_value_size, param_value, param_value_size_ret);
+    case CL_EVENT_COMMAND_EXECUTION_STATUS:
+        return get_info(cl_int{CL_COMPLETE}, param_value_size, param_value, param_value_size_ret);
+    case CL_EVENT_REFERENCE_COUNT:
+        return get_info(cl_uint(event->refs), param_value_size, param_value, param_value_size_ret);
+    default: return get_zeros(param_value_size, param_value, param_value_size_ret);
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainEvent(cl_event event) { return retain(event); }
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseEvent(cl_event event) { return release(event); }
+
+CL_API_ENTRY cl_int CL_API_CALL clGetEventProfilingInfo(cl_event event,
+                                                        cl_profiling_info,
+                                                        size_t param_value_size,
+                                                        void* param_value,
+                                                        size_t* param_value_size_ret)
+{
+    if(event == nullptr)
+        return CL_INVALID_EVENT;
+    return get_info(event->timestamp, param_value_size, param_value, param_value_size_ret);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clFlush(cl_command_queue queue)
+{
+    return queue == nullptr ? CL_INVALID_COMMAND_QUEUE : CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clFinish(cl_command_queue queue)
+{
+    return queue == nullptr ? CL_INVALID_COMMAND_QUEUE : CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueReadBuffer(cl_command_queue queue,
+                                                    cl_mem buffer,
+                                                    cl_bool,
+                                                    size_t offset,
+                                                    size_t size,
+                                                    void* ptr,
+                                                    cl_uint,
+                                                    const cl_event*,
+                                                    cl_event* event)
+{
+    if(buffer == nullptr || offset + size > buffer->size)
+        return CL_INVALID_VALUE;
+    std::memcpy(ptr, buffer->data() + offset, size);
+    return complete(queue, event);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueWriteBuffer(cl_command_queue queue,
+                                                     cl_mem buffer,
+                                                     cl_bool,
+                                                     size_t offset,
+                                                     size_t size,
+                                                     const void* ptr,
+                                                     cl_uint,
+                                                     const cl_event*,
+                                                     cl_event* event)
+{
+    if(buffer == nullptr || offset + size > buffer->size)
+        return CL_INVALID_VALUE;
+    std::memcpy(buffer->data() + offset, ptr, size);
+    return complete(queue, event);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueCopyBuffer(cl_command_queue queue,
+                                                    cl_mem src_buffer,
+                                                    cl_mem dst_buffer,
+                                                    size_t src_offset,
+                                                    size_t dst_offset,
+                                                    size_t size,
+                                                    cl_uint,
+                                                    const cl_event*,
+                                                    cl_event* event)
+{
+    if(src_buffer == nullptr || dst_buffer == nullptr || src_offset + size > src_buffer->size ||
+       dst_offset + size > dst_buffer->size)
+        return CL_INVALID_VALUE;
+    std::memmove(dst_buffer->data() + dst_offset, src_buffer->data() + src_offset, size);
+    return complete(queue, event);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueFillBuffer(cl_command_queue queue,
+                                                    cl_mem buffer,
+                                                    const void* pattern,
+                                                    size_t pattern_size,
+                                                    size_t offset,
+                                                    size_t size,
+                                                    cl_uint,
+                                                    const cl_event*,
+                                                    cl_event* event)
+{
+    if(buffer == nullptr || pattern_size == 0 || offset + size > buffer->size)
+        return CL_INVALID_VALUE;
+    for(size_t i = 0; i + pattern_size <= size; i += pattern_size)
+        std::memcpy(buffer->data() + offset + i, pattern, pattern_size);
+    return complete(queue, event);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueNDRangeKernel(cl_command_queue queue,
+                                                       cl_kernel kernel,
+                                                       cl_uint,
+                                                       const size_t*,
+                                                       const size_t*,
+                                                       const size_t*,
+                                                       cl_uint,
+                                                       const cl_event*,
+                                                       cl_event* event)
+{
+    if(kernel == nullptr)
+        return CL_INVALID_KERNEL;
+    return complete(queue, event);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueMarkerWithWaitList(cl_command_queue queue,
+                                                            cl_uint,
+                                                            const cl_event*,
+                                                            cl_event* event)
+{
+    return complete(queue, event);
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueBarrierWithWaitList(cl_command_queue queue,
+                                                             cl_uint,
+                                                             const cl_event*,
+                                                             cl_event* event)
+{
+    return complete(queue, event);
+}
+
+} // extern "C"
@@ -819,8 +819,11 @@ struct check_tensor_support
 
     void run()
     {
-        EXPECT(miopenSet4dTensorDescriptor(tensor, miopenHalf, 100, 32, 8, 8) !=
+        EXPECT(miopenSet4dTensorDescriptor(tensor, miopenHalf, 100, 32, 8, 8) ==
                miopenStatusSuccess);
+        size_t numBytes = 0;
+        miopenGetTensorNumBytes(tensor, &numBytes);
+        EXPECT(numBytes == 100 * 32 * 8 * 8 * 2);
     }
 
     ~check_tensor_support() { miopenDestroyTensorDescriptor(tensor); }
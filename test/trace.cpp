@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_record.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/trace.hpp>
+#include "temp_file_path.hpp"
+#include "test.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct TraceValue
+{
+    int x = 0;
+
+    void Serialize(std::ostream& s) const { s << x; }
+    bool Deserialize(const std::string& s)
+    {
+        x = std::stoi(s);
+        return true;
+    }
+#if MIOPEN_PERFDB_CONV_LEGACY_SUPPORT
+    void LegacySerialize(std::ostream& s) const { Serialize(s); }
+    bool LegacyDeserialize(const std::string& s) { return Deserialize(s); }
+#endif
+};
+
+std::string Write2s()
+{
+    return "__kernel void write(__global int* data) { data[get_global_id(0)] *= 2; }\n";
+}
+
+// Outlives the flush at exit, so the file is removed last.
+const miopen::TempFilePath& trace_file()
+{
+    static const miopen::TempFilePath result("/tmp/miopen.tests.trace.XXXXXX");
+    return result;
+}
+
+std::string read_trace()
+{
+    miopen::FlushTrace();
+    std::ifstream file(trace_file());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+bool contains(const std::string& s, const std::string& x) { return s.find(x) != std::string::npos; }
+
+void check_host_spans()
+{
+    {
+        miopen::TraceSpan span{"test", "outer \"span\""};
+        span.Arg("answer", 42.0).Arg("path", "a\\b");
+        miopen::TraceSequence seq{"test"};
+        seq.Mark("first");
+        seq.Mark("second", miopen::TraceArgs{}.Add("n", 2.0));
+    }
+
+    const auto trace = read_trace();
+    CHECK(trace.compare(0, 16, "{\"traceEvents\":[") == 0);
+    CHECK(contains(trace, "\"name\":\"outer \\\"span\\\"\""));
+    CHECK(contains(trace, "\"args\":{\"answer\":42,\"path\":\"a\\\\b\"}"));
+    CHECK(contains(trace, "\"name\":\"first\""));
+    CHECK(contains(trace, "\"name\":\"second\""));
+    CHECK(contains(trace, "\"process_name\""));
+}
+
+void check_perfdb()
+{
+    miopen::TempFilePath db_file("/tmp/miopen.tests.trace_db.XXXXXX");
+    const char* db_path = db_file;
+    TraceValue key;
+    key.x = 1;
+    TraceValue value;
+    value.x = 7;
+    {
+        miopen::DbRecord record(db_path, key);
+        CHECK(record.Store("solver", value));
+    }
+    TraceValue read;
+    {
+        miopen::DbRecord record(db_path, key);
+        CHECK(record.Load("solver", read));
+    }
+    CHECK(read.x == 7);
+
+    const auto trace = read_trace();
+    CHECK(contains(trace, "\"name\":\"DbRecord::Store\""));
+    CHECK(contains(trace, "\"name\":\"DbRecord::Load\""));
+    CHECK(contains(trace, "\"id\":\"solver\""));
+}
+
+void check_kernel_alignment()
+{
+    static int queue = 0;
+    std::vector<miopen::KernelProfile> profiles(2);
+    profiles[0].kernel_name = "aligned0";
+    profiles[0].enqueue_ns  = 1000;
+    profiles[0].start_ns    = 5000;
+    profiles[0].end_ns      = 5400;
+    profiles[1].kernel_name = "aligned1";
+    profiles[1].enqueue_ns  = 2000;
+    profiles[1].start_ns    = 5500;
+    profiles[1].end_ns      = 6000;
+    miopen::TraceKernels(&queue, profiles);
+
+    // The second kernel is the tighter bound: it starts as it is enqueued.
+    const auto trace = read_trace();
+    CHECK(contains(trace, "\"name\":\"aligned0\",\"pid\":2,\"tid\":0,\"ts\":1.500,\"dur\":0.400"));
+    CHECK(contains(trace, "\"name\":\"aligned1\",\"pid\":2,\"tid\":0,\"ts\":2.000,\"dur\":0.500"));
+}
+
+void check_handle()
+{
+    const std::size_t n = 64;
+    {
+        miopen::Handle h;
+        std::vector<int> data_in(n, 1);
+        auto data_dev = h.Write(data_in);
+        h.GetKernel("miopenGeneratedTrace", "write", Write2s(), "write", {n, 1, 1}, {n, 1, 1}, "")(
+            data_dev.get());
+        auto data_out = h.Read<int>(data_dev, n);
+        CHECK(data_out == std::vector<int>(n, 2));
+    }
+
+    // Destroying the handle drains its launches and rewrites the file.
+    std::ifstream file(trace_file());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const auto trace = ss.str();
+    CHECK(contains(trace, "\"cat\":\"program\",\"name\":\"Handle::LoadProgram\""));
+    CHECK(contains(trace, "\"cat\":\"enqueue\",\"name\":\"write\""));
+    CHECK(contains(trace, "\"cat\":\"kernel\",\"name\":\"write\""));
+}
+
+int main()
+{
+    setenv("MIOPEN_TRACE", trace_file(), 1);
+    CHECK(miopen::IsTracingEnabled());
+
+    check_host_spans();
+    check_perfdb();
+    check_kernel_alignment();
+    check_handle();
+}
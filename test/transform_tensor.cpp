@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "get_handle.hpp"
+#include "half.hpp"
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_ops.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Packed strides of a tensor whose dimensions are stored in the given order, outermost first
+std::vector<int> strides_for(const std::vector<int>& lens, const std::vector<int>& order)
+{
+    std::vector<int> strides(lens.size());
+    int stride = 1;
+    for(auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+        strides[*it] = stride;
+        stride *= lens[*it];
+    }
+    return strides;
+}
+
+std::vector<int> packed_order(std::size_t dims)
+{
+    std::vector<int> order(dims);
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+}
+
+// Calls f with the x and y offsets of every element
+template <class F>
+void for_each_index(const miopen::TensorDescriptor& xDesc,
+                    const miopen::TensorDescriptor& yDesc,
+                    F f)
+{
+    const auto& lens = xDesc.GetLengths();
+    std::vector<std::size_t> idx(lens.size(), 0);
+    for(std::size_t n = 0; n < xDesc.GetElementSize(); n++)
+    {
+        f(std::inner_product(idx.begin(), idx.end(), xDesc.GetStrides().begin(), std::size_t{0}),
+          std::inner_product(idx.begin(), idx.end(), yDesc.GetStrides().begin(), std::size_t{0}));
+        for(int d = lens.size() - 1; d >= 0; d--)
+        {
+            if(++idx[d] < lens[d])
+                break;
+            idx[d] = 0;
+        }
+    }
+}
+
+std::vector<uint16_t> to_half_data(const std::vector<float>& v)
+{
+    std::vector<uint16_t> result(v.size());
+    std::transform(v.begin(), v.end(), result.begin(), &to_half);
+    return result;
+}
+
+std::vector<float> from_half_data(const std::vector<uint16_t>& v)
+{
+    std::vector<float> result(v.size());
+    std::transform(v.begin(), v.end(), result.begin(), &from_half);
+    return result;
+}
+
+void test_transform(std::vector<int> lens,
+                    std::vector<int> x_order,
+                    std::vector<int> y_order,
+                    float alpha             = 1,
+                    float beta              = 0,
+                    miopenDataType_t x_type = miopenFloat,
+                    miopenDataType_t y_type = miopenFloat)
+{
+    auto&& handle = get_handle();
+    auto dims     = static_cast<int>(lens.size());
+    miopen::TensorDescriptor xDesc{x_type, lens.data(), strides_for(lens, x_order).data(), dims};
+    miopen::TensorDescriptor yDesc{y_type, lens.data(), strides_for(lens, y_order).data(), dims};
+
+    auto x = half_exact_data(xDesc.GetElementSpace(), 0);
+    auto y = half_exact_data(yDesc.GetElementSpace(), 1);
+
+    auto expected = y;
+    for_each_index(xDesc, yDesc, [&](std::size_t xi, std::size_t yi) {
+        expected[yi] = alpha * x[xi] + beta * y[yi];
+    });
+
+    auto x_dev = x_type == miopenHalf ? handle.Write(to_half_data(x)) : handle.Write(x);
+    auto y_dev = y_type == miopenHalf ? handle.Write(to_half_data(y)) : handle.Write(y);
+    miopen::TransformTensor(handle, &alpha, xDesc, x_dev.get(), &beta, yDesc, y_dev.get());
+    auto result = y_type == miopenHalf ? from_half_data(handle.Read<uint16_t>(y_dev, y.size()))
+                                       : handle.Read<float>(y_dev, y.size());
+
+    CHECK(all_close(result, expected, y_type == miopenHalf ? 1e-3f : 1e-6f));
+}
+
+int main()
+{
+    // NCHW <-> NHWC, through the tiled transpose
+    test_transform({2, 5, 7, 9}, {0, 1, 2, 3}, {0, 2, 3, 1});
+    test_transform({2, 40, 33, 3}, {0, 2, 3, 1}, {0, 1, 2, 3});
+    // sequence major <-> batch major RNN data, the innermost dimension is kept
+    test_transform({5, 3, 33}, {0, 1, 2}, {1, 0, 2});
+    // 5-D permutation and the plain copy of equal layouts
+    test_transform({2, 3, 4, 5, 6}, packed_order(5), {4, 2, 0, 3, 1});
+    test_transform({2, 3, 4, 5, 6}, packed_order(5), packed_order(5));
+    test_transform({70}, {0}, {0});
+    // blending and type conversion
+    test_transform({2, 5, 7, 9}, {0, 1, 2, 3}, {0, 2, 3, 1}, 2, 0.5f);
+    test_transform({5, 3, 33}, {0, 1, 2}, {1, 0, 2}, 0.5f, 1);
+    test_transform({2, 5, 7, 9}, {0, 1, 2, 3}, {0, 2, 3, 1}, 1, 0, miopenHalf, miopenFloat);
+    test_transform({2, 5, 7, 9}, {0, 2, 3, 1}, {0, 1, 2, 3}, 1, 0, miopenFloat, miopenHalf);
+    test_transform({2, 5, 7, 9}, {0, 1, 2, 3}, {0, 1, 2, 3}, 1, 0, miopenHalf, miopenHalf);
+
+    CHECK(throws([] { test_transform({2, 3, 4, 5, 6, 7}, packed_order(6), packed_order(6)); }));
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "counting_allocator.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <cmath>
+
+float gen_value(int n, int c, int h, int w)
+{
+    return ((n * 7 + c * 5 + h * 3 + w) % 13) / 13.0 - 0.5;
+}
+
+void test_arena()
+{
+    miopenHandle_t handle;
+    CHECK(miopenCreate(&handle) == miopenStatusSuccess);
+    auto&& h = miopen::deref(handle);
+
+    counting_allocator counter;
+    miopenSetAllocator(
+        handle, &counting_allocator::allocate, &counting_allocator::deallocate, &counter);
+    miopenEnableMemoryPool(handle, false);
+
+    // Disabled by default
+    miopenSetWorkspaceArenaLimit(handle, 0);
+    CHECK(h.GetWorkspaceArena(100) == nullptr);
+    CHECK(counter.allocs == 0);
+
+    // Only grows when a larger workspace is needed
+    miopenSetWorkspaceArenaLimit(handle, 1000);
+    auto p = h.GetWorkspaceArena(100);
+    CHECK(p != nullptr);
+    CHECK(h.GetWorkspaceArena(50) == p);
+    CHECK(counter.allocs == 1);
+    CHECK(h.GetWorkspaceArena(200) != nullptr);
+    CHECK(counter.allocs == 2);
+    CHECK(counter.frees == 1);
+
+    std::size_t size = 0;
+    CHECK(miopenGetWorkspaceArenaSize(handle, &size) == miopenStatusSuccess);
+    CHECK(size == 200);
+
+    // Requests over the limit are left to the caller
+    CHECK(h.GetWorkspaceArena(2000) == nullptr);
+    CHECK(counter.allocs == 2);
+
+    // Lowering the limit below the current size frees the buffer
+    miopenSetWorkspaceArenaLimit(handle, 100);
+    CHECK(counter.frees == 2);
+    CHECK(h.GetWorkspaceArenaSize() == 0);
+
+    miopenDestroy(handle);
+    CHECK(counter.frees == counter.allocs);
+}
+
+void test_conv_forward()
+{
+    auto&& handle = get_handle();
+    miopen::ConvolutionDescriptor filter(1, 1, 1, 1);
+    auto input   = tensor<float>{2, 8, 16, 16}.generate(gen_value);
+    auto weights = tensor<float>{4, 8, 3, 3}.generate(gen_value);
+    auto out     = tensor<float>{filter.GetForwardOutputTensor(input.desc, weights.desc)};
+
+    auto in_dev  = handle.Write(input.data);
+    auto wei_dev = handle.Write(weights.data);
+    auto out_dev = handle.Write(out.data);
+
+    size_t workspace_size =
+        filter.ForwardGetWorkSpaceSize(handle, weights.desc, input.desc, out.desc);
+    std::vector<char> workspace(workspace_size);
+    auto workspace_dev = workspace_size != 0 ? handle.Write(workspace) : nullptr;
+
+    auto run = [&](miopenConvFwdAlgorithm_t algo, Data_t ws, std::size_t ws_size) {
+        float alpha = 1, beta = 0;
+        out_dev     = handle.Write(out.data);
+        filter.ConvolutionForward(handle,
+                                  &alpha,
+                                  input.desc,
+                                  in_dev.get(),
+                                  weights.desc,
+                                  wei_dev.get(),
+                                  algo,
+                                  &beta,
+                                  out.desc,
+                                  out_dev.get(),
+                                  ws,
+                                  ws_size);
+        return handle.Read<float>(out_dev, out.data.size());
+    };
+
+    handle.SetWorkspaceArenaLimit(std::size_t{1} << 30);
+
+    // Find also runs on the arena when no workspace is passed
+    int ret_algo_count;
+    miopenConvAlgoPerf_t perf;
+    filter.FindConvFwdAlgorithm(handle,
+                                input.desc,
+                                in_dev.get(),
+                                weights.desc,
+                                wei_dev.get(),
+                                out.desc,
+                                out_dev.get(),
+                                1,
+                                &ret_algo_count,
+                                &perf,
+                                nullptr,
+                                0,
+                                false);
+
+    auto expected = run(perf.fwd_algo, workspace_dev.get(), workspace_size);
+    auto result   = run(perf.fwd_algo, nullptr, 0);
+    CHECK(std::equal(result.begin(), result.end(), expected.begin(), [](float x, float y) {
+        return std::abs(x - y) <= 1e-4f * std::max(1.0f, std::abs(y));
+    }));
+    CHECK(handle.GetWorkspaceArenaSize() == workspace_size);
+
+#if MIOPEN_USE_MIOPENGEMM
+    // The 3x3 GEMM path needs a workspace, which now comes from the arena
+    expected = run(miopenConvolutionFwdAlgoGEMM, workspace_dev.get(), workspace_size);
+    result   = run(miopenConvolutionFwdAlgoGEMM, nullptr, 0);
+    CHECK(std::equal(result.begin(), result.end(), expected.begin(), [](float x, float y) {
+        return std::abs(x - y) <= 1e-4f * std::max(1.0f, std::abs(y));
+    }));
+    CHECK(handle.GetWorkspaceArenaSize() == workspace_size);
+
+    // Without enough room the caller has to provide the workspace again
+    handle.SetWorkspaceArenaLimit(workspace_size - 1);
+    CHECK(throws([&] { run(miopenConvolutionFwdAlgoGEMM, nullptr, 0); }));
+#endif
+
+    // get_handle() is shared, leave the arena disabled
+    handle.SetWorkspaceArenaLimit(0);
+}
+
+int main()
+{
+    test_arena();
+    test_conv_forward();
+}